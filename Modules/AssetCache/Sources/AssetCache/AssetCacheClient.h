@@ -44,6 +44,7 @@ private:
 
     //ClientNetProxyListener
     void OnAddedToCache(const AssetCache::CacheItemKey& key, bool added) override;
+    void OnAddManifestAccepted(const AssetCache::CacheItemKey& key, bool accepted, const Vector<uint32>& missingChunks) override;
     void OnReceivedFromCache(const AssetCache::CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) override;
     void OnRemovedFromCache(const AssetCache::CacheItemKey& key, bool removed) override;
     void OnCacheCleared(bool cleared) override;
@@ -117,13 +118,13 @@ private:
         void Reset()
         {
             serializedData->Truncate(0);
-            chunksSent = 0;
-            chunksOverall = 0;
+            chunks.clear();
+            missingChunks.clear();
         }
 
         ScopedPtr<DynamicMemoryFile> serializedData;
-        uint32 chunksSent = 0;
-        uint32 chunksOverall = 0;
+        Vector<AssetCache::ContentChunk> chunks;
+        Vector<uint32> missingChunks; // indices of chunks that server doesn't have
     };
 
     struct Stats
@@ -138,6 +139,8 @@ private:
         uint32 addRequestsFailedCount = 0;
         uint32 addRequestsTimeoutCount = 0;
         uint32 addRequestsSucceedCount = 0;
+        uint64 addChunksCount = 0;
+        uint64 addChunksSentCount = 0;
 
         uint32 incorrectPacketsCount = 0;
     };
@@ -28,6 +28,9 @@ enum ePacketID : uint8
     PACKET_REMOVE_RESPONSE,
     PACKET_CLEAR_REQUEST,
     PACKET_CLEAR_RESPONSE,
+    PACKET_ADD_MANIFEST_REQUEST,
+    PACKET_ADD_MANIFEST_RESPONSE,
+    PACKET_ADD_CONTENT_CHUNK_REQUEST,
     PACKET_COUNT
 };
 
@@ -3,8 +3,10 @@
 #include "AssetCache/CacheItemKey.h"
 #include "AssetCache/CachedItemValue.h"
 #include "AssetCache/AssetCacheConstants.h"
+#include "AssetCache/ChunkSplitter.h"
 
 #include <FileSystem/DynamicMemoryFile.h>
+#include <Functional/Function.h>
 
 #include <memory>
 
@@ -77,8 +79,14 @@ private:
 class DataChunkPacket : public CachePacket
 {
 public:
+    using ChunkReader = Function<bool(uint8* dst, uint32 size)>;
+
     DataChunkPacket(ePacketID packetId);
     DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkSize, const ChunkReader& reader);
+
+    /** Return false if chunk data for sending can't be read */
+    bool IsValid() const;
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
@@ -89,8 +97,16 @@ public:
     uint32 numOfChunks = 0;
     uint32 chunkNumber = 0;
     Vector<uint8> chunkData;
+
+private:
+    bool isValid = true;
 };
 
+inline bool DataChunkPacket::IsValid() const
+{
+    return isValid;
+}
+
 //////////////////////////////////////////////////////////////////////////
 class AddChunkRequestPacket : public DataChunkPacket
 {
@@ -135,6 +151,9 @@ class GetChunkResponsePacket : public DataChunkPacket
 public:
     GetChunkResponsePacket();
     GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+
+    /** Chunk data is read by `reader` directly into sending buffer */
+    GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkSize, const ChunkReader& reader);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -219,5 +238,55 @@ public:
     bool cleared = false;
 };
 
+//////////////////////////////////////////////////////////////////////////
+// Add request with deduplication: client sends list of content chunks, server answers with chunks it doesn't have,
+// then client sends only them with AddContentChunkRequestPacket. Server answers every chunk with AddResponsePacket
+class AddManifestRequestPacket : public CachePacket
+{
+public:
+    AddManifestRequestPacket();
+    AddManifestRequestPacket(const CacheItemKey& key, uint64 dataSize, const Vector<ContentChunk>& chunks);
+
+protected:
+    bool DeserializeFromBuffer(File* file) override;
+
+public:
+    CacheItemKey key;
+    uint64 dataSize = 0;
+    Vector<ContentChunk> chunks;
+};
+
+//////////////////////////////////////////////////////////////////////////
+class AddManifestResponsePacket : public CachePacket
+{
+public:
+    AddManifestResponsePacket();
+    AddManifestResponsePacket(const CacheItemKey& key, bool accepted, const Vector<uint32>& missingChunks);
+
+protected:
+    bool DeserializeFromBuffer(File* file) override;
+
+public:
+    CacheItemKey key;
+    bool accepted = false;
+    Vector<uint32> missingChunks; // empty list for accepted manifest means that data is already added
+};
+
+//////////////////////////////////////////////////////////////////////////
+class AddContentChunkRequestPacket : public CachePacket
+{
+public:
+    AddContentChunkRequestPacket();
+    AddContentChunkRequestPacket(const CacheItemKey& key, uint32 chunkIndex, const uint8* chunkData, uint32 chunkSize);
+
+protected:
+    bool DeserializeFromBuffer(File* file) override;
+
+public:
+    CacheItemKey key;
+    uint32 chunkIndex = 0;
+    Vector<uint8> chunkData;
+};
+
 } // end of namespace AssetCache
 } // end of namespace DAVA
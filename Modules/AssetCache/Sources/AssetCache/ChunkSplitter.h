@@ -1,15 +1,42 @@
 #pragma once
 
 #include <Base/BaseTypes.h>
+#include <Utils/MD5.h>
 
 namespace DAVA
 {
 namespace AssetCache
 {
+using ChunkHash = MD5::MD5Digest;
+
+/** Part of serialized CachedItemValue identified by hash of its content */
+struct ContentChunk
+{
+    ChunkHash hash;
+    uint64 offset = 0;
+    uint32 size = 0;
+};
+
+struct ChunkHashHasher
+{
+    size_t operator()(const ChunkHash& hash) const;
+};
+
 namespace ChunkSplitter
 {
 uint32 GetNumberOfChunks(uint64 overallSize);
 Vector<uint8> GetChunk(const Vector<uint8>& dataVector, uint32 chunkNumber);
+
+/**
+    Split data into chunks with boundaries defined by content (rolling gear hash), so insertion or removal
+    of bytes in the middle of data changes only neighbouring chunks and the rest can be deduplicated.
+    Chunks are between MIN_CONTENT_CHUNK_SIZE and MAX_CONTENT_CHUNK_SIZE bytes, except the last one.
+*/
+Vector<ContentChunk> SplitByContent(const uint8* data, uint64 dataSize);
+
+static const uint32 MIN_CONTENT_CHUNK_SIZE = 64 * 1024;
+static const uint32 AVERAGE_CONTENT_CHUNK_SIZE = 256 * 1024;
+static const uint32 MAX_CONTENT_CHUNK_SIZE = 1024 * 1024;
 }
 } // namespace AssetCache
 } // namespace DAVA
@@ -2,6 +2,7 @@
 
 #include "AssetCache/Connection.h"
 #include "AssetCache/CacheItemKey.h"
+#include "AssetCache/ChunkSplitter.h"
 
 #include <Base/BaseTypes.h>
 #include <Network/IChannel.h>
@@ -27,6 +28,7 @@ public:
 
     virtual void OnClientProxyStateChanged(){};
     virtual void OnAddedToCache(const CacheItemKey& key, bool added){};
+    virtual void OnAddManifestAccepted(const CacheItemKey& key, bool accepted, const Vector<uint32>& missingChunks){};
     virtual void OnReceivedFromCache(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData){};
     virtual void OnRemovedFromCache(const CacheItemKey& key, bool removed){};
     virtual void OnCacheCleared(bool cleared){};
@@ -52,6 +54,8 @@ public:
     // requests to sent on server
     bool RequestServerStatus();
     bool RequestAddNextChunk(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    bool RequestAddManifest(const CacheItemKey& key, uint64 dataSize, const Vector<ContentChunk>& chunks);
+    bool RequestAddContentChunk(const CacheItemKey& key, uint32 chunkIndex, const uint8* chunkData, uint32 chunkSize);
     bool RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber);
     bool RequestWarmingUp(const CacheItemKey& key);
     bool RequestRemoveData(const CacheItemKey& key);
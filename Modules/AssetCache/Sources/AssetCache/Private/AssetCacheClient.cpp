@@ -100,31 +100,56 @@ AssetCache::Error AssetCacheClient::CheckStatusSynchronously()
 AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value)
 {
     uint64 dataSizeOverall = 0;
-    uint32 chunksOverall = 0;
+    Vector<AssetCache::ContentChunk> chunks;
     {
         LockGuard<Mutex> guard(requestLocker);
-        request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
+        request = Request(AssetCache::PACKET_ADD_MANIFEST_REQUEST, key);
         addFilesRequest.Reset();
         value.Serialize(addFilesRequest.serializedData);
         dataSizeOverall = addFilesRequest.serializedData->GetSize();
-        chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(dataSizeOverall);
-        addFilesRequest.chunksSent = 0;
+        addFilesRequest.chunks = AssetCache::ChunkSplitter::SplitByContent(addFilesRequest.serializedData->GetData(), dataSizeOverall);
+        chunks = addFilesRequest.chunks;
     }
 
+    // Send list of chunks first, server answers with chunks it doesn't have yet
     AssetCache::Error resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
 
-    for (uint32 currentChunk = 0; currentChunk < chunksOverall; ++currentChunk)
+    bool requestSent = client.RequestAddManifest(key, dataSizeOverall, chunks);
+    if (requestSent)
+    {
+        resultCode = WaitRequest();
+    }
+
+    Vector<uint32> missingChunks;
     {
-        Vector<uint8> chunkData;
+        LockGuard<Mutex> guard(requestLocker);
+        request.Reset();
+        missingChunks = addFilesRequest.missingChunks;
+    }
+
+    for (uint32 chunkIndex : missingChunks)
+    {
+        if (resultCode != AssetCache::Error::NO_ERRORS)
+        {
+            break;
+        }
+
+        if (chunkIndex >= chunks.size())
+        {
+            Logger::Error("Server requested wrong chunk #%u, there are %u chunks", chunkIndex, static_cast<uint32>(chunks.size()));
+            resultCode = AssetCache::Error::WRONG_CHUNK;
+            break;
+        }
+
         {
             LockGuard<Mutex> guard(requestLocker);
-            request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
-            chunkData = AssetCache::ChunkSplitter::GetChunk(addFilesRequest.serializedData->GetDataVector(), currentChunk);
+            request = Request(AssetCache::PACKET_ADD_CONTENT_CHUNK_REQUEST, key);
         }
 
         resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
 
-        bool requestSent = client.RequestAddNextChunk(key, dataSizeOverall, chunksOverall, currentChunk, chunkData);
+        const AssetCache::ContentChunk& chunk = chunks[chunkIndex];
+        requestSent = client.RequestAddContentChunk(key, chunkIndex, addFilesRequest.serializedData->GetData() + chunk.offset, chunk.size);
         if (requestSent)
         {
             resultCode = WaitRequest();
@@ -134,11 +159,6 @@ AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::Ca
             LockGuard<Mutex> guard(requestLocker);
             request.Reset();
         }
-
-        if (resultCode != AssetCache::Error::NO_ERRORS)
-        {
-            break;
-        }
     }
 
     { //process stats
@@ -147,6 +167,8 @@ AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::Ca
         {
         case AssetCache::Error::NO_ERRORS:
             ++stats.addRequestsSucceedCount;
+            stats.addChunksCount += chunks.size();
+            stats.addChunksSentCount += missingChunks.size();
             break;
         case AssetCache::Error::OPERATION_TIMEOUT:
             ++stats.addRequestsTimeoutCount;
@@ -373,7 +395,7 @@ void AssetCacheClient::OnAddedToCache(const AssetCache::CacheItemKey& key, bool
 {
     LockGuard<Mutex> guard(requestLocker);
 
-    if ((request.requestID == AssetCache::PACKET_ADD_CHUNK_REQUEST) && request.key == key)
+    if ((request.requestID == AssetCache::PACKET_ADD_CHUNK_REQUEST || request.requestID == AssetCache::PACKET_ADD_CONTENT_CHUNK_REQUEST) && request.key == key)
     {
         request.result = (added) ? AssetCache::Error::NO_ERRORS : AssetCache::Error::SERVER_ERROR;
         request.recieved = true;
@@ -385,6 +407,23 @@ void AssetCacheClient::OnAddedToCache(const AssetCache::CacheItemKey& key, bool
     }
 }
 
+void AssetCacheClient::OnAddManifestAccepted(const AssetCache::CacheItemKey& key, bool accepted, const Vector<uint32>& missingChunks)
+{
+    LockGuard<Mutex> guard(requestLocker);
+
+    if ((request.requestID == AssetCache::PACKET_ADD_MANIFEST_REQUEST) && request.key == key)
+    {
+        request.result = (accepted) ? AssetCache::Error::NO_ERRORS : AssetCache::Error::SERVER_ERROR;
+        request.recieved = true;
+        request.processingRequest = false;
+        addFilesRequest.missingChunks = missingChunks;
+    }
+    else
+    {
+        //skip this request, because it was canceled by timeout
+    }
+}
+
 void AssetCacheClient::OnReceivedFromCache(const AssetCache::CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
 {
     LockGuard<Mutex> guard(requestLocker);
@@ -558,6 +597,8 @@ void AssetCacheClient::DumpStats() const
             Logger::Info("  all requests: %d", stats.addRequestsCount);
             if (stats.addRequestsSucceedCount > 0)
                 Logger::Info("  added: %d", stats.addRequestsSucceedCount);
+            if (stats.addChunksCount > 0)
+                Logger::Info("  chunks sent: %llu of %llu", stats.addChunksSentCount, stats.addChunksCount);
             if (stats.addRequestsTimeoutCount > 0)
                 Logger::Info("  timeout: %d", stats.addRequestsTimeoutCount);
             if (stats.addRequestsFailedCount > 0)
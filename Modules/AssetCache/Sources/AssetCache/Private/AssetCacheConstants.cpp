@@ -29,7 +29,10 @@ String PacketToString(ePacketID packet)
     { ePacketID::PACKET_REMOVE_REQUEST, "PACKET_REMOVE_REQUEST" },
     { ePacketID::PACKET_REMOVE_RESPONSE, "PACKET_REMOVE_RESPONSE" },
     { ePacketID::PACKET_CLEAR_REQUEST, "PACKET_CLEAR_REQUEST" },
-    { ePacketID::PACKET_CLEAR_RESPONSE, "PACKET_CLEAR_RESPONSE" }
+    { ePacketID::PACKET_CLEAR_RESPONSE, "PACKET_CLEAR_RESPONSE" },
+    { ePacketID::PACKET_ADD_MANIFEST_REQUEST, "PACKET_ADD_MANIFEST_REQUEST" },
+    { ePacketID::PACKET_ADD_MANIFEST_RESPONSE, "PACKET_ADD_MANIFEST_RESPONSE" },
+    { ePacketID::PACKET_ADD_CONTENT_CHUNK_REQUEST, "PACKET_ADD_CONTENT_CHUNK_REQUEST" }
     } };
 
     DVASSERT(static_cast<uint32>(ePacketID::PACKET_COUNT) == packetStrings.size());
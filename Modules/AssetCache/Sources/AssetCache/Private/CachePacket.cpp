@@ -9,7 +9,7 @@ namespace DAVA
 namespace AssetCache
 {
 const uint16 PACKET_HEADER = 0xACCA;
-const uint8 PACKET_VERSION = 3;
+const uint8 PACKET_VERSION = 4;
 
 Map<const uint8*, ScopedPtr<DynamicMemoryFile>> CachePacket::sendingPackets;
 
@@ -27,8 +27,24 @@ bool ReadFromBuffer(File* buffer, T& value)
     return (buffer->Read(&value) == sizeof(value));
 };
 
+bool ReadFromBuffer(File* buffer, ContentChunk& chunk)
+{
+    const uint32 hashSize = static_cast<uint32>(chunk.hash.digest.size());
+    return (buffer->Read(chunk.hash.digest.data(), hashSize) == hashSize) && ReadFromBuffer(buffer, chunk.size);
+};
+
+bool HasBytes(File* buffer, uint64 count)
+{
+    return count <= buffer->GetSize() - buffer->GetPos();
+}
+
 bool ReadFromBuffer(File* buffer, Vector<uint8>& data, uint32 dataSize)
 {
+    if (!HasBytes(buffer, dataSize))
+    {
+        return false;
+    }
+
     data.resize(dataSize);
     if (dataSize > 0)
     {
@@ -128,6 +144,12 @@ std::unique_ptr<CachePacket> CachePacket::CreateByType(ePacketID type)
         return std::unique_ptr<CachePacket>(new ClearRequestPacket());
     case PACKET_CLEAR_RESPONSE:
         return std::unique_ptr<CachePacket>(new ClearResponsePacket());
+    case PACKET_ADD_MANIFEST_REQUEST:
+        return std::unique_ptr<CachePacket>(new AddManifestRequestPacket());
+    case PACKET_ADD_MANIFEST_RESPONSE:
+        return std::unique_ptr<CachePacket>(new AddManifestResponsePacket());
+    case PACKET_ADD_CONTENT_CHUNK_REQUEST:
+        return std::unique_ptr<CachePacket>(new AddContentChunkRequestPacket());
     default:
     {
         Logger::Error("[CachePacket::%s] Wrong packet type: %d", __FUNCTION__, type);
@@ -174,6 +196,30 @@ DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, ui
     }
 }
 
+DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkSize, const ChunkReader& reader)
+    : CachePacket(packetId, DO_NOT_CREATE_SENDING_BUFFER)
+{
+    ScopedPtr<DynamicMemoryFile> fields(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    WriteHeader(fields);
+
+    fields->Write(key.data(), static_cast<uint32>(key.size()));
+    fields->Write(&dataSize, sizeof(dataSize));
+    fields->Write(&numOfChunks, sizeof(numOfChunks));
+    fields->Write(&chunkNumber, sizeof(chunkNumber));
+    fields->Write(&chunkSize, sizeof(chunkSize));
+
+    // chunk is read right into the tail of sending buffer to avoid copying of big chunks
+    Vector<uint8> buffer(fields->GetDataVector());
+    const size_t fieldsSize = buffer.size();
+    buffer.resize(fieldsSize + chunkSize);
+    if (chunkSize > 0)
+    {
+        isValid = reader(buffer.data() + fieldsSize, chunkSize);
+    }
+
+    serializationBuffer.reset(DynamicMemoryFile::Create(std::move(buffer), File::OPEN | File::READ | File::WRITE, FilePath()));
+}
+
 DataChunkPacket::DataChunkPacket(ePacketID packetId)
     : CachePacket(packetId, DO_NOT_CREATE_SENDING_BUFFER)
 {
@@ -251,6 +297,11 @@ GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, uint64 d
 {
 }
 
+GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkSize, const ChunkReader& reader)
+    : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE, key, dataSize, numOfChunks, chunkNumber, chunkSize, reader)
+{
+}
+
 GetChunkResponsePacket::GetChunkResponsePacket()
     : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE)
 {
@@ -370,5 +421,140 @@ bool ClearResponsePacket::DeserializeFromBuffer(File* file)
     return ((file->Read(&cleared) == sizeof(cleared)));
 }
 
+//////////////////////////////////////////////////////////////////////////
+AddManifestRequestPacket::AddManifestRequestPacket(const CacheItemKey& key_, uint64 dataSize_, const Vector<ContentChunk>& chunks_)
+    : CachePacket(PACKET_ADD_MANIFEST_REQUEST, CREATE_SENDING_BUFFER)
+{
+    WriteHeader(serializationBuffer);
+
+    serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
+    serializationBuffer->Write(&dataSize_, sizeof(dataSize_));
+
+    uint32 chunksCount = static_cast<uint32>(chunks_.size());
+    serializationBuffer->Write(&chunksCount, sizeof(chunksCount));
+    for (const ContentChunk& chunk : chunks_)
+    {
+        serializationBuffer->Write(chunk.hash.digest.data(), static_cast<uint32>(chunk.hash.digest.size()));
+        serializationBuffer->Write(&chunk.size, sizeof(chunk.size));
+    }
+}
+
+AddManifestRequestPacket::AddManifestRequestPacket()
+    : CachePacket(PACKET_ADD_MANIFEST_REQUEST, DO_NOT_CREATE_SENDING_BUFFER)
+{
+}
+
+bool AddManifestRequestPacket::DeserializeFromBuffer(File* buffer)
+{
+    using namespace CachePacketDetails;
+
+    uint32 chunksCount = 0;
+    if (!ReadFromBuffer(buffer, key) || !ReadFromBuffer(buffer, dataSize) || !ReadFromBuffer(buffer, chunksCount))
+    {
+        return false;
+    }
+
+    if (!HasBytes(buffer, static_cast<uint64>(chunksCount) * (MD5::MD5Digest::DIGEST_SIZE + sizeof(uint32))))
+    {
+        return false;
+    }
+
+    // offsets are not transferred, they follow from sizes
+    uint64 offset = 0;
+    chunks.resize(chunksCount);
+    for (ContentChunk& chunk : chunks)
+    {
+        if (!ReadFromBuffer(buffer, chunk))
+        {
+            return false;
+        }
+
+        chunk.offset = offset;
+        offset += chunk.size;
+    }
+
+    return (offset == dataSize);
+}
+
+//////////////////////////////////////////////////////////////////////////
+AddManifestResponsePacket::AddManifestResponsePacket(const CacheItemKey& key_, bool accepted_, const Vector<uint32>& missingChunks_)
+    : CachePacket(PACKET_ADD_MANIFEST_RESPONSE, CREATE_SENDING_BUFFER)
+{
+    WriteHeader(serializationBuffer);
+
+    serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
+    serializationBuffer->Write(&accepted_, sizeof(accepted_));
+
+    uint32 missingCount = static_cast<uint32>(missingChunks_.size());
+    serializationBuffer->Write(&missingCount, sizeof(missingCount));
+    if (missingCount > 0)
+    {
+        serializationBuffer->Write(missingChunks_.data(), missingCount * sizeof(uint32));
+    }
+}
+
+AddManifestResponsePacket::AddManifestResponsePacket()
+    : CachePacket(PACKET_ADD_MANIFEST_RESPONSE, DO_NOT_CREATE_SENDING_BUFFER)
+{
+}
+
+bool AddManifestResponsePacket::DeserializeFromBuffer(File* buffer)
+{
+    using namespace CachePacketDetails;
+
+    uint32 missingCount = 0;
+    if (!ReadFromBuffer(buffer, key) || !ReadFromBuffer(buffer, accepted) || !ReadFromBuffer(buffer, missingCount))
+    {
+        return false;
+    }
+
+    if (!HasBytes(buffer, static_cast<uint64>(missingCount) * sizeof(uint32)))
+    {
+        return false;
+    }
+
+    missingChunks.resize(missingCount);
+    for (uint32& index : missingChunks)
+    {
+        if (!ReadFromBuffer(buffer, index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+AddContentChunkRequestPacket::AddContentChunkRequestPacket(const CacheItemKey& key_, uint32 chunkIndex_, const uint8* chunkData_, uint32 chunkSize_)
+    : CachePacket(PACKET_ADD_CONTENT_CHUNK_REQUEST, CREATE_SENDING_BUFFER)
+{
+    WriteHeader(serializationBuffer);
+
+    serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
+    serializationBuffer->Write(&chunkIndex_, sizeof(chunkIndex_));
+    serializationBuffer->Write(&chunkSize_, sizeof(chunkSize_));
+    if (chunkSize_ > 0)
+    {
+        serializationBuffer->Write(chunkData_, chunkSize_);
+    }
+}
+
+AddContentChunkRequestPacket::AddContentChunkRequestPacket()
+    : CachePacket(PACKET_ADD_CONTENT_CHUNK_REQUEST, DO_NOT_CREATE_SENDING_BUFFER)
+{
+}
+
+bool AddContentChunkRequestPacket::DeserializeFromBuffer(File* buffer)
+{
+    using namespace CachePacketDetails;
+
+    uint32 chunkSize = 0;
+    return ReadFromBuffer(buffer, key)
+    && ReadFromBuffer(buffer, chunkIndex)
+    && ReadFromBuffer(buffer, chunkSize)
+    && ReadFromBuffer(buffer, chunkData, chunkSize);
+}
+
 } //AssetCache
 } //DAVA
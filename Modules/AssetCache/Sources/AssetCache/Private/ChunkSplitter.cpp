@@ -1,9 +1,16 @@
 #include "AssetCache/ChunkSplitter.h"
 
+#include <Base/Hash.h>
+
 namespace DAVA
 {
 namespace AssetCache
 {
+size_t ChunkHashHasher::operator()(const ChunkHash& hash) const
+{
+    return BufferHash(hash.digest.data(), static_cast<uint32>(hash.digest.size()));
+}
+
 namespace ChunkSplitter
 {
 const uint32 CHUNK_SIZE_IN_BYTES = 5 * 1024 * 1024;
@@ -26,6 +33,89 @@ Vector<uint8> GetChunk(const Vector<uint8>& dataVector, uint32 chunkNumber)
         return Vector<uint8>();
     }
 }
+
+namespace ChunkSplitterDetails
+{
+// Cut point is found when masked bits of rolling hash are zero. Stricter mask is used before average size is reached
+// and looser one after it, which narrows distribution of chunk sizes around the average (FastCDC normalization)
+// Only high bits of gear hash depend on the whole 64 byte window, so masks use them
+const uint64 STRICT_MASK = 0xfffff00000000000ULL; // 20 bits
+const uint64 LOOSE_MASK = 0xffff000000000000ULL; // 16 bits
+
+const Array<uint64, 256>& GetGearTable()
+{
+    // Table must be the same on all machines exchanging chunks, so it is generated from fixed seed
+    static const Array<uint64, 256> table = []() {
+        Array<uint64, 256> result;
+        uint64 state = 0x9e3779b97f4a7c15ULL;
+        for (uint64& value : result)
+        {
+            // splitmix64
+            state += 0x9e3779b97f4a7c15ULL;
+            uint64 z = state;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            value = z ^ (z >> 31);
+        }
+        return result;
+    }();
+    return table;
+}
+
+uint64 FindCutPoint(const uint8* data, uint64 size)
+{
+    if (size <= MIN_CONTENT_CHUNK_SIZE)
+    {
+        return size;
+    }
+
+    const Array<uint64, 256>& gear = GetGearTable();
+    const uint64 maxSize = std::min<uint64>(size, MAX_CONTENT_CHUNK_SIZE);
+    const uint64 normalSize = std::min<uint64>(maxSize, AVERAGE_CONTENT_CHUNK_SIZE);
+
+    uint64 hash = 0;
+    uint64 i = MIN_CONTENT_CHUNK_SIZE;
+    for (; i < normalSize; ++i)
+    {
+        hash = (hash << 1) + gear[data[i]];
+        if ((hash & STRICT_MASK) == 0)
+        {
+            return i + 1;
+        }
+    }
+
+    for (; i < maxSize; ++i)
+    {
+        hash = (hash << 1) + gear[data[i]];
+        if ((hash & LOOSE_MASK) == 0)
+        {
+            return i + 1;
+        }
+    }
+
+    return maxSize;
+}
+}
+
+Vector<ContentChunk> SplitByContent(const uint8* data, uint64 dataSize)
+{
+    Vector<ContentChunk> chunks;
+    chunks.reserve(static_cast<size_t>(dataSize / AVERAGE_CONTENT_CHUNK_SIZE + 1));
+
+    uint64 offset = 0;
+    while (offset < dataSize)
+    {
+        ContentChunk chunk;
+        chunk.offset = offset;
+        chunk.size = static_cast<uint32>(ChunkSplitterDetails::FindCutPoint(data + offset, dataSize - offset));
+        MD5::ForData(data + offset, chunk.size, chunk.hash);
+        chunks.push_back(chunk);
+
+        offset += chunk.size;
+    }
+
+    return chunks;
+}
 }
 } // namespace AssetCache
 } // namespace DAVA
@@ -108,6 +108,28 @@ bool ClientNetProxy::RequestAddNextChunk(const CacheItemKey& key, uint64 dataSiz
     return false;
 }
 
+bool ClientNetProxy::RequestAddManifest(const CacheItemKey& key, uint64 dataSize, const Vector<ContentChunk>& chunks)
+{
+    if (openedChannel)
+    {
+        AddManifestRequestPacket packet(key, dataSize, chunks);
+        return packet.SendTo(openedChannel);
+    }
+
+    return false;
+}
+
+bool ClientNetProxy::RequestAddContentChunk(const CacheItemKey& key, uint32 chunkIndex, const uint8* chunkData, uint32 chunkSize)
+{
+    if (openedChannel)
+    {
+        AddContentChunkRequestPacket packet(key, chunkIndex, chunkData, chunkSize);
+        return packet.SendTo(openedChannel);
+    }
+
+    return false;
+}
+
 bool ClientNetProxy::RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber)
 {
     //Logger::FrameworkDebug("Requesting chunk #%u", chunkNumber);
@@ -209,6 +231,13 @@ void ClientNetProxy::OnPacketReceived(const std::shared_ptr<DAVA::Net::IChannel>
                     listener->OnAddedToCache(p->key, p->added);
                 return;
             }
+            case PACKET_ADD_MANIFEST_RESPONSE:
+            {
+                AddManifestResponsePacket* p = static_cast<AddManifestResponsePacket*>(packet.get());
+                for (ClientNetProxyListener* listener : listeners)
+                    listener->OnAddManifestAccepted(p->key, p->accepted, p->missingChunks);
+                return;
+            }
             case PACKET_GET_CHUNK_RESPONSE:
             {
                 GetChunkResponsePacket* p = static_cast<GetChunkResponsePacket*>(packet.get());
@@ -61,6 +61,18 @@ void ServerNetProxy::OnPacketReceived(const std::shared_ptr<Net::IChannel>& chan
                 listener->OnAddChunkToCache(channel, p->key, p->dataSize, p->numOfChunks, p->chunkNumber, p->chunkData);
                 return;
             }
+            case PACKET_ADD_MANIFEST_REQUEST:
+            {
+                AddManifestRequestPacket* p = static_cast<AddManifestRequestPacket*>(packet.get());
+                listener->OnAddManifestToCache(channel, p->key, p->dataSize, p->chunks);
+                return;
+            }
+            case PACKET_ADD_CONTENT_CHUNK_REQUEST:
+            {
+                AddContentChunkRequestPacket* p = static_cast<AddContentChunkRequestPacket*>(packet.get());
+                listener->OnAddContentChunkToCache(channel, p->key, p->chunkIndex, p->chunkData);
+                return;
+            }
             case PACKET_GET_CHUNK_REQUEST:
             {
                 GetChunkRequestPacket* p = static_cast<GetChunkRequestPacket*>(packet.get());
@@ -127,6 +139,17 @@ bool ServerNetProxy::SendAddedToCache(const std::shared_ptr<Net::IChannel>& chan
     return false;
 }
 
+bool ServerNetProxy::SendAddManifestAccepted(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool accepted, const Vector<uint32>& missingChunks)
+{
+    if (channel)
+    {
+        AddManifestResponsePacket packet(key, accepted, missingChunks);
+        return packet.SendTo(channel);
+    }
+
+    return false;
+}
+
 bool ServerNetProxy::SendRemovedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool removed)
 {
     if (channel)
@@ -160,6 +183,17 @@ bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, co
     return false;
 }
 
+bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkSize, const Function<bool(uint8*, uint32)>& reader)
+{
+    if (channel)
+    {
+        GetChunkResponsePacket packet(key, dataSize, numOfChunks, chunkNumber, chunkSize, reader);
+        return packet.IsValid() && packet.SendTo(channel);
+    }
+
+    return false;
+}
+
 bool ServerNetProxy::SendStatus(const std::shared_ptr<Net::IChannel>& channel)
 {
     if (channel)
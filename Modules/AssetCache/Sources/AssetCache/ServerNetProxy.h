@@ -4,6 +4,7 @@
 
 #include "AssetCache/Connection.h"
 #include "AssetCache/CacheItemKey.h"
+#include "AssetCache/ChunkSplitter.h"
 
 #include <Base/BaseTypes.h>
 #include <Network/IChannel.h>
@@ -20,6 +21,8 @@ public:
     virtual ~ServerNetProxyListener() = default;
 
     virtual void OnAddChunkToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) = 0;
+    virtual void OnAddManifestToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, const Vector<ContentChunk>& chunks) = 0;
+    virtual void OnAddContentChunkToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint32 chunkIndex, const Vector<uint8>& chunkData) = 0;
     virtual void OnChunkRequestedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint32 chunkNumber) = 0;
     virtual void OnRemoveFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key) = 0;
     virtual void OnClearCache(const std::shared_ptr<Net::IChannel>& channel) = 0;
@@ -44,9 +47,12 @@ public:
     uint16 GetListenPort() const;
 
     bool SendAddedToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool added);
+    bool SendAddManifestAccepted(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool accepted, const Vector<uint32>& missingChunks);
     bool SendRemovedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool removed);
     bool SendCleared(const std::shared_ptr<Net::IChannel>& channel, bool cleared);
     bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    /** Send chunk which data is read by `reader` directly into network buffer. Return false if chunk can't be read or sent */
+    bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkSize, const Function<bool(uint8*, uint32)>& reader);
     bool SendStatus(const std::shared_ptr<Net::IChannel>& channel);
 
     //Net::IChannelListener
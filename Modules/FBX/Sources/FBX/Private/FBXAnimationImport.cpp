@@ -1,5 +1,6 @@
 #include "FBXAnimationImport.h"
 
+#include "Animation/AnimationChannelEncoder.h"
 #include "Animation/AnimationClip.h"
 #include "FileSystem/File.h"
 #include "Logger/Logger.h"
@@ -81,16 +82,9 @@ void SaveAnimation(const FBXAnimationStackData& fbxStackAnimationData, const Fil
     //binary file format described in 'AnimationBinaryFormat.md'
     struct ChannelHeader
     {
-        //Track part
+        //Track part, channel part is written by AnimationChannelEncoder
         uint8 target;
         uint8 pad0[3];
-
-        //Channel part
-        uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
-        uint8 dimension = 0;
-        uint8 interpolation = 0;
-        uint16 compression = 0;
-        uint32 keyCount = 0;
     } channelHeader;
 
     ScopedPtr<File> file(File::Create(filePath, File::CREATE | File::WRITE));
@@ -132,51 +126,40 @@ void SaveAnimation(const FBXAnimationStackData& fbxStackAnimationData, const Fil
             {
                 if (!fbxChannelData.animationKeys.empty())
                 {
-                    channelHeader.target = fbxChannelData.channel;
-                    channelHeader.keyCount = uint32(fbxChannelData.animationKeys.size());
+                    AnimationTrack::eChannelTarget target = fbxChannelData.channel;
+                    channelHeader.target = uint8(target);
 
-                    if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_POSITION)
-                    {
-                        channelHeader.dimension = 3;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
-                    }
-                    else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
+                    uint32 dimension = 1;
+                    AnimationChannel::eInterpolation interpolation = AnimationChannel::INTERPOLATION_LINEAR;
+                    if (target == AnimationTrack::CHANNEL_TARGET_POSITION)
                     {
-                        channelHeader.dimension = 4;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+                        dimension = 3;
                     }
-                    else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_SCALE)
+                    else if (target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
                     {
-                        channelHeader.dimension = 1;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
+                        dimension = 4;
+                        interpolation = AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR;
                     }
 
                     WriteToBuffer(animationData, &channelHeader);
 
-                    for (uint32 k = 0; k < channelHeader.keyCount; ++k)
+                    AnimationChannelEncoder encoder(dimension, interpolation);
+                    for (const FBXAnimationKey& key : fbxChannelData.animationKeys)
                     {
-                        const FBXAnimationKey& key = fbxChannelData.animationKeys[k];
-
                         float32 relativeKeyTime = key.time - fbxStackAnimationData.minTimeStamp;
-                        WriteToBuffer(animationData, &relativeKeyTime);
-
-                        if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_POSITION)
-                        {
-                            Vector3 position = Vector3(key.value.data);
-                            WriteToBuffer(animationData, &position);
-                        }
-                        else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
+                        if (target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
                         {
                             Quaternion orientation = Quaternion(key.value.data);
                             orientation.Normalize();
-                            WriteToBuffer(animationData, &orientation);
+                            encoder.AddKey(relativeKeyTime, orientation.data);
                         }
-                        else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_SCALE)
+                        else
                         {
-                            float32 scale = key.value.x;
-                            WriteToBuffer(animationData, &scale);
+                            encoder.AddKey(relativeKeyTime, key.value.data);
                         }
                     }
+
+                    encoder.Encode(animationData, AnimationChannelEncoder::GetDefaultTolerance(target), AnimationChannel::COMPRESSION_QUANTIZED_16);
                 }
             }
         }
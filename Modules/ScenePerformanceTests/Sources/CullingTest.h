@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+
+namespace DAVA
+{
+class Scene;
+}
+
+struct CullingTestResult
+{
+    bool completed = false;
+    bool resultsMatch = false;
+    DAVA::uint32 samplesCount = 0;
+    DAVA::uint32 iterationsPerSample = 0;
+    DAVA::uint64 visibleObjectsCount = 0;
+    DAVA::float32 serialTimeMs = 0.f;
+    DAVA::float32 parallelTimeMs = 0.f;
+    DAVA::float32 speedup = 0.f;
+};
+
+/**
+    Measures time spent in `QuadTree::Clip` of scene render hierarchy with parallel clipping disabled and enabled.
+    Camera is placed in grid nodes over hierarchy world box and rotated around vertical axis in every node.
+    Test is synchronous and does not change scene camera.
+*/
+class CullingTest final
+{
+public:
+    static CullingTestResult Run(DAVA::Scene* scene, DAVA::uint32 iterationsPerSample = 16);
+};
@@ -0,0 +1,122 @@
+#include "CullingTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Logger/Logger.h>
+#include <Math/AABBox3.h>
+#include <Render/Highlevel/Camera.h>
+#include <Render/Highlevel/RenderObject.h>
+#include <Render/Highlevel/RenderSystem.h>
+#include <Render/Highlevel/VisibilityQuadTree.h>
+#include <Scene3D/Scene.h>
+#include <Time/SystemTimer.h>
+
+namespace CullingTestDetails
+{
+using namespace DAVA;
+
+const uint32 GRID_SIZE = 8;
+const uint32 ANGLE_COUNT = 8;
+const float32 ELEVATION_FRACTION = 0.1f;
+
+struct CullingSample
+{
+    Vector3 position;
+    Vector3 direction;
+};
+
+void GenerateSamples(const AABBox3& worldBox, Vector<CullingSample>& samples)
+{
+    Vector3 size = worldBox.max - worldBox.min;
+    float32 z = worldBox.min.z + size.z * ELEVATION_FRACTION;
+
+    for (uint32 y = 0; y < GRID_SIZE; ++y)
+    {
+        for (uint32 x = 0; x < GRID_SIZE; ++x)
+        {
+            Vector3 position(worldBox.min.x + size.x * (x + 0.5f) / GRID_SIZE, worldBox.min.y + size.y * (y + 0.5f) / GRID_SIZE, z);
+            for (uint32 a = 0; a < ANGLE_COUNT; ++a)
+            {
+                float32 angle = PI_2 * a / ANGLE_COUNT;
+                samples.push_back({ position, Vector3(std::cos(angle), std::sin(angle), 0.f) });
+            }
+        }
+    }
+}
+
+float32 MeasureClipping(QuadTree* quadTree, Camera* camera, const Vector<CullingSample>& samples, uint32 iterations, Vector<Vector<RenderObject*>>& visibilityArrays)
+{
+    visibilityArrays.resize(samples.size());
+
+    int64 totalTimeUs = 0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        camera->SetPosition(samples[i].position);
+        camera->SetDirection(samples[i].direction);
+        camera->PrepareDynamicParameters(false);
+
+        Vector<RenderObject*>& visibilityArray = visibilityArrays[i];
+        for (uint32 iteration = 0; iteration < iterations; ++iteration)
+        {
+            visibilityArray.clear();
+
+            int64 startTimeUs = SystemTimer::GetUs();
+            quadTree->Clip(camera, visibilityArray, RenderObject::CLIPPING_VISIBILITY_CRITERIA);
+            totalTimeUs += SystemTimer::GetUs() - startTimeUs;
+        }
+    }
+
+    return static_cast<float32>(totalTimeUs) / 1000.f;
+}
+}
+
+CullingTestResult CullingTest::Run(DAVA::Scene* scene, DAVA::uint32 iterationsPerSample)
+{
+    using namespace DAVA;
+    using namespace CullingTestDetails;
+
+    CullingTestResult result;
+
+    DVASSERT(scene != nullptr);
+    QuadTree* quadTree = dynamic_cast<QuadTree*>(scene->renderSystem->GetRenderHierarchy());
+    Camera* sceneCamera = scene->GetCurrentCamera();
+    if (quadTree == nullptr || sceneCamera == nullptr || iterationsPerSample == 0)
+    {
+        Logger::Error("[CullingTest] Scene has no quad tree render hierarchy or camera");
+        return result;
+    }
+
+    ScopedPtr<Camera> camera(new Camera());
+    camera->SetupPerspective(sceneCamera->GetFOV(), sceneCamera->GetAspect(), sceneCamera->GetZNear(), sceneCamera->GetZFar());
+    camera->SetUp(Vector3(0.f, 0.f, 1.f));
+
+    Vector<CullingSample> samples;
+    GenerateSamples(quadTree->GetWorldBoundingBox(), samples);
+
+    bool parallelClippingWasEnabled = quadTree->IsParallelClippingEnabled();
+
+    Vector<Vector<RenderObject*>> serialVisibility;
+    quadTree->SetParallelClippingEnabled(false);
+    result.serialTimeMs = MeasureClipping(quadTree, camera, samples, iterationsPerSample, serialVisibility);
+
+    Vector<Vector<RenderObject*>> parallelVisibility;
+    quadTree->SetParallelClippingEnabled(true);
+    result.parallelTimeMs = MeasureClipping(quadTree, camera, samples, iterationsPerSample, parallelVisibility);
+
+    quadTree->SetParallelClippingEnabled(parallelClippingWasEnabled);
+
+    result.completed = true;
+    result.resultsMatch = (serialVisibility == parallelVisibility);
+    result.samplesCount = static_cast<uint32>(samples.size());
+    result.iterationsPerSample = iterationsPerSample;
+    for (const Vector<RenderObject*>& visibilityArray : serialVisibility)
+    {
+        result.visibleObjectsCount += visibilityArray.size();
+    }
+    result.speedup = (result.parallelTimeMs > 0.f) ? result.serialTimeMs / result.parallelTimeMs : 0.f;
+
+    Logger::Info("[CullingTest] %u samples x %u iterations, %llu visible objects: serial %.3f ms, parallel %.3f ms, speedup %.2f, results %s",
+                 result.samplesCount, result.iterationsPerSample, static_cast<unsigned long long>(result.visibleObjectsCount),
+                 result.serialTimeMs, result.parallelTimeMs, result.speedup, result.resultsMatch ? "match" : "DIFFER");
+
+    return result;
+}
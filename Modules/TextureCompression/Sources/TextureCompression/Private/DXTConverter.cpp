@@ -166,11 +166,17 @@ FilePath DXTConverter::ConvertCubemapToDxt(const TextureDescriptor& descriptor,
             //generate mipmaps for every face
             if (descriptor.dataSettings.GetGenerateMipMaps())
             {
+                Vector<Image*> faceImages;
                 for (auto& imageSet : imageSets)
                 {
-                    Image* image = imageSet[0];
-                    imageSet = image->CreateMipMapsImages();
-                    SafeRelease(image);
+                    faceImages.push_back(imageSet[0]);
+                }
+
+                Vector<Vector<Image*>> mipmapSets = Image::CreateMipMapsImageSets(faceImages);
+                for (size_t i = 0; i < imageSets.size(); ++i)
+                {
+                    imageSets[i].swap(mipmapSets[i]);
+                    SafeRelease(faceImages[i]);
                 }
             }
         }
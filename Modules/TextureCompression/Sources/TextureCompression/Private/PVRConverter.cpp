@@ -95,16 +95,22 @@ Vector<Image*> ProcessFloatImageSet(Vector<Image*>& sourceImages, PixelFormat in
 
     if (generateMipmaps)
     {
-        Vector<Image*> generatedImages;
+        Vector<Image*> topLevelImages;
         for (Image* sourceImage : sourceImages)
         {
             if (sourceImage->mipmapLevel == 0)
             {
-                Vector<Image*> mipMaps = sourceImage->CreateMipMapsImages(false);
-                generatedImages.insert(generatedImages.end(), mipMaps.begin(), mipMaps.end());
+                topLevelImages.push_back(sourceImage);
             }
         }
 
+        // cube faces are processed in parallel
+        Vector<Image*> generatedImages;
+        for (const Vector<Image*>& mipMaps : Image::CreateMipMapsImageSets(topLevelImages, false))
+        {
+            generatedImages.insert(generatedImages.end(), mipMaps.begin(), mipMaps.end());
+        }
+
         // release original images and replace them with generated ones
         for (Image* image : sourceImages)
             SafeRelease(image);
@@ -4,6 +4,7 @@
 
 #include <CommandLine/CommandLineParser.h>
 #include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/FileList.h>
 #include <Utils/StringUtils.h>
@@ -15,6 +16,8 @@
 #include <Utils/UTF8Utils.h>
 #include <Render/GPUFamilyDescriptor.h>
 #include <Platform/Process.h>
+#include <Concurrency/Atomic.h>
+#include <Job/JobManager.h>
 #include <Render/TextureDescriptor.h>
 #include <Logger/Logger.h>
 
@@ -152,6 +155,7 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
     }
 
     Vector<PackingAlgorithm> packAlgorithms;
+    packSortOrders = { PackingSortOrder::SORT_BY_AREA };
 
     String alg = CommandLineParser::Instance()->GetCommandParam("-alg");
     if (alg.empty() || CompareCaseInsensitive(alg, "maxrect") == 0)
@@ -170,6 +174,25 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
     {
         packAlgorithms.push_back(PackingAlgorithm::ALG_BASIC);
     }
+    else if (CompareCaseInsensitive(alg, "skyline") == 0)
+    {
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_MIN_WASTE);
+    }
+    else if (CompareCaseInsensitive(alg, "best") == 0)
+    {
+        // slowest one: every algorithm with every sort order, candidates are tried by job workers
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_MIN_WASTE);
+
+        packSortOrders = { PackingSortOrder::SORT_BY_AREA, PackingSortOrder::SORT_BY_MAX_SIDE, PackingSortOrder::SORT_BY_PERIMETER,
+                           PackingSortOrder::SORT_BY_WIDTH, PackingSortOrder::SORT_BY_HEIGHT };
+    }
     else
     {
         AddError(Format("Unknown algorithm: '%s'", alg.c_str()));
@@ -364,7 +387,95 @@ uint32 ResourcePacker2D::GetMaxTextureSize() const
     return maxTextureSize;
 }
 
-void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath& outputDir, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& passedFlags)
+struct ResourcePacker2D::DirectoryTask
+{
+    struct PickedFile
+    {
+        String name;
+        String basename;
+        String ext;
+        uint32 index = 0;
+        bool tagged = false;
+        String outName;
+        String outBasename;
+    };
+
+    FilePath inputDir;
+    FilePath outputDir;
+    FilePath processDir;
+
+    Vector<String> flags;
+    String mergedFlags;
+    String packingParams;
+
+    RefPtr<FileList> fileList;
+    List<PickedFile> pickedFiles;
+
+    bool inputDirModified = false;
+    bool modified = false;
+    bool needRepack = false;
+    bool packed = false;
+    AssetCache::CacheItemKey cacheKey;
+
+    uint32 packedFilesCount = 0;
+    uint64 packTime = 0;
+    Set<String> errors;
+};
+
+void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath& outputDir, const Vector<PackingAlgorithm>& packAlgorithms)
+{
+    Vector<std::unique_ptr<DirectoryTask>> tasks;
+    CollectDirectories(inputDir, outputDir, packAlgorithms, Vector<String>(), tasks);
+
+    // md5 of input directory is calculated over content of its files, so it is done in parallel too
+    ParallelFor(static_cast<uint32>(tasks.size()), [this, &tasks](uint32 index)
+                {
+                    CheckDirectoryModified(*tasks[index]);
+                });
+
+    // cache client processes one request at a time, so all directories are looked up before packing is started
+    Vector<DirectoryTask*> packTasks;
+    for (const std::unique_ptr<DirectoryTask>& task : tasks)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+
+        if (task->modified && task->pickedFiles.empty() == false)
+        {
+            if (IsUsingCache())
+            {
+                MD5::MD5Digest digest;
+
+                ReadMD5FromFile(task->processDir + "dir.md5", digest);
+                task->cacheKey.SetPrimaryKey(digest);
+
+                ReadMD5FromFile(task->processDir + "params.md5", digest);
+                task->cacheKey.SetSecondaryKey(digest);
+            }
+
+            task->needRepack = (false == GetFilesFromCache(task->cacheKey, task->inputDir, task->outputDir));
+            if (task->needRepack)
+            {
+                packTasks.push_back(task.get());
+            }
+        }
+    }
+
+    ParallelFor(static_cast<uint32>(packTasks.size()), [this, &packTasks, &packAlgorithms](uint32 index)
+                {
+                    PackDirectory(*packTasks[index], packAlgorithms);
+                });
+
+    // results are reported and added to cache in order of directories traversal, whatever order tasks were finished in
+    for (const std::unique_ptr<DirectoryTask>& task : tasks)
+    {
+        ReportDirectory(*task);
+    }
+}
+
+void ResourcePacker2D::CollectDirectories(const FilePath& inputDir, const FilePath& outputDir, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& passedFlags, Vector<std::unique_ptr<DirectoryTask>>& tasks)
 {
     using namespace ResourcePacker2DDetails;
 
@@ -375,36 +486,36 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         return;
     }
 
-    uint64 packTime = SystemTimer::GetMs();
+    std::unique_ptr<DirectoryTask> task = std::make_unique<DirectoryTask>();
+    task->inputDir = inputDir;
+    task->outputDir = outputDir;
 
     String inputRelativePath = inputDir.GetRelativePathname(rootDirectory);
-    FilePath processDir = rootDirectory + GetProcessFolderName() + inputRelativePath;
-    FileSystem::Instance()->CreateDirectory(processDir, true);
+    task->processDir = rootDirectory + GetProcessFolderName() + inputRelativePath;
+    FileSystem::Instance()->CreateDirectory(task->processDir, true);
 
     if (forceRepack)
     {
-        FileSystem::Instance()->DeleteDirectoryFiles(processDir, false);
+        FileSystem::Instance()->DeleteDirectoryFiles(task->processDir, false);
     }
 
+    // output directory of parent is created before directories of children are packed
     FileSystem::Instance()->CreateDirectory(outputDir);
 
-    Vector<String> currentFlags;
-
     const auto flagsPathname = inputDir + "flags.txt";
     if (FileSystem::Instance()->Exists(flagsPathname))
     {
-        currentFlags = FetchFlags(flagsPathname);
+        task->flags = FetchFlags(flagsPathname);
     }
     else
     {
-        currentFlags = passedFlags;
+        task->flags = passedFlags;
     }
 
-    CommandLineParser::Instance()->SetFlags(currentFlags);
-    String mergedFlags;
-    Merge(currentFlags, ' ', mergedFlags);
+    Merge(task->flags, ' ', task->mergedFlags);
 
-    String packingParams = mergedFlags;
+    String& packingParams = task->packingParams;
+    packingParams = task->mergedFlags;
 
     for (eGPUFamily gpu : requestedGPUs)
     {
@@ -417,28 +528,27 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     {
         packingParams += String("PackerAlgorithm = ") + GlobalEnumMap<DAVA::PackingAlgorithm>::Instance()->ToString(static_cast<int>(algorithm));
     }
+    if (packSortOrders.size() != 1 || packSortOrders.front() != PackingSortOrder::SORT_BY_AREA)
+    { // default order is not written to keep params of already packed directories unchanged
+        for (PackingSortOrder sortOrder : packSortOrders)
+        {
+            packingParams += String("PackerSortOrder = ") + GlobalEnumMap<DAVA::PackingSortOrder>::Instance()->ToString(static_cast<int>(sortOrder));
+        }
+    }
 
     if (tag.empty() == false)
     {
         packingParams += String("Tag = ") + tag;
     }
 
-    ScopedPtr<FileList> fileList(new FileList(inputDir));
+    task->fileList = RefPtr<FileList>(new FileList(inputDir));
+    FileList* fileList = task->fileList.Get();
     fileList->Sort();
 
     uint64 allFilesSize = 0;
 
-    struct PickedFile
-    {
-        String name;
-        String basename;
-        String ext;
-        uint32 index = 0;
-        bool tagged = false;
-        String outName;
-        String outBasename;
-    };
-    List<PickedFile> pickedFiles;
+    using PickedFile = DirectoryTask::PickedFile;
+    List<PickedFile>& pickedFiles = task->pickedFiles;
     List<PickedFile*> taggedFiles;
 
     for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
@@ -512,188 +622,252 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     packingParams += Format("FilesCount = %u", pickedFiles.size());
     packingParams += Format("DescriptorVersion = %i", TextureDescriptor::CURRENT_VERSION);
 
-    bool inputDirModified = RecalculateDirMD5(inputDir, processDir + "dir.md5", false);
-    bool paramsModified = RecalculateParamsMD5(packingParams, processDir + "params.md5");
+    // flags of subdirectories are resolved here, so directories don't depend on each other while being packed
+    bool passCurrentFlags = false;
+    {
+        CommandLineParser::ScopedFlags scopedFlags(task->flags);
+        passCurrentFlags = CommandLineParser::Instance()->IsFlagSet("--recursive");
+    }
+    const Vector<String>& flagsToPass = passCurrentFlags ? task->flags : passedFlags;
+
+    tasks.push_back(std::move(task));
 
-    bool modified = outputDirModified || inputDirModified || paramsModified;
-    if (modified)
+    for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
     {
-        if (pickedFiles.empty() == false)
+        if (fileList->IsDirectory(fi))
         {
-            AssetCache::CacheItemKey cacheKey;
-            if (IsUsingCache())
+            String filename = fileList->GetFilename(fi);
+            if (!fileList->IsNavigationDirectory(fi) && (filename != "$process") && (filename != ".svn"))
             {
-                MD5::MD5Digest digest;
+                if ((filename.size() > 0) && (filename[0] != '.'))
+                {
+                    FilePath input = inputDir + filename;
+                    input.MakeDirectoryPathname();
 
-                ReadMD5FromFile(processDir + "dir.md5", digest);
-                cacheKey.SetPrimaryKey(digest);
+                    FilePath output = outputDir + filename;
+                    output.MakeDirectoryPathname();
 
-                ReadMD5FromFile(processDir + "params.md5", digest);
-                cacheKey.SetSecondaryKey(digest);
+                    CollectDirectories(input, output, packAlgorithms, flagsToPass, tasks);
+                }
             }
+        }
+    }
+}
 
-            bool needRepack = (false == GetFilesFromCache(cacheKey, inputDir, outputDir));
-            if (needRepack)
-            {
-                // read textures margins settings
-                bool useTwoSideMargin = CommandLineParser::Instance()->IsFlagSet("--add2sidepixel");
-                uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
-                if (CommandLineParser::Instance()->IsFlagSet("--add0pixel"))
-                    marginInPixels = 0;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add1pixel"))
-                    marginInPixels = 1;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add2pixel"))
-                    marginInPixels = 2;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add4pixel"))
-                    marginInPixels = 4;
-
-                uint32 maxTextureSize = GetMaxTextureSize();
-
-                bool withAlpha = CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha");
-                bool useLayerNames = CommandLineParser::Instance()->IsFlagSet("--useLayerNames");
-                bool verbose = CommandLineParser::Instance()->GetVerbose();
-
-                if (clearOutputDirectory)
-                {
-                    FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
-                }
+void ResourcePacker2D::CheckDirectoryModified(DirectoryTask& task) const
+{
+    if (cancelled)
+    {
+        return;
+    }
 
-                DefinitionFile::Collection definitionFileList;
-                Vector<PickedFile*> justCopyList;
-                definitionFileList.reserve(pickedFiles.size());
-                for (PickedFile& file : pickedFiles)
-                {
-                    if (cancelled)
-                    {
-                        break;
-                    }
-
-                    DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
-
-                    bool shouldAcceptFile = false;
-
-                    FilePath path = fileList->GetPathname(file.index);
-                    if (CompareCaseInsensitive(file.ext, ".psd") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPSD(path, processDir, maxTextureSize,
-                                                            withAlpha, useLayerNames, verbose, file.outBasename);
-                    }
-                    else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPNGDef(path, processDir, file.outBasename);
-                    }
-                    else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
-                    {
-                        shouldAcceptFile = defFile->LoadImage(path, processDir, file.outBasename);
-                    }
-                    else
-                    {
-                        justCopyList.push_back(&file);
-                    }
-
-                    if (shouldAcceptFile)
-                    {
-                        definitionFileList.push_back(defFile);
-                    }
-                }
+    task.inputDirModified = RecalculateDirMD5(task.inputDir, task.processDir + "dir.md5", false);
+    bool paramsModified = RecalculateParamsMD5(task.packingParams, task.processDir + "params.md5");
 
-                if (!definitionFileList.empty())
-                {
-                    TexturePacker packer;
-                    packer.SetConvertQuality(quality);
-
-                    if (isLightmapsPacking)
-                    {
-                        packer.SetUseOnlySquareTextures();
-                        packer.SetMaxTextureSize(2048);
-                    }
-                    else
-                    {
-                        if (CommandLineParser::Instance()->IsFlagSet("--square"))
-                        {
-                            packer.SetUseOnlySquareTextures();
-                        }
-                        packer.SetMaxTextureSize(maxTextureSize);
-                    }
-
-                    packer.SetTwoSideMargin(useTwoSideMargin);
-                    packer.SetTexturesMargin(marginInPixels);
-                    packer.SetAlgorithms(packAlgorithms);
-                    packer.SetTexturePostfix(texturePostfix);
-
-                    if (CommandLineParser::Instance()->IsFlagSet("--split"))
-                    {
-                        packer.PackToTexturesSeparate(outputDir, definitionFileList, requestedGPUs);
-                    }
-                    else
-                    {
-                        packer.PackToTextures(outputDir, definitionFileList, requestedGPUs);
-                    }
-
-                    Set<String> currentErrors = packer.GetErrors();
-                    if (!currentErrors.empty())
-                    {
-                        errors.insert(currentErrors.begin(), currentErrors.end());
-                    }
-                }
+    task.modified = outputDirModified || task.inputDirModified || paramsModified;
+}
 
-                for (const PickedFile* file : justCopyList)
-                {
-                    FilePath srcPath = inputDir + file->name;
-                    FilePath destPath = outputDir + file->outName;
-                    if (!FileSystem::Instance()->CopyFile(srcPath, destPath))
-                    {
-                        Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
-                    }
-                }
+void ResourcePacker2D::PackDirectory(DirectoryTask& task, const Vector<PackingAlgorithm>& packAlgorithms) const
+{
+    using PickedFile = DirectoryTask::PickedFile;
 
-                packTime = SystemTimer::GetMs() - packTime;
+    if (cancelled)
+    {
+        return;
+    }
 
-                if (Engine::Instance()->IsConsoleMode())
-                {
-                    Logger::Info("[%u files packed with flags: %s]", static_cast<uint32>(definitionFileList.size()), mergedFlags.c_str());
-                }
+    uint64 packTime = SystemTimer::GetMs();
+
+    // flags of directory are also read by TexturePacker, so they are kept for the current thread until directory is packed
+    CommandLineParser::ScopedFlags scopedFlags(task.flags);
+
+    // read textures margins settings
+    bool useTwoSideMargin = CommandLineParser::Instance()->IsFlagSet("--add2sidepixel");
+    uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
+    if (CommandLineParser::Instance()->IsFlagSet("--add0pixel"))
+        marginInPixels = 0;
+    else if (CommandLineParser::Instance()->IsFlagSet("--add1pixel"))
+        marginInPixels = 1;
+    else if (CommandLineParser::Instance()->IsFlagSet("--add2pixel"))
+        marginInPixels = 2;
+    else if (CommandLineParser::Instance()->IsFlagSet("--add4pixel"))
+        marginInPixels = 4;
+
+    uint32 maxTextureSize = GetMaxTextureSize();
+
+    bool withAlpha = CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha");
+    bool useLayerNames = CommandLineParser::Instance()->IsFlagSet("--useLayerNames");
+    bool verbose = CommandLineParser::Instance()->GetVerbose();
+
+    if (clearOutputDirectory)
+    {
+        FileSystem::Instance()->DeleteDirectoryFiles(task.outputDir, false);
+    }
+
+    DefinitionFile::Collection definitionFileList;
+    Vector<PickedFile*> justCopyList;
+    definitionFileList.reserve(task.pickedFiles.size());
+    for (PickedFile& file : task.pickedFiles)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+
+        DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
 
-                const char* result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
-                Logger::Info("[%s - %.2lf secs] - %s", inputDir.GetAbsolutePathname().c_str(),
-                             static_cast<float64>(packTime) / 1000.0, result);
+        bool shouldAcceptFile = false;
 
-                AddFilesToCache(cacheKey, inputDir, outputDir);
+        FilePath path = task.fileList->GetPathname(file.index);
+        if (CompareCaseInsensitive(file.ext, ".psd") == 0)
+        {
+            shouldAcceptFile = defFile->LoadPSD(path, task.processDir, maxTextureSize,
+                                                withAlpha, useLayerNames, verbose, file.outBasename);
+        }
+        else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
+        {
+            shouldAcceptFile = defFile->LoadPNGDef(path, task.processDir, file.outBasename);
+        }
+        else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
+        {
+            shouldAcceptFile = defFile->LoadImage(path, task.processDir, file.outBasename);
+        }
+        else
+        {
+            justCopyList.push_back(&file);
+        }
+
+        if (shouldAcceptFile)
+        {
+            definitionFileList.push_back(defFile);
+        }
+    }
+
+    if (!definitionFileList.empty())
+    {
+        TexturePacker packer;
+        packer.SetConvertQuality(quality);
+
+        if (isLightmapsPacking)
+        {
+            packer.SetUseOnlySquareTextures();
+            packer.SetMaxTextureSize(2048);
+        }
+        else
+        {
+            if (CommandLineParser::Instance()->IsFlagSet("--square"))
+            {
+                packer.SetUseOnlySquareTextures();
             }
+            packer.SetMaxTextureSize(maxTextureSize);
+        }
+
+        packer.SetTwoSideMargin(useTwoSideMargin);
+        packer.SetTexturesMargin(marginInPixels);
+        packer.SetAlgorithms(packAlgorithms);
+        packer.SetSortOrders(packSortOrders);
+        packer.SetTexturePostfix(texturePostfix);
+
+        if (CommandLineParser::Instance()->IsFlagSet("--split"))
+        {
+            packer.PackToTexturesSeparate(task.outputDir, definitionFileList, requestedGPUs);
         }
-        else if (outputDirModified || inputDirModified)
+        else
         {
-            Logger::Info("[%s] - empty directory. Clearing output folder", inputDir.GetAbsolutePathname().c_str());
-            FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
+            packer.PackToTextures(task.outputDir, definitionFileList, requestedGPUs);
         }
+
+        task.errors = packer.GetErrors();
     }
-    else
+
+    for (const PickedFile* file : justCopyList)
     {
-        Logger::Info("[%s] - unchanged", inputDir.GetAbsolutePathname().c_str());
+        FilePath srcPath = task.inputDir + file->name;
+        FilePath destPath = task.outputDir + file->outName;
+        if (!FileSystem::Instance()->CopyFile(srcPath, destPath))
+        {
+            Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
+        }
     }
 
-    const auto& flagsToPass = CommandLineParser::Instance()->IsFlagSet("--recursive") ? currentFlags : passedFlags;
+    task.packedFilesCount = static_cast<uint32>(definitionFileList.size());
+    task.packTime = SystemTimer::GetMs() - packTime;
+    task.packed = true;
+}
 
-    for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
+void ResourcePacker2D::ReportDirectory(DirectoryTask& task)
+{
+    if (task.packed && task.errors.empty() == false)
     {
-        if (fileList->IsDirectory(fi))
+        errors.insert(task.errors.begin(), task.errors.end());
+    }
+
+    if (cancelled)
+    {
+        return;
+    }
+
+    if (task.modified)
+    {
+        if (task.packed)
         {
-            String filename = fileList->GetFilename(fi);
-            if (!fileList->IsNavigationDirectory(fi) && (filename != "$process") && (filename != ".svn"))
+            if (Engine::Instance()->IsConsoleMode())
             {
-                if ((filename.size() > 0) && (filename[0] != '.'))
-                {
-                    FilePath input = inputDir + filename;
-                    input.MakeDirectoryPathname();
+                Logger::Info("[%u files packed with flags: %s]", task.packedFilesCount, task.mergedFlags.c_str());
+            }
 
-                    FilePath output = outputDir + filename;
-                    output.MakeDirectoryPathname();
+            const char* result = (task.packedFilesCount == 0) ? "[unchanged]" : "[REPACKED]";
+            Logger::Info("[%s - %.2lf secs] - %s", task.inputDir.GetAbsolutePathname().c_str(),
+                         static_cast<float64>(task.packTime) / 1000.0, result);
 
-                    PackRecursively(input, output, packAlgorithms, flagsToPass);
-                }
-            }
+            AddFilesToCache(task.cacheKey, task.inputDir, task.outputDir);
         }
+        else if (task.pickedFiles.empty() && (outputDirModified || task.inputDirModified))
+        {
+            Logger::Info("[%s] - empty directory. Clearing output folder", task.inputDir.GetAbsolutePathname().c_str());
+            FileSystem::Instance()->DeleteDirectoryFiles(task.outputDir, false);
+        }
+    }
+    else
+    {
+        Logger::Info("[%s] - unchanged", task.inputDir.GetAbsolutePathname().c_str());
+    }
+}
+
+void ResourcePacker2D::ParallelFor(uint32 count, const Function<void(uint32)>& fn) const
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 lanesCount = (nullptr != jobManager) ? jobManager->GetWorkersCount() : 0;
+    if (maxParallelTasks > 0)
+    {
+        lanesCount = std::min(lanesCount, maxParallelTasks);
+    }
+    lanesCount = std::min(lanesCount, count);
+
+    if (lanesCount <= 1)
+    {
+        for (uint32 index = 0; index < count; ++index)
+        {
+            fn(index);
+        }
+        return;
+    }
+
+    // every lane takes next not started index, so no more than lanesCount directories are processed at once
+    Atomic<uint32> nextIndex(0);
+    JobGroup group;
+    for (uint32 lane = 0; lane < lanesCount; ++lane)
+    {
+        jobManager->CreateWorkerTask([&nextIndex, &fn, count]()
+                                     {
+                                         for (uint32 index = nextIndex++; index < count; index = nextIndex++)
+                                         {
+                                             fn(index);
+                                         }
+                                     },
+                                     &group);
     }
+    jobManager->WaitWorkerGroup(&group);
 }
 
 void ResourcePacker2D::SetCacheClient(AssetCacheClient* cacheClient_, const String& comment)
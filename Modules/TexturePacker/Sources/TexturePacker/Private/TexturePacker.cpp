@@ -55,6 +55,8 @@ const Set<PixelFormat> TexturePacker::PIXEL_FORMATS_WITH_COMPRESSION = InitPixel
 TexturePacker::TexturePacker()
 {
     quality = TextureConverter::ECQ_VERY_HIGH;
+    rectanglePacker.SetUseParallelSearch();
+
     if (CommandLineParser::Instance()->IsFlagSet("--quality"))
     {
         String qualityName = CommandLineParser::Instance()->GetParamForFlag("--quality");
@@ -6,6 +6,7 @@
 #include "AssetCache/AssetCacheClient.h"
 
 #include <Base/BaseTypes.h>
+#include <Functional/Function.h>
 #include <Render/RenderBase.h>
 #include <FileSystem/FilePath.h>
 
@@ -57,7 +58,14 @@ private:
 
     void AddError(const String& errorMsg);
 
-    void PackRecursively(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& flags = Vector<String>());
+    struct DirectoryTask;
+
+    void PackRecursively(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms);
+    void CollectDirectories(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& flags, Vector<std::unique_ptr<DirectoryTask>>& tasks);
+    void CheckDirectoryModified(DirectoryTask& task) const;
+    void PackDirectory(DirectoryTask& task, const Vector<PackingAlgorithm>& packAlgorithms) const;
+    void ReportDirectory(DirectoryTask& task);
+    void ParallelFor(uint32 count, const Function<void(uint32)>& fn) const;
 
     bool GetFilesFromCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
     bool AddFilesToCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
@@ -75,6 +83,7 @@ public:
     bool isLightmapsPacking = false;
     bool forceRepack = false;
     bool clearOutputDirectory = true;
+    uint32 maxParallelTasks = 0; // directories packed simultaneously, 0 - as many as there are job workers
     Vector<eGPUFamily> requestedGPUs;
     TextureConverter::eConvertQuality quality = TextureConverter::ECQ_VERY_HIGH;
 
@@ -86,6 +95,7 @@ private:
     FilePath ignoresListPath;
     List<FilePath> ignoredFiles;
     Vector<String> allTags;
+    Vector<PackingSortOrder> packSortOrders = { PackingSortOrder::SORT_BY_AREA };
 
     Set<String> errors;
 
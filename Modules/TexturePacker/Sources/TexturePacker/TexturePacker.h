@@ -55,6 +55,8 @@ public:
     void SetUseOnlySquareTextures(bool value = true);
     void SetMaxTextureSize(uint32 maxTextureSize);
     void SetAlgorithms(const Vector<PackingAlgorithm>& algorithms);
+    void SetSortOrders(const Vector<PackingSortOrder>& sortOrders);
+    void SetUseParallelSearch(bool value = true);
     void SetTwoSideMargin(bool val = true);
     void SetTexturesMargin(uint32 margin);
     const Set<String>& GetErrors() const;
@@ -114,6 +116,14 @@ inline void TexturePacker::SetAlgorithms(const Vector<PackingAlgorithm>& value)
 {
     rectanglePacker.SetAlgorithms(value);
 }
+inline void TexturePacker::SetSortOrders(const Vector<PackingSortOrder>& value)
+{
+    rectanglePacker.SetSortOrders(value);
+}
+inline void TexturePacker::SetUseParallelSearch(bool value)
+{
+    rectanglePacker.SetUseParallelSearch(value);
+}
 inline void TexturePacker::SetTwoSideMargin(bool value)
 {
     rectanglePacker.SetTwoSideMargin(value);
@@ -4,6 +4,7 @@
 
 #include <AssetCache/CachedItemValue.h>
 
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/File.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/KeyedArchive.h>
@@ -13,7 +14,20 @@
 #include <Logger/Logger.h>
 
 const DAVA::String CacheDB::DB_FILE_NAME = "cache.dat";
+const DAVA::String CacheDB::JOURNAL_FILE_NAME = "cache.journal";
+const DAVA::String CacheDB::CHUNKS_FOLDER_NAME = "chunks/";
 const DAVA::uint32 CacheDB::VERSION = 1;
+const DAVA::uint32 CacheDB::JOURNAL_VERSION = 1;
+const DAVA::uint64 CacheDB::MIN_JOURNAL_RECORDS_TO_COMPACT = 1024;
+
+namespace CacheDBDetails
+{
+enum JournalRecordType : DAVA::uint32
+{
+    RECORD_PUT = 0,
+    RECORD_REMOVE = 1
+};
+}
 
 CacheDB::CacheDB(CacheDBOwner& _owner)
     : owner(_owner)
@@ -48,6 +62,8 @@ void CacheDB::UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint6
 
         cacheRootFolder = newCacheRootFolder;
         cacheSettings = cacheRootFolder + DB_FILE_NAME;
+        cacheJournal = cacheRootFolder + JOURNAL_FILE_NAME;
+        chunkStorage.SetFolder(cacheRootFolder + CHUNKS_FOLDER_NAME);
 
         Load();
         fullCacheChanged = true;
@@ -87,55 +103,151 @@ void CacheDB::Load()
     DVASSERT(fastCache.empty());
     DVASSERT(fullCache.empty());
 
+    occupiedSize = 0;
+
     DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::OPEN | DAVA::File::READ));
-    if (!file)
+    if (file)
     {
-        return;
+        DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
+        header->Load(file);
+
+        if (header->GetString("signature") != "cache")
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Wrong signature %s", __FUNCTION__, header->GetString("signature").c_str());
+            return;
+        }
+
+        if (header->GetUInt32("version") != VERSION)
+        {
+            DVASSERT(false, "cachedb file version is changed. Versions load functions should be implemented");
+            return;
+        }
+
+        DAVA::uint64 cacheSize = header->GetUInt64("itemsCount");
+        fullCache.reserve(static_cast<size_t>(cacheSize));
+
+        DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
+        if (!cache->Load(file))
+        {
+            DAVA::Logger::Error("[%s] Can't load cache file", __FUNCTION__);
+            return;
+        }
+
+        for (DAVA::uint64 index = 0; index < cacheSize; ++index)
+        {
+            DAVA::KeyedArchive* itemArchieve = cache->GetArchive(DAVA::Format("item_%d", index));
+            DVASSERT(nullptr != itemArchieve);
+
+            DAVA::AssetCache::CacheItemKey key;
+            key.Deserialize(itemArchieve);
+
+            ServerCacheEntry entry;
+            entry.Deserialize(itemArchieve);
+
+            fullCache[key] = std::move(entry);
+        }
     }
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
-    header->Load(file);
+    LoadJournal();
+    BuildAccessLists();
+    RestoreOccupiedSize();
 
-    if (header->GetString("signature") != "cache")
+    NotifySizeChanged();
+    dbStateChanged = false;
+}
+
+void CacheDB::LoadJournal()
+{
+    journalRecordsCount = 0;
+
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheJournal, DAVA::File::OPEN | DAVA::File::READ));
+    if (!file)
     {
-        DAVA::Logger::Error("[CacheDB::%s] Wrong signature %s", __FUNCTION__, header->GetString("signature").c_str());
         return;
     }
 
-    if (header->GetUInt32("version") != VERSION)
+    DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
+    if (!header->Load(file) || header->GetString("signature") != "journal" || header->GetUInt32("version") != JOURNAL_VERSION)
     {
-        DVASSERT(false, "cachedb file version is changed. Versions load functions should be implemented");
+        DAVA::Logger::Error("[CacheDB::%s] Wrong journal header, journal is skipped", __FUNCTION__);
         return;
     }
 
-    DAVA::uint64 cacheSize = header->GetUInt64("itemsCount");
-    fullCache.reserve(static_cast<size_t>(cacheSize));
-
-    DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
-    if (!cache->Load(file))
+    // Records are applied in order, the last record for a key wins.
+    // Partially written record at the end of journal is the only expected damage, so stop on it
+    while (!file->IsEof())
     {
-        DAVA::Logger::Error("[%s] Can't load cache file", __FUNCTION__);
-        return;
+        DAVA::ScopedPtr<DAVA::KeyedArchive> record(new DAVA::KeyedArchive());
+        if (!record->Load(file))
+        {
+            DAVA::Logger::Warning("[CacheDB::%s] Journal is truncated after %llu records", __FUNCTION__, journalRecordsCount);
+            break;
+        }
+
+        DAVA::AssetCache::CacheItemKey key;
+        key.Deserialize(record);
+
+        fullCache.erase(key);
+
+        if (record->GetUInt32("type") == CacheDBDetails::RECORD_PUT)
+        {
+            ServerCacheEntry entry;
+            entry.Deserialize(record);
+
+            fullCache[key] = std::move(entry);
+        }
+
+        ++journalRecordsCount;
     }
+}
 
-    occupiedSize = 0;
-    for (DAVA::uint64 index = 0; index < cacheSize; ++index)
+void CacheDB::BuildAccessLists()
+{
+    DVASSERT(fastCache.empty());
+
+    DAVA::Vector<std::pair<DAVA::uint64, const DAVA::AssetCache::CacheItemKey*>> timestamps;
+    timestamps.reserve(fullCache.size());
+    for (const auto& item : fullCache)
     {
-        DAVA::KeyedArchive* itemArchieve = cache->GetArchive(DAVA::Format("item_%d", index));
-        DVASSERT(nullptr != itemArchieve);
+        timestamps.emplace_back(item.second.GetTimestamp(), &item.first);
+    }
 
-        DAVA::AssetCache::CacheItemKey key;
-        key.Deserialize(itemArchieve);
+    std::sort(timestamps.begin(), timestamps.end(), [](const std::pair<DAVA::uint64, const DAVA::AssetCache::CacheItemKey*>& left, const std::pair<DAVA::uint64, const DAVA::AssetCache::CacheItemKey*>& right)
+              {
+                  return left.first < right.first;
+              });
 
-        ServerCacheEntry entry;
-        entry.Deserialize(itemArchieve);
+    fastCacheAccessList.clear();
+    fullCacheAccessList.clear();
+    for (const auto& item : timestamps)
+    {
+        ServerCacheEntry& entry = fullCache[*item.second];
+        entry.fullCachePosition = fullCacheAccessList.insert(fullCacheAccessList.end(), *item.second);
+    }
+}
 
-        occupiedSize += entry.GetValue().GetSize();
-        fullCache[key] = std::move(entry);
+void CacheDB::RestoreOccupiedSize()
+{
+    // Chunk references are not stored, they are counted again from loaded entries.
+    // Chunks that are left without references are remains of interrupted work and can be deleted
+    occupiedSize = 0;
+    for (auto& item : fullCache)
+    {
+        const DAVA::Vector<DAVA::AssetCache::ContentChunk>& chunks = item.second.GetChunks();
+        if (chunks.empty())
+        {
+            occupiedSize += item.second.GetValue().GetSize();
+        }
+        else
+        {
+            for (const DAVA::AssetCache::ContentChunk& chunk : chunks)
+            {
+                occupiedSize += chunkStorage.Restore(chunk);
+            }
+        }
     }
 
-    NotifySizeChanged();
-    dbStateChanged = false;
+    chunkStorage.RemoveUnreferencedFiles();
 }
 
 void CacheDB::Unload()
@@ -149,6 +261,9 @@ void CacheDB::Unload()
 
     fastCache.clear();
     fullCache.clear();
+    fastCacheAccessList.clear();
+    fullCacheAccessList.clear();
+    chunkStorage.Clear();
     occupiedSize = 0;
     NotifySizeChanged();
 }
@@ -181,21 +296,73 @@ void CacheDB::Save()
         cache->SetArchive(DAVA::Format("item_%d", index++), itemArchieve);
     }
     cache->Save(file);
+    file.reset();
+
+    // all changes from journal are in settings file now
+    DAVA::FileSystem::Instance()->DeleteFile(cacheJournal);
+    journalRecordsCount = 0;
+    changedKeys.clear();
+
+    dbStateChanged = false;
+    lastSaveTime = DAVA::SystemTimer::GetMs();
+}
+
+void CacheDB::SaveJournal()
+{
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheJournal, DAVA::File::APPEND | DAVA::File::WRITE));
+    if (!file)
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Cannot open file %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+        return;
+    }
+
+    if (file->GetSize() == 0)
+    {
+        DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
+        header->SetString("signature", "journal");
+        header->SetUInt32("version", JOURNAL_VERSION);
+        header->Save(file);
+    }
+
+    for (const DAVA::AssetCache::CacheItemKey& key : changedKeys)
+    {
+        DAVA::ScopedPtr<DAVA::KeyedArchive> record(new DAVA::KeyedArchive());
+        key.Serialize(record);
+
+        const ServerCacheEntry* entry = FindInFullCache(key);
+        if (nullptr != entry)
+        {
+            record->SetUInt32("type", CacheDBDetails::RECORD_PUT);
+            entry->Serialize(record);
+        }
+        else
+        {
+            record->SetUInt32("type", CacheDBDetails::RECORD_REMOVE);
+        }
+
+        record->Save(file);
+        ++journalRecordsCount;
+    }
+    changedKeys.clear();
 
     dbStateChanged = false;
     lastSaveTime = DAVA::SystemTimer::GetMs();
 }
 
+void CacheDB::MarkChanged(const DAVA::AssetCache::CacheItemKey& key)
+{
+    changedKeys.insert(key);
+    dbStateChanged = true;
+}
+
 void CacheDB::ReduceFullCacheToSize(DAVA::uint64 toSize)
 {
     while (occupiedSize > toSize)
     {
-        const auto& found = std::min_element(fullCache.begin(), fullCache.end(), [](const CacheMap::value_type& left, const CacheMap::value_type& right) -> bool
-                                             {
-                                                 return left.second.GetTimestamp() < right.second.GetTimestamp();
-                                             });
-        if (found != fullCache.end())
+        if (!fullCacheAccessList.empty())
         {
+            auto found = fullCache.find(fullCacheAccessList.front());
+            DVASSERT(found != fullCache.end());
             Remove(found);
         }
         else
@@ -213,21 +380,11 @@ void CacheDB::ReduceFullCacheToSize(DAVA::uint64 toSize)
 
 void CacheDB::ReduceFastCacheByCount(DAVA::uint32 countToRemove)
 {
-    for (; countToRemove > 0; --countToRemove)
+    for (; countToRemove > 0 && !fastCacheAccessList.empty(); --countToRemove)
     {
-        const auto& oldestFound = std::min_element(fastCache.begin(), fastCache.end(), [](const FastCacheMap::value_type& left, const FastCacheMap::value_type& right) -> bool
-                                                   {
-                                                       return left.second->GetTimestamp() < right.second->GetTimestamp();
-                                                   });
-
-        if (oldestFound != fastCache.end())
-        {
-            RemoveFromFastCache(oldestFound);
-        }
-        else
-        {
-            return;
-        }
+        auto oldestFound = fastCache.find(fastCacheAccessList.front());
+        DVASSERT(oldestFound != fastCache.end());
+        RemoveFromFastCache(oldestFound);
     }
 }
 
@@ -242,7 +399,7 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
         {
             const DAVA::FilePath path = CreateFolderPath(key);
 
-            if (true == entry->Fetch(path))
+            if (true == entry->Fetch(path, chunkStorage))
             {
                 InsertInFastCache(key, entry);
             }
@@ -318,6 +475,41 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
         return;
     }
 
+    // Chunks of new value are added before removing of old value, so chunks shared by both values stay on disk
+    DAVA::uint64 addedSize = 0;
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> serializedValue(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+    if (entry.GetValue().Serialize(serializedValue))
+    {
+        const DAVA::uint8* data = serializedValue->GetData();
+        DAVA::Vector<DAVA::AssetCache::ContentChunk> chunks = DAVA::AssetCache::ChunkSplitter::SplitByContent(data, serializedValue->GetSize());
+
+        size_t addedCount = 0;
+        for (; addedCount < chunks.size(); ++addedCount)
+        {
+            const DAVA::AssetCache::ContentChunk& chunk = chunks[addedCount];
+            DAVA::uint64 chunkSize = 0;
+            if (!chunkStorage.Add(chunk, data + chunk.offset, chunkSize))
+            {
+                break;
+            }
+            addedSize += chunkSize;
+        }
+
+        if (addedCount == chunks.size())
+        {
+            entry.SetChunks(std::move(chunks));
+        }
+        else
+        { // entry without chunks is saved as files below
+            for (size_t i = 0; i < addedCount; ++i)
+            {
+                addedSize -= chunkStorage.Release(chunks[i]);
+            }
+            DVASSERT(addedSize == 0);
+        }
+    }
+    serializedValue.reset();
+
     auto found = fullCache.find(key);
     if (found != fullCache.end())
     {
@@ -327,10 +519,16 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     DAVA::Logger::Debug("Inserting into cache: key %s", Brief(key).c_str());
     fullCache[key] = std::move(entry);
     ServerCacheEntry* insertedEntry = &fullCache[key];
-    DAVA::FilePath savedPath = CreateFolderPath(key);
-    insertedEntry->GetValue().ExportToFolder(savedPath);
+    if (insertedEntry->GetChunks().empty())
+    {
+        DAVA::Logger::Warning("[CacheDB::%s] Cannot store value of %s as chunks, value is saved as files", __FUNCTION__, Brief(key).c_str());
+        DAVA::FilePath savedPath = CreateFolderPath(key);
+        insertedEntry->GetValue().ExportToFolder(savedPath);
+        addedSize = insertedEntry->GetValue().GetSize();
+    }
     insertedEntry->UpdateAccessTimestamp();
-    occupiedSize += insertedEntry->GetValue().GetSize();
+    insertedEntry->fullCachePosition = fullCacheAccessList.insert(fullCacheAccessList.end(), key);
+    occupiedSize += addedSize;
     NotifySizeChanged();
 
     InsertInFastCache(key, insertedEntry);
@@ -341,7 +539,7 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
         DVASSERT(fullCache.find(key) != fullCache.end());
     }
 
-    dbStateChanged = true;
+    MarkChanged(key);
 }
 
 void CacheDB::InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry)
@@ -359,6 +557,7 @@ void CacheDB::InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, Serve
     DVASSERT(entry->GetValue().IsFetched() == true);
 
     fastCache[key] = entry;
+    entry->fastCachePosition = fastCacheAccessList.insert(fastCacheAccessList.end(), key);
 }
 
 void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key)
@@ -377,10 +576,32 @@ void CacheDB::UpdateAccessTimestamp(ServerCacheEntry* entry)
     if (nullptr != entry)
     {
         entry->UpdateAccessTimestamp();
-        dbStateChanged = true;
+
+        // move entry to the most recently used end of lists
+        const DAVA::AssetCache::CacheItemKey& key = *entry->fullCachePosition;
+        fullCacheAccessList.splice(fullCacheAccessList.end(), fullCacheAccessList, entry->fullCachePosition);
+        if (fastCache.count(key) != 0)
+        {
+            fastCacheAccessList.splice(fastCacheAccessList.end(), fastCacheAccessList, entry->fastCachePosition);
+        }
+
+        MarkChanged(key);
     }
 }
 
+bool CacheDB::GetStoredChunks(const DAVA::AssetCache::CacheItemKey& key, DAVA::Vector<DAVA::AssetCache::ContentChunk>& chunks)
+{
+    ServerCacheEntry* entry = FindInFullCache(key);
+    if (nullptr == entry || entry->GetChunks().empty())
+    {
+        return false;
+    }
+
+    chunks = entry->GetChunks();
+    UpdateAccessTimestamp(entry);
+    return true;
+}
+
 bool CacheDB::Remove(const DAVA::AssetCache::CacheItemKey& key)
 {
     auto found = fullCache.find(key);
@@ -401,21 +622,34 @@ void CacheDB::Remove(const CacheMap::iterator& it)
         RemoveFromFastCache(found);
     }
 
+    MarkChanged(it->first);
     RemoveFromFullCache(it);
-    dbStateChanged = true;
 }
 
 void CacheDB::RemoveFromFullCache(const CacheMap::iterator& it)
 {
     DVASSERT(it != fullCache.end());
 
-    DAVA::FilePath dataPath = CreateFolderPath(it->first);
-    DAVA::FileSystem::Instance()->DeleteDirectory(dataPath);
+    DAVA::uint64 itemSize = 0;
+    const DAVA::Vector<DAVA::AssetCache::ContentChunk>& chunks = it->second.GetChunks();
+    if (chunks.empty())
+    {
+        DAVA::FilePath dataPath = CreateFolderPath(it->first);
+        DAVA::FileSystem::Instance()->DeleteDirectory(dataPath);
+        itemSize = it->second.GetValue().GetSize();
+    }
+    else
+    {
+        for (const DAVA::AssetCache::ContentChunk& chunk : chunks)
+        {
+            itemSize += chunkStorage.Release(chunk);
+        }
+    }
 
-    DAVA::uint64 itemSize = it->second.GetValue().GetSize();
     DVASSERT(itemSize <= occupiedSize);
     occupiedSize -= itemSize;
     DAVA::Logger::Debug("Removing from full cache: key %s", Brief(it->first).c_str());
+    fullCacheAccessList.erase(it->second.fullCachePosition);
     fullCache.erase(it);
     NotifySizeChanged();
 }
@@ -426,6 +660,7 @@ void CacheDB::RemoveFromFastCache(const FastCacheMap::iterator& it)
 
     DVASSERT(it->second->GetValue().IsFetched() == true);
     it->second->Free();
+    fastCacheAccessList.erase(it->second->fastCachePosition);
     fastCache.erase(it);
 }
 
@@ -444,7 +679,15 @@ void CacheDB::Update()
         auto curTime = DAVA::SystemTimer::GetMs();
         if (curTime - lastSaveTime > autoSaveTimeout)
         {
-            Save();
+            // Append changes to the journal, and rewrite full index only when journal becomes too long
+            if (journalRecordsCount + changedKeys.size() > std::max(MIN_JOURNAL_RECORDS_TO_COMPACT, static_cast<DAVA::uint64>(fullCache.size())))
+            {
+                Save();
+            }
+            else
+            {
+                SaveJournal();
+            }
             lastSaveTime = curTime;
         }
     }
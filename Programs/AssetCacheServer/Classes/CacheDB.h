@@ -1,5 +1,8 @@
 #pragma once
 
+#include "ServerCacheEntry.h"
+#include "ChunkStorage.h"
+
 #include <AssetCache/CacheItemKey.h>
 
 #include <Base/BaseTypes.h>
@@ -15,8 +18,6 @@ class CachedItemValue;
 }
 }
 
-class ServerCacheEntry;
-
 struct CacheDBOwner
 {
     virtual void OnStorageSizeChanged(DAVA::uint64 occupied, DAVA::uint64 overall) = 0;
@@ -25,10 +26,15 @@ struct CacheDBOwner
 class CacheDB final
 {
     static const DAVA::String DB_FILE_NAME;
+    static const DAVA::String JOURNAL_FILE_NAME;
+    static const DAVA::String CHUNKS_FOLDER_NAME;
     static const DAVA::uint32 VERSION;
+    static const DAVA::uint32 JOURNAL_VERSION;
+    static const DAVA::uint64 MIN_JOURNAL_RECORDS_TO_COMPACT;
 
     using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
     using FastCacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry*>;
+    using AccessList = ServerCacheEntry::AccessList;
 
 public:
     CacheDB(CacheDBOwner& owner);
@@ -36,6 +42,7 @@ public:
 
     void UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint64 size, const DAVA::uint32 itemsInMemory, const DAVA::uint64 autoSaveTimeout);
 
+    /** Rewrite full index of the cache and clear the journal */
     void Save();
     void Load();
 
@@ -46,6 +53,14 @@ public:
     void ClearStorage();
     void UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key);
 
+    /**
+        Get chunks of stored item without fetching it into memory. Return false if item isn't found
+        or if it is stored in legacy format without chunks
+    */
+    bool GetStoredChunks(const DAVA::AssetCache::CacheItemKey& key, DAVA::Vector<DAVA::AssetCache::ContentChunk>& chunks);
+    bool HasChunk(const DAVA::AssetCache::ChunkHash& hash) const;
+    bool ReadChunk(const DAVA::AssetCache::ChunkHash& hash, DAVA::uint8* dst, DAVA::uint32 size) const;
+
     const DAVA::FilePath& GetPath() const;
     const DAVA::uint64 GetStorageSize() const;
     const DAVA::uint64 GetAvailableSize() const;
@@ -60,6 +75,12 @@ private:
 
     void Unload();
 
+    void LoadJournal();
+    void SaveJournal();
+    void MarkChanged(const DAVA::AssetCache::CacheItemKey& key);
+    void BuildAccessLists();
+    void RestoreOccupiedSize();
+
     ServerCacheEntry* FindInFastCache(const DAVA::AssetCache::CacheItemKey& key) const;
     ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key);
     const ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key) const;
@@ -88,6 +109,7 @@ private:
     DAVA::uint32 maxItemsInMemory = 0; //count of items in memory, to use for fast access
 
     DAVA::uint64 occupiedSize = 0; //used by CacheItemValues
+    ChunkStorage chunkStorage; //content of items, shared between items with the same chunks
     DAVA::uint64 nextItemID = 0; //item counter, used as last access time token
 
     DAVA::uint64 autoSaveTimeout = 0;
@@ -96,6 +118,13 @@ private:
     FastCacheMap fastCache; //runtime, week storage
     CacheMap fullCache; //stored on disk, strong storage
 
+    AccessList fastCacheAccessList; //keys of fastCache from least to most recently used
+    AccessList fullCacheAccessList; //keys of fullCache from least to most recently used
+
+    DAVA::FilePath cacheJournal; //path to journal with changes made after last save of settings
+    DAVA::UnorderedSet<DAVA::AssetCache::CacheItemKey> changedKeys; //keys changed after last save of journal
+    DAVA::uint64 journalRecordsCount = 0;
+
     std::atomic<bool> dbStateChanged; //flag about changes in db
 };
 
@@ -113,3 +142,13 @@ inline const DAVA::uint64 CacheDB::GetOccupiedSize() const
 {
     return occupiedSize;
 }
+
+inline bool CacheDB::HasChunk(const DAVA::AssetCache::ChunkHash& hash) const
+{
+    return chunkStorage.Contains(hash);
+}
+
+inline bool CacheDB::ReadChunk(const DAVA::AssetCache::ChunkHash& hash, DAVA::uint8* dst, DAVA::uint32 size) const
+{
+    return chunkStorage.Read(hash, dst, size);
+}
@@ -0,0 +1,151 @@
+#include "ChunkStorage.h"
+
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Debug/DVAssert.h>
+#include <Logger/Logger.h>
+#include <Utils/MD5.h>
+
+void ChunkStorage::SetFolder(const DAVA::FilePath& folder)
+{
+    DVASSERT(chunks.empty());
+
+    chunksFolder = folder;
+    chunksFolder.MakeDirectoryPathname();
+}
+
+DAVA::FilePath ChunkStorage::GetChunkPath(const DAVA::AssetCache::ChunkHash& hash) const
+{
+    DAVA::String hashString = DAVA::MD5::HashToString(hash);
+    return chunksFolder + (hashString.substr(0, 2) + "/" + hashString);
+}
+
+bool ChunkStorage::Add(const DAVA::AssetCache::ContentChunk& chunk, const DAVA::uint8* chunkData, DAVA::uint64& addedSize)
+{
+    addedSize = 0;
+
+    StoredChunk& stored = chunks[chunk.hash];
+    if (stored.refCount++ > 0)
+    {
+        DVASSERT(stored.size == chunk.size);
+        return true;
+    }
+
+    // write to temporary file first, so chunk file is never seen partially written
+    DAVA::FilePath chunkPath = GetChunkPath(chunk.hash);
+    DAVA::FilePath tempPath = chunkPath.GetAbsolutePathname() + ".tmp";
+    DAVA::FileSystem::Instance()->CreateDirectory(chunkPath.GetDirectory(), true);
+
+    bool written = false;
+    {
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(tempPath, DAVA::File::CREATE | DAVA::File::WRITE));
+        written = file && (file->Write(chunkData, chunk.size) == chunk.size);
+    }
+
+    if (!written || !DAVA::FileSystem::Instance()->MoveFile(tempPath, chunkPath, true))
+    {
+        DAVA::Logger::Error("[ChunkStorage::%s] Cannot write chunk %s", __FUNCTION__, chunkPath.GetStringValue().c_str());
+        DAVA::FileSystem::Instance()->DeleteFile(tempPath);
+        chunks.erase(chunk.hash);
+        return false;
+    }
+
+    stored.size = chunk.size;
+    occupiedSize += chunk.size;
+    addedSize = chunk.size;
+    return true;
+}
+
+DAVA::uint64 ChunkStorage::Restore(const DAVA::AssetCache::ContentChunk& chunk)
+{
+    StoredChunk& stored = chunks[chunk.hash];
+    if (stored.refCount++ > 0)
+    {
+        return 0;
+    }
+
+    stored.size = chunk.size;
+    occupiedSize += chunk.size;
+    return chunk.size;
+}
+
+DAVA::uint64 ChunkStorage::Release(const DAVA::AssetCache::ContentChunk& chunk)
+{
+    auto found = chunks.find(chunk.hash);
+    if (found == chunks.end())
+    {
+        DVASSERT(false, "Releasing unknown chunk");
+        return 0;
+    }
+
+    StoredChunk& stored = found->second;
+    DVASSERT(stored.refCount > 0);
+    if (--stored.refCount > 0)
+    {
+        return 0;
+    }
+
+    DAVA::uint64 freedSize = stored.size;
+    DVASSERT(freedSize <= occupiedSize);
+    occupiedSize -= freedSize;
+    chunks.erase(found);
+
+    DAVA::FileSystem::Instance()->DeleteFile(GetChunkPath(chunk.hash));
+    return freedSize;
+}
+
+bool ChunkStorage::Contains(const DAVA::AssetCache::ChunkHash& hash) const
+{
+    return chunks.count(hash) != 0;
+}
+
+bool ChunkStorage::Read(const DAVA::AssetCache::ChunkHash& hash, DAVA::uint8* dst, DAVA::uint32 size) const
+{
+    auto found = chunks.find(hash);
+    if (found == chunks.end() || found->second.size != size)
+    {
+        return false;
+    }
+
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(GetChunkPath(hash), DAVA::File::OPEN | DAVA::File::READ));
+    return file && (file->Read(dst, size) == size);
+}
+
+void ChunkStorage::RemoveUnreferencedFiles()
+{
+    if (false == DAVA::FileSystem::Instance()->IsDirectory(chunksFolder))
+    {
+        return;
+    }
+
+    DAVA::uint32 removedCount = 0;
+    DAVA::Vector<DAVA::FilePath> files = DAVA::FileSystem::Instance()->EnumerateFilesInDirectory(chunksFolder, true);
+    for (const DAVA::FilePath& path : files)
+    {
+        DAVA::String filename = path.GetFilename();
+
+        DAVA::AssetCache::ChunkHash hash;
+        bool isChunk = (filename.length() == DAVA::AssetCache::ChunkHash::DIGEST_SIZE * 2);
+        if (isChunk)
+        {
+            DAVA::MD5::CharToHash(filename.c_str(), hash);
+        }
+
+        if (!isChunk || !Contains(hash))
+        {
+            DAVA::FileSystem::Instance()->DeleteFile(path);
+            ++removedCount;
+        }
+    }
+
+    if (removedCount > 0)
+    {
+        DAVA::Logger::Info("[ChunkStorage::%s] %u unreferenced files are removed", __FUNCTION__, removedCount);
+    }
+}
+
+void ChunkStorage::Clear()
+{
+    chunks.clear();
+    occupiedSize = 0;
+}
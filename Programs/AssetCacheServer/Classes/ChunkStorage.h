@@ -0,0 +1,57 @@
+#pragma once
+
+#include <AssetCache/ChunkSplitter.h>
+
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+
+/**
+    Deduplicated storage of content chunks of cached items.
+
+    Every chunk is stored once in file named by its hash, no matter how many cache entries reference it.
+    References are counted in memory only: CacheDB restores them from entries on loading,
+    so files without references left after crash are removed by `RemoveUnreferencedFiles`.
+*/
+class ChunkStorage final
+{
+public:
+    void SetFolder(const DAVA::FilePath& folder);
+
+    /**
+        Add reference to chunk and write chunk data if chunk isn't stored yet. Count of bytes added to storage is returned in `addedSize`.
+        Return false if chunk can't be written, no reference is added in this case.
+    */
+    bool Add(const DAVA::AssetCache::ContentChunk& chunk, const DAVA::uint8* chunkData, DAVA::uint64& addedSize);
+
+    /** Add reference to chunk that should be already written. Return count of bytes added to storage */
+    DAVA::uint64 Restore(const DAVA::AssetCache::ContentChunk& chunk);
+
+    /** Remove reference to chunk and delete chunk file when no references left. Return count of freed bytes */
+    DAVA::uint64 Release(const DAVA::AssetCache::ContentChunk& chunk);
+
+    bool Contains(const DAVA::AssetCache::ChunkHash& hash) const;
+    bool Read(const DAVA::AssetCache::ChunkHash& hash, DAVA::uint8* dst, DAVA::uint32 size) const;
+
+    void RemoveUnreferencedFiles();
+    void Clear();
+
+    DAVA::uint64 GetOccupiedSize() const;
+
+private:
+    DAVA::FilePath GetChunkPath(const DAVA::AssetCache::ChunkHash& hash) const;
+
+    struct StoredChunk
+    {
+        DAVA::uint32 size = 0;
+        DAVA::uint32 refCount = 0;
+    };
+
+    DAVA::FilePath chunksFolder;
+    DAVA::UnorderedMap<DAVA::AssetCache::ChunkHash, StoredChunk, DAVA::AssetCache::ChunkHashHasher> chunks;
+    DAVA::uint64 occupiedSize = 0;
+};
+
+inline DAVA::uint64 ChunkStorage::GetOccupiedSize() const
+{
+    return occupiedSize;
+}
@@ -1,5 +1,7 @@
 #include "ServerCacheEntry.h"
+#include "ChunkStorage.h"
 
+#include "FileSystem/DynamicMemoryFile.h"
 #include "FileSystem/KeyedArchive.h"
 
 #include "Debug/DVAssert.h"
@@ -15,7 +17,10 @@ ServerCacheEntry::ServerCacheEntry(const DAVA::AssetCache::CachedItemValue& _val
 
 ServerCacheEntry::ServerCacheEntry(ServerCacheEntry&& right)
     : value(std::move(right.value))
+    , chunks(std::move(right.chunks))
     , accessTimestamp(right.accessTimestamp)
+    , fullCachePosition(right.fullCachePosition)
+    , fastCachePosition(right.fastCachePosition)
 {
 }
 
@@ -24,7 +29,10 @@ ServerCacheEntry& ServerCacheEntry::operator=(ServerCacheEntry&& right)
     if (this != &right)
     {
         value = std::move(right.value);
+        chunks = std::move(right.chunks);
         accessTimestamp = right.accessTimestamp;
+        fullCachePosition = right.fullCachePosition;
+        fastCachePosition = right.fastCachePosition;
     }
 
     return (*this);
@@ -44,6 +52,18 @@ void ServerCacheEntry::Serialize(DAVA::KeyedArchive* archieve) const
     DAVA::ScopedPtr<DAVA::KeyedArchive> valueArchieve(new DAVA::KeyedArchive());
     value.Serialize(valueArchieve, false);
     archieve->SetArchive("value", valueArchieve);
+
+    if (!chunks.empty())
+    {
+        // hash and size of every chunk, offsets follow from sizes
+        DAVA::ScopedPtr<DAVA::DynamicMemoryFile> chunksData(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+        for (const DAVA::AssetCache::ContentChunk& chunk : chunks)
+        {
+            chunksData->Write(chunk.hash.digest.data(), static_cast<DAVA::uint32>(chunk.hash.digest.size()));
+            chunksData->Write(&chunk.size, sizeof(chunk.size));
+        }
+        archieve->SetByteArray("chunks", chunksData->GetData(), static_cast<DAVA::int32>(chunksData->GetSize()));
+    }
 }
 
 void ServerCacheEntry::Deserialize(DAVA::KeyedArchive* archieve)
@@ -55,11 +75,54 @@ void ServerCacheEntry::Deserialize(DAVA::KeyedArchive* archieve)
     DAVA::KeyedArchive* valueArchieve = archieve->GetArchive("value");
     DVASSERT(valueArchieve);
     value.Deserialize(valueArchieve);
+
+    chunks.clear();
+    const DAVA::int32 chunksDataSize = archieve->GetByteArraySize("chunks");
+    if (chunksDataSize > 0)
+    {
+        const DAVA::uint8* chunksData = archieve->GetByteArray("chunks");
+        const DAVA::uint32 recordSize = DAVA::AssetCache::ChunkHash::DIGEST_SIZE + sizeof(DAVA::uint32);
+        DVASSERT(chunksDataSize % recordSize == 0);
+
+        DAVA::uint64 offset = 0;
+        chunks.resize(chunksDataSize / recordSize);
+        for (DAVA::AssetCache::ContentChunk& chunk : chunks)
+        {
+            Memcpy(chunk.hash.digest.data(), chunksData, DAVA::AssetCache::ChunkHash::DIGEST_SIZE);
+            Memcpy(&chunk.size, chunksData + DAVA::AssetCache::ChunkHash::DIGEST_SIZE, sizeof(chunk.size));
+            chunk.offset = offset;
+
+            offset += chunk.size;
+            chunksData += recordSize;
+        }
+    }
 }
 
-bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder)
+bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder, const ChunkStorage& chunkStorage)
 {
-    return value.Fetch(folder);
+    if (chunks.empty())
+    {
+        return value.Fetch(folder);
+    }
+
+    DAVA::Vector<DAVA::uint8> serializedValue(static_cast<size_t>(chunks.back().offset + chunks.back().size));
+    for (const DAVA::AssetCache::ContentChunk& chunk : chunks)
+    {
+        if (!chunkStorage.Read(chunk.hash, serializedValue.data() + chunk.offset, chunk.size))
+        {
+            return false;
+        }
+    }
+
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> file(DAVA::DynamicMemoryFile::Create(std::move(serializedValue), DAVA::File::OPEN | DAVA::File::READ, DAVA::FilePath()));
+    DAVA::AssetCache::CachedItemValue fetchedValue;
+    if (!fetchedValue.Deserialize(file) || !fetchedValue.IsFetched())
+    {
+        return false;
+    }
+
+    value = std::move(fetchedValue);
+    return true;
 }
 
 void ServerCacheEntry::Free()
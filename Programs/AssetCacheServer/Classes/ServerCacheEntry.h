@@ -1,6 +1,8 @@
 #pragma once
 
+#include <AssetCache/CacheItemKey.h>
 #include <AssetCache/CachedItemValue.h>
+#include <AssetCache/ChunkSplitter.h>
 #include <Base/BaseTypes.h>
 #include <chrono>
 
@@ -9,9 +11,13 @@ namespace DAVA
 class KeyedArchive;
 }
 
+class ChunkStorage;
+
 class ServerCacheEntry final
 {
 public:
+    using AccessList = DAVA::List<DAVA::AssetCache::CacheItemKey>;
+
     ServerCacheEntry();
     explicit ServerCacheEntry(const DAVA::AssetCache::CachedItemValue& value);
 
@@ -33,14 +39,25 @@ public:
 
     DAVA::AssetCache::CachedItemValue& GetValue();
 
-    bool Fetch(const DAVA::FilePath& folder);
+    /** Chunks of serialized value in ChunkStorage. Empty for entries stored as separate files by older versions */
+    const DAVA::Vector<DAVA::AssetCache::ContentChunk>& GetChunks() const;
+    void SetChunks(DAVA::Vector<DAVA::AssetCache::ContentChunk>&& chunks);
+
+    bool Fetch(const DAVA::FilePath& folder, const ChunkStorage& chunkStorage);
     void Free();
 
 private:
     DAVA::AssetCache::CachedItemValue value;
+    DAVA::Vector<DAVA::AssetCache::ContentChunk> chunks;
 
 private:
     DAVA::uint64 accessTimestamp = 0;
+
+    // Positions of the entry in CacheDB access lists, sorted from least to most recently used
+    AccessList::iterator fullCachePosition = AccessList::iterator();
+    AccessList::iterator fastCachePosition = AccessList::iterator();
+
+    friend class CacheDB;
 };
 
 inline void ServerCacheEntry::UpdateAccessTimestamp()
@@ -57,3 +74,13 @@ inline DAVA::AssetCache::CachedItemValue& ServerCacheEntry::GetValue()
 {
     return value;
 }
+
+inline const DAVA::Vector<DAVA::AssetCache::ContentChunk>& ServerCacheEntry::GetChunks() const
+{
+    return chunks;
+}
+
+inline void ServerCacheEntry::SetChunks(DAVA::Vector<DAVA::AssetCache::ContentChunk>&& chunks_)
+{
+    chunks = std::move(chunks_);
+}
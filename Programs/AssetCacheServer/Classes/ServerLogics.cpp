@@ -6,6 +6,7 @@
 
 #include <Concurrency/LockGuard.h>
 #include <Logger/Logger.h>
+#include <Utils/MD5.h>
 #include <Utils/StringFormat.h>
 
 void ServerLogics::Init(DAVA::AssetCache::ServerNetProxy* server_, const DAVA::String& serverName_, DAVA::AssetCache::ClientNetProxy* client_, CacheDB* dataBase_)
@@ -92,34 +93,203 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
             return;
         }
 
-        AssetCache::CachedItemValue value;
-        task.receivedData->Seek(0, File::SEEK_FROM_START);
-        value.Deserialize(task.receivedData);
-        if (value.IsEmpty() || !value.IsValid())
+        if (!InsertAddedData(key, task.receivedData))
         {
-            Error("Received data is empty or invalid");
+            DiscardTask();
             return;
         }
 
-        AssetCache::CachedItemValue::Description description = value.GetDescription();
-        description.addingChain += "/" + serverName;
-        value.SetDescription(description);
+        dataAddTasks.erase(it);
+    }
+
+    DAVA::Logger::Debug("Sending 'chunk successfully added' response");
+    serverProxy->SendAddedToCache(channel, key, true);
+}
+
+void ServerLogics::OnAddManifestToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, const DAVA::Vector<DAVA::AssetCache::ContentChunk>& chunks)
+{
+    hasIncomingRequestsRecently = true;
+
+    using namespace DAVA;
+
+    DAVA::List<DataAddTask>::iterator it = GetOrCreateAddTask(channel, key);
+    DataAddTask& task = *it;
+
+    auto DiscardTask = [&]()
+    {
+        DAVA::Logger::Debug("Sending 'manifest is not accepted' response");
+        serverProxy->SendAddManifestAccepted(channel, key, false, Vector<uint32>());
+        dataAddTasks.erase(it);
+    };
+
+    auto Error = [&](const char* err)
+    {
+        Logger::Error("Wrong manifest: %s. Client %p, key %s", err, channel.get(), Brief(key).c_str());
+        DiscardTask();
+    };
+
+    if (dataSize == 0 || chunks.empty())
+    {
+        Error("both data size and number of chunks are zero");
+        return;
+    }
+
+    if (task.manifestReceived || task.chunksOverall != 0 || task.bytesOverall != 0)
+    {
+        Error("add data info was already received with given key and channel");
+        return;
+    }
+
+    if (dataSize > dataBase->GetStorageSize())
+    {
+        DAVA::Logger::Warning("Inserted data size %u is bigger than max storage size %u", dataSize, dataBase->GetStorageSize());
+        DiscardTask();
+        return;
+    }
 
-        if (value.GetSize() > dataBase->GetStorageSize())
+    task.manifestReceived = true;
+    task.bytesOverall = static_cast<size_t>(dataSize);
+    task.chunksOverall = static_cast<uint32>(chunks.size());
+    task.chunks = chunks;
+    task.assembledData.resize(static_cast<size_t>(dataSize));
+
+    // Chunks that are already stored are copied right now, so they can't be removed from storage before all missing chunks are received
+    UnorderedMap<AssetCache::ChunkHash, uint32, AssetCache::ChunkHashHasher> firstChunkIndices;
+    for (uint32 i = 0; i < task.chunksOverall; ++i)
+    {
+        const AssetCache::ContentChunk& chunk = chunks[i];
+        auto inserted = firstChunkIndices.emplace(chunk.hash, i);
+        if (!inserted.second)
         {
-            Logger::Warning("Inserted data size %u is bigger than max storage size %u", value.GetSize(), dataBase->GetStorageSize());
-            DiscardTask();
-            return;
+            task.duplicateChunks.emplace_back(i, inserted.first->second);
+        }
+        else if (!dataBase->ReadChunk(chunk.hash, task.assembledData.data() + chunk.offset, chunk.size))
+        {
+            task.missingChunks.push_back(i);
         }
+    }
 
-        dataBase->Insert(key, value);
+    DAVA::Logger::Debug("Receiving add manifest: key %s, %llu bytes, %u chunks, %u missing", Brief(key).c_str(), dataSize, task.chunksOverall, static_cast<uint32>(task.missingChunks.size()));
+
+    if (task.missingChunks.empty())
+    {
+        bool added = FinishManifestAddTask(it);
+        DAVA::Logger::Debug("Sending 'manifest is %s' response", (added ? "accepted" : "not accepted"));
+        serverProxy->SendAddManifestAccepted(channel, key, added, Vector<uint32>());
+    }
+    else
+    {
+        DAVA::Logger::Debug("Sending 'manifest is accepted' response");
+        serverProxy->SendAddManifestAccepted(channel, key, true, task.missingChunks);
+    }
+}
+
+void ServerLogics::OnAddContentChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkIndex, const DAVA::Vector<DAVA::uint8>& chunkData)
+{
+    hasIncomingRequestsRecently = true;
+
+    using namespace DAVA;
+
+    DAVA::List<DataAddTask>::iterator it = GetOrCreateAddTask(channel, key);
+    DataAddTask& task = *it;
+
+    auto DiscardTask = [&]()
+    {
+        DAVA::Logger::Debug("Sending 'add data chunk failed' response");
+        serverProxy->SendAddedToCache(channel, key, false);
         dataAddTasks.erase(it);
-        dataRemoteAddTasks.emplace(key, DataRemoteAddTask());
-        DAVA::Logger::Debug("Adding remote add task. Tasks now: %u", dataRemoteAddTasks.size());
+    };
+
+    auto Error = [&](const char* err)
+    {
+        Logger::Error("Wrong request: %s. Client %p, key %s chunk#%u", err, channel.get(), Brief(key).c_str(), chunkIndex);
+        DiscardTask();
+    };
+
+    if (!task.manifestReceived)
+    {
+        Error("manifest was not received");
+        return;
     }
 
-    DAVA::Logger::Debug("Sending 'chunk successfully added' response");
-    serverProxy->SendAddedToCache(channel, key, true);
+    if (task.missingReceived >= task.missingChunks.size() || task.missingChunks[task.missingReceived] != chunkIndex)
+    {
+        Error("chunk was not expected");
+        return;
+    }
+
+    const AssetCache::ContentChunk& chunk = task.chunks[chunkIndex];
+    if (chunkData.size() != chunk.size)
+    {
+        Error(Format("chunk size %u doesn't match manifest (expected %u bytes)", static_cast<uint32>(chunkData.size()), chunk.size).c_str());
+        return;
+    }
+
+    AssetCache::ChunkHash hash;
+    MD5::ForData(chunkData.data(), chunk.size, hash);
+    if (!(hash == chunk.hash))
+    {
+        Error("chunk content doesn't match its hash");
+        return;
+    }
+
+    Memcpy(task.assembledData.data() + chunk.offset, chunkData.data(), chunk.size);
+    ++task.missingReceived;
+
+    bool added = true;
+    if (task.missingReceived == task.missingChunks.size())
+    {
+        added = FinishManifestAddTask(it);
+    }
+
+    DAVA::Logger::Debug("Sending 'chunk %s added' response", (added ? "successfully" : "not"));
+    serverProxy->SendAddedToCache(channel, key, added);
+}
+
+bool ServerLogics::FinishManifestAddTask(DAVA::List<DataAddTask>::iterator it)
+{
+    using namespace DAVA;
+
+    DataAddTask& task = *it;
+    for (const std::pair<uint32, uint32>& duplicate : task.duplicateChunks)
+    {
+        const AssetCache::ContentChunk& chunk = task.chunks[duplicate.first];
+        Memcpy(task.assembledData.data() + chunk.offset, task.assembledData.data() + task.chunks[duplicate.second].offset, chunk.size);
+    }
+
+    ScopedPtr<DynamicMemoryFile> assembledFile(DynamicMemoryFile::Create(std::move(task.assembledData), File::OPEN | File::READ, FilePath()));
+    bool inserted = InsertAddedData(task.key, assembledFile);
+    dataAddTasks.erase(it);
+    return inserted;
+}
+
+bool ServerLogics::InsertAddedData(const DAVA::AssetCache::CacheItemKey& key, DAVA::File* serializedData)
+{
+    using namespace DAVA;
+
+    AssetCache::CachedItemValue value;
+    serializedData->Seek(0, File::SEEK_FROM_START);
+    value.Deserialize(serializedData);
+    if (value.IsEmpty() || !value.IsValid())
+    {
+        Logger::Error("Wrong request: received data is empty or invalid. Key %s", Brief(key).c_str());
+        return false;
+    }
+
+    AssetCache::CachedItemValue::Description description = value.GetDescription();
+    description.addingChain += "/" + serverName;
+    value.SetDescription(description);
+
+    if (value.GetSize() > dataBase->GetStorageSize())
+    {
+        Logger::Warning("Inserted data size %u is bigger than max storage size %u", value.GetSize(), dataBase->GetStorageSize());
+        return false;
+    }
+
+    dataBase->Insert(key, value);
+    dataRemoteAddTasks.emplace(key, DataRemoteAddTask());
+    DAVA::Logger::Debug("Adding remote add task. Tasks now: %u", dataRemoteAddTasks.size());
+    return true;
 }
 
 DAVA::List<ServerLogics::DataAddTask>::iterator ServerLogics::GetOrCreateAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key)
@@ -148,9 +318,21 @@ ServerLogics::DataGetMap::iterator ServerLogics::GetOrCreateGetTask(const DAVA::
     DataGetMap::iterator taskIter = dataGetTasks.find(key);
     if (taskIter == dataGetTasks.end())
     {
-        ServerCacheEntry* entry = dataBase->Get(key);
-        if (nullptr != entry)
-        { // Found in db.
+        Vector<AssetCache::ContentChunk> storedChunks;
+        ServerCacheEntry* entry = nullptr;
+        if (dataBase->GetStoredChunks(key, storedChunks))
+        { // Found in db. Chunks will be read from storage directly into sent packets
+            Logger::Debug("Creating get task using stored chunks");
+            taskIter = dataGetTasks.emplace(key, DataGetTask()).first;
+            DataGetTask& task = taskIter->second;
+            task.chunks = std::move(storedChunks);
+            task.chunksInStorage = true;
+            task.dataStatus = DataGetTask::READY;
+            task.bytesOverall = task.bytesReady = task.chunks.back().offset + task.chunks.back().size;
+            task.chunksOverall = task.chunksReady = static_cast<uint32>(task.chunks.size());
+        }
+        else if (nullptr != (entry = dataBase->Get(key)))
+        { // Found in db, stored in old format.
             Logger::Debug("Creating get task using local data");
             taskIter = dataGetTasks.emplace(key, DataGetTask()).first;
             DataGetTask& task = taskIter->second;
@@ -161,9 +343,10 @@ ServerLogics::DataGetMap::iterator ServerLogics::GetOrCreateGetTask(const DAVA::
             description.receivingChain += "/" + serverName;
             value.SetDescription(description);
             value.Serialize(task.serializedData);
+            task.chunks = AssetCache::ChunkSplitter::SplitByContent(task.serializedData->GetData(), task.serializedData->GetSize());
             task.dataStatus = DataGetTask::READY;
             task.bytesOverall = task.bytesReady = task.serializedData->GetSize();
-            task.chunksOverall = task.chunksReady = AssetCache::ChunkSplitter::GetNumberOfChunks(task.bytesOverall);
+            task.chunksOverall = task.chunksReady = static_cast<uint32>(task.chunks.size());
         }
         else if (IsRemoteServerConnected() && clientProxy->RequestGetNextChunk(key, 0))
         { // Not found in db. Ask from remote cache.
@@ -200,19 +383,23 @@ void ServerLogics::OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IC
 
         if (task.chunksReady > chunkNumber) // task has such chunk
         {
-            Vector<uint8> chunk = AssetCache::ChunkSplitter::GetChunk(task.serializedData->GetDataVector(), chunkNumber);
-            if (chunk.empty())
+            if (chunkNumber == 0)
             {
-                Error("can't get valid range for given chunk");
-                return;
+                DAVA::Logger::Debug("Requested data will be sent: %u chunks, %u bytes", task.chunksOverall, task.bytesOverall);
             }
 
-            if (chunkNumber == 0)
+            if (!SendChunkToClient(taskIter, clientChannel, chunkNumber))
             {
-                DAVA::Logger::Debug("Requested data will be sent: %u chunks, %u bytes", task.chunksOverall, task.bytesOverall);
+                Error("can't read given chunk");
+                if (task.chunksInStorage)
+                {
+                    DAVA::Logger::Error("Stored chunks of entry '%s' are damaged. Entry will be removed from cache", Brief(key).c_str());
+                    dataBase->Remove(key);
+                }
+                CancelGetTask(taskIter);
+                return;
             }
 
-            SendChunkToClient(taskIter, clientChannel, chunkNumber, chunk);
             RemoveTaskIfChunksAreSent(taskIter);
         }
         else // task hasn't such chunk yet
@@ -376,6 +563,11 @@ void ServerLogics::OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key
         return;
     }
 
+    AssetCache::ContentChunk chunk;
+    chunk.offset = task.bytesReady;
+    chunk.size = chunkSize;
+    task.chunks.push_back(chunk);
+
     task.bytesReady += chunkSize;
     ++task.chunksReady;
 
@@ -406,7 +598,7 @@ void ServerLogics::OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key
         RequestNextChunk(taskIter);
     }
 
-    SendChunkToClients(taskIter, chunkNumber, chunkData);
+    SendChunkToClients(taskIter, chunkNumber);
 }
 
 void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, bool received)
@@ -419,7 +611,7 @@ void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, boo
 
         if (received)
         {
-            if (task.chunksSent == task.chunksOverall)
+            if (task.missingSent == task.missingChunks.size())
             {
                 DAVA::Logger::Debug("All chunks are sent. Removing remote add task. Tasks remaining: %u", dataRemoteAddTasks.size() - 1);
                 dataRemoteAddTasks.erase(itTask);
@@ -451,6 +643,38 @@ void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, boo
     }
 }
 
+void ServerLogics::OnAddManifestAccepted(const DAVA::AssetCache::CacheItemKey& key, bool accepted, const DAVA::Vector<DAVA::uint32>& missingChunks)
+{
+    DAVA::Logger::Debug("Receiving response: manifest was %s by the remote cache, %u chunks are missing", (accepted ? "accepted" : "not accepted"), static_cast<DAVA::uint32>(missingChunks.size()));
+    DataRemoteAddMap::iterator itTask = dataRemoteAddTasks.find(key);
+    if (itTask == dataRemoteAddTasks.end())
+    {
+        DAVA::Logger::Error("Answer for unknown remote add task is received. Key %s", Brief(key).c_str());
+        return;
+    }
+
+    DataRemoteAddTask& task = itTask->second;
+    bool indicesAreValid = std::all_of(missingChunks.begin(), missingChunks.end(), [&task](DAVA::uint32 index)
+                                       {
+                                           return index < task.chunks.size();
+                                       });
+
+    bool sentOk = false;
+    if (accepted && indicesAreValid && !missingChunks.empty())
+    {
+        task.missingChunks = missingChunks;
+        task.missingSent = 0;
+        sentOk = SendChunkToRemote(itTask);
+    }
+
+    if (!sentOk)
+    {
+        DAVA::Logger::Debug("No more chunks to send to remote cache. Removing task");
+        dataRemoteAddTasks.erase(itTask);
+        ProcessFirstRemoteAddDataTask();
+    }
+}
+
 void ServerLogics::RequestNextChunk(ServerLogics::DataGetMap::iterator it)
 {
     DVASSERT(it != dataGetTasks.end());
@@ -465,22 +689,50 @@ void ServerLogics::RequestNextChunk(ServerLogics::DataGetMap::iterator it)
     task.dataStatus = DataGetTask::WAITING_NEXT_CHUNK;
 }
 
-void ServerLogics::SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk)
+bool ServerLogics::SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber)
 {
     DataGetTask& task = taskIt->second;
     DataGetTask::ClientStatus& client = task.clients[clientChannel];
 
-    DAVA::Logger::Debug("Sending chunk #%u: %u bytes", chunkNumber, chunk.size());
-    serverProxy->SendChunk(clientChannel, taskIt->first, task.bytesOverall, task.chunksOverall, chunkNumber, chunk);
+    DVASSERT(chunkNumber < task.chunks.size());
+    const DAVA::AssetCache::ContentChunk& chunk = task.chunks[chunkNumber];
+
+    DAVA::Logger::Debug("Sending chunk #%u: %u bytes", chunkNumber, chunk.size);
+    bool sent = false;
+    if (task.chunksInStorage)
+    {
+        CacheDB* db = dataBase;
+        sent = serverProxy->SendChunk(clientChannel, taskIt->first, task.bytesOverall, task.chunksOverall, chunkNumber, chunk.size, [db, &chunk](DAVA::uint8* dst, DAVA::uint32 size)
+                                      {
+                                          return db->ReadChunk(chunk.hash, dst, size);
+                                      });
+    }
+    else
+    {
+        const DAVA::uint8* data = task.serializedData->GetData() + chunk.offset;
+        sent = serverProxy->SendChunk(clientChannel, taskIt->first, task.bytesOverall, task.chunksOverall, chunkNumber, chunk.size, [data](DAVA::uint8* dst, DAVA::uint32 size)
+                                      {
+                                          Memcpy(dst, data, size);
+                                          return true;
+                                      });
+    }
+
+    if (!sent)
+    {
+        return false;
+    }
+
     client.status = DataGetTask::READY;
 
     if (chunkNumber + 1 == task.chunksOverall)
     {
         client.lastChunkWasSent = true;
     }
+
+    return true;
 }
 
-void ServerLogics::SendChunkToClients(ServerLogics::DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk)
+void ServerLogics::SendChunkToClients(ServerLogics::DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber)
 {
     DVASSERT(taskIt != dataGetTasks.end());
 
@@ -491,7 +743,7 @@ void ServerLogics::SendChunkToClients(ServerLogics::DataGetMap::iterator taskIt,
     {
         if (client.second.status == DataGetTask::WAITING_NEXT_CHUNK && client.second.waitingChunk == chunkNumber)
         {
-            SendChunkToClient(taskIt, client.first, chunkNumber, chunk);
+            SendChunkToClient(taskIt, client.first, chunkNumber);
         }
     }
 
@@ -513,7 +765,7 @@ void ServerLogics::RemoveTaskIfChunksAreSent(ServerLogics::DataGetMap::iterator
     }
 }
 
-bool ServerLogics::SendFirstChunkToRemote(DataRemoteAddMap::iterator taskIt)
+bool ServerLogics::SendManifestToRemote(DataRemoteAddMap::iterator taskIt)
 {
     using namespace DAVA;
 
@@ -529,9 +781,12 @@ bool ServerLogics::SendFirstChunkToRemote(DataRemoteAddMap::iterator taskIt)
         AssetCache::CachedItemValue& value = entry->GetValue();
         value.Serialize(task.serializedData);
         task.bytesOverall = task.serializedData->GetSize();
-        task.chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(task.bytesOverall);
-        task.chunksSent = 0;
-        return SendChunkToRemote(taskIt);
+        task.chunks = AssetCache::ChunkSplitter::SplitByContent(task.serializedData->GetData(), task.bytesOverall);
+        task.missingChunks.clear();
+        task.missingSent = 0;
+        task.manifestSent = true;
+        DAVA::Logger::Debug("Sending add manifest to remote: %u chunks, key %s", static_cast<uint32>(task.chunks.size()), Brief(key).c_str());
+        return clientProxy->RequestAddManifest(key, task.bytesOverall, task.chunks);
     }
     else
     {
@@ -549,9 +804,11 @@ bool ServerLogics::SendChunkToRemote(DataRemoteAddMap::iterator taskIt)
     const AssetCache::CacheItemKey& key = taskIt->first;
     DataRemoteAddTask& task = taskIt->second;
 
-    Vector<uint8> chunk = AssetCache::ChunkSplitter::GetChunk(task.serializedData->GetDataVector(), task.chunksSent);
-    DAVA::Logger::Debug("Sending add chunk %u/%u to remote, key %s", task.chunksSent, task.chunksOverall, Brief(key).c_str());
-    return clientProxy->RequestAddNextChunk(key, task.bytesOverall, task.chunksOverall, task.chunksSent++, chunk);
+    DVASSERT(task.missingSent < task.missingChunks.size());
+    uint32 chunkIndex = task.missingChunks[task.missingSent++];
+    const AssetCache::ContentChunk& chunk = task.chunks[chunkIndex];
+    DAVA::Logger::Debug("Sending add chunk %u/%u to remote, key %s", task.missingSent, static_cast<uint32>(task.missingChunks.size()), Brief(key).c_str());
+    return clientProxy->RequestAddContentChunk(key, chunkIndex, task.serializedData->GetData() + chunk.offset, chunk.size);
 }
 
 void ServerLogics::CancelGetTask(ServerLogics::DataGetMap::iterator it)
@@ -662,9 +919,9 @@ void ServerLogics::ProcessFirstRemoteAddDataTask()
         if (firstRemoteDataTask != dataRemoteAddTasks.end())
         {
             DataRemoteAddTask& task = firstRemoteDataTask->second;
-            if (!task.chunksSent)
+            if (!task.manifestSent)
             {
-                bool sentOk = SendFirstChunkToRemote(firstRemoteDataTask);
+                bool sentOk = SendManifestToRemote(firstRemoteDataTask);
                 if (!sentOk)
                 {
                     dataRemoteAddTasks.erase(firstRemoteDataTask);
@@ -18,6 +18,8 @@ public:
 
     //ServerNetProxyListener
     void OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, DAVA::uint32 numOfChunks, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunkData) override;
+    void OnAddManifestToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, const DAVA::Vector<DAVA::AssetCache::ContentChunk>& chunks) override;
+    void OnAddContentChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkIndex, const DAVA::Vector<DAVA::uint8>& chunkData) override;
     void OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkNumber) override;
     void OnRemoveFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key) override;
     void OnClearCache(const std::shared_ptr<DAVA::Net::IChannel>& channel) override;
@@ -28,6 +30,7 @@ public:
     //ClientNetProxyListener
     void OnClientProxyStateChanged() override;
     void OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, bool added) override;
+    void OnAddManifestAccepted(const DAVA::AssetCache::CacheItemKey& key, bool accepted, const DAVA::Vector<DAVA::uint32>& missingChunks) override;
     void OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, DAVA::uint32 numOfChunks, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunkData) override;
 
 private:
@@ -52,6 +55,8 @@ private:
 
         DAVA::UnorderedMap<std::shared_ptr<DAVA::Net::IChannel>, ClientStatus> clients;
         DAVA::ScopedPtr<DAVA::DynamicMemoryFile> serializedData;
+        DAVA::Vector<DAVA::AssetCache::ContentChunk> chunks; // ranges of chunks in serializedData or in chunk storage of dataBase
+        bool chunksInStorage = false; // chunks are read from dataBase while sending, serializedData isn't used
         DataRequestStatus dataStatus = READY;
 
         DAVA::uint64 bytesReady = 0;
@@ -71,14 +76,24 @@ private:
         size_t bytesOverall = 0;
         DAVA::uint32 chunksReceived = 0;
         DAVA::uint32 chunksOverall = 0;
+
+        // adding by manifest: data is assembled from stored chunks and from missing chunks sent by client
+        bool manifestReceived = false;
+        DAVA::Vector<DAVA::AssetCache::ContentChunk> chunks;
+        DAVA::Vector<DAVA::uint32> missingChunks;
+        DAVA::Vector<std::pair<DAVA::uint32, DAVA::uint32>> duplicateChunks; // index of chunk and index of first chunk with the same content
+        DAVA::uint32 missingReceived = 0;
+        DAVA::Vector<DAVA::uint8> assembledData;
     };
 
     struct DataRemoteAddTask
     {
         DAVA::ScopedPtr<DAVA::DynamicMemoryFile> serializedData;
-        DAVA::uint32 chunksSent = 0;
-        DAVA::uint32 chunksOverall = 0;
+        DAVA::Vector<DAVA::AssetCache::ContentChunk> chunks;
+        DAVA::Vector<DAVA::uint32> missingChunks;
+        DAVA::uint32 missingSent = 0;
         DAVA::uint64 bytesOverall = 0;
+        bool manifestSent = false;
     };
     using DataRemoteAddMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, DataRemoteAddTask>;
 
@@ -96,10 +111,12 @@ private:
 
     DAVA::List<DataAddTask>::iterator GetOrCreateAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key);
     DataGetMap::iterator GetOrCreateGetTask(const DAVA::AssetCache::CacheItemKey& key);
+    bool InsertAddedData(const DAVA::AssetCache::CacheItemKey& key, DAVA::File* serializedData);
+    bool FinishManifestAddTask(DAVA::List<DataAddTask>::iterator it);
     void RequestNextChunk(DataGetMap::iterator it);
-    void SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk);
-    void SendChunkToClients(DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk);
-    bool SendFirstChunkToRemote(DataRemoteAddMap::iterator taskIt);
+    bool SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber);
+    void SendChunkToClients(DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber);
+    bool SendManifestToRemote(DataRemoteAddMap::iterator taskIt);
     bool SendChunkToRemote(DataRemoteAddMap::iterator taskIt);
     void CancelGetTask(DataGetMap::iterator it);
     void CancelRemoteTasks();
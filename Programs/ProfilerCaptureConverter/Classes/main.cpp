@@ -0,0 +1,65 @@
+#include <Engine/Engine.h>
+#include <CommandLine/CommandLineParser.h>
+#include <Debug/DVAssertDefaultHandlers.h>
+#include <Debug/ProfilerUtils.h>
+#include <FileSystem/FilePath.h>
+#include <Logger/Logger.h>
+#include <Base/BaseTypes.h>
+
+using namespace DAVA;
+
+void PrintUsage()
+{
+    printf("Usage:\n");
+
+    printf("\t-usage or --help to display this help\n");
+    printf("\t-capture - binary capture written by ProfilerCPU::StartCapture\n");
+    printf("\t-json - output file in Chromium Trace Viewer format\n");
+
+    printf("\nExample:\n");
+    printf("\t-capture /Users/nickname/soak.dvpc -json /Users/nickname/soak.json\n");
+}
+
+int32 Process(Engine& e)
+{
+    const EngineContext* context = e.GetContext();
+    context->logger->SetLogLevel(Logger::LEVEL_INFO);
+    DVASSERT(e.IsConsoleMode() == true);
+
+    FilePath capturePath = CommandLineParser::GetCommandParam(String("-capture"));
+    FilePath jsonPath = CommandLineParser::GetCommandParam(String("-json"));
+
+    if (CommandLineParser::CommandIsFound(String("-usage"))
+        || CommandLineParser::CommandIsFound(String("-help"))
+        || capturePath.IsEmpty()
+        || jsonPath.IsEmpty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (ProfilerUtils::ConvertCPUCaptureToJSON(capturePath, jsonPath) == false)
+    {
+        Logger::Error("Can't convert capture %s", capturePath.GetAbsolutePathname().c_str());
+        return 1;
+    }
+
+    Logger::Info("Trace is written to %s", jsonPath.GetAbsolutePathname().c_str());
+    return 0;
+}
+
+int DAVAMain(Vector<String> cmdline)
+{
+    Assert::AddHandler(Assert::DefaultLoggerHandler);
+    Assert::AddHandler(Assert::DefaultDebuggerBreakHandler);
+
+    Engine e;
+    e.Init(eEngineRunMode::CONSOLE_MODE, {}, nullptr);
+
+    e.update.Connect([&e](float32)
+                     {
+                         e.QuitAsync(Process(e));
+                     });
+
+    return e.Run();
+}
@@ -5,6 +5,7 @@
 #include "Classes/Collada/ColladaToSc2Importer/ImportSettings.h"
 
 #include <Animation/AnimationChannel.h>
+#include <Animation/AnimationChannelEncoder.h>
 #include <Animation/AnimationClip.h>
 #include <Animation/AnimationTrack.h>
 #include <FileSystem/DynamicMemoryFile.h>
@@ -430,16 +431,9 @@ eColladaErrorCodes ColladaImporter::SaveAnimations(ColladaScene* colladaScene, c
     //binary file format described in 'AnimationBinaryFormat.md'
     struct ChannelHeader
     {
-        //Track part
+        //Track part, channel part is written by AnimationChannelEncoder
         uint8 target;
         uint8 pad0[3];
-
-        //Channel part
-        uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
-        uint8 dimension = 0;
-        uint8 interpolation = 0;
-        uint16 compression = 0;
-        uint32 keyCount = 0;
     } channelHeader;
 
     for (auto canimation : colladaScene->colladaAnimations)
@@ -481,49 +475,40 @@ eColladaErrorCodes ColladaImporter::SaveAnimations(ColladaScene* colladaScene, c
                 if (!animationData.translations.empty())
                 {
                     //Write position channel
-                    channelHeader.dimension = 3;
-                    channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
                     channelHeader.target = AnimationTrack::CHANNEL_TARGET_POSITION;
-                    channelHeader.keyCount = uint32(animationData.translations.size());
                     WriteToBuffer(animationClipData, &channelHeader);
 
+                    AnimationChannelEncoder encoder(3, AnimationChannel::INTERPOLATION_LINEAR);
                     for (auto& t : animationData.translations)
-                    {
-                        WriteToBuffer(animationClipData, &t.first); //time
-                        WriteToBuffer(animationClipData, &t.second); //position
-                    }
+                        encoder.AddKey(t.first, t.second.data);
+
+                    encoder.Encode(animationClipData, AnimationChannelEncoder::GetDefaultTolerance(AnimationTrack::CHANNEL_TARGET_POSITION), AnimationChannel::COMPRESSION_QUANTIZED_16);
                 }
 
                 //Write orientation channel
                 if (!animationData.rotations.empty())
                 {
-                    channelHeader.dimension = 4;
-                    channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
                     channelHeader.target = AnimationTrack::CHANNEL_TARGET_ORIENTATION;
-                    channelHeader.keyCount = uint32(animationData.rotations.size());
                     WriteToBuffer(animationClipData, &channelHeader);
 
+                    AnimationChannelEncoder encoder(4, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
                     for (auto& r : animationData.rotations)
-                    {
-                        WriteToBuffer(animationClipData, &r.first); //time
-                        WriteToBuffer(animationClipData, &r.second); //rotation
-                    }
+                        encoder.AddKey(r.first, r.second.data);
+
+                    encoder.Encode(animationClipData, AnimationChannelEncoder::GetDefaultTolerance(AnimationTrack::CHANNEL_TARGET_ORIENTATION), AnimationChannel::COMPRESSION_QUANTIZED_16);
                 }
 
                 //Write scale channel
                 if (!animationData.scales.empty())
                 {
-                    channelHeader.dimension = 1;
-                    channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
                     channelHeader.target = AnimationTrack::CHANNEL_TARGET_SCALE;
-                    channelHeader.keyCount = uint32(animationData.scales.size());
                     WriteToBuffer(animationClipData, &channelHeader);
 
+                    AnimationChannelEncoder encoder(1, AnimationChannel::INTERPOLATION_LINEAR);
                     for (auto& s : animationData.scales)
-                    {
-                        WriteToBuffer(animationClipData, &s.first); //time
-                        WriteToBuffer(animationClipData, &s.second.x); //scale
-                    }
+                        encoder.AddKey(s.first, &s.second.x);
+
+                    encoder.Encode(animationClipData, AnimationChannelEncoder::GetDefaultTolerance(AnimationTrack::CHANNEL_TARGET_SCALE), AnimationChannel::COMPRESSION_QUANTIZED_16);
                 }
             }
 
@@ -32,6 +32,7 @@ void PrintUsage()
     printf("\t-t - asset cache timeout\n");
     printf("\t-postifx - trailing part of texture name\n");
     printf("\t-output - output folder for .../Project/Data/Gfx/\n");
+    printf("\t-threads - max count of directories packed simultaneously, all job workers are used by default\n");
 
     printf("\n");
     printf("ResourcePacker [src_dir] - will pack resources from src_dir\n");
@@ -138,6 +139,12 @@ void ProcessRecourcePacker(Engine& e)
     resourcePacker.SetTag(CommandLineParser::GetCommandParam("-tag"));
     resourcePacker.SetIgnoresFile(CommandLineParser::GetCommandParam("-ignore"));
 
+    String threadsStr = CommandLineParser::GetCommandParam("-threads");
+    if (!threadsStr.empty())
+    {
+        resourcePacker.maxParallelTasks = static_cast<uint32>(std::max(atoi(threadsStr.c_str()), 0));
+    }
+
     if (CommandLineParser::CommandIsFound(String("-md5mode")))
     {
         resourcePacker.RecalculateMD5ForOutputDir();
@@ -216,6 +223,7 @@ int DAVAMain(Vector<String> cmdLine)
     DAVA::Vector<DAVA::String> modules =
     {
       "NetCore", // AssetCacheClient
+      "JobManager", // ResourcePacker2D packs directories in job worker threads
       "LocalizationSystem" // ResourcePacker2D::SetCacheClient is using DateTime::GetLocalizedTime() to create cache item
     };
 
@@ -4,6 +4,7 @@
 
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
 #include <GridTest.h>
+#include <CullingTest.h>
 #endif
 #include <NetworkHelpers/ChannelListenerDispatched.h>
 
@@ -32,6 +33,7 @@ struct SceneViewerData
     DAVA::ScopedPtr<DAVA::Scene> scene;
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
     GridTestResult gridTestResult;
+    CullingTestResult cullingTestResult;
 #endif
 };
 
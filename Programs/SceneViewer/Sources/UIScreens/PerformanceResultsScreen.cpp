@@ -214,13 +214,22 @@ void PerformanceResultsScreen::AddResultsText()
     using namespace PerformanceResultsScreenDetails;
     using namespace DAVA;
 
-    fpsResultsText = new UIStaticText(Rect(infoColumnRect.x, INFO_FPS_RESULTS_Y0, infoColumnRect.dx, 200.f));
+    fpsResultsText = new UIStaticText(Rect(infoColumnRect.x, INFO_FPS_RESULTS_Y0, infoColumnRect.dx, 300.f));
     fpsResultsText->SetFont(font);
     fpsResultsText->SetTextColor(Color::White);
     fpsResultsText->SetTextColorInheritType(UIControlBackground::COLOR_IGNORE_PARENT);
     fpsResultsText->SetTextAlign(ALIGN_LEFT | ALIGN_TOP);
     fpsResultsText->SetMultiline(true);
-    fpsResultsText->SetText(Format(L"Average FPS: %.1f\nMin FPS: %.1f\nMax FPS: %.1f", data.gridTestResult.avgFPS, data.gridTestResult.minFPS, data.gridTestResult.maxFPS));
+
+    WideString resultsText = Format(L"Average FPS: %.1f\nMin FPS: %.1f\nMax FPS: %.1f", data.gridTestResult.avgFPS, data.gridTestResult.minFPS, data.gridTestResult.maxFPS);
+    const CullingTestResult& culling = data.cullingTestResult;
+    if (culling.completed)
+    {
+        resultsText += Format(L"\n\nCulling, %u samples:\nSerial: %.3f ms\nParallel: %.3f ms\nSpeedup: %.2fx%ls",
+                              culling.samplesCount, culling.serialTimeMs, culling.parallelTimeMs, culling.speedup,
+                              culling.resultsMatch ? L"" : L"\nVisibility results differ!");
+    }
+    fpsResultsText->SetText(resultsText);
     AddControl(fpsResultsText);
 }
 
@@ -571,6 +571,7 @@ void ViewSceneScreen::OnGridTestStateChanged()
     if (gridTest.GetState() == GridTest::StateFinished)
     {
         data.gridTestResult = gridTest.GetResult();
+        data.cullingTestResult = CullingTest::Run(scene);
         SetNextScreen();
     }
 }
@@ -1,8 +1,13 @@
 #include "UnitTests/UnitTests.h"
+#include <Compression/LZ4Compressor.h>
+#include <FileSystem/Private/ArchiveFileView.h>
 #include <FileSystem/Private/PackArchive.h>
+#include <FileSystem/Private/PackFormatSpec.h>
 #include <FileSystem/Private/ZipArchive.h>
 #include <FileSystem/FileSystem.h>
+#include <FileSystem/ResourceArchive.h>
 #include <Logger/Logger.h>
+#include <Utils/CRC32.h>
 
 #include <cstring>
 
@@ -46,6 +51,11 @@ DAVA_TESTCLASS (ArchiveTest)
                     file->Read(fileFromHDD.data(), static_cast<uint32>(fileSize));
 
                     TEST_VERIFY(fileFromHDD == fileFromArchive);
+
+                    // compressed content can't be viewed without decompression
+                    const uint8* view = nullptr;
+                    uint32 viewSize = 0;
+                    TEST_VERIFY(archive.GetFileView(filename, view, viewSize) == false);
                 }
             }
             catch (std::exception& ex)
@@ -58,6 +68,80 @@ DAVA_TESTCLASS (ArchiveTest)
 #endif // __DAVAENGINE_IPHONE__
     }
 
+    DAVA_TEST (TestArchiveFileView)
+    {
+        using namespace PackFormat;
+
+        const FilePath packPath("~doc:/ArchiveTest/view.dvpk");
+        const String content = "uncompressed file content";
+        const String names("view.txt\0", 9);
+
+        // pack with single uncompressed file
+        Vector<uint8> compressedNames;
+        TEST_VERIFY(LZ4HCCompressor().Compress(Vector<uint8>(names.begin(), names.end()), compressedNames));
+
+        FileTableEntry entry = {};
+        entry.startPosition = 0;
+        entry.compressedSize = static_cast<uint32>(content.size());
+        entry.originalSize = static_cast<uint32>(content.size());
+        entry.compressedCrc32 = CRC32::ForBuffer(content.data(), content.size());
+        entry.originalCrc32 = entry.compressedCrc32;
+        entry.type = Compressor::Type::None;
+
+        Vector<uint8> filesTable(sizeof(entry));
+        Memcpy(filesTable.data(), &entry, sizeof(entry));
+        filesTable.insert(filesTable.end(), compressedNames.begin(), compressedNames.end());
+
+        PackFile::FooterBlock footer;
+        footer.info.numFiles = 1;
+        footer.info.namesSizeCompressed = static_cast<uint32>(compressedNames.size());
+        footer.info.namesSizeOriginal = static_cast<uint32>(names.size());
+        footer.info.filesTableSize = static_cast<uint32>(filesTable.size());
+        footer.info.filesTableCrc32 = CRC32::ForBuffer(filesTable.data(), filesTable.size());
+        footer.info.packArchiveMarker = FILE_MARKER;
+        footer.infoCrc32 = CRC32::ForBuffer(&footer.info, sizeof(footer.info));
+
+        FileSystem::Instance()->CreateDirectory(packPath.GetDirectory(), true);
+        {
+            ScopedPtr<File> packFile(File::Create(packPath, File::CREATE | File::WRITE));
+            TEST_VERIFY(packFile);
+            packFile->Write(content.data(), static_cast<uint32>(content.size()));
+            packFile->Write(filesTable.data(), static_cast<uint32>(filesTable.size()));
+            packFile->Write(&footer, sizeof(footer));
+        }
+
+        std::shared_ptr<ResourceArchive> archive = std::make_shared<ResourceArchive>(packPath);
+        const uint8* view = nullptr;
+        uint32 viewSize = 0;
+        // files can be viewed only if archive is memory-mapped on this platform
+        if (archive->GetFileView("view.txt", view, viewSize))
+        {
+            TEST_VERIFY(String(reinterpret_cast<const char*>(view), viewSize) == content);
+
+            ScopedPtr<File> file(ArchiveFileView::Create(archive, "view.txt", "~res:/view.txt"));
+            TEST_VERIFY(file);
+
+            // view keeps archive mapped after archive is released by owner
+            archive.reset();
+
+            String fileContent(static_cast<size_t>(file->GetSize()), '\0');
+            TEST_VERIFY(file->Read(&fileContent[0], static_cast<uint32>(fileContent.size())) == content.size());
+            TEST_VERIFY(fileContent == content);
+
+            char8 byte = 0;
+            TEST_VERIFY(file->Read(&byte, 1) == 0 && file->IsEof());
+            TEST_VERIFY(file->Seek(0, File::SEEK_FROM_START) && !file->IsEof());
+            TEST_VERIFY(file->Read(&byte, 1) == 1 && byte == content[0]);
+        }
+        else
+        {
+            TEST_VERIFY(ArchiveFileView::Create(archive, "view.txt", "~res:/view.txt") == nullptr);
+        }
+        archive.reset();
+
+        FileSystem::Instance()->DeleteDirectory(packPath.GetDirectory());
+    }
+
     DAVA_TEST (TestZipArchive)
     {
         try
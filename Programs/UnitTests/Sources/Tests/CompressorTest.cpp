@@ -60,4 +60,29 @@ DAVA_TESTCLASS (CompressorTest)
             TEST_VERIFY(uncompressedZip == in);
         }
     }
+
+    DAVA_TEST (TestLZ4DamagedInput)
+    {
+        Vector<uint8> in(4096);
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            in[i] = static_cast<uint8>((i * 7) % 13);
+        }
+
+        LZ4Compressor lz4;
+        Vector<uint8> compressed;
+        TEST_VERIFY(lz4.Compress(in, compressed));
+
+        // truncated input must be rejected without reading beyond it
+        Vector<uint8> truncated(compressed.begin(), compressed.begin() + compressed.size() / 2);
+        Vector<uint8> out(in.size(), '\0');
+        TEST_VERIFY(lz4.Decompress(truncated.data(), truncated.size(), out.data(), out.size()) == false);
+
+        // output size not matching original size is an error too
+        Vector<uint8> smallerOut(in.size() - 1, '\0');
+        TEST_VERIFY(lz4.Decompress(compressed, smallerOut) == false);
+
+        TEST_VERIFY(lz4.Decompress(compressed.data(), compressed.size(), out.data(), out.size()));
+        TEST_VERIFY(out == in);
+    }
 };
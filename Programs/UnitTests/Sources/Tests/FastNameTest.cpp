@@ -152,4 +152,48 @@ DAVA_TESTCLASS (FastNameTest)
             TEST_VERIFY(strcmp(fns[i].back().c_str(), std::to_string(i).c_str()) == 0);
         }
     }
+
+    DAVA_TEST (ConcurrentInsertTest)
+    {
+        // every thread interns the same large set of new names in its own order,
+        // so shards grow while other threads read and insert
+        const size_t threadsNum = 8;
+        const size_t namesNum = 20000;
+
+        Array<Thread*, threadsNum> threads;
+        Vector<Vector<const char*>> results(threadsNum, Vector<const char*>(namesNum));
+
+        const size_t namesCountBefore = FastNameDB::GetLocalDB()->GetNamesCount();
+
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i] = Thread::Create([i, &results, namesNum]() {
+                for (size_t j = 0; j < namesNum; ++j)
+                {
+                    size_t index = (j * 7 + i * 131) % namesNum;
+                    results[i][index] = FastName("ConcurrentInsertTest_" + std::to_string(index)).c_str();
+                }
+            });
+            threads[i]->Start();
+        }
+
+        for (auto& thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+
+        for (size_t j = 0; j < namesNum; ++j)
+        {
+            String expected = "ConcurrentInsertTest_" + std::to_string(j);
+            TEST_VERIFY(expected == results[0][j]);
+            TEST_VERIFY(FastName(expected).c_str() == results[0][j]);
+            for (size_t i = 1; i < threadsNum; ++i)
+            {
+                TEST_VERIFY(results[i][j] == results[0][j]);
+            }
+        }
+
+        TEST_VERIFY(FastNameDB::GetLocalDB()->GetNamesCount() == namesCountBefore + namesNum);
+    }
 };
@@ -107,4 +107,65 @@ DAVA_TESTCLASS (ImageTest)
             }
         }
     }
+
+    DAVA_TEST (VectorizedDownscaleTest)
+    {
+        // vectorized and tiled downscale should give exactly the same result as plain bilinear filter
+        struct TestData
+        {
+            uint32 width;
+            uint32 height;
+        };
+
+        static Vector<TestData> tests =
+        {
+          { 1024, 1024 }, // large enough to be split into tiles
+          { 22, 6 }, // width is not multiple of vector size
+          { 2, 1 },
+          { 1, 2 }
+        };
+
+        for (const TestData& td : tests)
+        {
+            const uint32 dWidth = Max(td.width / 2, 1u);
+            const uint32 dHeight = Max(td.height / 2, 1u);
+
+            {
+                Vector<uint32> source(td.width * td.height);
+                for (uint32& pixel : source)
+                {
+                    pixel = Random::Instance()->Rand();
+                }
+
+                Vector<uint32> expected(dWidth * dHeight);
+                ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
+                convert(source.data(), td.width, td.height, td.width * 4, expected.data(), dWidth, dHeight, dWidth * 4);
+
+                Vector<uint32> result(dWidth * dHeight);
+                TEST_VERIFY(ImageConvert::DownscaleTwiceBillinear(FORMAT_RGBA8888, FORMAT_RGBA8888, source.data(), td.width, td.height, td.width * 4,
+                                                                  result.data(), dWidth, dHeight, dWidth * 4, false));
+                TEST_VERIFY_WITH_MESSAGE(result == expected, Format("RGBA8888 %ux%u", td.width, td.height));
+            }
+
+            {
+                Vector<RGBA32F> source(td.width * td.height);
+                for (RGBA32F& pixel : source)
+                {
+                    pixel.r = Random::Instance()->RandFloat32InBounds(-100.0f, 100.0f);
+                    pixel.g = Random::Instance()->RandFloat32InBounds(-100.0f, 100.0f);
+                    pixel.b = Random::Instance()->RandFloat32InBounds(-100.0f, 100.0f);
+                    pixel.a = Random::Instance()->RandFloat32InBounds(0.0f, 1.0f);
+                }
+
+                Vector<RGBA32F> expected(dWidth * dHeight);
+                ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
+                convert(source.data(), td.width, td.height, td.width * 16, expected.data(), dWidth, dHeight, dWidth * 16);
+
+                Vector<RGBA32F> result(dWidth * dHeight);
+                TEST_VERIFY(ImageConvert::DownscaleTwiceBillinear(FORMAT_RGBA32F, FORMAT_RGBA32F, source.data(), td.width, td.height, td.width * 16,
+                                                                  result.data(), dWidth, dHeight, dWidth * 16, false));
+                TEST_VERIFY_WITH_MESSAGE(Memcmp(result.data(), expected.data(), result.size() * sizeof(RGBA32F)) == 0, Format("RGBA32F %ux%u", td.width, td.height));
+            }
+        }
+    }
 };
@@ -83,8 +83,95 @@ DAVA_TESTCLASS (JobManagerTest)
 
     DAVA_TEST (TestWorkerJobs)
     {
-        // TODO:
-        // ...
+        Atomic<uint32> counter(0);
+
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            GetEngineContext()->jobManager->CreateWorkerJob([&counter]() { counter++; });
+        }
+
+        GetEngineContext()->jobManager->WaitWorkerJobs();
+
+        TEST_VERIFY(counter == JOBS_COUNT);
+        TEST_VERIFY(GetEngineContext()->jobManager->HasWorkerJobs() == false);
+    }
+
+    DAVA_TEST (TestWorkerTaskDependencies)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        // each task of the chain depends on the previous one, so they should be executed in order
+        Vector<uint32> executionOrder;
+        Vector<JobHandle> chain;
+        for (uint32 i = 0; i < 50; ++i)
+        {
+            Vector<JobHandle> dependencies;
+            if (!chain.empty())
+            {
+                dependencies.push_back(chain.back());
+            }
+
+            chain.push_back(jobManager->CreateWorkerTask([&executionOrder, i]() { executionOrder.push_back(i); }, nullptr, JobHandle(), dependencies));
+        }
+
+        jobManager->WaitWorkerTask(chain.back());
+
+        TEST_VERIFY(executionOrder.size() == chain.size());
+        for (uint32 i = 0; i < executionOrder.size(); ++i)
+        {
+            TEST_VERIFY(executionOrder[i] == i);
+        }
+    }
+
+    DAVA_TEST (TestWorkerTaskChildren)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> childrenCounter(0);
+        JobHandle parent = jobManager->CreateWorkerTask([jobManager, &childrenCounter]() {
+            JobHandle self = jobManager->GetCurrentWorkerTask();
+            for (uint32 i = 0; i < JOBS_COUNT; ++i)
+            {
+                jobManager->CreateWorkerTask([&childrenCounter]() { childrenCounter++; }, nullptr, self);
+            }
+        });
+
+        // parent is finished only when all of its children are finished
+        Atomic<bool> continuationSawAllChildren(false);
+        JobHandle continuation = jobManager->CreateWorkerTask([&]() {
+            continuationSawAllChildren = (childrenCounter == JOBS_COUNT);
+        },
+                                                              nullptr, JobHandle(), { parent });
+
+        jobManager->WaitWorkerTask(continuation);
+
+        TEST_VERIFY(jobManager->IsWorkerTaskFinished(parent));
+        TEST_VERIFY(childrenCounter == JOBS_COUNT);
+        TEST_VERIFY(continuationSawAllChildren);
+    }
+
+    DAVA_TEST (TestWorkerGroup)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        JobGroup group;
+        Atomic<uint32> counter(0);
+
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            // nested waiting from worker task shouldn't dead lock
+            jobManager->CreateWorkerTask([jobManager, &counter]() {
+                JobGroup nestedGroup;
+                jobManager->CreateWorkerTask([&counter]() { counter++; }, &nestedGroup);
+                jobManager->WaitWorkerGroup(&nestedGroup);
+            },
+                                         &group);
+        }
+
+        jobManager->WaitWorkerGroup(&group);
+
+        TEST_VERIFY(group.IsDone());
+        TEST_VERIFY(counter == JOBS_COUNT);
     }
 
     void ThreadFunc(JobManagerTestData * data)
@@ -0,0 +1,67 @@
+#include <DLCManager/Private/LocalFileIndex.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Engine/Engine.h>
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (LocalFileIndexTest)
+{
+    static LocalFileIndex::Record MakeRecord(uint32 fileIndex, bool isReady)
+    {
+        LocalFileIndex::Record record;
+        record.fileIndex = fileIndex;
+        record.compressedSize = fileIndex * 10;
+        record.compressedCrc32 = fileIndex * 100;
+        record.isReady = isReady ? 1 : 0;
+        return record;
+    }
+
+    DAVA_TEST (TestJournalReplay)
+    {
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const FilePath dir("~doc:/UnitTests/LocalFileIndexTest/");
+        const FilePath path = dir + "local_files.index";
+        fs->DeleteDirectory(dir);
+        fs->CreateDirectory(dir, true);
+
+        uint32 filesTableCrc32 = 0;
+        Vector<LocalFileIndex::Record> readyFiles;
+        TEST_VERIFY(!LocalFileIndex::Read(path, filesTableCrc32, readyFiles));
+
+        {
+            LocalFileIndex index;
+            TEST_VERIFY(index.Rewrite(path, 0xC0FFEE, { MakeRecord(1, true), MakeRecord(2, true) }));
+            TEST_VERIFY(index.IsOpened());
+            index.Append(MakeRecord(3, true));
+            index.Append(MakeRecord(1, false));
+            index.Close();
+            TEST_VERIFY(!index.IsOpened());
+        }
+
+        // simulate record partially written before application was killed
+        {
+            ScopedPtr<File> f(File::Create(path, File::APPEND | File::WRITE));
+            TEST_VERIFY(f);
+            const uint8 tail[3] = { 4, 0, 0 };
+            f->Write(tail, sizeof(tail));
+        }
+
+        TEST_VERIFY(LocalFileIndex::Read(path, filesTableCrc32, readyFiles));
+        TEST_VERIFY(filesTableCrc32 == 0xC0FFEE);
+        TEST_VERIFY(readyFiles.size() == 2);
+
+        Set<uint32> readyIndexes;
+        for (const LocalFileIndex::Record& record : readyFiles)
+        {
+            TEST_VERIFY(record.compressedSize == record.fileIndex * 10);
+            TEST_VERIFY(record.compressedCrc32 == record.fileIndex * 100);
+            readyIndexes.insert(record.fileIndex);
+        }
+        TEST_VERIFY((readyIndexes == Set<uint32>{ 2, 3 }));
+
+        fs->DeleteDirectory(dir);
+    }
+};
@@ -3,6 +3,8 @@
 #include "Logger/Logger.h"
 #include "Concurrency/Thread.h"
 #include "Concurrency/Atomic.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
 
 #include <algorithm>
 #include <numeric>
@@ -10,6 +12,25 @@
 
 using namespace DAVA;
 
+namespace LoggerConcurrentTestDetails
+{
+class CountingLoggerOutput : public LoggerOutput
+{
+public:
+    ~CountingLoggerOutput() override = default;
+
+    void Output(Logger::eLogLevel ll, const char8* text) override
+    {
+        if (strstr(text, "async test message") != nullptr)
+        {
+            ++messagesCount;
+        }
+    }
+
+    std::atomic<size_t> messagesCount{ 0 };
+};
+}
+
 DAVA_TESTCLASS (LoggerConcurrentTest)
 {
     DAVA_TEST (ConcurrentLoggerTest)
@@ -62,4 +83,51 @@ DAVA_TESTCLASS (LoggerConcurrentTest)
 
         TEST_VERIFY(threadsFinished == threadsNumber);
     }
-};
\ No newline at end of file
+
+    DAVA_TEST (AsyncLoggerTest)
+    {
+        using namespace LoggerConcurrentTestDetails;
+
+        const size_t threadsNumber = 8;
+        const size_t messagesPerThread = 500;
+
+        Logger* logger = GetEngineContext()->logger;
+        CountingLoggerOutput output;
+        Logger::AddCustomOutput(&output);
+
+        logger->SetAsyncQueueLimit(64, Logger::ASYNC_OVERFLOW_BLOCK);
+        logger->SetAsyncModeEnabled(true);
+        TEST_VERIFY(logger->IsAsyncModeEnabled());
+
+        Vector<Thread*> threads(threadsNumber);
+        for (auto& t : threads)
+        {
+            t = Thread::Create([messagesPerThread] {
+                for (size_t i = 0; i < messagesPerThread; ++i)
+                {
+                    Logger::Info("async test message %u", static_cast<uint32>(i));
+                }
+            });
+            t->Start();
+        }
+
+        for (auto& t : threads)
+        {
+            t->Join();
+            SafeRelease(t);
+        }
+
+        // with blocking policy nothing is lost and everything is written after flush
+        Logger::Flush();
+        TEST_VERIFY(output.messagesCount == threadsNumber * messagesPerThread);
+
+        logger->SetAsyncModeEnabled(false);
+        logger->SetAsyncQueueLimit(4096, Logger::ASYNC_OVERFLOW_DROP_LOW_LEVELS);
+        TEST_VERIFY(logger->IsAsyncModeEnabled() == false);
+
+        Logger::Info("async test message after disable");
+        TEST_VERIFY(output.messagesCount == threadsNumber * messagesPerThread + 1);
+
+        Logger::RemoveCustomOutput(&output);
+    }
+};
@@ -114,6 +114,38 @@ DAVA_TESTCLASS (MemoryManagerTest)
         ::operator delete(buffer);
     }
 
+    DAVA_TEST (TestCrossThreadDealloc)
+    {
+        const size_t statSize = MemoryManager::Instance()->CalcCurStatSize();
+        void* buffer = ::operator new(statSize);
+        AllocPoolStat* poolStat = OffsetPointer<AllocPoolStat>(buffer, sizeof(MMCurStat));
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        uint32 oldAllocByApp = poolStat[ALLOC_POOL_BULLET].allocByApp;
+        uint32 oldBlockCount = poolStat[ALLOC_POOL_BULLET].blockCount;
+
+        // Statistics are kept per thread, so block allocated in one thread and freed in other should be accounted properly
+        void* ptr = nullptr;
+        Thread* thread = Thread::Create([&ptr]() {
+            ptr = MemoryManager::Instance()->Allocate(333, ALLOC_POOL_BULLET);
+        });
+        thread->Start();
+        thread->Join();
+        thread->Release();
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        TEST_VERIFY(oldAllocByApp + 333 == poolStat[ALLOC_POOL_BULLET].allocByApp);
+        TEST_VERIFY(oldBlockCount + 1 == poolStat[ALLOC_POOL_BULLET].blockCount);
+
+        MemoryManager::Instance()->Deallocate(ptr);
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        TEST_VERIFY(oldAllocByApp == poolStat[ALLOC_POOL_BULLET].allocByApp);
+        TEST_VERIFY(oldBlockCount == poolStat[ALLOC_POOL_BULLET].blockCount);
+
+        ::operator delete(buffer);
+    }
+
     DAVA_TEST (TestCallback)
     {
         const uint32 TAG = 1;
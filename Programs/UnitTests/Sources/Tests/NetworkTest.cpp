@@ -232,6 +232,58 @@ private:
     size_t pendingDelivered = 0; // Parcel index expected to be confirmed as delivered
 };
 
+class TestSinkServer : public DAVA::Net::NetService
+{
+public:
+    void PacketReceived(const void* packet, size_t length) override
+    {
+        bytesRecieved += length;
+    }
+
+    size_t BytesRecieved() const
+    {
+        return bytesRecieved;
+    }
+
+private:
+    size_t bytesRecieved = 0;
+};
+
+class TestFloodClient : public DAVA::Net::NetService
+{
+public:
+    TestFloodClient(size_t packetSize, size_t packetCount_)
+        : data(std::make_shared<Vector<uint8>>(packetSize, static_cast<uint8>(packetCount_)))
+        , packetCount(packetCount_)
+    {
+    }
+
+    void ChannelOpen() override
+    {
+        // All packets share the same buffer, so nothing is copied or freed by client
+        for (size_t i = 0; i < packetCount; ++i)
+            Send(data);
+    }
+    void PacketDelivered() override
+    {
+        deliveredCount += 1;
+    }
+
+    bool IsTestDone() const
+    {
+        return deliveredCount == packetCount;
+    }
+    size_t TotalBytes() const
+    {
+        return data->size() * packetCount;
+    }
+
+private:
+    SharedBuffer data;
+    size_t packetCount = 0;
+    size_t deliveredCount = 0;
+};
+
 DAVA_TESTCLASS (NetworkTest)
 {
     //BEGIN_FILES_COVERED_BY_TESTS( )
@@ -244,7 +296,9 @@ DAVA_TESTCLASS (NetworkTest)
 
     enum eServiceTypes
     {
-        SERVICE_ECHO = 1000
+        SERVICE_ECHO = 1000,
+        SERVICE_FLOOD_SMALL = 1001,
+        SERVICE_FLOOD_LARGE = 1002
     };
 
     enum
@@ -254,11 +308,18 @@ DAVA_TESTCLASS (NetworkTest)
     };
 
     static const uint16 ECHO_PORT = 55101;
+    static const uint16 FLOOD_PORT = 55102;
 
     bool echoTestDone = false;
     TestEchoServer echoServer;
     TestEchoClient echoClient;
 
+    // Many small packets on one channel and few big ones on another channel
+    bool throughputTestDone = false;
+    int64 throughputStartTime = 0;
+    TestSinkServer sinkServers[2];
+    TestFloodClient floodClients[2] = { TestFloodClient(256, 20000), TestFloodClient(256 * 1024, 64) };
+
     NetCore::TrackId serverId = NetCore::INVALID_TRACK_ID;
     NetCore::TrackId clientId = NetCore::INVALID_TRACK_ID;
 
@@ -278,13 +339,29 @@ DAVA_TESTCLASS (NetworkTest)
                 TEST_VERIFY(echoServer.BytesRecieved() == echoClient.BytesRecieved());
             }
         }
+        else if (testName == "TestThroughput")
+        {
+            throughputTestDone = floodClients[0].IsTestDone() && floodClients[1].IsTestDone();
+            if (throughputTestDone)
+            {
+                size_t totalBytes = 0;
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    TEST_VERIFY(sinkServers[i].BytesRecieved() == floodClients[i].TotalBytes());
+                    totalBytes += floodClients[i].TotalBytes();
+                }
+
+                float64 seconds = Max(SystemTimer::GetMs() - throughputStartTime, int64(1)) / 1000.0;
+                Logger::Info("NetworkTest: %u bytes sent through loopback in %.3f s, %.2f MB/s", static_cast<uint32>(totalBytes), seconds, totalBytes / seconds / (1024.0 * 1024.0));
+            }
+        }
 
         TestClass::Update(timeElapsed, testName);
     }
 
     void TearDown(const String& testName) override
     {
-        if (testName == "TestEcho")
+        if (testName == "TestEcho" || testName == "TestThroughput")
         {
             // Check whether DestroyControllerBlocked() really blocks until controller is destroyed
             size_t nactive = NetCore::Instance()->ControllersCount();
@@ -305,6 +382,10 @@ DAVA_TESTCLASS (NetworkTest)
         {
             return echoTestDone;
         }
+        else if (testName == "TestThroughput")
+        {
+            return throughputTestDone;
+        }
         return true;
     }
 
@@ -389,6 +470,33 @@ DAVA_TESTCLASS (NetworkTest)
         clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(ECHO_CLIENT_CONTEXT));
     }
 
+    DAVA_TEST (TestThroughput)
+    {
+        NetCore::Instance()->RegisterService(SERVICE_FLOOD_SMALL, MakeFunction(this, &NetworkTest::CreateFlood), MakeFunction(this, &NetworkTest::DeleteEcho));
+        NetCore::Instance()->RegisterService(SERVICE_FLOOD_LARGE, MakeFunction(this, &NetworkTest::CreateFlood), MakeFunction(this, &NetworkTest::DeleteEcho));
+
+        NetConfig serverConfig(SERVER_ROLE);
+        serverConfig.AddTransport(TRANSPORT_TCP, Endpoint(FLOOD_PORT));
+        serverConfig.AddService(SERVICE_FLOOD_SMALL);
+        serverConfig.AddService(SERVICE_FLOOD_LARGE);
+
+        NetConfig clientConfig = serverConfig.Mirror(IPAddress("127.0.0.1"));
+
+        throughputStartTime = SystemTimer::GetMs();
+        serverId = NetCore::Instance()->CreateController(serverConfig, reinterpret_cast<void*>(ECHO_SERVER_CONTEXT));
+        clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(ECHO_CLIENT_CONTEXT));
+    }
+
+    IChannelListener* CreateFlood(uint32 serviceId, void* context)
+    {
+        size_t index = SERVICE_FLOOD_SMALL == serviceId ? 0 : 1;
+        if (ECHO_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &sinkServers[index];
+        else if (ECHO_CLIENT_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &floodClients[index];
+        return nullptr;
+    }
+
     IChannelListener* CreateEcho(uint32 serviceId, void* context)
     {
         if (ECHO_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
@@ -0,0 +1,203 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Particles/ParticleStorage.h"
+#include "Particles/ParticlePropertyLine.h"
+#include "Particles/Private/ParticleKernels.h"
+
+using namespace DAVA;
+
+namespace ParticleStorageTestDetails
+{
+// not a multiple of SIMD width, so both vectorized and tail parts of kernels are checked
+const uint32 PARTICLES_COUNT = 23;
+
+Particle MakeParticle(uint32 index)
+{
+    Particle particle;
+    particle.life = 0.0f;
+    particle.lifeTime = 1.0f;
+    particle.position = Vector3(static_cast<float32>(index), -static_cast<float32>(index), 0.5f * index);
+    particle.speed = Vector3(1.0f, 2.0f, 3.0f);
+    particle.currSize = Vector2(0.1f * (index + 1), 0.2f * (index + 1));
+    particle.seed = index;
+    return particle;
+}
+
+void FillStorage(ParticleStorage& storage, uint32 count)
+{
+    storage.Clear();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        storage.Add(MakeParticle(i));
+    }
+}
+
+bool IsEqual(float32 a, float32 b)
+{
+    return Abs(a - b) <= 1e-4f * Max(1.0f, Abs(a));
+}
+}
+
+DAVA_TESTCLASS (ParticleStorageTest)
+{
+    DAVA_TEST (AddGetTest)
+    {
+        using namespace ParticleStorageTestDetails;
+
+        ParticleStorage storage;
+        TEST_VERIFY(storage.IsEmpty());
+        FillStorage(storage, PARTICLES_COUNT);
+        TEST_VERIFY(storage.GetCount() == PARTICLES_COUNT);
+
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            Particle expected = MakeParticle(i);
+            Particle particle = storage.Get(i);
+            TEST_VERIFY(particle.seed == expected.seed);
+            TEST_VERIFY(particle.position == expected.position);
+            TEST_VERIFY(particle.speed == expected.speed);
+            TEST_VERIFY(storage.GetSize(i) == expected.currSize);
+        }
+
+        Particle particle = storage.Get(3);
+        particle.angle = 2.0f;
+        storage.Set(3, particle);
+        TEST_VERIFY(storage.angle[3] == 2.0f);
+    }
+
+    DAVA_TEST (RemoveTest)
+    {
+        using namespace ParticleStorageTestDetails;
+
+        ParticleStorage storage;
+        FillStorage(storage, PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; i += 3)
+        {
+            storage.life[i] = storage.lifeTime[i];
+        }
+
+        uint32 deadCount = (PARTICLES_COUNT + 2) / 3;
+        TEST_VERIFY(storage.RemoveDead() == deadCount);
+        TEST_VERIFY(storage.GetCount() == PARTICLES_COUNT - deadCount);
+        for (uint32 i = 0; i < storage.GetCount(); ++i)
+        {
+            TEST_VERIFY(storage.seed[i] % 3 != 0);
+            if (i > 0)
+            {
+                TEST_VERIFY(storage.seed[i - 1] < storage.seed[i]); // order of generation is kept
+            }
+            TEST_VERIFY(storage.positionX[i] == static_cast<float32>(storage.seed[i]));
+        }
+
+        // newest particle always stays
+        FillStorage(storage, 7);
+        TEST_VERIFY(storage.RemoveEverySecond() == 3);
+        TEST_VERIFY(storage.GetCount() == 4);
+        TEST_VERIFY(storage.seed[0] == 0 && storage.seed[1] == 2 && storage.seed[2] == 4 && storage.seed[3] == 6);
+
+        storage.Clear();
+        TEST_VERIFY(storage.IsEmpty());
+        TEST_VERIFY(storage.RemoveDead() == 0);
+    }
+
+    DAVA_TEST (KernelsTest)
+    {
+        using namespace ParticleStorageTestDetails;
+
+        ParticleStorage storage;
+        FillStorage(storage, PARTICLES_COUNT);
+
+        Vector<float32> scale(PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            scale[i] = 0.5f + 0.1f * i;
+        }
+
+        const float32 dt = 0.016f;
+        ParticleKernels::Integrate(storage.positionX.data(), storage.speedX.data(), scale.data(), dt, PARTICLES_COUNT);
+        ParticleKernels::Integrate(storage.positionY.data(), storage.speedY.data(), nullptr, dt, PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            Particle expected = MakeParticle(i);
+            TEST_VERIFY(IsEqual(storage.positionX[i], expected.position.x + expected.speed.x * (scale[i] * dt)));
+            TEST_VERIFY(IsEqual(storage.positionY[i], expected.position.y + expected.speed.y * dt));
+        }
+
+        Vector<float32> overLife(PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            storage.life[i] = 0.03f * i;
+        }
+        ParticleKernels::ComputeOverLife(storage.life.data(), storage.lifeTime.data(), overLife.data(), PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            TEST_VERIFY(IsEqual(overLife[i], storage.life[i] / storage.lifeTime[i]));
+        }
+
+        Vector2 pivotOffset(0.5f, 1.5f);
+        ParticleKernels::ComputeRadius(storage.currSizeX.data(), storage.currSizeY.data(), pivotOffset, storage.currRadius.data(), PARTICLES_COUNT);
+        AABBox3 expectedBox;
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            Vector2 offset(storage.currSizeX[i] * pivotOffset.x, storage.currSizeY[i] * pivotOffset.y);
+            TEST_VERIFY(IsEqual(storage.currRadius[i], offset.Length()));
+
+            Vector3 position = storage.GetPosition(i) + Vector3(1.0f, 0.0f, 0.0f);
+            float32 radius = storage.currRadius[i];
+            expectedBox.AddPoint(position - Vector3(radius, radius, radius));
+            expectedBox.AddPoint(position + Vector3(radius, radius, radius));
+        }
+
+        AABBox3 box;
+        ParticleKernels::AccumulateBBox(storage.positionX.data(), storage.positionY.data(), storage.positionZ.data(), storage.currRadius.data(), Vector3(1.0f, 0.0f, 0.0f), box, PARTICLES_COUNT);
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            TEST_VERIFY(IsEqual(box.min.data[axis], expectedBox.min.data[axis]));
+            TEST_VERIFY(IsEqual(box.max.data[axis], expectedBox.max.data[axis]));
+        }
+
+        // second group with other offset extends box by its own particles only
+        ParticleStorage secondGroup;
+        FillStorage(secondGroup, 3);
+        ParticleKernels::ComputeRadius(secondGroup.currSizeX.data(), secondGroup.currSizeY.data(), pivotOffset, secondGroup.currRadius.data(), 3);
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            Vector3 position = secondGroup.GetPosition(i) + Vector3(0.0f, 100.0f, -50.0f);
+            float32 radius = secondGroup.currRadius[i];
+            expectedBox.AddPoint(position - Vector3(radius, radius, radius));
+            expectedBox.AddPoint(position + Vector3(radius, radius, radius));
+        }
+
+        ParticleKernels::AccumulateBBox(secondGroup.positionX.data(), secondGroup.positionY.data(), secondGroup.positionZ.data(), secondGroup.currRadius.data(), Vector3(0.0f, 100.0f, -50.0f), box, 3);
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            TEST_VERIFY(IsEqual(box.min.data[axis], expectedBox.min.data[axis]));
+            TEST_VERIFY(IsEqual(box.max.data[axis], expectedBox.max.data[axis]));
+        }
+    }
+
+    DAVA_TEST (PropertyLineEvaluateTest)
+    {
+        using namespace ParticleStorageTestDetails;
+
+        RefPtr<PropertyLineKeyframes<float32>> line(new PropertyLineKeyframes<float32>());
+        line->AddValue(0.0f, 1.0f);
+        line->AddValue(0.25f, 3.0f);
+        line->AddValue(0.5f, -2.0f);
+        line->AddValue(1.0f, 0.0f);
+
+        Vector<float32> t(PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            t[i] = -0.1f + 1.2f * i / (PARTICLES_COUNT - 1);
+        }
+        Vector<float32> values(PARTICLES_COUNT);
+        line->Evaluate(t.data(), values.data(), PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            TEST_VERIFY(IsEqual(values[i], line->GetValue(t[i])));
+        }
+        TEST_VERIFY(line->Evaluate(0.25f) == 3.0f);
+    }
+};
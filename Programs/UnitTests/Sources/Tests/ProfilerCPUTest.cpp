@@ -0,0 +1,112 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Debug/ProfilerCPU.h"
+#include "Debug/ProfilerUtils.h"
+#include "Debug/TraceEvent.h"
+#include "Job/JobManager.h"
+
+using namespace DAVA;
+
+namespace ProfilerCPUTestDetails
+{
+const char* OUTER_COUNTER = "ProfilerCPUTest.Outer";
+const char* INNER_COUNTER = "ProfilerCPUTest.Inner";
+const uint32 TASKS_COUNT = 16;
+const uint32 INNER_COUNTERS_PER_TASK = 32;
+
+void ProduceCounters(ProfilerCPU* profiler)
+{
+    DAVA_PROFILER_CPU_SCOPE_CUSTOM_WITH_FRAME_INDEX(OUTER_COUNTER, profiler, 1);
+    for (uint32 i = 0; i < INNER_COUNTERS_PER_TASK; ++i)
+    {
+        DAVA_PROFILER_CPU_SCOPE_CUSTOM(INNER_COUNTER, profiler);
+    }
+}
+
+void ProduceCountersOnWorkers(ProfilerCPU* profiler)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    JobGroup group;
+    for (uint32 i = 0; i < TASKS_COUNT; ++i)
+    {
+        jobManager->CreateWorkerTask([profiler]() { ProduceCounters(profiler); }, &group);
+    }
+    jobManager->WaitWorkerGroup(&group);
+}
+
+uint32 CountEvents(const Vector<TraceEvent>& trace, const char* name)
+{
+    FastName fastName(name);
+    return static_cast<uint32>(std::count_if(trace.begin(), trace.end(), [&fastName](const TraceEvent& e) {
+        return e.name == fastName && e.phase == TraceEvent::PHASE_DURATION;
+    }));
+}
+}
+
+DAVA_TESTCLASS (ProfilerCPUTest)
+{
+    DAVA_TEST (CountersFromSeveralThreadsTest)
+    {
+        using namespace ProfilerCPUTestDetails;
+
+        ProfilerCPU profiler(1024);
+        profiler.Start();
+        ProduceCountersOnWorkers(&profiler);
+        profiler.Stop();
+
+        Vector<TraceEvent> trace = profiler.GetTrace();
+        TEST_VERIFY(CountEvents(trace, OUTER_COUNTER) == TASKS_COUNT);
+        TEST_VERIFY(CountEvents(trace, INNER_COUNTER) == TASKS_COUNT * INNER_COUNTERS_PER_TASK);
+
+        // trace of last counter contains only counters of its own thread
+        Vector<TraceEvent> outerTrace = profiler.GetTrace(OUTER_COUNTER);
+        TEST_VERIFY(CountEvents(outerTrace, OUTER_COUNTER) == 1);
+        TEST_VERIFY(CountEvents(outerTrace, INNER_COUNTER) == INNER_COUNTERS_PER_TASK);
+        for (const TraceEvent& e : outerTrace)
+        {
+            TEST_VERIFY(e.threadID == outerTrace.front().threadID);
+            TEST_VERIFY(e.timestamp >= outerTrace.front().timestamp);
+            TEST_VERIFY(e.timestamp + e.duration <= outerTrace.front().timestamp + outerTrace.front().duration);
+        }
+    }
+
+    DAVA_TEST (CaptureToTraceTest)
+    {
+        using namespace ProfilerCPUTestDetails;
+
+        FilePath capturePath("~doc:/UnitTests/ProfilerCPUTest/capture.dvpc");
+        FilePath jsonPath("~doc:/UnitTests/ProfilerCPUTest/capture.json");
+        FileSystem::Instance()->CreateDirectory(capturePath.GetDirectory(), true);
+
+        ProfilerCPU profiler(4096);
+        profiler.Start();
+        ProduceCounters(&profiler); // counters before capture start are not written
+
+        TEST_VERIFY(profiler.StartCapture(capturePath));
+        TEST_VERIFY(profiler.IsCapturing());
+        ProduceCountersOnWorkers(&profiler);
+        ProduceCounters(&profiler);
+        profiler.Stop();
+        profiler.StopCapture();
+        TEST_VERIFY(profiler.IsCapturing() == false);
+
+        Vector<TraceEvent> trace;
+        TEST_VERIFY(ProfilerUtils::LoadCPUCaptureTrace(capturePath, trace));
+        TEST_VERIFY(CountEvents(trace, OUTER_COUNTER) == TASKS_COUNT + 1);
+        TEST_VERIFY(CountEvents(trace, INNER_COUNTER) == (TASKS_COUNT + 1) * INNER_COUNTERS_PER_TASK);
+
+        for (const TraceEvent& e : trace)
+        {
+            if (e.name == FastName(OUTER_COUNTER))
+            {
+                TEST_VERIFY(e.args.size() == 1 && e.args[0].first == ProfilerCPU::TRACE_ARG_FRAME && e.args[0].second == 1);
+            }
+        }
+
+        TEST_VERIFY(ProfilerUtils::ConvertCPUCaptureToJSON(capturePath, jsonPath));
+        TEST_VERIFY(FileSystem::Instance()->Exists(jsonPath));
+
+        FileSystem::Instance()->DeleteDirectory(capturePath.GetDirectory(), true);
+    }
+};
@@ -0,0 +1,182 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/Highlevel/RenderBatchArray.h"
+
+using namespace DAVA;
+
+namespace RenderBatchArrayTestDetails
+{
+const uint32 OBJECTS_COUNT = 300;
+const uint32 PARENT_MATERIALS_COUNT = 5;
+
+struct TestScene
+{
+    Vector<Matrix4> worldMatrices;
+    Vector<ScopedPtr<RenderObject>> objects;
+    Vector<ScopedPtr<NMaterial>> materials;
+    Vector<RenderBatch*> batches;
+};
+
+float32 MakeDistance(uint32 index, uint32 seed)
+{
+    return 1.0f + static_cast<float32>((index * 7919 + seed * 104729) % 1000) * 0.25f;
+}
+
+void CreateScene(TestScene& scene)
+{
+    for (uint32 i = 0; i < PARENT_MATERIALS_COUNT; ++i)
+    {
+        scene.materials.emplace_back(new NMaterial());
+    }
+
+    scene.worldMatrices.resize(OBJECTS_COUNT);
+    for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+    {
+        ScopedPtr<NMaterial> material(new NMaterial());
+        material->SetParent(scene.materials[i % PARENT_MATERIALS_COUNT]);
+
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        batch->SetMaterial(material);
+        batch->SetSortingKey(i % 3 == 0 ? 10 : 8);
+        batch->SetSortingOffset(i % 32);
+
+        scene.objects.emplace_back(new RenderObject());
+        RenderObject* object = scene.objects.back();
+        object->SetAABBox(AABBox3(Vector3(), 1.0f));
+        object->SetWorldMatrixPtr(&scene.worldMatrices[i]);
+        object->AddRenderBatch(batch);
+        scene.batches.push_back(batch);
+    }
+}
+
+void PlaceObjects(TestScene& scene, uint32 seed)
+{
+    for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+    {
+        scene.worldMatrices[i] = Matrix4::MakeTranslation(Vector3(0.0f, MakeDistance(i, seed), 0.0f));
+        scene.objects[i]->RecalculateWorldBoundingBox();
+    }
+}
+
+void FillArray(RenderBatchArray& array, TestScene& scene, Camera* camera)
+{
+    array.Clear();
+    array.PrepareSorting(camera);
+    for (RenderBatch* batch : scene.batches)
+    {
+        array.AddRenderBatch(batch);
+    }
+}
+
+uint64 GetDistanceKey(RenderBatch* batch)
+{
+    float32 distance = batch->GetRenderObject()->GetWorldMatrixPtr()->GetTranslationVector().y;
+    return static_cast<uint64>(distance * 1000.0f) + 31 - batch->GetSortingOffset();
+}
+
+bool IsSortedBackToFront(const RenderBatchArray& array)
+{
+    for (uint32 i = 1; i < array.GetRenderBatchCount(); ++i)
+    {
+        RenderBatch* prev = array.Get(i - 1);
+        RenderBatch* curr = array.Get(i);
+        if (prev->GetSortingKey() != curr->GetSortingKey())
+        {
+            if (prev->GetSortingKey() < curr->GetSortingKey())
+                return false;
+            continue;
+        }
+
+        if (GetDistanceKey(prev) < GetDistanceKey(curr))
+            return false;
+    }
+    return true;
+}
+
+bool IsGroupedByMaterial(const RenderBatchArray& array)
+{
+    Set<uint64> finishedGroups;
+    for (uint32 i = 1; i < array.GetRenderBatchCount(); ++i)
+    {
+        RenderBatch* prev = array.Get(i - 1);
+        RenderBatch* curr = array.Get(i);
+        uint64 prevGroup = (uint64(prev->GetSortingKey()) << 32) | prev->GetMaterial()->GetSortingKey();
+        uint64 currGroup = (uint64(curr->GetSortingKey()) << 32) | curr->GetMaterial()->GetSortingKey();
+        if (prevGroup != currGroup)
+        {
+            if (prev->GetSortingKey() < curr->GetSortingKey() || finishedGroups.count(currGroup) != 0)
+                return false;
+            finishedGroups.insert(prevGroup);
+        }
+    }
+    return true;
+}
+}
+
+DAVA_TESTCLASS (RenderBatchArrayTest)
+{
+    DAVA_TEST (SortByDistanceTest)
+    {
+        using namespace RenderBatchArrayTestDetails;
+
+        TestScene scene;
+        CreateScene(scene);
+
+        ScopedPtr<Camera> camera(new Camera());
+        camera->SetPosition(Vector3(0.0f, 0.0f, 0.0f));
+        camera->SetDirection(Vector3(0.0f, 1.0f, 0.0f));
+
+        RenderBatchArray array;
+        array.SetSortingFlags(RenderBatchArray::SORT_ENABLED | RenderBatchArray::SORT_BY_DISTANCE_BACK_TO_FRONT);
+
+        PlaceObjects(scene, 0);
+        FillArray(array, scene, camera);
+        array.Sort(camera);
+        TEST_VERIFY(array.GetRenderBatchCount() == OBJECTS_COUNT);
+        TEST_VERIFY(IsSortedBackToFront(array));
+
+        // small movement, the same batches are re-sorted incrementally
+        for (uint32 frame = 0; frame < 3; ++frame)
+        {
+            for (uint32 i = 0; i < OBJECTS_COUNT; i += 7)
+            {
+                scene.worldMatrices[i].SetTranslationVector(scene.worldMatrices[i].GetTranslationVector() + Vector3(0.0f, 0.3f, 0.0f));
+            }
+            FillArray(array, scene, camera);
+            array.Sort(camera);
+            TEST_VERIFY(IsSortedBackToFront(array));
+        }
+
+        // everything moved, keys are computed in `Sort` without prepared camera
+        PlaceObjects(scene, 1);
+        array.Clear();
+        for (RenderBatch* batch : scene.batches)
+        {
+            array.AddRenderBatch(batch);
+        }
+        array.Sort(camera);
+        TEST_VERIFY(array.GetRenderBatchCount() == OBJECTS_COUNT);
+        TEST_VERIFY(IsSortedBackToFront(array));
+    }
+
+    DAVA_TEST (SortByMaterialTest)
+    {
+        using namespace RenderBatchArrayTestDetails;
+
+        TestScene scene;
+        CreateScene(scene);
+        PlaceObjects(scene, 2);
+
+        ScopedPtr<Camera> camera(new Camera());
+        camera->SetPosition(Vector3(0.0f, -10.0f, 0.0f));
+
+        RenderBatchArray array;
+        array.SetSortingFlags(RenderBatchArray::SORT_ENABLED | RenderBatchArray::SORT_BY_MATERIAL);
+        FillArray(array, scene, camera);
+        array.Sort(camera);
+
+        TEST_VERIFY(array.GetRenderBatchCount() == OBJECTS_COUNT);
+        TEST_VERIFY(IsGroupedByMaterial(array));
+    }
+};
@@ -203,6 +203,54 @@ DAVA_TESTCLASS (ResourcePackerTest)
 
         TEST_VERIFY(packer.GetErrors().empty() == false); // should contain error about absence of ".china" tag in allTags
     };
+
+    DAVA_TEST (SubdirectoriesTest)
+    {
+        using namespace DAVA;
+
+        ClearWorkingFolders();
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        {
+            ScopedPtr<File> flagsFile(File::Create(inputDir + "flags.txt", File::CREATE | File::WRITE));
+            flagsFile->WriteLine("--recursive --add2pixel");
+        }
+        for (const String& basename : psdBaseNames)
+        {
+            // every directory is packed by own task
+            FilePath subdir = inputDir + (basename + "/");
+            TEST_VERIFY(fs->CreateDirectory(subdir, true) != FileSystem::DIRECTORY_CANT_CREATE);
+            TEST_VERIFY(fs->CopyFile(resourcesDir + basename + ".psd", subdir + basename + ".psd") == true);
+        }
+        {
+            // own flags of directory are not mixed with flags of directories packed at the same time
+            ScopedPtr<File> flagsFile(File::Create(inputDir + psdBaseNames[0] + "/flags.txt", File::CREATE | File::WRITE));
+            flagsFile->WriteLine("--split");
+        }
+
+        ResourcePacker2D parallelPacker;
+        parallelPacker.InitFolders(inputDir, outputDir);
+        parallelPacker.PackResources({ eGPUFamily::GPU_ORIGIN });
+        TEST_VERIFY(parallelPacker.GetErrors().empty() == true);
+
+        const FilePath sequentialOutputDir = rootDir + "OutputSequential/";
+        ResourcePacker2D sequentialPacker;
+        sequentialPacker.maxParallelTasks = 1;
+        sequentialPacker.forceRepack = true;
+        sequentialPacker.InitFolders(inputDir, sequentialOutputDir);
+        sequentialPacker.PackResources({ eGPUFamily::GPU_ORIGIN });
+        TEST_VERIFY(sequentialPacker.GetErrors().empty() == true);
+
+        for (const String& basename : psdBaseNames)
+        {
+            const String sheetName = (basename == psdBaseNames[0]) ? (basename + "0.png") : "texture0.png"; // split directory names textures after sprites
+            const String subdir = basename + "/";
+
+            TEST_VERIFY(fs->Exists(outputDir + subdir + sheetName) == true);
+            TEST_VERIFY(fs->CompareBinaryFiles(outputDir + subdir + sheetName, sequentialOutputDir + subdir + sheetName) == true);
+            TEST_VERIFY(fs->CompareTextFiles(outputDir + subdir + basename + ".txt", sequentialOutputDir + subdir + basename + ".txt") == true);
+        }
+    }
 };
 
 #endif
@@ -0,0 +1,163 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Highlevel/Mesh.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Scene3D/SceneFileV2.h"
+
+using namespace DAVA;
+
+namespace SceneLoadingTestDetails
+{
+const uint32 ENTITIES_COUNT = 32;
+const int32 GRID_SIZE = 16;
+
+PolygonGroup* CreateGrid(uint32 index)
+{
+    const int32 vertexCount = GRID_SIZE * GRID_SIZE;
+    const int32 indexCount = (GRID_SIZE - 1) * (GRID_SIZE - 1) * 6;
+
+    PolygonGroup* group = new PolygonGroup();
+    group->AllocateData(EVF_VERTEX | EVF_TEXCOORD0, vertexCount, indexCount);
+    group->SetPrimitiveType(rhi::PrimitiveType::PRIMITIVE_TRIANGLELIST);
+
+    float32 offset = static_cast<float32>(index) * 3.0f;
+    for (int32 y = 0; y < GRID_SIZE; ++y)
+    {
+        for (int32 x = 0; x < GRID_SIZE; ++x)
+        {
+            int32 v = y * GRID_SIZE + x;
+            group->SetCoord(v, Vector3(offset + x * 0.1f, y * 0.1f, std::sin(offset + x + y)));
+            group->SetTexcoord(0, v, Vector2(x / float32(GRID_SIZE), y / float32(GRID_SIZE)));
+        }
+    }
+
+    int32 i = 0;
+    for (int32 y = 0; y < GRID_SIZE - 1; ++y)
+    {
+        for (int32 x = 0; x < GRID_SIZE - 1; ++x)
+        {
+            int32 v = y * GRID_SIZE + x;
+            group->SetIndex(i++, v);
+            group->SetIndex(i++, v + 1);
+            group->SetIndex(i++, v + GRID_SIZE);
+            group->SetIndex(i++, v + GRID_SIZE);
+            group->SetIndex(i++, v + 1);
+            group->SetIndex(i++, v + GRID_SIZE + 1);
+        }
+    }
+
+    group->RecalcAABBox();
+    group->BuildBuffers();
+    return group;
+}
+
+void CreateScene(Scene* scene)
+{
+    ScopedPtr<NMaterial> material(new NMaterial());
+    material->SetMaterialName(FastName("SceneLoadingTest"));
+    material->SetFXName(NMaterialName::TEXTURED_OPAQUE);
+
+    for (uint32 i = 0; i < ENTITIES_COUNT; ++i)
+    {
+        ScopedPtr<PolygonGroup> geometry(CreateGrid(i));
+        ScopedPtr<Mesh> mesh(new Mesh());
+        mesh->AddPolygonGroup(geometry, material);
+
+        ScopedPtr<Entity> entity(new Entity());
+        entity->SetName(FastName(Format("mesh_%u", i).c_str()));
+        entity->AddComponent(new RenderComponent(mesh));
+        scene->AddNode(entity);
+    }
+}
+
+Scene* LoadScene(const FilePath& path, bool parallel)
+{
+    Scene* scene = new Scene();
+    ScopedPtr<SceneFileV2> file(new SceneFileV2());
+    file->EnableParallelLoading(parallel);
+    TEST_VERIFY(file->LoadScene(path, scene) == SceneFileV2::ERROR_NO_ERROR);
+    return scene;
+}
+
+PolygonGroup* GetGeometry(Scene* scene, uint32 index)
+{
+    RenderObject* ro = GetRenderObject(scene->GetChild(index));
+    return (ro != nullptr && ro->GetRenderBatchCount() > 0) ? ro->GetRenderBatch(0)->GetPolygonGroup() : nullptr;
+}
+
+bool IsEqualGeometry(PolygonGroup* left, PolygonGroup* right)
+{
+    if (left->GetFormat() != right->GetFormat() || left->GetVertexCount() != right->GetVertexCount() || left->GetIndexCount() != right->GetIndexCount())
+    {
+        return false;
+    }
+
+    if (!(left->GetBoundingBox() == right->GetBoundingBox()))
+    {
+        return false;
+    }
+
+    for (int32 v = 0; v < left->GetVertexCount(); ++v)
+    {
+        Vector3 leftCoord, rightCoord;
+        left->GetCoord(v, leftCoord);
+        right->GetCoord(v, rightCoord);
+        if (leftCoord != rightCoord)
+        {
+            return false;
+        }
+    }
+
+    for (int32 i = 0; i < left->GetIndexCount(); ++i)
+    {
+        int32 leftIndex = 0, rightIndex = 0;
+        left->GetIndex(i, leftIndex);
+        right->GetIndex(i, rightIndex);
+        if (leftIndex != rightIndex)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+}
+
+DAVA_TESTCLASS (SceneLoadingTest)
+{
+    DAVA_TEST (ParallelGeometryLoadingTest)
+    {
+        using namespace SceneLoadingTestDetails;
+
+        FilePath scenePath("~doc:/UnitTests/SceneLoadingTest/geometry.sc2");
+        FileSystem::Instance()->CreateDirectory(scenePath.GetDirectory(), true);
+
+        ScopedPtr<Scene> scene(new Scene());
+        CreateScene(scene);
+        TEST_VERIFY(scene->SaveScene(scenePath) == SceneFileV2::ERROR_NO_ERROR);
+
+        ScopedPtr<Scene> serialScene(LoadScene(scenePath, false));
+        ScopedPtr<Scene> parallelScene(LoadScene(scenePath, true));
+
+        TEST_VERIFY(serialScene->GetChildrenCount() == static_cast<int32>(ENTITIES_COUNT));
+        TEST_VERIFY(parallelScene->GetChildrenCount() == static_cast<int32>(ENTITIES_COUNT));
+        for (uint32 i = 0; i < ENTITIES_COUNT; ++i)
+        {
+            PolygonGroup* original = GetGeometry(scene, i);
+            PolygonGroup* serial = GetGeometry(serialScene, i);
+            PolygonGroup* parallel = GetGeometry(parallelScene, i);
+
+            TEST_VERIFY(serial != nullptr && parallel != nullptr);
+            if (serial != nullptr && parallel != nullptr)
+            {
+                TEST_VERIFY(IsEqualGeometry(original, serial));
+                TEST_VERIFY(IsEqualGeometry(serial, parallel));
+                TEST_VERIFY(parallel->vertexBuffer.IsValid() && parallel->indexBuffer.IsValid());
+            }
+        }
+
+        FileSystem::Instance()->DeleteDirectory(scenePath.GetDirectory(), true);
+    }
+};
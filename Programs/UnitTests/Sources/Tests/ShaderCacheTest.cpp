@@ -0,0 +1,111 @@
+#include "UnitTests/UnitTests.h"
+
+#include <Base/FastName.h>
+#include <Engine/Engine.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Job/JobManager.h>
+#include <Render/RHI/rhi_ShaderCache.h>
+#include <Render/Shader.h>
+#include <Render/ShaderCache.h>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (ShaderCacheTest)
+{
+    const FilePath savedCachePath = "~doc:/ShaderCacheTest/saved.bin";
+    const FilePath testCachePath = "~doc:/ShaderCacheTest/test.bin";
+
+    ShaderCacheTest()
+    {
+        // programs cached by engine are restored when test is finished
+        FileSystem::Instance()->CreateDirectory(savedCachePath.GetDirectory(), true);
+        rhi::ShaderCache::Save(savedCachePath.GetAbsolutePathname().c_str());
+    }
+
+    ~ShaderCacheTest()
+    {
+        rhi::ShaderCache::Load(savedCachePath.GetAbsolutePathname().c_str());
+        FileSystem::Instance()->DeleteDirectory(savedCachePath.GetDirectory());
+    }
+
+    DAVA_TEST (ProgramsTest)
+    {
+        const FastName uid("ShaderCacheTest vSource");
+        const char bin[] = "void main() {}";
+        const uint32 srcHash = 0x1234;
+        const rhi::Api api = rhi::HostApi();
+
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api, uid, srcHash) == false);
+        rhi::ShaderCache::UpdateProgBinary(api, rhi::PROG_VERTEX, uid, bin, sizeof(bin), srcHash);
+
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api, uid, srcHash));
+        // program built from other source or for other api should be rebuilt
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api, uid, srcHash + 1) == false);
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api == rhi::RHI_GLES2 ? rhi::RHI_METAL : rhi::RHI_GLES2, uid, srcHash) == false);
+
+        // stored program is terminated with zero
+        const std::vector<uint8>& prog = rhi::ShaderCache::GetProg(uid);
+        TEST_VERIFY(prog.size() == sizeof(bin) + 1 && prog.back() == 0 && memcmp(prog.data(), bin, sizeof(bin)) == 0);
+
+        // programs survive save and load
+        rhi::ShaderCache::Save(testCachePath.GetAbsolutePathname().c_str());
+        rhi::ShaderCache::Clear();
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api, uid, srcHash) == false);
+        TEST_VERIFY(rhi::ShaderCache::GetProg(uid).empty());
+
+        rhi::ShaderCache::Load(testCachePath.GetAbsolutePathname().c_str());
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api, uid, srcHash));
+        const std::vector<uint8>& loadedProg = rhi::ShaderCache::GetProg(uid);
+        TEST_VERIFY(loadedProg.size() == sizeof(bin) + 1 && loadedProg.back() == 0 && memcmp(loadedProg.data(), bin, sizeof(bin)) == 0);
+
+        // truncated cache file is ignored as a whole
+        Vector<uint8> content;
+        {
+            ScopedPtr<File> file(File::Create(testCachePath, File::OPEN | File::READ));
+            TEST_VERIFY(file);
+            content.resize(static_cast<size_t>(file->GetSize()));
+            file->Read(content.data(), static_cast<uint32>(content.size()));
+        }
+        {
+            ScopedPtr<File> file(File::Create(testCachePath, File::CREATE | File::WRITE));
+            file->Write(content.data(), static_cast<uint32>(content.size() - 1));
+        }
+        rhi::ShaderCache::Load(testCachePath.GetAbsolutePathname().c_str());
+        TEST_VERIFY(rhi::ShaderCache::HasProg(api, uid, srcHash) == false);
+
+        FileSystem::Instance()->DeleteFile(testCachePath);
+    }
+
+    DAVA_TEST (AsyncCompilationTest)
+    {
+        const FastName shaderName("~res:/Materials/Shaders/Default/materials");
+
+        UnorderedMap<FastName, int32> defines;
+        defines[FastName("SHADER_CACHE_TEST_ASYNC")] = 1;
+
+        ShaderDescriptorCache::SetAsyncCompilationEnabled(true);
+        ShaderDescriptor* shader = ShaderDescriptorCache::GetShaderDescriptor(shaderName, defines);
+        ShaderDescriptorCache::SetAsyncCompilationEnabled(false);
+
+        TEST_VERIFY(shader != nullptr);
+        // new variant is compiled in worker job and can't be used until it is finished,
+        // variant which sources were cached by previous run is compiled right away
+        if (shader->IsPending())
+        {
+            TEST_VERIFY(GetEngineContext()->jobManager->GetWorkersCount() > 0);
+            TEST_VERIFY(shader->IsValid() == false);
+        }
+
+        ShaderDescriptorCache::CompletePendingShader(shader);
+        TEST_VERIFY(shader->IsPending() == false);
+        TEST_VERIFY(ShaderDescriptorCache::GetShaderDescriptor(shaderName, defines) == shader);
+
+        // finished variant is compiled the same way as synchronously compiled one
+        defines[FastName("SHADER_CACHE_TEST_ASYNC")] = 2;
+        ShaderDescriptor* syncShader = ShaderDescriptorCache::GetShaderDescriptor(shaderName, defines);
+        TEST_VERIFY(syncShader != shader);
+        TEST_VERIFY(syncShader->IsPending() == false);
+        TEST_VERIFY(syncShader->IsValid() == shader->IsValid());
+    }
+};
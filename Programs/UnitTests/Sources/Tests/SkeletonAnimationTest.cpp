@@ -0,0 +1,223 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Animation/AnimationChannel.h"
+#include "Animation/AnimationChannelEncoder.h"
+#include "Scene3D/SkeletonAnimation/JointTransform.h"
+#include "Scene3D/SkeletonAnimation/SkeletonPose.h"
+
+using namespace DAVA;
+
+namespace SkeletonAnimationTestDetails
+{
+// not a multiple of SIMD width, so both vectorized and tail parts of blending are checked
+const uint32 JOINTS_COUNT = 13;
+
+JointTransform MakeTransform(uint32 index, float32 angle)
+{
+    JointTransform transform;
+    if (index % 5 != 4)
+    {
+        transform.SetPosition(Vector3(float32(index), 2.f * angle, -0.5f * index));
+        Quaternion orientation = Quaternion::MakeRotation(Vector3(1.f, float32(index), 0.5f), angle + 0.3f * index);
+        orientation.Normalize();
+        transform.SetOrientation(orientation);
+    }
+    if (index % 3 == 0)
+    {
+        transform.SetScale(1.f + 0.1f * index);
+    }
+    return transform;
+}
+
+bool IsEqual(float32 a, float32 b)
+{
+    return Abs(a - b) <= 1e-4f;
+}
+
+bool IsEqual(const JointTransform& t0, const JointTransform& t1)
+{
+    if (t0.HasPosition() != t1.HasPosition() || t0.HasOrientation() != t1.HasOrientation() || t0.HasScale() != t1.HasScale())
+        return false;
+
+    const Vector3& p0 = t0.GetPosition();
+    const Vector3& p1 = t1.GetPosition();
+    if (!IsEqual(p0.x, p1.x) || !IsEqual(p0.y, p1.y) || !IsEqual(p0.z, p1.z) || !IsEqual(t0.GetScale(), t1.GetScale()))
+        return false;
+
+    //q and -q are the same rotation
+    const Quaternion& q0 = t0.GetOrientation();
+    const Quaternion& q1 = t1.GetOrientation();
+    float32 sign = (q0.DotProduct(q1) < 0.f) ? -1.f : 1.f;
+    return IsEqual(q0.x, sign * q1.x) && IsEqual(q0.y, sign * q1.y) && IsEqual(q0.z, sign * q1.z) && IsEqual(q0.w, sign * q1.w);
+}
+
+void AppendData(Vector<uint8>& buffer, const void* data, uint32 size)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+}
+
+DAVA_TESTCLASS (SkeletonAnimationTest)
+{
+    DAVA_TEST (PoseLerpTest)
+    {
+        using namespace SkeletonAnimationTestDetails;
+
+        SkeletonPose pose0(JOINTS_COUNT), pose1(JOINTS_COUNT);
+        for (uint32 j = 0; j < JOINTS_COUNT; ++j)
+        {
+            pose0.SetTransform(j, MakeTransform(j, 0.2f));
+            // some joints have different components in poses
+            pose1.SetTransform(j, MakeTransform((j == 7) ? j + 1 : j, 2.5f));
+        }
+
+        const float32 factor = 0.35f;
+        SkeletonPose result = pose0;
+        result.Lerp(pose1, factor);
+
+        TEST_VERIFY(result.GetJointsCount() == JOINTS_COUNT);
+        for (uint32 j = 0; j < JOINTS_COUNT; ++j)
+        {
+            JointTransform expected = JointTransform::Lerp(pose0.GetJointTransform(j), pose1.GetJointTransform(j), factor);
+            TEST_VERIFY(IsEqual(result.GetJointTransform(j), expected));
+        }
+    }
+
+    DAVA_TEST (PoseOverrideTest)
+    {
+        using namespace SkeletonAnimationTestDetails;
+
+        SkeletonPose pose0(JOINTS_COUNT), pose1;
+        for (uint32 j = 0; j < JOINTS_COUNT; ++j)
+        {
+            pose0.SetTransform(j, MakeTransform(j, 0.2f));
+        }
+        pose1.SetScale(2, 5.f);
+        pose1.SetPosition(JOINTS_COUNT + 1, Vector3(1.f, 2.f, 3.f));
+
+        SkeletonPose result = pose0;
+        result.Override(pose1);
+
+        TEST_VERIFY(result.GetJointsCount() == JOINTS_COUNT + 2);
+        for (uint32 j = 0; j < JOINTS_COUNT; ++j)
+        {
+            JointTransform expected = JointTransform::Override(pose0.GetJointTransform(j), pose1.GetJointTransform(j));
+            TEST_VERIFY(IsEqual(result.GetJointTransform(j), expected));
+        }
+        TEST_VERIFY(result.GetJointTransform(2).GetScale() == 5.f);
+        TEST_VERIFY(result.GetJointTransform(JOINTS_COUNT + 1).HasPosition());
+        TEST_VERIFY(result.GetJointTransform(JOINTS_COUNT).IsEmpty());
+    }
+
+    DAVA_TEST (ChannelCursorTest)
+    {
+        using namespace SkeletonAnimationTestDetails;
+
+        const uint32 keysCount = 9;
+        const uint8 dimension = 3;
+
+        Vector<uint8> buffer;
+        uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+        AppendData(buffer, &signature, sizeof(uint32));
+        buffer.push_back(dimension);
+        buffer.push_back(AnimationChannel::INTERPOLATION_LINEAR);
+        uint16 compression = 0;
+        AppendData(buffer, &compression, sizeof(uint16));
+        AppendData(buffer, &keysCount, sizeof(uint32));
+        for (uint32 k = 0; k < keysCount; ++k)
+        {
+            float32 key[dimension + 1] = { 0.25f * k, float32(k), float32(k * k), -float32(k) };
+            AppendData(buffer, key, sizeof(key));
+        }
+
+        AnimationChannel channel;
+        TEST_VERIFY(channel.Bind(buffer.data()) == uint32(buffer.size()));
+        TEST_VERIFY(channel.GetDimension() == dimension);
+
+        // two independent cursors on the same channel: one plays forward, another one jumps back and forth
+        uint32 forwardCursor = 0, jumpingCursor = 0;
+        for (uint32 step = 0; step < 50; ++step)
+        {
+            float32 forwardTime = -0.1f + 0.05f * step;
+            float32 jumpingTime = (step % 2) ? 2.2f - 0.03f * step : 0.07f * step;
+
+            float32 expected[dimension], forward[dimension], jumping[dimension];
+
+            channel.Evaluate(forwardTime, expected, dimension);
+            channel.Evaluate(forwardTime, forward, dimension, forwardCursor);
+            for (uint32 d = 0; d < dimension; ++d)
+                TEST_VERIFY(IsEqual(forward[d], expected[d]));
+
+            channel.Evaluate(jumpingTime, expected, dimension);
+            channel.Evaluate(jumpingTime, jumping, dimension, jumpingCursor);
+            for (uint32 d = 0; d < dimension; ++d)
+                TEST_VERIFY(IsEqual(jumping[d], expected[d]));
+        }
+
+        float32 value[dimension];
+        channel.Evaluate(0.3f, value, dimension);
+        TEST_VERIFY(IsEqual(value[0], 1.2f) && IsEqual(value[1], 1.6f) && IsEqual(value[2], -1.2f));
+    }
+
+    DAVA_TEST (ChannelCompressionTest)
+    {
+        using namespace SkeletonAnimationTestDetails;
+
+        // densely sampled curves, as importers produce them
+        const uint32 samplesCount = 121;
+        const float32 samplesStep = 1.f / 30.f;
+        AnimationChannelEncoder positionEncoder(3, AnimationChannel::INTERPOLATION_LINEAR);
+        AnimationChannelEncoder orientationEncoder(4, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+        for (uint32 s = 0; s < samplesCount; ++s)
+        {
+            float32 time = s * samplesStep;
+            Vector3 position(std::sin(time), (time < 2.f) ? time : 2.f, 5.f);
+            positionEncoder.AddKey(time, position.data);
+
+            Quaternion orientation = Quaternion::MakeRotation(Vector3(0.f, 0.f, 1.f), 0.5f * time);
+            orientationEncoder.AddKey(time, orientation.data);
+        }
+
+        const float32 tolerance = 1e-3f;
+        for (uint16 compression : { AnimationChannel::COMPRESSION_NONE, AnimationChannel::COMPRESSION_QUANTIZED_16 })
+        {
+            Vector<uint8> positionData, orientationData;
+            positionEncoder.Encode(positionData, tolerance, AnimationChannel::eCompression(compression));
+            orientationEncoder.Encode(orientationData, tolerance, AnimationChannel::eCompression(compression));
+
+            // raw format takes 4 bytes for time and for every component of every sample
+            uint32 rawSizeRatio = (compression == AnimationChannel::COMPRESSION_NONE) ? 2 : 4;
+            TEST_VERIFY(positionData.size() * rawSizeRatio < samplesCount * 4 * 4);
+            TEST_VERIFY(orientationData.size() * rawSizeRatio < samplesCount * 5 * 4);
+            TEST_VERIFY(positionData.size() % 4 == 0 && orientationData.size() % 4 == 0);
+
+            AnimationChannel positionChannel, orientationChannel;
+            TEST_VERIFY(positionChannel.Bind(positionData.data()) == uint32(positionData.size()));
+            TEST_VERIFY(orientationChannel.Bind(orientationData.data()) == uint32(orientationData.size()));
+            TEST_VERIFY(positionChannel.GetKeysCount() < samplesCount / 2);
+            // rotation with constant speed (less than half turn) is restored from the first and the last keys
+            TEST_VERIFY(orientationChannel.GetKeysCount() == 2);
+
+            // error of quantization is about 1/65535 of value range
+            const float32 maxError = 2.f * tolerance;
+            uint32 cursor = 0;
+            for (uint32 s = 0; s < samplesCount; ++s)
+            {
+                float32 time = s * samplesStep;
+
+                float32 position[3];
+                positionChannel.Evaluate(time, position, 3, cursor);
+                TEST_VERIFY(Abs(position[0] - std::sin(time)) < maxError);
+                TEST_VERIFY(Abs(position[1] - ((time < 2.f) ? time : 2.f)) < maxError);
+                TEST_VERIFY(Abs(position[2] - 5.f) < maxError);
+
+                Quaternion orientation;
+                orientationChannel.Evaluate(time, orientation.data, 4);
+                Quaternion expected = Quaternion::MakeRotation(Vector3(0.f, 0.f, 1.f), 0.5f * time);
+                TEST_VERIFY(Abs(Abs(orientation.DotProduct(expected)) - 1.f) < maxError);
+            }
+        }
+    }
+};
@@ -1,6 +1,7 @@
 #include "DAVAEngine.h"
 
 #include "UI/UIControl.h"
+#include "UI/UIScreen.h"
 #include "UI/Layouts/UILayoutSystem.h"
 #include "UI/Layouts/UIAnchorComponent.h"
 #include "UI/Layouts/UISizePolicyComponent.h"
@@ -55,4 +56,95 @@ DAVA_TESTCLASS (UILayoutSystemTest)
         SafeRelease(parent);
         SafeRelease(child);
     }
+
+    DAVA_TEST (IncrementalLayout_RelayoutsOnlyDirtyAndResizedSubtrees)
+    {
+        UIControl* screen = MakeRoot("screen");
+        screen->SetSize(Vector2(200.0f, 200.0f));
+
+        UIControl* panel = MakeChild(screen, "panel");
+        UIAnchorComponent* panelAnchor = panel->GetOrCreateComponent<UIAnchorComponent>();
+        panelAnchor->SetLeftAnchorEnabled(true);
+        panelAnchor->SetRightAnchorEnabled(true);
+
+        UIControl* item = MakeChild(panel, "item");
+        UIAnchorComponent* itemAnchor = item->GetOrCreateComponent<UIAnchorComponent>();
+        itemAnchor->SetLeftAnchorEnabled(true);
+        itemAnchor->SetRightAnchorEnabled(true);
+
+        UIControl* label = MakeChild(screen, "label");
+        label->SetSize(Vector2(10.0f, 10.0f));
+
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+        layoutSystem->ProcessHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(item->GetSize().x, 200.0f, 0.01f));
+        TEST_VERIFY(!screen->IsLayoutSubtreeDirty());
+        TEST_VERIFY(!panel->IsLayoutSubtreeDirty());
+
+        // only path to changed control is marked
+        label->SetSize(Vector2(20.0f, 10.0f));
+        TEST_VERIFY(label->IsLayoutSubtreeDirty());
+        TEST_VERIFY(screen->IsLayoutSubtreeDirty());
+        TEST_VERIFY(!panel->IsLayoutSubtreeDirty());
+
+        // panel subtree is clean, but panel is resized, so its children are laid out again
+        screen->SetSize(Vector2(300.0f, 200.0f));
+        layoutSystem->ProcessHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(panel->GetSize().x, 300.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(item->GetSize().x, 300.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(label->GetSize().x, 20.0f, 0.01f));
+        TEST_VERIFY(!screen->IsLayoutSubtreeDirty());
+
+        SafeRelease(screen);
+        SafeRelease(panel);
+        SafeRelease(item);
+        SafeRelease(label);
+    }
+
+    DAVA_TEST (FullLayout_RelayoutsScreenAndPopupsOnRtlChange)
+    {
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+        RefPtr<UIScreen> prevScreen = layoutSystem->currentScreen;
+        RefPtr<UIControl> prevPopupContainer = layoutSystem->popupContainer;
+        bool prevRtl = layoutSystem->IsRtl();
+
+        RefPtr<UIScreen> screen(new UIScreen());
+        screen->SetSize(Vector2(200.0f, 200.0f));
+        RefPtr<UIControl> popupContainer(MakeRoot("popupContainer"));
+        popupContainer->SetSize(Vector2(200.0f, 200.0f));
+
+        UIControl* screenItem = MakeChild(screen.Get(), "screenItem");
+        UIControl* popupItem = MakeChild(popupContainer.Get(), "popupItem");
+        for (UIControl* item : { screenItem, popupItem })
+        {
+            item->SetSize(Vector2(20.0f, 20.0f));
+            UIAnchorComponent* anchor = item->GetOrCreateComponent<UIAnchorComponent>();
+            anchor->SetLeftAnchorEnabled(true);
+            anchor->SetLeftAnchor(10.0f);
+            anchor->SetUseRtl(true);
+        }
+
+        layoutSystem->SetRtl(false);
+        layoutSystem->SetCurrentScreen(screen);
+        layoutSystem->SetPopupContainer(popupContainer);
+        layoutSystem->SetDirty();
+        layoutSystem->Process(0.0f);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(screenItem->GetPosition().x, 10.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(popupItem->GetPosition().x, 10.0f, 0.01f));
+
+        // rtl is applied to the whole screen and to opened popups in the same frame
+        layoutSystem->SetRtl(true);
+        layoutSystem->SetDirty();
+        layoutSystem->Process(0.0f);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(screenItem->GetPosition().x, 170.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(popupItem->GetPosition().x, 170.0f, 0.01f));
+        TEST_VERIFY(!layoutSystem->fullLayoutRequired);
+
+        layoutSystem->SetRtl(prevRtl);
+        layoutSystem->SetCurrentScreen(prevScreen);
+        layoutSystem->SetPopupContainer(prevPopupContainer);
+
+        SafeRelease(screenItem);
+        SafeRelease(popupItem);
+    }
 };
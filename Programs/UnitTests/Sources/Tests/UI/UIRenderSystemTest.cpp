@@ -0,0 +1,185 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/2D/Systems/RenderSystem2D.h"
+#include "UI/Render/UIRenderSystem.h"
+#include "UI/UIControlBackground.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIRenderSystemTest)
+{
+    // Vertex color which is never written by test controls, it stays in batches until they are rebuilt
+    const uint32 MARKER_COLOR = 0x12345678;
+
+    UIRenderSystem* renderSystem = nullptr;
+    RefPtr<UIScreen> screen;
+    RefPtr<UIControl> parent;
+    RefPtr<UIControl> child1;
+    RefPtr<UIControl> child2;
+
+    RefPtr<UIControl> MakeControl(UIControl * parentControl, const Rect& rect)
+    {
+        RefPtr<UIControl> control(new UIControl(rect));
+        UIControlBackground* bg = control->GetOrCreateComponent<UIControlBackground>();
+        bg->SetDrawType(UIControlBackground::DRAW_FILL);
+        bg->SetColor(Color(0.5f, 0.5f, 0.5f, 1.0f));
+        parentControl->AddControl(control.Get());
+        return control;
+    }
+
+    void SetUp(const String& testName) override
+    {
+        renderSystem = GetEngineContext()->uiControlSystem->GetRenderSystem();
+        renderSystem->SetRetainedBatchesEnabled(true);
+
+        screen = RefPtr<UIScreen>(new UIScreen());
+        parent = MakeControl(screen.Get(), Rect(10.0f, 10.0f, 100.0f, 100.0f));
+        child1 = MakeControl(parent.Get(), Rect(0.0f, 0.0f, 20.0f, 20.0f));
+        child2 = MakeControl(parent.Get(), Rect(50.0f, 50.0f, 20.0f, 20.0f));
+
+        GetEngineContext()->uiControlSystem->SetScreen(screen.Get());
+        GetEngineContext()->uiControlSystem->Update();
+    }
+
+    void TearDown(const String& testName) override
+    {
+        GetEngineContext()->uiControlSystem->Reset();
+        renderSystem->SetRetainedBatchesEnabled(true);
+
+        child1 = nullptr;
+        child2 = nullptr;
+        parent = nullptr;
+        screen = nullptr;
+    }
+
+    void Render()
+    {
+        renderSystem->Render();
+        // Drop batched geometry, test is run outside of frame
+        RenderSystem2D::Instance()->Flush();
+    }
+
+    RetainedBatches2D* GetBatches(UIControl * control)
+    {
+        auto it = renderSystem->retainedBackgrounds.find(control->GetComponent<UIControlBackground>());
+        return it != renderSystem->retainedBackgrounds.end() ? &it->second.batches : nullptr;
+    }
+
+    void MarkBatches()
+    {
+        for (UIControl* control : { parent.Get(), child1.Get(), child2.Get() })
+        {
+            RetainedBatches2D* batches = GetBatches(control);
+            TEST_VERIFY(batches != nullptr && batches->replayable && !batches->vertices.empty());
+            if (batches != nullptr)
+            {
+                for (BatchVertex2D& v : batches->vertices)
+                {
+                    v.color = MARKER_COLOR;
+                }
+            }
+        }
+    }
+
+    bool IsRebuilt(UIControl * control)
+    {
+        RetainedBatches2D* batches = GetBatches(control);
+        return batches != nullptr && !batches->vertices.empty() && batches->vertices.front().color != MARKER_COLOR;
+    }
+
+    DAVA_TEST (UnchangedControlsAreNotRebuilt)
+    {
+        Render();
+        MarkBatches();
+
+        Render();
+        TEST_VERIFY(!IsRebuilt(parent.Get()));
+        TEST_VERIFY(!IsRebuilt(child1.Get()));
+        TEST_VERIFY(!IsRebuilt(child2.Get()));
+
+        // single fill is kept in one range
+        RetainedBatches2D* batches = GetBatches(child1.Get());
+        TEST_VERIFY(batches->ranges.size() == 1);
+        TEST_VERIFY(batches->vertices.size() == 4 && batches->indices.size() == 6);
+    }
+
+    DAVA_TEST (ChangedGeometryIsRebuilt)
+    {
+        Render();
+        MarkBatches();
+
+        child1->SetPosition(Vector2(5.0f, 5.0f));
+        Render();
+        TEST_VERIFY(IsRebuilt(child1.Get()));
+        TEST_VERIFY(!IsRebuilt(child2.Get()));
+        TEST_VERIFY(!IsRebuilt(parent.Get()));
+
+        MarkBatches();
+        child2->SetSize(Vector2(30.0f, 30.0f));
+        Render();
+        TEST_VERIFY(!IsRebuilt(child1.Get()));
+        TEST_VERIFY(IsRebuilt(child2.Get()));
+        TEST_VERIFY(!IsRebuilt(parent.Get()));
+    }
+
+    DAVA_TEST (ChangedParentTransformRebuildsSubtree)
+    {
+        Render();
+        MarkBatches();
+
+        parent->SetPosition(Vector2(20.0f, 10.0f));
+        Render();
+        TEST_VERIFY(IsRebuilt(parent.Get()));
+        TEST_VERIFY(IsRebuilt(child1.Get()));
+        TEST_VERIFY(IsRebuilt(child2.Get()));
+
+        MarkBatches();
+        parent->SetScale(Vector2(2.0f, 2.0f));
+        Render();
+        TEST_VERIFY(IsRebuilt(parent.Get()));
+        TEST_VERIFY(IsRebuilt(child1.Get()));
+        TEST_VERIFY(IsRebuilt(child2.Get()));
+    }
+
+    DAVA_TEST (ChangedBackgroundIsRebuilt)
+    {
+        Render();
+        MarkBatches();
+
+        child2->GetComponent<UIControlBackground>()->SetColor(Color(1.0f, 0.0f, 0.0f, 1.0f));
+        Render();
+        TEST_VERIFY(!IsRebuilt(child1.Get()));
+        TEST_VERIFY(IsRebuilt(child2.Get()));
+        TEST_VERIFY(!IsRebuilt(parent.Get()));
+
+        MarkBatches();
+        child1->GetComponent<UIControlBackground>()->SetDrawType(UIControlBackground::DRAW_FILL);
+        parent->GetComponent<UIControlBackground>()->SetModification(ESM_HFLIP);
+        Render();
+        TEST_VERIFY(!IsRebuilt(child1.Get()));
+        TEST_VERIFY(!IsRebuilt(child2.Get()));
+        TEST_VERIFY(IsRebuilt(parent.Get()));
+    }
+
+    DAVA_TEST (InvisibleControlsAreReleased)
+    {
+        Render();
+        TEST_VERIFY(GetBatches(child1.Get()) != nullptr);
+
+        child1->SetVisibilityFlag(false);
+        TEST_VERIFY(GetBatches(child1.Get()) == nullptr);
+        Render();
+        TEST_VERIFY(GetBatches(child1.Get()) == nullptr);
+
+        UIControlBackground* bg = child2->GetComponent<UIControlBackground>();
+        TEST_VERIFY(renderSystem->retainedBackgrounds.count(bg) == 1);
+        child2->RemoveComponent(bg);
+        TEST_VERIFY(renderSystem->retainedBackgrounds.count(bg) == 0);
+
+        renderSystem->SetRetainedBatchesEnabled(false);
+        TEST_VERIFY(renderSystem->retainedBackgrounds.empty());
+        Render();
+        TEST_VERIFY(renderSystem->retainedBackgrounds.empty());
+    }
+};
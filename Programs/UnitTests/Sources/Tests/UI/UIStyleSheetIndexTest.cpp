@@ -0,0 +1,49 @@
+#include "DAVAEngine.h"
+
+#include "UI/UIControl.h"
+#include "UI/Styles/UIStyleSheet.h"
+#include "UI/Styles/UIStyleSheetIndex.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIStyleSheetIndexTest)
+{
+    DAVA_TEST (CollectCandidatesTest)
+    {
+        const char* selectors[] = { "#button", ".red", "UIStaticText", "UIControl .blue", ".global", "#label", "UIControl ?" };
+
+        Vector<UIPriorityStyleSheet> sortedStyleSheets;
+        for (const char* selector : selectors)
+        {
+            RefPtr<UIStyleSheet> styleSheet(new UIStyleSheet());
+            styleSheet->SetSelectorChain(UIStyleSheetSelectorChain(selector));
+            sortedStyleSheets.push_back(UIPriorityStyleSheet(styleSheet.Get()));
+        }
+
+        UIStyleSheetIndex index;
+        index.Build(sortedStyleSheets);
+
+        RefPtr<UIControl> control(new UIControl());
+        control->SetName("button");
+        control->AddClass(FastName("red"));
+
+        UIStyleSheetClassSet globalClasses;
+        globalClasses.AddClass(FastName("global"));
+        globalClasses.AddClass(FastName("red"));
+
+        // selector with any control goes to unkeyed list, "red" is both local and global
+        Vector<uint32> candidates;
+        index.CollectCandidates(control.Get(), globalClasses, candidates);
+        TEST_VERIFY((candidates == Vector<uint32>{ 6, 4, 1, 0 }));
+
+        control->SetName("label");
+        control->RemoveClass(FastName("red"));
+        index.CollectCandidates(control.Get(), UIStyleSheetClassSet(), candidates);
+        TEST_VERIFY((candidates == Vector<uint32>{ 6, 5 }));
+
+        TEST_VERIFY(index.IsClassUsed(FastName("blue")));
+        TEST_VERIFY(!index.IsClassUsed(FastName("green")));
+    }
+};
@@ -7,6 +7,7 @@ namespace DAVA
 uint32 AnimationChannel::Bind(const uint8* _data)
 {
     keysData = nullptr;
+    quantization = nullptr;
     dimension = 0;
     keyStride = keysCount = 0;
 
@@ -27,66 +28,136 @@ uint32 AnimationChannel::Bind(const uint8* _data)
         keysCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
-        keysData = dataptr;
+        if (compression == COMPRESSION_NONE)
+        {
+            keyStride = uint32(sizeof(float32)) * (dimension + 1);
+            if (interpolation == INTERPOLATION_BEZIER)
+                keyStride += uint32(sizeof(float32) * 4); //four float32 as tangents
+        }
+        else if (compression == COMPRESSION_QUANTIZED_16 && interpolation != INTERPOLATION_BEZIER)
+        {
+            quantization = reinterpret_cast<const float32*>(dataptr);
+            dataptr += sizeof(float32) * (2 + 2 * dimension);
+
+            keyStride = uint32(sizeof(uint16)) * (dimension + 1);
+        }
+        else
+        {
+            DVASSERT(false, "Unsupported animation channel compression");
+            return 0;
+        }
 
-        keyStride = uint32(sizeof(float32)) * (dimension + 1);
-        if (interpolation == INTERPOLATION_BEZIER)
-            keyStride += uint32(sizeof(float32) * 4); //four float32 as tangents
+        keysData = dataptr;
+    }
+    else
+    {
+        return 0;
     }
 
-    return uint32(keysData - _data) + keysCount * keyStride;
+    //keep next data aligned
+    uint32 keysDataSize = (keysCount * keyStride + 3) & ~3u;
+    return uint32(keysData - _data) + keysDataSize;
 }
 
 #define KEY_DATA_SIZE (dimension * sizeof(float32))
-#define KEY_TIME(keyIndex) (*reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride))
 #define KEY_DATA(keyIndex) (reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride + sizeof(float32)))
 #define KEY_META(keyIndex) (KEY_DATA(keyIndex) + KEY_DATA_SIZE) //tangents for bezier interpolation
+#define QUANTIZED_KEY(keyIndex) (reinterpret_cast<const uint16*>(keysData + (keyIndex)*keyStride))
+
+inline float32 AnimationChannel::GetKeyTime(uint32 key) const
+{
+    if (compression == COMPRESSION_NONE)
+        return *reinterpret_cast<const float32*>(keysData + key * keyStride);
+
+    return quantization[0] + quantization[1] * float32(QUANTIZED_KEY(key)[0]);
+}
+
+inline void AnimationChannel::GetKeyData(uint32 key, float32* outData) const
+{
+    if (compression == COMPRESSION_NONE)
+    {
+        Memcpy(outData, KEY_DATA(key), KEY_DATA_SIZE);
+        return;
+    }
+
+    const uint16* values = QUANTIZED_KEY(key) + 1;
+    const float32* valuesMin = quantization + 2;
+    const float32* valuesScale = valuesMin + dimension;
+    for (uint32 d = 0; d < uint32(dimension); ++d)
+        outData[d] = valuesMin[d] + valuesScale[d] * float32(values[d]);
+}
 
 void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize) const
 {
     DVASSERT(dataSize >= GetDimension());
 
+    //first key with time greater than `time`
+    uint32 begin = 0, end = keysCount;
+    while (begin < end)
+    {
+        uint32 middle = (begin + end) / 2;
+        if (GetKeyTime(middle) > time)
+            end = middle;
+        else
+            begin = middle + 1;
+    }
+
+    Interpolate(begin, time, outData);
+}
+
+void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize, uint32& startKey) const
+{
+    DVASSERT(dataSize >= GetDimension());
+
     uint32 k = startKey;
 
-    if (KEY_TIME(k) > time)
+    if (k >= keysCount || GetKeyTime(k) > time)
     {
         k = 0;
     }
 
     for (; k < keysCount; ++k)
     {
-        if (KEY_TIME(k) > time)
+        if (GetKeyTime(k) > time)
             break;
 
         startKey = k;
     }
 
-    if (k == 0)
-    {
-        Memcpy(outData, KEY_DATA(0), KEY_DATA_SIZE);
-        return;
-    }
+    Interpolate(k, time, outData);
+}
 
-    if (k == keysCount)
+void AnimationChannel::Interpolate(uint32 k, float32 time, float32* outData) const
+{
+    if (k == 0 || k == keysCount)
     {
-        Memcpy(outData, KEY_DATA(keysCount - 1), KEY_DATA_SIZE);
+        GetKeyData((k == 0) ? 0 : keysCount - 1, outData);
+        if (interpolation == INTERPOLATION_SPHERICAL_LINEAR && compression != COMPRESSION_NONE)
+        {
+            //quantized orientation isn't exactly unit
+            Quaternion q(outData);
+            q.Normalize();
+            Memcpy(outData, q.data, KEY_DATA_SIZE);
+        }
         return;
     }
 
     uint32 k0 = k - 1;
-    float32 time0 = KEY_TIME(k0);
-    float32 time1 = KEY_TIME(k);
+    float32 time0 = GetKeyTime(k0);
+    float32 time1 = GetKeyTime(k);
     float32 t = (time - time0) / (time1 - time0);
 
     switch (interpolation)
     {
     case INTERPOLATION_LINEAR:
     {
+        float32 v0[4], v1[4];
+        DVASSERT(dimension <= 4);
+        GetKeyData(k0, v0);
+        GetKeyData(k, v1);
         for (uint32 d = 0; d < uint32(dimension); ++d)
         {
-            float32 v0 = *(KEY_DATA(k0) + d);
-            float32 v1 = *(KEY_DATA(k) + d);
-            *(outData + d) = Lerp(v0, v1, t);
+            *(outData + d) = Lerp(v0[d], v1[d], t);
         }
     }
     break;
@@ -95,8 +166,9 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
     {
         DVASSERT(dimension == 4); //should be quaternion
 
-        Quaternion q0(KEY_DATA(k0));
-        Quaternion q(KEY_DATA(k));
+        Quaternion q0, q;
+        GetKeyData(k0, q0.data);
+        GetKeyData(k, q.data);
         q.Slerp(q0, q, t);
         q.Normalize();
 
@@ -116,7 +188,7 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
 }
 
 #undef KEY_DATA_SIZE
-#undef KEY_TIME
+#undef QUANTIZED_KEY
 #undef KEY_DATA
 #undef KEY_META
 }
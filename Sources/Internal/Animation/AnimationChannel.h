@@ -18,16 +18,37 @@ public:
         INTERPOLATION_COUNT
     };
 
+    enum eCompression : uint16
+    {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_QUANTIZED_16, //key times and values are 16-bit offsets from per-channel minimum
+
+        COMPRESSION_COUNT
+    };
+
     AnimationChannel() = default;
 
     uint32 Bind(const uint8* data);
+
+    /** Evaluate channel at `time`, keys are found with binary search. */
     void Evaluate(float32 time, float32* outData, uint32 dataSize) const;
 
+    /**
+        Evaluate channel at `time` searching keys forward from `startKey` and update it, which is faster for playback.
+        Cursor is kept by caller, so the same channel may be evaluated by several animations and threads at once.
+    */
+    void Evaluate(float32 time, float32* outData, uint32 dataSize, uint32& startKey) const;
+
     uint32 GetDimension() const;
+    uint32 GetKeysCount() const;
 
 private:
+    float32 GetKeyTime(uint32 key) const;
+    void GetKeyData(uint32 key, float32* outData) const;
+    void Interpolate(uint32 key, float32 time, float32* outData) const;
+
     const DAVA::uint8* keysData = nullptr;
-    mutable uint32 startKey = 0;
+    const float32* quantization = nullptr; //time min, time scale, values min[dimension], values scale[dimension]
     uint32 keysCount = 0;
     uint32 keyStride = 0;
     uint16 compression = 0;
@@ -39,4 +60,9 @@ inline uint32 AnimationChannel::GetDimension() const
 {
     return uint32(dimension);
 }
+
+inline uint32 AnimationChannel::GetKeysCount() const
+{
+    return keysCount;
+}
 }
\ No newline at end of file
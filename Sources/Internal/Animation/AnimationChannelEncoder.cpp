@@ -0,0 +1,224 @@
+#include "Animation/AnimationChannelEncoder.h"
+#include "Base/BaseMath.h"
+#include "Debug/DVAssert.h"
+
+#include <cmath>
+
+namespace DAVA
+{
+namespace AnimationChannelEncoderDetails
+{
+const float32 QUANTIZATION_MAX = 65535.f;
+
+template <class T>
+void WriteToBuffer(Vector<uint8>& buffer, const T* value, uint32 count = 1)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+}
+
+uint16 Quantize(float32 value, float32 min, float32 scale)
+{
+    if (scale <= 0.f)
+        return 0;
+
+    float32 quantized = std::floor((value - min) / scale + 0.5f);
+    return uint16(Clamp(quantized, 0.f, QUANTIZATION_MAX));
+}
+}
+
+AnimationChannelEncoder::AnimationChannelEncoder(uint32 dimension_, AnimationChannel::eInterpolation interpolation_)
+    : dimension(dimension_)
+    , interpolation(interpolation_)
+{
+    DVASSERT(dimension > 0 && dimension <= 4);
+    DVASSERT(interpolation != AnimationChannel::INTERPOLATION_BEZIER, "Bezier keys aren't supported by encoder");
+    DVASSERT(interpolation != AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR || dimension == 4);
+}
+
+void AnimationChannelEncoder::AddKey(float32 time, const float32* data)
+{
+    DVASSERT(times.empty() || times.back() < time);
+
+    times.push_back(time);
+    values.insert(values.end(), data, data + dimension);
+}
+
+float32 AnimationChannelEncoder::GetDefaultTolerance(AnimationTrack::eChannelTarget target)
+{
+    switch (target)
+    {
+    case AnimationTrack::CHANNEL_TARGET_POSITION:
+        return 1e-3f;
+    case AnimationTrack::CHANNEL_TARGET_ORIENTATION:
+        return 2e-4f;
+    case AnimationTrack::CHANNEL_TARGET_SCALE:
+        return 5e-4f;
+    default:
+        return 0.f;
+    }
+}
+
+float32 AnimationChannelEncoder::GetInterpolationError(uint32 key0, uint32 key1, uint32 key) const
+{
+    float32 t = (times[key] - times[key0]) / (times[key1] - times[key0]);
+    const float32* v0 = values.data() + key0 * dimension;
+    const float32* v1 = values.data() + key1 * dimension;
+    const float32* v = values.data() + key * dimension;
+
+    float32 error = 0.f;
+    if (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        //same as `AnimationChannel` does
+        Quaternion q0(v0);
+        Quaternion q(v1);
+        q.Slerp(q0, q, t);
+        q.Normalize();
+
+        //q and -q are the same rotation
+        float32 sign = (q.DotProduct(Quaternion(v)) < 0.f) ? -1.f : 1.f;
+        for (uint32 d = 0; d < 4; ++d)
+            error = Max(error, Abs(q.data[d] * sign - v[d]));
+    }
+    else
+    {
+        for (uint32 d = 0; d < dimension; ++d)
+            error = Max(error, Abs(Lerp(v0[d], v1[d], t) - v[d]));
+    }
+
+    return error;
+}
+
+Vector<uint32> AnimationChannelEncoder::ReduceKeys(float32 tolerance) const
+{
+    uint32 keysCount = GetKeysCount();
+
+    Vector<uint32> keys;
+    if (keysCount == 0)
+        return keys;
+
+    //greedy: every segment is extended while skipped keys are restored within tolerance
+    uint32 segmentStart = 0;
+    keys.push_back(segmentStart);
+    while (segmentStart + 1 < keysCount)
+    {
+        uint32 segmentEnd = segmentStart + 1;
+        while (segmentEnd + 1 < keysCount)
+        {
+            uint32 candidate = segmentEnd + 1;
+            bool fits = true;
+            for (uint32 k = segmentStart + 1; k < candidate && fits; ++k)
+                fits = (GetInterpolationError(segmentStart, candidate, k) <= tolerance);
+
+            if (!fits)
+                break;
+
+            segmentEnd = candidate;
+        }
+
+        keys.push_back(segmentEnd);
+        segmentStart = segmentEnd;
+    }
+
+    //constant channel
+    if (keys.size() == 2)
+    {
+        float32 error = 0.f;
+        for (uint32 d = 0; d < dimension; ++d)
+            error = Max(error, Abs(values[keys[0] * dimension + d] - values[keys[1] * dimension + d]));
+
+        if (error <= tolerance)
+            keys.pop_back();
+    }
+
+    return keys;
+}
+
+void AnimationChannelEncoder::Encode(Vector<uint8>& buffer, float32 tolerance, AnimationChannel::eCompression compression) const
+{
+    using namespace AnimationChannelEncoderDetails;
+
+    DVASSERT(compression == AnimationChannel::COMPRESSION_NONE || compression == AnimationChannel::COMPRESSION_QUANTIZED_16);
+
+    Vector<uint32> keys = ReduceKeys(tolerance);
+
+    float32 quantization[2 + 2 * 4] = {};
+    if (compression == AnimationChannel::COMPRESSION_QUANTIZED_16 && !keys.empty())
+    {
+        float32 timeMin = times[keys.front()];
+        float32 timeScale = (times[keys.back()] - timeMin) / QUANTIZATION_MAX;
+
+        //keys closer than quantization step of time are merged
+        Vector<uint32> uniqueKeys;
+        uint16 lastTime = 0;
+        for (uint32 key : keys)
+        {
+            uint16 quantizedTime = Quantize(times[key], timeMin, timeScale);
+            if (uniqueKeys.empty() || quantizedTime > lastTime)
+            {
+                uniqueKeys.push_back(key);
+                lastTime = quantizedTime;
+            }
+        }
+        keys.swap(uniqueKeys);
+
+        quantization[0] = timeMin;
+        quantization[1] = timeScale;
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            float32 valueMin = std::numeric_limits<float32>::max();
+            float32 valueMax = -std::numeric_limits<float32>::max();
+            for (uint32 key : keys)
+            {
+                valueMin = Min(valueMin, values[key * dimension + d]);
+                valueMax = Max(valueMax, values[key * dimension + d]);
+            }
+
+            quantization[2 + d] = valueMin;
+            quantization[2 + dimension + d] = (valueMax - valueMin) / QUANTIZATION_MAX;
+        }
+    }
+
+    uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+    uint8 channelDimension = uint8(dimension);
+    uint8 channelInterpolation = uint8(interpolation);
+    uint16 channelCompression = uint16(compression);
+    uint32 keysCount = uint32(keys.size());
+
+    uint32 channelStart = uint32(buffer.size());
+    WriteToBuffer(buffer, &signature);
+    WriteToBuffer(buffer, &channelDimension);
+    WriteToBuffer(buffer, &channelInterpolation);
+    WriteToBuffer(buffer, &channelCompression);
+    WriteToBuffer(buffer, &keysCount);
+
+    if (compression == AnimationChannel::COMPRESSION_QUANTIZED_16)
+    {
+        WriteToBuffer(buffer, quantization, 2 + 2 * dimension);
+
+        const float32* valuesMin = quantization + 2;
+        const float32* valuesScale = valuesMin + dimension;
+        for (uint32 key : keys)
+        {
+            uint16 quantizedKey[1 + 4];
+            quantizedKey[0] = Quantize(times[key], quantization[0], quantization[1]);
+            for (uint32 d = 0; d < dimension; ++d)
+                quantizedKey[1 + d] = Quantize(values[key * dimension + d], valuesMin[d], valuesScale[d]);
+
+            WriteToBuffer(buffer, quantizedKey, 1 + dimension);
+        }
+    }
+    else
+    {
+        for (uint32 key : keys)
+        {
+            WriteToBuffer(buffer, &times[key]);
+            WriteToBuffer(buffer, &values[key * dimension], dimension);
+        }
+    }
+
+    //keep next data aligned
+    uint32 channelSize = uint32(buffer.size()) - channelStart;
+    buffer.resize(buffer.size() + ((4 - (channelSize & 0x3)) & 0x3), 0);
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Animation/AnimationChannel.h"
+#include "Animation/AnimationTrack.h"
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Builds channel data in format described in 'AnimationBinaryFormat.md' from sampled keys.
+    Keys which are restored by interpolation of kept neighbours within `tolerance` are removed,
+    remaining keys may be quantized to 16 bits (`COMPRESSION_QUANTIZED_16`), which adds up to half of
+    quantization step (1/65535 of value range) to the error.
+    Used by offline importers, runtime reads result with `AnimationChannel`.
+*/
+class AnimationChannelEncoder
+{
+public:
+    AnimationChannelEncoder(uint32 dimension, AnimationChannel::eInterpolation interpolation);
+
+    /** Add key with `dimension` values. Keys should be added in increasing order of time. */
+    void AddKey(float32 time, const float32* data);
+    uint32 GetKeysCount() const;
+
+    /** Append encoded channel (starting with signature) to `buffer`. */
+    void Encode(Vector<uint8>& buffer, float32 tolerance, AnimationChannel::eCompression compression) const;
+
+    /** Default max error of key reduction for channel `target` values. */
+    static float32 GetDefaultTolerance(AnimationTrack::eChannelTarget target);
+
+private:
+    Vector<uint32> ReduceKeys(float32 tolerance) const;
+    float32 GetInterpolationError(uint32 key0, uint32 key1, uint32 key) const;
+
+    Vector<float32> times;
+    Vector<float32> values; //`dimension` values per key
+    uint32 dimension = 0;
+    AnimationChannel::eInterpolation interpolation = AnimationChannel::INTERPOLATION_LINEAR;
+};
+
+inline uint32 AnimationChannelEncoder::GetKeysCount() const
+{
+    return uint32(times.size());
+}
+}
@@ -47,6 +47,12 @@ void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, ui
     channels[channel].channel.Evaluate(time, outData, dataSize);
 }
 
+void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize, uint32& startKey) const
+{
+    DVASSERT(channel < GetChannelsCount());
+    channels[channel].channel.Evaluate(time, outData, dataSize, startKey);
+}
+
 uint32 AnimationTrack::GetChannelsCount() const
 {
     return uint32(channels.size());
@@ -20,6 +20,8 @@ public:
 
     uint32 Bind(const uint8* data);
     void Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize) const;
+    /** Evaluate `channel` using caller's key cursor, see `AnimationChannel::Evaluate`. */
+    void Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize, uint32& startKey) const;
 
     uint32 GetChannelsCount() const;
     eChannelTarget GetChannelTarget(uint32 channel) const;
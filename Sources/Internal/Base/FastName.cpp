@@ -5,6 +5,24 @@
 
 namespace DAVA
 {
+FastNameDB::Table::Table(size_t capacity_)
+    : capacity(capacity_)
+    , slots(new Slot[capacity_])
+{
+    DVASSERT((capacity & (capacity - 1)) == 0);
+}
+
+FastNameDB::FastNameDB()
+{
+    for (Shard& shard : shards)
+    {
+        shard.tables.emplace_back(new Table(INITIAL_SHARD_CAPACITY));
+        shard.table = shard.tables.back().get();
+    }
+}
+
+FastNameDB::~FastNameDB() = default;
+
 FastNameDB* FastNameDB::GetLocalDB()
 {
     return *GetLocalDBPtr();
@@ -29,38 +47,145 @@ void FastNameDB::SetMasterDB(FastNameDB* db)
     *localDBPtr = db;
 }
 
-void FastName::Init(const char* name)
+size_t FastNameDB::GetNamesCount() const
 {
-    DVASSERT(nullptr != name);
+    return namesCount.load(std::memory_order_relaxed);
+}
+
+size_t FastNameDB::MixHash(size_t hash)
+{
+    // DavaHashString has weak low bits, spread them before selecting shard and slot
+    uint64 h = static_cast<uint64>(hash);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+const FastNameDB::CharT* FastNameDB::Find(const Table* table, size_t hash, const CharT* name)
+{
+    const size_t mask = table->capacity - 1;
+    for (size_t i = (hash / SHARDS_COUNT) & mask;; i = (i + 1) & mask)
+    {
+        const Slot& slot = table->slots[i];
+        const CharT* str = slot.str.load(std::memory_order_acquire);
+        if (nullptr == str)
+        {
+            return nullptr;
+        }
+
+        if (slot.hash.load(std::memory_order_relaxed) == hash && 0 == strcmp(str, name))
+        {
+            return str;
+        }
+    }
+}
+
+const FastNameDB::CharT* FastNameDB::Intern(const CharT* name)
+{
+    const size_t hash = MixHash(DavaHashString(name));
+    Shard& shard = shards[hash % SHARDS_COUNT];
+
+    // fast path: name is already interned, table is never full so search always terminates
+    const CharT* str = Find(shard.table.load(std::memory_order_acquire), hash, name);
+    if (nullptr != str)
+    {
+        return str;
+    }
+
+    return Insert(shard, hash, name);
+}
 
-    FastNameDB* db = FastNameDB::GetLocalDB();
-    LockGuard<FastNameDB::MutexT> guard(db->mutex);
+const FastNameDB::CharT* FastNameDB::Insert(Shard& shard, size_t hash, const CharT* name)
+{
+    LockGuard<MutexT> guard(shard.mutex);
 
-    // search if that name is already in hash
-    auto it = db->nameToIndexMap.find(name);
-    if (it != db->nameToIndexMap.end())
+    // name could be added by other thread or table could be grown since lock-free search
+    Table* table = shard.table.load(std::memory_order_relaxed);
+    const CharT* str = Find(table, hash, name);
+    if (nullptr != str)
     {
-        // already exist, so we just need to set the same index to this object
-        str = db->namesTable[it->second];
+        return str;
     }
-    else
+
+    // keep load factor below 1/2
+    if ((shard.count + 1) * 2 > table->capacity)
     {
-        // string isn't in hash and it isn't in names table, so we need to copy it
-        // and find place for copied string in names table and set it
-        size_t nameLen = strlen(name);
-        FastNameDB::CharT* nameCopy = new FastNameDB::CharT[nameLen + 1];
-        memcpy(nameCopy, name, nameLen + 1);
+        Table* newTable = new Table(table->capacity * 2);
+        for (size_t i = 0; i < table->capacity; ++i)
+        {
+            const Slot& slot = table->slots[i];
+            const CharT* slotStr = slot.str.load(std::memory_order_relaxed);
+            if (nullptr != slotStr)
+            {
+                InsertToTable(newTable, slot.hash.load(std::memory_order_relaxed), slotStr);
+            }
+        }
+
+        shard.tables.emplace_back(newTable);
+        shard.table.store(newTable, std::memory_order_release);
+        table = newTable;
+    }
 
-        db->sizeOfNames += (nameLen * sizeof(FastNameDB::CharT));
+    // string isn't interned yet, so we need to copy it into arena
+    const size_t nameLen = strlen(name);
+    CharT* nameCopy = AllocateString(shard, nameLen);
+    memcpy(nameCopy, name, nameLen + 1);
 
-        // index will be a new row in names table
-        size_t index = db->namesTable.size();
+    InsertToTable(table, hash, nameCopy);
+    shard.count++;
 
-        db->namesTable.push_back(nameCopy);
-        db->nameToIndexMap.emplace(nameCopy, index);
+    namesCount.fetch_add(1, std::memory_order_relaxed);
+    sizeOfNames.fetch_add(nameLen * sizeof(CharT), std::memory_order_relaxed);
 
-        str = nameCopy;
+    return nameCopy;
+}
+
+FastNameDB::CharT* FastNameDB::AllocateString(Shard& shard, size_t length)
+{
+    const size_t size = length + 1;
+    if (size > ARENA_BLOCK_SIZE / 4)
+    {
+        // long names get own block, current block stays available for short ones
+        shard.arenaBlocks.emplace_back(new CharT[size]);
+        return shard.arenaBlocks.back().get();
     }
+
+    if (size > shard.arenaLeft)
+    {
+        shard.arenaBlocks.emplace_back(new CharT[ARENA_BLOCK_SIZE]);
+        shard.arenaCurrent = shard.arenaBlocks.back().get();
+        shard.arenaLeft = ARENA_BLOCK_SIZE;
+    }
+
+    CharT* result = shard.arenaCurrent;
+    shard.arenaCurrent += size;
+    shard.arenaLeft -= size;
+    return result;
+}
+
+void FastNameDB::InsertToTable(Table* table, size_t hash, const CharT* str)
+{
+    const size_t mask = table->capacity - 1;
+    for (size_t i = (hash / SHARDS_COUNT) & mask;; i = (i + 1) & mask)
+    {
+        Slot& slot = table->slots[i];
+        if (nullptr == slot.str.load(std::memory_order_relaxed))
+        {
+            // hash should be visible to readers that see the string
+            slot.hash.store(hash, std::memory_order_relaxed);
+            slot.str.store(str, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void FastName::Init(const char* name)
+{
+    DVASSERT(nullptr != name);
+    str = FastNameDB::GetLocalDB()->Intern(name);
 }
 
 template <>
@@ -5,8 +5,19 @@
 #include "Base/Any.h"
 #include "Concurrency/Spinlock.h"
 
+#include <atomic>
+#include <memory>
+
 namespace DAVA
 {
+/**
+    Storage of strings interned by `FastName`.
+
+    Names are distributed between `SHARDS_COUNT` shards by hash. Every shard has open addressing hash table
+    and append-only arena with string copies. Lookup of an existing name reads table without any locks,
+    only insertion of a new name takes lock of a single shard. Interned strings are never moved or freed
+    while database is alive, so `FastName` can keep raw pointer and compare names by pointer.
+*/
 class FastNameDB final
 {
     friend class FastName;
@@ -18,45 +29,58 @@ public:
     static FastNameDB* GetLocalDB();
     void SetMasterDB(FastNameDB* masterDB);
 
+    /** Return count of interned names. */
+    size_t GetNamesCount() const;
+
 private:
-    FastNameDB()
-        : nameToIndexMap(8192 * 2)
-    {
-        namesTable.reserve(512);
-    }
+    static const size_t SHARDS_COUNT = 64;
+    static const size_t INITIAL_SHARD_CAPACITY = 512;
+    static const size_t ARENA_BLOCK_SIZE = 16 * 1024;
 
-    ~FastNameDB()
+    struct Slot
     {
-        const size_t count = namesTable.size();
-        for (size_t i = 0; i < count; ++i)
-        {
-            SafeDeleteArray(namesTable[i]);
-        }
-    }
-
-    static FastNameDB** GetLocalDBPtr();
+        std::atomic<const CharT*> str{ nullptr };
+        std::atomic<size_t> hash{ 0 };
+    };
 
-    struct FastNameDBHash
+    struct Table
     {
-        size_t operator()(const char* str) const
-        {
-            return DavaHashString(str);
-        }
+        explicit Table(size_t capacity);
+
+        size_t capacity = 0;
+        std::unique_ptr<Slot[]> slots;
     };
 
-    struct FastNameDBEqualTo
+    struct Shard
     {
-        bool operator()(const char* left, const char* right) const
-        {
-            return (0 == strcmp(left, right));
-        }
+        std::atomic<Table*> table{ nullptr };
+        size_t count = 0;
+
+        // Tables are retired instead of deleted because readers can still use them
+        Vector<std::unique_ptr<Table>> tables;
+
+        Vector<std::unique_ptr<CharT[]>> arenaBlocks;
+        CharT* arenaCurrent = nullptr;
+        size_t arenaLeft = 0;
+
+        MutexT mutex;
     };
 
-    Vector<const CharT*> namesTable;
-    UnorderedMap<const CharT*, size_t, FastNameDBHash, FastNameDBEqualTo> nameToIndexMap;
+    FastNameDB();
+    ~FastNameDB();
+
+    static FastNameDB** GetLocalDBPtr();
+    static size_t MixHash(size_t hash);
+    static const CharT* Find(const Table* table, size_t hash, const CharT* name);
+
+    const CharT* Intern(const CharT* name);
+    const CharT* Insert(Shard& shard, size_t hash, const CharT* name);
+    CharT* AllocateString(Shard& shard, size_t length);
+    void InsertToTable(Table* table, size_t hash, const CharT* str);
 
-    MutexT mutex;
-    size_t sizeOfNames = 0;
+    Array<Shard, SHARDS_COUNT> shards;
+    std::atomic<size_t> namesCount{ 0 };
+    std::atomic<size_t> sizeOfNames{ 0 };
 };
 
 class FastName
@@ -1,4 +1,5 @@
 #include "CommandLine/CommandLineParser.h"
+#include "Concurrency/ThreadLocalPtr.h"
 #include "Logger/Logger.h"
 
 #include "Engine/Engine.h"
@@ -17,21 +18,41 @@ CommandLineParser::CommandLineParser()
 {
 }
 
+ThreadLocalPtr<Vector<CommandLineParser::Flag>> CommandLineParser::threadFlags;
+
+CommandLineParser::ScopedFlags::ScopedFlags(const Vector<String>& arguments)
+{
+    Vector<Flag>* scopedFlags = new Vector<Flag>();
+    ParseFlags(arguments, *scopedFlags);
+
+    prevFlags = threadFlags.Release();
+    threadFlags.Reset(scopedFlags);
+}
+
+CommandLineParser::ScopedFlags::~ScopedFlags()
+{
+    threadFlags.Reset(prevFlags);
+}
+
 void CommandLineParser::SetFlags(const Vector<String>& tokens)
 {
     ClearFlags();
+    ParseFlags(tokens, flags);
+}
 
+void CommandLineParser::ParseFlags(const Vector<String>& tokens, Vector<Flag>& parsedFlags)
+{
     for (auto& token : tokens)
     {
         if ((token.length() >= 1) && (token[0] == '-'))
         {
-            flags.emplace_back(token);
+            parsedFlags.emplace_back(token);
         }
         else
         {
-            if (!flags.empty())
+            if (!parsedFlags.empty())
             {
-                flags.back().params.push_back(token);
+                parsedFlags.back().params.push_back(token);
             }
             else
             {
@@ -41,6 +62,12 @@ void CommandLineParser::SetFlags(const Vector<String>& tokens)
     }
 }
 
+const Vector<CommandLineParser::Flag>& CommandLineParser::GetCurrentFlags() const
+{
+    const Vector<Flag>* scopedFlags = threadFlags.Get();
+    return (scopedFlags != nullptr) ? *scopedFlags : flags;
+}
+
 void CommandLineParser::ClearFlags()
 {
     flags.clear();
@@ -82,7 +109,7 @@ CommandLineParser::~CommandLineParser()
 
 bool CommandLineParser::IsFlagSet(const String& s) const
 {
-    for (auto& flag : flags)
+    for (auto& flag : GetCurrentFlags())
     {
         if (flag.name == s)
             return true;
@@ -103,7 +130,7 @@ String CommandLineParser::GetParamForFlag(const String& flag)
 
 Vector<String> CommandLineParser::GetParamsForFlag(const String& flagname)
 {
-    for (auto& flag : flags)
+    for (auto& flag : GetCurrentFlags())
     {
         if (flag.name == flagname)
             return flag.params;
@@ -6,9 +6,32 @@
 
 namespace DAVA
 {
+template <typename T>
+class ThreadLocalPtr;
+
 class CommandLineParser : public StaticSingleton<CommandLineParser>
 {
+    struct Flag;
+
 public:
+    /**
+        Override flags for the current thread while object is alive.
+        Lets several flag sets be processed concurrently, e.g. when directories with own flags.txt
+        are packed by different threads. Scopes can be nested, previous flags are restored on destruction.
+    */
+    class ScopedFlags final
+    {
+    public:
+        explicit ScopedFlags(const Vector<String>& arguments);
+        ~ScopedFlags();
+
+    private:
+        ScopedFlags(const ScopedFlags&) = delete;
+        ScopedFlags& operator=(const ScopedFlags&) = delete;
+
+        Vector<Flag>* prevFlags = nullptr;
+    };
+
     CommandLineParser();
     virtual ~CommandLineParser();
 
@@ -50,10 +73,15 @@ private:
         Vector<String> params;
     };
 
+    static void ParseFlags(const Vector<String>& tokens, Vector<Flag>& parsedFlags);
+    const Vector<Flag>& GetCurrentFlags() const;
+
     Vector<Flag> flags;
     bool isVerbose;
     bool isExtendedOutput;
     bool useTeamcityOutput;
+
+    static ThreadLocalPtr<Vector<Flag>> threadFlags;
 };
 }
 
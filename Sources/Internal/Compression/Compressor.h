@@ -20,6 +20,8 @@ public:
     virtual bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
     // you should resize output to correct size before call this method
     virtual bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
+    // decompress `inSize` bytes into preallocated `out` buffer of exactly original size, without intermediate copies
+    virtual bool Decompress(const uint8* in, size_t inSize, uint8* out, size_t outSize) const = 0;
 };
 
 } // end namespace DAVA
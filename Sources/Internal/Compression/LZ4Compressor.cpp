@@ -31,8 +31,14 @@ bool LZ4Compressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
 
 bool LZ4Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
 {
-    int32 decompressResult = LZ4_decompress_fast(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), static_cast<uint32>(out.size()));
-    if (decompressResult < 0)
+    return Decompress(in.data(), in.size(), out.data(), out.size());
+}
+
+bool LZ4Compressor::Decompress(const uint8* in, size_t inSize, uint8* out, size_t outSize) const
+{
+    // input may come straight from mapped pack file, so it must not be read beyond inSize even if data is damaged
+    int32 decompressResult = LZ4_decompress_safe(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out), static_cast<int32>(inSize), static_cast<int32>(outSize));
+    if (decompressResult < 0 || static_cast<size_t>(decompressResult) != outSize)
     {
         Logger::Error("LZ4 decompress failed");
         return false;
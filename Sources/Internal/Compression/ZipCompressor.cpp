@@ -75,6 +75,23 @@ bool ZipCompressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) cons
     return true;
 }
 
+bool ZipCompressor::Decompress(const uint8* in, size_t inSize, uint8* out, size_t outSize) const
+{
+    if (inSize > static_cast<size_t>(std::numeric_limits<uLong>::max()))
+    {
+        Logger::Error("too big input buffer for uncompress rfc1951");
+        return false;
+    }
+    uLong uncompressedSize = static_cast<uLong>(outSize);
+    int32 decompressResult = uncompress(out, &uncompressedSize, in, static_cast<uLong>(inSize));
+    if (decompressResult != Z_OK || uncompressedSize != outSize)
+    {
+        Logger::Error("can't uncompress rfc1951 buffer");
+        return false;
+    }
+    return true;
+}
+
 class ZipPrivateData
 {
 public:
@@ -17,6 +17,7 @@ public:
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
     // you should resize output to correct size before call this method
     bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, size_t inSize, uint8* out, size_t outSize) const override;
 };
 
 class ZipFile final
@@ -6,6 +6,7 @@
 #include "FileSystem/FileAPIHelper.h"
 #include "DLCManager/DLCDownloader.h"
 #include "Utils/CRC32.h"
+#include "Concurrency/LockGuard.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
 #include "Time/SystemTimer.h"
@@ -354,6 +355,11 @@ void DLCManagerImpl::ClearResouces()
     retryCount = 0;
 
     scanFileReady.clear();
+    scanFileFromIndex.clear();
+    {
+        LockGuard<Mutex> lock(localFileIndexMutex);
+        localFileIndex.Close();
+    }
 
     lastProgress.alreadyDownloaded = 0;
     lastProgress.inQueue = 0;
@@ -520,6 +526,7 @@ void DLCManagerImpl::Initialize(const FilePath& dirToDownloadPacks_,
         localCacheMeta = dirToDownloadPacks_ + "local_copy_server_meta.meta";
         localCacheFileTable = dirToDownloadPacks_ + "local_copy_server_file_table.block";
         localCacheFooter = dirToDownloadPacks_ + "local_copy_server_footer.footer";
+        localFileIndexPath = dirToDownloadPacks_ + "local_files.index";
         urlToSuperPack = urlToServerSuperpack_;
         hints = hints_;
 
@@ -735,9 +742,9 @@ PackRequest* DLCManagerImpl::AddDelayedRequest(const String& requestedPackName)
     return delayedRequests.back();
 }
 
-void DLCManagerImpl::RemoveDownloadedFileIndexes(Vector<uint32>& packIndexes) const
+void DLCManagerImpl::RemoveDownloadedFileIndexes(Vector<uint32>& packIndexes)
 {
-    const auto removeIt = remove_if(begin(packIndexes), end(packIndexes), [&](uint32 index) { return IsFileReady(index); });
+    const auto removeIt = remove_if(begin(packIndexes), end(packIndexes), [&](uint32 index) { return VerifyFileIsReady(index); });
     packIndexes.erase(removeIt, end(packIndexes));
 }
 
@@ -1391,6 +1398,7 @@ void DLCManagerImpl::LoadPacksDataFromMeta()
 
         const size_t numFiles = metaRemote->GetFileCount();
         scanFileReady.resize(numFiles);
+        scanFileFromIndex.resize(numFiles);
 
         // now user can do requests for local packs
         requestManager.reset(new RequestManager(*this));
@@ -1724,6 +1732,8 @@ void DLCManagerImpl::RemovePack(const String& requestedPackName)
                         }
                     }
                     scanFileReady[index] = false; // clear flag anyway
+                    scanFileFromIndex[index] = false;
+                    AppendToLocalFileIndex(index, false);
                 }
             }
             String errMsg = undeletedFiles.str();
@@ -2212,14 +2222,24 @@ void DLCManagerImpl::ScanFiles(const FilePath& dir, Vector<LocalFileInfo>& files
 void DLCManagerImpl::ThreadScanFunc()
 {
     Thread* thisThread = Thread::Current();
-    // scan files in download dir
     const int64 startTime = SystemTimer::GetMs();
 
-    ScanFiles(dirToDownloadedPacks, localFiles);
-
-    const int64 finishScan = SystemTimer::GetMs() - startTime;
+    // restore downloaded files from local file index, scan files in download dir only if there is no index
+    uint32 indexFilesTableCrc32 = 0;
+    Vector<LocalFileIndex::Record> indexedFiles;
+    bool hasIndex = LocalFileIndex::Read(localFileIndexPath, indexFilesTableCrc32, indexedFiles);
+    if (hasIndex)
+    {
+        const int64 finishRead = SystemTimer::GetMs() - startTime;
+        Logger::Info("finish read local file index for: %fsec total files: %ld", finishRead / 1000.f, indexedFiles.size());
+    }
+    else
+    {
+        ScanFiles(dirToDownloadedPacks, localFiles);
 
-    Logger::Info("finish scan files for: %fsec total files: %ld", finishScan / 1000.f, localFiles.size());
+        const int64 finishScan = SystemTimer::GetMs() - startTime;
+        Logger::Info("finish scan files for: %fsec total files: %ld", finishScan / 1000.f, localFiles.size());
+    }
 
     if (thisThread->IsCancelling())
     {
@@ -2237,6 +2257,44 @@ void DLCManagerImpl::ThreadScanFunc()
         return;
     }
 
+    if (hasIndex && indexFilesTableCrc32 != initFooterOnServer.info.filesTableCrc32)
+    {
+        // files on server changed, so file indexes in local index are meaningless
+        Logger::Info("local file index is outdated, scan files");
+        hasIndex = false;
+        ScanFiles(dirToDownloadedPacks, localFiles);
+    }
+
+    if (thisThread->IsCancelling())
+    {
+        return;
+    }
+
+    if (hasIndex)
+    {
+        MergeIndexedFilesWithMeta(indexedFiles);
+    }
+    else
+    {
+        MergeScannedFilesWithMeta();
+    }
+
+    if (thisThread->IsCancelling())
+    {
+        return;
+    }
+
+    RewriteLocalFileIndex();
+
+    DAVA::RunOnMainThreadAsync([this]()
+                               {
+                                   // finish thread
+                                   scanState = ScanState::Done;
+                               });
+}
+
+void DLCManagerImpl::MergeScannedFilesWithMeta()
+{
     // merge with meta
     // Yes! is pack loaded before meta
     const PackFormat::PackFile& pack = GetPack();
@@ -2246,11 +2304,6 @@ void DLCManagerImpl::ThreadScanFunc()
 
     String relativeNameWithoutDvpl;
 
-    if (thisThread->IsCancelling())
-    {
-        return;
-    }
-
     FileSystem* fs = GetEngineContext()->fileSystem;
 
     for (const LocalFileInfo& info : localFiles)
@@ -2279,16 +2332,92 @@ void DLCManagerImpl::ThreadScanFunc()
         }
     }
 
-    if (thisThread->IsCancelling())
+    localFiles.clear();
+    localFiles.shrink_to_fit();
+}
+
+void DLCManagerImpl::MergeIndexedFilesWithMeta(const Vector<LocalFileIndex::Record>& indexedFiles)
+{
+    // files on device are not checked here, it's done lazily by VerifyFileIsReady when file is requested
+    const Vector<PackFormat::FileTableEntry>& files = GetPack().filesTable.data.files;
+
+    for (const LocalFileIndex::Record& record : indexedFiles)
     {
-        return;
+        if (record.fileIndex < files.size())
+        {
+            const PackFormat::FileTableEntry& entry = files[record.fileIndex];
+            if (entry.compressedCrc32 == record.compressedCrc32 && entry.compressedSize == record.compressedSize)
+            {
+                SetFileIsReady(record.fileIndex, record.compressedSize);
+                scanFileFromIndex[record.fileIndex] = true;
+            }
+        }
     }
+}
 
-    DAVA::RunOnMainThreadAsync([this]()
-                               {
-                                   // finish thread
-                                   scanState = ScanState::Done;
-                               });
+void DLCManagerImpl::RewriteLocalFileIndex()
+{
+    const Vector<PackFormat::FileTableEntry>& files = GetPack().filesTable.data.files;
+
+    Vector<LocalFileIndex::Record> readyFiles;
+    for (size_t fileIndex = 0; fileIndex < scanFileReady.size(); ++fileIndex)
+    {
+        if (scanFileReady[fileIndex])
+        {
+            LocalFileIndex::Record record;
+            record.fileIndex = static_cast<uint32>(fileIndex);
+            record.compressedSize = files[fileIndex].compressedSize;
+            record.compressedCrc32 = files[fileIndex].compressedCrc32;
+            record.isReady = 1;
+            readyFiles.push_back(record);
+        }
+    }
+
+    // compact journal once per start, later it only grows by records of downloaded and removed files
+    LockGuard<Mutex> lock(localFileIndexMutex);
+    localFileIndex.Rewrite(localFileIndexPath, initFooterOnServer.info.filesTableCrc32, readyFiles);
+}
+
+void DLCManagerImpl::AppendToLocalFileIndex(size_t fileIndex, bool isReady)
+{
+    // journal is opened by scan thread, so it's guarded while main thread appends to it
+    LockGuard<Mutex> lock(localFileIndexMutex);
+    if (localFileIndex.IsOpened())
+    {
+        const PackFormat::FileTableEntry& entry = GetPack().filesTable.data.files.at(fileIndex);
+
+        LocalFileIndex::Record record;
+        record.fileIndex = static_cast<uint32>(fileIndex);
+        record.compressedSize = entry.compressedSize;
+        record.compressedCrc32 = entry.compressedCrc32;
+        record.isReady = isReady ? 1 : 0;
+        localFileIndex.Append(record);
+    }
+}
+
+bool DLCManagerImpl::VerifyFileIsReady(size_t fileIndex)
+{
+    DVASSERT(Thread::IsMainThread());
+
+    if (IsFileReady(fileIndex) && scanFileFromIndex[fileIndex])
+    {
+        scanFileFromIndex[fileIndex] = false;
+
+        const PackFormat::FileTableEntry& entry = GetPack().filesTable.data.files.at(fileIndex);
+        const FilePath localFile = dirToDownloadedPacks + (GetRelativeFilePath(static_cast<uint32>(fileIndex)) + extDvpl);
+
+        uint64 sizeOnDevice = 0;
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        if (!fs->GetFileSize(localFile, sizeOnDevice) || entry.compressedSize + sizeof(PackFormat::LitePack::Footer) != sizeOnDevice)
+        {
+            log << "file from local index is missing or damaged, download it again: " << localFile.GetStringValue() << std::endl;
+            scanFileReady[fileIndex] = false;
+            lastProgress.alreadyDownloaded -= entry.compressedSize;
+            AppendToLocalFileIndex(fileIndex, false);
+        }
+    }
+
+    return IsFileReady(fileIndex);
 }
 
 } // end namespace DAVA
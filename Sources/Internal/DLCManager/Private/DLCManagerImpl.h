@@ -7,10 +7,12 @@
 #include "DLCManager/Private/RequestManager.h"
 #include "DLCManager/Private/PackRequest.h"
 #include "DLCManager/Private/DebugGestureListener.h"
+#include "DLCManager/Private/LocalFileIndex.h"
 #include "FileSystem/FilePath.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/PackMetaData.h"
 #include "Functional/Function.h"
+#include "Concurrency/Mutex.h"
 #include "Concurrency/Semaphore.h"
 #include "Concurrency/Thread.h"
 #include "Engine/Engine.h"
@@ -182,6 +184,9 @@ public:
 
     void SetFileIsReady(size_t fileIndex, uint32 compressedSize);
 
+    // check file on device if its ready flag was restored from local file index, return actual ready flag
+    bool VerifyFileIsReady(size_t fileIndex);
+
     bool IsInQueue(const PackRequest* request) const;
 
     bool IsTop(const PackRequest* request) const;
@@ -231,7 +236,7 @@ private:
     void SwapRequestAndUpdatePointers(PackRequest* request, PackRequest* newRequest);
     void SwapPointers(PackRequest* userRequestObject, PackRequest* newRequestObject);
     PackRequest* AddDelayedRequest(const String& requestedPackName);
-    void RemoveDownloadedFileIndexes(Vector<uint32>& packIndexes) const;
+    void RemoveDownloadedFileIndexes(Vector<uint32>& packIndexes);
     void AddRequest(PackRequest* request);
     void RemoveRemoteRequest(PackRequest* request);
     PackRequest* PrepareNewRemoteRequest(const String& requestedPackName);
@@ -265,6 +270,12 @@ private:
     Vector<LocalFileInfo> localFiles;
     // every bit mean file exist and size match with meta
     Vector<bool> scanFileReady;
+    // every bit mean ready flag is restored from local file index and file on device is not checked yet
+    Vector<bool> scanFileFromIndex;
+    // journal of ready files to skip scanning of download directory on next start
+    LocalFileIndex localFileIndex;
+    // journal is rewritten on scan thread and appended on main thread
+    Mutex localFileIndexMutex;
     Thread* scanThread = nullptr;
     ScanState scanState{ ScanState::Wait };
     Semaphore metaRemoteDataLoadedSem;
@@ -273,6 +284,10 @@ private:
     void ThreadScanFunc();
     void ScanFiles(const FilePath& dir, Vector<LocalFileInfo>& files);
     void RecursiveScan(const FilePath& baseDir, const FilePath& dir, Vector<LocalFileInfo>& files);
+    void MergeScannedFilesWithMeta();
+    void MergeIndexedFilesWithMeta(const Vector<LocalFileIndex::Record>& indexedFiles);
+    void RewriteLocalFileIndex();
+    void AppendToLocalFileIndex(size_t fileIndex, bool isReady);
 
     mutable std::ofstream log;
 
@@ -280,6 +295,7 @@ private:
     FilePath localCacheMeta;
     FilePath localCacheFileTable;
     FilePath localCacheFooter;
+    FilePath localFileIndexPath;
     FilePath dirToDownloadedPacks;
     String urlToSuperPack;
     bool isProcessingEnabled = false;
@@ -374,6 +390,7 @@ inline void DLCManagerImpl::SetFileIsReady(size_t fileIndex, uint32 compressedSi
 {
     scanFileReady[fileIndex] = true;
     lastProgress.alreadyDownloaded += compressedSize;
+    AppendToLocalFileIndex(fileIndex, true);
 }
 
 inline bool DLCManagerImpl::IsInQueue(const PackRequest* request) const
@@ -0,0 +1,135 @@
+#include "DLCManager/Private/LocalFileIndex.h"
+#include "FileSystem/FileSystem.h"
+#include "Engine/Engine.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+namespace LocalFileIndexDetails
+{
+const Array<char8, 4> FILE_MARKER{ { 'D', 'L', 'C', 'I' } };
+const uint32 VERSION = 1;
+}
+
+bool LocalFileIndex::Read(const FilePath& path, uint32& filesTableCrc32, Vector<Record>& readyFiles)
+{
+    using namespace LocalFileIndexDetails;
+
+    readyFiles.clear();
+
+    ScopedPtr<File> f(File::Create(path, File::OPEN | File::READ));
+    if (!f)
+    {
+        return false;
+    }
+
+    Header header;
+    if (f->Read(&header) != sizeof(Header) || header.marker != FILE_MARKER || header.version != VERSION)
+    {
+        Logger::Info("local file index is damaged: %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    // ignore partially written record in the end
+    const uint64 recordsSize = f->GetSize() - sizeof(Header);
+    Vector<Record> records(static_cast<size_t>(recordsSize / sizeof(Record)));
+    const uint32 readSize = static_cast<uint32>(records.size() * sizeof(Record));
+    if (readSize != 0 && f->Read(records.data(), readSize) != readSize)
+    {
+        Logger::Info("can't read local file index: %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    // replay journal, last record of every file wins
+    UnorderedMap<uint32, size_t> lastRecords;
+    lastRecords.reserve(records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        lastRecords[records[i].fileIndex] = i;
+    }
+
+    readyFiles.reserve(lastRecords.size());
+    for (const auto& pair : lastRecords)
+    {
+        const Record& record = records[pair.second];
+        if (record.isReady != 0)
+        {
+            readyFiles.push_back(record);
+        }
+    }
+
+    filesTableCrc32 = header.filesTableCrc32;
+    return true;
+}
+
+bool LocalFileIndex::Rewrite(const FilePath& path, uint32 filesTableCrc32, const Vector<Record>& readyFiles)
+{
+    using namespace LocalFileIndexDetails;
+
+    Close();
+
+    FileSystem* fs = GetEngineContext()->fileSystem;
+
+    // write new journal beside and replace old one, so journal is never left half written.
+    // Old journal is outdated anyway, remove it on failure to scan files on device on next start
+    const FilePath tmpPath = path.GetStringValue() + ".tmp";
+    {
+        ScopedPtr<File> f(File::Create(tmpPath, File::CREATE | File::WRITE));
+        if (!f)
+        {
+            Logger::Error("can't create local file index: %s", tmpPath.GetStringValue().c_str());
+            fs->DeleteFile(path);
+            return false;
+        }
+
+        Header header;
+        header.marker = FILE_MARKER;
+        header.version = VERSION;
+        header.filesTableCrc32 = filesTableCrc32;
+
+        const uint32 recordsSize = static_cast<uint32>(readyFiles.size() * sizeof(Record));
+        if (f->Write(&header) != sizeof(Header) ||
+            (recordsSize != 0 && f->Write(readyFiles.data(), recordsSize) != recordsSize))
+        {
+            Logger::Error("can't write local file index: %s", tmpPath.GetStringValue().c_str());
+            f.reset();
+            fs->DeleteFile(tmpPath);
+            fs->DeleteFile(path);
+            return false;
+        }
+    }
+
+    if (!fs->MoveFile(tmpPath, path, true))
+    {
+        Logger::Error("can't replace local file index: %s", path.GetStringValue().c_str());
+        fs->DeleteFile(tmpPath);
+        fs->DeleteFile(path);
+        return false;
+    }
+
+    journalPath = path;
+    journal.reset(File::Create(path, File::APPEND | File::WRITE));
+    return IsOpened();
+}
+
+void LocalFileIndex::Append(const Record& record)
+{
+    if (journal)
+    {
+        // flush every record, journal should survive killing of application
+        if (journal->Write(&record) != sizeof(Record) || !journal->Flush())
+        {
+            // incomplete journal is worse than none, on next start files on device will be scanned
+            Logger::Error("can't append record to local file index: %s", journalPath.GetStringValue().c_str());
+            Close();
+            GetEngineContext()->fileSystem->DeleteFile(journalPath);
+        }
+    }
+}
+
+void LocalFileIndex::Close()
+{
+    journal.reset();
+}
+
+} // end namespace DAVA
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+/**
+    Journal of downloaded files kept in directory with downloaded packs.
+    Lets DLCManager restore downloaded files on start by reading one small
+    file instead of scanning whole download directory.
+
+    Journal starts with header bound to files table of superpack on server,
+    then records are appended every time file becomes ready or is removed.
+    Last record of file wins, partially written record in the end (e.g. after crash) is ignored.
+*/
+class LocalFileIndex
+{
+public:
+    struct Record
+    {
+        uint32 fileIndex = 0; // index in files table of superpack
+        uint32 compressedSize = 0;
+        uint32 compressedCrc32 = 0;
+        uint32 isReady = 0;
+    };
+
+    /**
+        Read journal from `path` and fill `readyFiles` with files which are ready according to it.
+        Return false if there is no journal or its header is damaged.
+    */
+    static bool Read(const FilePath& path, uint32& filesTableCrc32, Vector<Record>& readyFiles);
+
+    /** Write new compacted journal with `readyFiles` and keep it opened to append records */
+    bool Rewrite(const FilePath& path, uint32 filesTableCrc32, const Vector<Record>& readyFiles);
+
+    /** Append record to opened journal, do nothing if journal is not opened */
+    void Append(const Record& record);
+
+    bool IsOpened() const;
+
+    void Close();
+
+private:
+    struct Header
+    {
+        Array<char8, 4> marker;
+        uint32 version = 0;
+        uint32 filesTableCrc32 = 0;
+        uint32 reserved = 0;
+    };
+
+    FilePath journalPath;
+    ScopedPtr<File> journal;
+};
+
+inline bool LocalFileIndex::IsOpened() const
+{
+    return static_cast<bool>(journal);
+}
+
+} // end namespace DAVA
@@ -332,7 +332,7 @@ PackRequest::FileRequest::~FileRequest()
 
 bool PackRequest::CheckLocalFileState(FileSystem* fs, FileRequest& fileRequest)
 {
-    if (packManager->IsFileReady(fileRequest.fileIndex))
+    if (packManager->VerifyFileIsReady(fileRequest.fileIndex))
     {
         fileRequest.downloadedFileSize = fileRequest.sizeOfCompressedFile;
         fileRequest.status = Ready;
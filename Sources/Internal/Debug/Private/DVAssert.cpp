@@ -128,5 +128,8 @@ DAVA::Assert::FailBehaviour HandleAssert(const char* const expr,
         }
     }
 
+    // Make sure messages logged before assert reach their outputs before application is halted
+    Logger::Flush();
+
     return resultBehaviour;
 }
@@ -2,37 +2,160 @@
 #include "Time/SystemTimer.h"
 #include "Concurrency/Thread.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/ThreadLocalPtr.h"
 #include "Base/AllocatorFactory.h"
 #include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
+#include "Logger/Logger.h"
 #include "ProfilerRingArray.h"
+#include "ProfilerCPUCaptureFormat.h"
 #include <ostream>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_CPU_USE_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define PROFILER_CPU_USE_TSC 1
+#else
+#define PROFILER_CPU_USE_TSC 0
+#endif
+
 //==============================================================================
 
 namespace DAVA
 {
-
-#if PROFILER_CPU_ENABLED
-static ProfilerCPU GLOBAL_TIME_PROFILER;
-ProfilerCPU* const ProfilerCPU::globalProfiler = &GLOBAL_TIME_PROFILER;
-#else
-ProfilerCPU* const ProfilerCPU::globalProfiler = nullptr;
-#endif
-
 //////////////////////////////////////////////////////////////////////////
 //Internal Declaration
 
 struct ProfilerCPU::Counter
 {
-    uint64 startTime = 0;
+    uint64 startTime = 0; //in ticks, see ProfilerCPUDetails::ReadTicks
     uint64 endTime = 0;
     const char* name = nullptr;
-    uint64 threadID = 0;
     uint32 frame = 0;
 };
 
+struct ProfilerCPU::ThreadCounters
+{
+    ThreadCounters(uint64 threadID_, uint32 numCounters)
+        : counters(numCounters)
+        , threadID(threadID_)
+    {
+    }
+
+    //Written only by thread with `threadID`
+    CounterArray counters;
+    uint64 threadID = 0;
+};
+
+struct ProfilerCPU::CaptureContext
+{
+    File* file = nullptr;
+    Thread* thread = nullptr;
+    std::atomic<bool> stopRequested{ false };
+
+    UnorderedMap<const ThreadCounters*, uint32> readIndices;
+    UnorderedMap<const char*, uint32> nameIDs;
+    Vector<std::pair<uint32, Counter>> pendingCounters;
+    Vector<uint8> countersData;
+    Vector<uint8> buffer;
+};
+
 namespace ProfilerCPUDetails
 {
+const uint32 CAPTURE_FLUSH_PERIOD_MS = 10;
+const uint32 THREAD_CACHE_SIZE = 4;
+
+std::atomic<uint32> nextProfilerID{ 1 };
+
+//Per-thread cache of thread counters of last used profilers.
+//Lets ScopedCounter find its ring array without locking.
+struct ThreadCountersCache
+{
+    uint32 profilerIDs[THREAD_CACHE_SIZE] = {};
+    ProfilerCPU::ThreadCounters* counters[THREAD_CACHE_SIZE] = {};
+    uint32 nextSlot = 0;
+};
+
+ThreadLocalPtr<ThreadCountersCache> threadCountersCache;
+
+struct TicksCalibration
+{
+    uint64 ticks = 0;
+    uint64 us = 0;
+    float64 usPerTick = 0.001;
+};
+
+inline uint64 ReadTicks()
+{
+#if PROFILER_CPU_USE_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64>(SystemTimer::GetNs());
+#endif
+}
+
+TicksCalibration CalibrateTicks()
+{
+    TicksCalibration calibration;
+
+#if PROFILER_CPU_USE_TSC
+    //Measure TSC frequency against system timer. It takes ~10ms once per process.
+    const int64 CALIBRATION_PERIOD_US = 10000;
+
+    int64 startUs = SystemTimer::GetUs();
+    int64 us = startUs;
+    while (us == startUs)
+    {
+        us = SystemTimer::GetUs();
+    }
+    startUs = us;
+    uint64 startTicks = ReadTicks();
+
+    while (us - startUs < CALIBRATION_PERIOD_US)
+    {
+        us = SystemTimer::GetUs();
+    }
+    uint64 endTicks = ReadTicks();
+
+    calibration.ticks = startTicks;
+    calibration.us = static_cast<uint64>(startUs);
+    calibration.usPerTick = static_cast<float64>(us - startUs) / static_cast<float64>(endTicks - startTicks);
+#else
+    calibration.ticks = ReadTicks();
+    calibration.us = static_cast<uint64>(SystemTimer::GetUs());
+    calibration.usPerTick = 0.001;
+#endif
+
+    return calibration;
+}
+
+const TicksCalibration& GetTicksCalibration()
+{
+    static TicksCalibration calibration = CalibrateTicks();
+    return calibration;
+}
+
+inline uint64 TicksToUs(uint64 ticks)
+{
+    const TicksCalibration& calibration = GetTicksCalibration();
+    int64 deltaTicks = static_cast<int64>(ticks - calibration.ticks);
+    return calibration.us + static_cast<int64>(static_cast<float64>(deltaTicks) * calibration.usPerTick);
+}
+
+inline uint64 TicksDurationToUs(uint64 startTicks, uint64 endTicks)
+{
+    return TicksToUs(endTicks) - TicksToUs(startTicks);
+}
+
+template <typename T>
+void AppendValue(Vector<uint8>& buffer, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
 struct CounterTreeNode
 {
     IMPLEMENT_POOL_ALLOCATOR(CounterTreeNode, 128)
@@ -70,6 +193,13 @@ bool NameEquals(const char* name1, const char* name2)
 }
 }
 
+#if PROFILER_CPU_ENABLED
+static ProfilerCPU GLOBAL_TIME_PROFILER;
+ProfilerCPU* const ProfilerCPU::globalProfiler = &GLOBAL_TIME_PROFILER;
+#else
+ProfilerCPU* const ProfilerCPU::globalProfiler = nullptr;
+#endif
+
 const FastName ProfilerCPU::TRACE_ARG_FRAME("Frame Number");
 
 //////////////////////////////////////////////////////////////////////////
@@ -79,14 +209,16 @@ ProfilerCPU::ScopedCounter::ScopedCounter(const char* counterName, ProfilerCPU*
     profiler = _profiler;
     if (profiler->isStarted)
     {
-        Counter& c = profiler->counters->next();
+        CounterArray& counters = profiler->GetThreadCounters()->counters;
 
-        endTime = &c.endTime;
-        c.startTime = SystemTimer::GetUs();
+        Counter& c = counters.peek_next();
+        c.startTime = ProfilerCPUDetails::ReadTicks();
         c.endTime = 0;
         c.name = counterName;
-        c.threadID = Thread::GetCurrentIdAsUInt64();
         c.frame = frame;
+        counters.commit_next();
+
+        counter = &c;
     }
 }
 
@@ -97,34 +229,35 @@ ProfilerCPU::ScopedCounter::~ScopedCounter()
     // Potentially due to 'pseudo-thread-safe' (see ProfilerRingArray.h)
     // we can get invalid counter (only one, therefore there is 'if(started)' ).
     // We know it. But it performance reason.
-    if (profiler->isStarted && endTime != nullptr)
+    if (profiler->isStarted && counter != nullptr)
     {
-        *endTime = SystemTimer::GetUs();
+        counter->endTime = ProfilerCPUDetails::ReadTicks();
     }
 }
 
 ProfilerCPU::ProfilerCPU(uint32 numCounters_)
     : numCounters(numCounters_)
+    , profilerID(ProfilerCPUDetails::nextProfilerID++)
 {
 }
 
 ProfilerCPU::~ProfilerCPU()
 {
+    StopCapture();
     DeleteSnapshots();
-    SafeDelete(counters);
+    for (ThreadCounters*& c : threadCounters)
+    {
+        SafeDelete(c);
+    }
 }
 
 void ProfilerCPU::Start()
 {
+    //Calibrate time source before any counter is written
+    ProfilerCPUDetails::GetTicksCalibration();
+
     LockGuard<Mutex> lock(mutex);
-    if (isStarted == false)
-    {
-        if (counters == nullptr)
-        {
-            counters = new CounterArray(numCounters);
-        }
-        isStarted = true;
-    }
+    isStarted = true;
 }
 
 void ProfilerCPU::Stop()
@@ -138,6 +271,52 @@ bool ProfilerCPU::IsStarted() const
     return isStarted;
 }
 
+ProfilerCPU::ThreadCounters* ProfilerCPU::GetThreadCounters()
+{
+    using namespace ProfilerCPUDetails;
+
+    ThreadCountersCache* cache = threadCountersCache.Get();
+    if (cache == nullptr)
+    {
+        cache = new ThreadCountersCache();
+        threadCountersCache.Reset(cache);
+    }
+
+    for (uint32 i = 0; i < THREAD_CACHE_SIZE; ++i)
+    {
+        if (cache->profilerIDs[i] == profilerID)
+        {
+            return cache->counters[i];
+        }
+    }
+
+    ThreadCounters* counters = nullptr;
+    uint64 threadID = Thread::GetCurrentIdAsUInt64();
+    {
+        LockGuard<Mutex> lock(mutex);
+        auto found = std::find_if(threadCounters.begin(), threadCounters.end(), [threadID](const ThreadCounters* c) {
+            return c->threadID == threadID;
+        });
+
+        if (found != threadCounters.end())
+        {
+            counters = *found;
+        }
+        else
+        {
+            counters = new ThreadCounters(threadID, numCounters);
+            threadCounters.push_back(counters);
+        }
+    }
+
+    uint32 slot = cache->nextSlot;
+    cache->nextSlot = (cache->nextSlot + 1) % THREAD_CACHE_SIZE;
+    cache->profilerIDs[slot] = profilerID;
+    cache->counters[slot] = counters;
+
+    return counters;
+}
+
 int32 ProfilerCPU::MakeSnapshot()
 {
     //CPU profiler use 'pseudo-thread-safe' ring array (see ProfilerRingArray.h)
@@ -145,7 +324,16 @@ int32 ProfilerCPU::MakeSnapshot()
     //For performance reasons we should stop profiler before dumping or snapshotting
     DVASSERT(!isStarted && "Stop profiler before make snapshot");
 
-    snapshots.push_back(new CounterArray(*counters));
+    LockGuard<Mutex> lock(mutex);
+
+    Vector<ThreadCounters*> snapshot;
+    snapshot.reserve(threadCounters.size());
+    for (const ThreadCounters* c : threadCounters)
+    {
+        snapshot.push_back(new ThreadCounters(*c));
+    }
+
+    snapshots.push_back(std::move(snapshot));
     return int32(snapshots.size() - 1);
 }
 
@@ -154,30 +342,42 @@ void ProfilerCPU::DeleteSnapshot(int32 snapshot)
     if (snapshot != NO_SNAPSHOT_ID)
     {
         DVASSERT(snapshot >= 0 && snapshot < int32(snapshots.size()));
-        SafeDelete(snapshots[snapshot]);
+        for (ThreadCounters*& c : snapshots[snapshot])
+        {
+            SafeDelete(c);
+        }
         snapshots.erase(snapshots.begin() + snapshot);
     }
 }
 
 void ProfilerCPU::DeleteSnapshots()
 {
-    for (CounterArray*& c : snapshots)
+    for (Vector<ThreadCounters*>& snapshot : snapshots)
     {
-        SafeDelete(c);
+        for (ThreadCounters*& c : snapshot)
+        {
+            SafeDelete(c);
+        }
     }
     snapshots.clear();
 }
 
 uint64 ProfilerCPU::GetLastCounterTime(const char* counterName) const
 {
+    const ThreadCounters* threadCounters = FindLastCounter(counterName, 0, NO_SNAPSHOT_ID);
+    if (threadCounters == nullptr)
+    {
+        return 0;
+    }
+
     uint64 timeDelta = 0;
-    CounterArray::reverse_iterator it = counters->rbegin(), itEnd = counters->rend();
+    CounterArray::const_reverse_iterator it = threadCounters->counters.rbegin(), itEnd = threadCounters->counters.rend();
     for (; it != itEnd; ++it)
     {
         const Counter& c = *it;
         if (c.endTime != 0 && (strcmp(counterName, c.name) == 0))
         {
-            timeDelta = c.endTime - c.startTime;
+            timeDelta = ProfilerCPUDetails::TicksDurationToUs(c.startTime, c.endTime);
             break;
         }
     }
@@ -187,32 +387,37 @@ uint64 ProfilerCPU::GetLastCounterTime(const char* counterName) const
 
 void ProfilerCPU::DumpLast(const char* counterName, uint32 counterCount, std::ostream& stream, int32 snapshot) const
 {
+    using namespace ProfilerCPUDetails;
     DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted) && "Stop profiler before dumping");
 
     stream << "================================================================\n";
 
-    const CounterArray* array = GetCounterArray(snapshot);
-    CounterArray::const_reverse_iterator it = array->rbegin(), itEnd = array->rend();
-    const Counter* lastDumpedCounter = nullptr;
-    for (; it != itEnd; ++it)
+    const ThreadCounters* threadCounters = FindLastCounter(counterName, 0, snapshot);
+    if (threadCounters != nullptr)
     {
-        if (it->endTime != 0 && (strcmp(counterName, it->name) == 0))
+        const CounterArray* array = &threadCounters->counters;
+        CounterArray::const_reverse_iterator it = array->rbegin(), itEnd = array->rend();
+        const Counter* lastDumpedCounter = nullptr;
+        for (; it != itEnd; ++it)
         {
-            if (lastDumpedCounter)
+            if (it->endTime != 0 && (strcmp(counterName, it->name) == 0))
             {
-                stream << "=== Non-tracked time [" << (lastDumpedCounter->startTime - it->endTime) << " us] ===\n";
-            }
-            lastDumpedCounter = &(*it);
+                if (lastDumpedCounter)
+                {
+                    stream << "=== Non-tracked time [" << TicksDurationToUs(it->endTime, lastDumpedCounter->startTime) << " us] ===\n";
+                }
+                lastDumpedCounter = &(*it);
 
-            ProfilerCPUDetails::CounterTreeNode* treeRoot = ProfilerCPUDetails::CounterTreeNode::BuildTree(CounterArray::const_iterator(it), array);
-            ProfilerCPUDetails::CounterTreeNode::DumpTree(treeRoot, stream, false);
-            SafeDelete(treeRoot);
+                CounterTreeNode* treeRoot = CounterTreeNode::BuildTree(CounterArray::const_iterator(it), array);
+                CounterTreeNode::DumpTree(treeRoot, stream, false);
+                CounterTreeNode::SafeDeleteTree(treeRoot);
 
-            counterCount--;
-        }
+                counterCount--;
+            }
 
-        if (counterCount == 0)
-            break;
+            if (counterCount == 0)
+                break;
+        }
     }
 
     stream << "================================================================\n";
@@ -227,31 +432,35 @@ void ProfilerCPU::DumpAverage(const char* counterName, uint32 counterCount, std:
     stream << "================================================================\n";
     stream << "=== Average time for " << counterCount << " counter(s):\n";
 
-    const CounterArray* array = GetCounterArray(snapshot);
-    CounterArray::const_reverse_iterator it = array->rbegin();
-    CounterArray::const_reverse_iterator itEnd = array->rend();
+    const ThreadCounters* threadCounters = FindLastCounter(counterName, 0, snapshot);
     CounterTreeNode* treeRoot = nullptr;
-    for (; it != itEnd; ++it)
+    if (threadCounters != nullptr)
     {
-        if (it->endTime != 0 && (strcmp(counterName, it->name) == 0))
+        const CounterArray* array = &threadCounters->counters;
+        CounterArray::const_reverse_iterator it = array->rbegin();
+        CounterArray::const_reverse_iterator itEnd = array->rend();
+        for (; it != itEnd; ++it)
         {
-            CounterTreeNode* node = CounterTreeNode::BuildTree(CounterArray::const_iterator(it), array);
-
-            if (treeRoot)
+            if (it->endTime != 0 && (strcmp(counterName, it->name) == 0))
             {
-                CounterTreeNode::MergeTree(treeRoot, node);
-                CounterTreeNode::SafeDeleteTree(node);
-            }
-            else
-            {
-                treeRoot = node;
+                CounterTreeNode* node = CounterTreeNode::BuildTree(CounterArray::const_iterator(it), array);
+
+                if (treeRoot)
+                {
+                    CounterTreeNode::MergeTree(treeRoot, node);
+                    CounterTreeNode::SafeDeleteTree(node);
+                }
+                else
+                {
+                    treeRoot = node;
+                }
+
+                counterCount--;
             }
 
-            counterCount--;
+            if (counterCount == 0)
+                break;
         }
-
-        if (counterCount == 0)
-            break;
     }
 
     if (treeRoot)
@@ -266,28 +475,30 @@ void ProfilerCPU::DumpAverage(const char* counterName, uint32 counterCount, std:
 
 Vector<TraceEvent> ProfilerCPU::GetTrace(int32 snapshot) const
 {
+    using namespace ProfilerCPUDetails;
     DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted) && "Stop profiler before tracing");
 
-    const CounterArray* array = GetCounterArray(snapshot);
+    Vector<const ThreadCounters*> arrays;
+    GetThreadCountersArrays(snapshot, arrays);
+
     Vector<TraceEvent> trace;
-    if (array == nullptr)
-    {
-        return trace;
-    }
-    trace.reserve(array->size());
+    trace.reserve(arrays.size() * numCounters);
 
-    for (const Counter& c : *array)
+    for (const ThreadCounters* threadCounters : arrays)
     {
-        if (c.name == nullptr || c.startTime == 0 || c.endTime == 0)
+        for (const Counter& c : threadCounters->counters)
         {
-            continue;
-        }
+            if (c.name == nullptr || c.startTime == 0 || c.endTime == 0)
+            {
+                continue;
+            }
 
-        trace.push_back({ FastName(c.name), c.startTime, (c.endTime - c.startTime), c.threadID, 0, TraceEvent::PHASE_DURATION });
+            trace.push_back({ FastName(c.name), TicksToUs(c.startTime), TicksDurationToUs(c.startTime, c.endTime), threadCounters->threadID, 0, TraceEvent::PHASE_DURATION });
 
-        if (c.frame)
-        {
-            trace.back().args.push_back({ TRACE_ARG_FRAME, c.frame });
+            if (c.frame)
+            {
+                trace.back().args.push_back({ TRACE_ARG_FRAME, c.frame });
+            }
         }
     }
 
@@ -296,11 +507,19 @@ Vector<TraceEvent> ProfilerCPU::GetTrace(int32 snapshot) const
 
 Vector<TraceEvent> ProfilerCPU::GetTrace(const char* counterName, uint32 desiredFrameIndex, int32 snapshot) const
 {
+    using namespace ProfilerCPUDetails;
+
     Vector<TraceEvent> trace;
 
+    const ThreadCounters* threadCounters = FindLastCounter(counterName, desiredFrameIndex, snapshot);
+    if (threadCounters == nullptr)
+    {
+        return trace;
+    }
+
     bool found = false;
     std::size_t countersCount = 0;
-    const CounterArray* array = GetCounterArray(snapshot);
+    const CounterArray* array = &threadCounters->counters;
     CounterArray::const_reverse_iterator rit = array->rbegin();
     CounterArray::const_reverse_iterator rend = array->rend();
     for (; rit != rend; ++rit)
@@ -323,23 +542,19 @@ Vector<TraceEvent> ProfilerCPU::GetTrace(const char* counterName, uint32 desired
 
         trace.reserve(countersCount);
 
-        uint64 threadID = it->threadID;
         uint64 counterEndTime = it->endTime;
         for (; it != end; ++it)
         {
-            if (it->threadID == threadID)
+            if (it->endTime == 0 || it->startTime > counterEndTime)
             {
-                if (it->endTime == 0 || it->startTime > counterEndTime)
-                {
-                    break;
-                }
+                break;
+            }
 
-                trace.push_back({ FastName(it->name), it->startTime, it->endTime - it->startTime, it->threadID, 0, TraceEvent::PHASE_DURATION });
+            trace.push_back({ FastName(it->name), TicksToUs(it->startTime), TicksDurationToUs(it->startTime, it->endTime), threadCounters->threadID, 0, TraceEvent::PHASE_DURATION });
 
-                if (it->frame)
-                {
-                    trace.back().args.push_back({ TRACE_ARG_FRAME, it->frame });
-                }
+            if (it->frame)
+            {
+                trace.back().args.push_back({ TRACE_ARG_FRAME, it->frame });
             }
         }
     }
@@ -347,15 +562,237 @@ Vector<TraceEvent> ProfilerCPU::GetTrace(const char* counterName, uint32 desired
     return trace;
 }
 
-const ProfilerCPU::CounterArray* ProfilerCPU::GetCounterArray(int32 snapshot) const
+void ProfilerCPU::GetThreadCountersArrays(int32 snapshot, Vector<const ThreadCounters*>& arrays) const
 {
     if (snapshot != NO_SNAPSHOT_ID)
     {
         DVASSERT(snapshot >= 0 && snapshot < int32(snapshots.size()));
-        return snapshots[snapshot];
+        arrays.assign(snapshots[snapshot].begin(), snapshots[snapshot].end());
+    }
+    else
+    {
+        //Thread counters may be added by other thread at the same time
+        LockGuard<Mutex> lock(mutex);
+        arrays.assign(threadCounters.begin(), threadCounters.end());
+    }
+}
+
+const ProfilerCPU::ThreadCounters* ProfilerCPU::FindLastCounter(const char* counterName, uint32 desiredFrameIndex, int32 snapshot) const
+{
+    Vector<const ThreadCounters*> arrays;
+    GetThreadCountersArrays(snapshot, arrays);
+
+    //Counters with the same name may be placed in different threads, so take the thread where such counter was completed last
+    const ThreadCounters* result = nullptr;
+    uint64 resultEndTime = 0;
+    for (const ThreadCounters* threadCounters : arrays)
+    {
+        CounterArray::const_reverse_iterator it = threadCounters->counters.rbegin(), itEnd = threadCounters->counters.rend();
+        for (; it != itEnd; ++it)
+        {
+            if (it->endTime != 0 && (strcmp(counterName, it->name) == 0))
+            {
+                if ((it->frame <= desiredFrameIndex || it->frame == 0 || desiredFrameIndex == 0))
+                {
+                    if (result == nullptr || it->endTime > resultEndTime)
+                    {
+                        result = threadCounters;
+                        resultEndTime = it->endTime;
+                    }
+                    break;
+                }
+            }
+        }
     }
 
-    return counters;
+    return result;
+}
+
+bool ProfilerCPU::StartCapture(const FilePath& capturePath)
+{
+    using namespace ProfilerCPUDetails;
+    using namespace ProfilerCPUCaptureFormat;
+
+    LockGuard<Mutex> captureLock(captureMutex);
+    if (capture != nullptr)
+    {
+        DVASSERT(false, "CPU profiler capture is already started");
+        return false;
+    }
+
+    File* file = File::Create(capturePath, File::CREATE | File::WRITE);
+    if (file == nullptr)
+    {
+        Logger::Error("[ProfilerCPU] Can't create capture file %s", capturePath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    capture = new CaptureContext();
+    capture->file = file;
+
+    {
+        //Capture only counters that will be started from this moment
+        LockGuard<Mutex> lock(mutex);
+        for (const ThreadCounters* c : threadCounters)
+        {
+            capture->readIndices[c] = c->counters.get_head();
+        }
+    }
+
+    const TicksCalibration& calibration = GetTicksCalibration();
+    Vector<uint8>& buffer = capture->buffer;
+    buffer.insert(buffer.end(), std::begin(CAPTURE_SIGNATURE), std::end(CAPTURE_SIGNATURE));
+    AppendValue(buffer, CAPTURE_VERSION);
+    AppendValue(buffer, calibration.usPerTick);
+    AppendValue(buffer, RECORD_SYNC);
+    AppendValue(buffer, calibration.ticks);
+    AppendValue(buffer, calibration.us);
+    capture->file->Write(buffer.data(), static_cast<uint32>(buffer.size()));
+
+    capture->thread = Thread::Create([this]() { CaptureThreadFunc(); });
+    capture->thread->SetName("ProfilerCPUCapture");
+    capture->thread->Start();
+
+    return true;
+}
+
+void ProfilerCPU::StopCapture()
+{
+    LockGuard<Mutex> captureLock(captureMutex);
+    if (capture == nullptr)
+    {
+        return;
+    }
+
+    capture->stopRequested = true;
+    capture->thread->Join();
+    SafeRelease(capture->thread);
+    SafeRelease(capture->file);
+    SafeDelete(capture);
+}
+
+bool ProfilerCPU::IsCapturing() const
+{
+    LockGuard<Mutex> captureLock(captureMutex);
+    return capture != nullptr;
+}
+
+void ProfilerCPU::CaptureThreadFunc()
+{
+    while (!capture->stopRequested)
+    {
+        Thread::Sleep(ProfilerCPUDetails::CAPTURE_FLUSH_PERIOD_MS);
+        FlushCapture(false);
+    }
+
+    FlushCapture(true);
+}
+
+void ProfilerCPU::FlushCapture(bool finalFlush)
+{
+    using namespace ProfilerCPUDetails;
+    using namespace ProfilerCPUCaptureFormat;
+
+    Vector<const ThreadCounters*> arrays;
+    GetThreadCountersArrays(NO_SNAPSHOT_ID, arrays);
+
+    Vector<uint8>& buffer = capture->buffer;
+    buffer.clear();
+    AppendValue(buffer, RECORD_SYNC);
+    AppendValue(buffer, ReadTicks());
+    AppendValue(buffer, static_cast<uint64>(SystemTimer::GetUs()));
+
+    for (const ThreadCounters* threadCounters : arrays)
+    {
+        const CounterArray& counters = threadCounters->counters;
+        const uint32 size = static_cast<uint32>(counters.size());
+
+        //Threads that appeared after capture start are read from the beginning
+        uint32& readIndex = capture->readIndices[threadCounters];
+        uint32 droppedCount = 0;
+
+        uint32 head = counters.get_head();
+        if (head - readIndex > size)
+        {
+            droppedCount += head - readIndex - size;
+            readIndex = head - size;
+        }
+
+        capture->pendingCounters.clear();
+        uint32 index = readIndex;
+        for (; index != head; ++index)
+        {
+            Counter c = counters.at(index);
+            if (c.endTime == 0)
+            {
+                //Wait for unfinished counter while there is enough space in ring array for the following ones
+                if (!finalFlush && (head - index) < size / 2)
+                {
+                    break;
+                }
+
+                ++droppedCount;
+                continue;
+            }
+
+            capture->pendingCounters.emplace_back(index, c);
+        }
+
+        //Counters overwritten by owner thread while they were being read are not reliable
+        uint32 headAfterRead = counters.get_head();
+        uint32 firstReliableIndex = (headAfterRead - readIndex > size) ? headAfterRead - size : readIndex;
+        readIndex = index;
+
+        Vector<uint8>& countersData = capture->countersData;
+        countersData.clear();
+        uint32 writtenCount = 0;
+        for (const std::pair<uint32, Counter>& pending : capture->pendingCounters)
+        {
+            if (static_cast<int32>(pending.first - firstReliableIndex) < 0)
+            {
+                ++droppedCount;
+                continue;
+            }
+
+            const Counter& c = pending.second;
+            auto nameIt = capture->nameIDs.find(c.name);
+            if (nameIt == capture->nameIDs.end())
+            {
+                uint32 nameID = static_cast<uint32>(capture->nameIDs.size());
+                nameIt = capture->nameIDs.emplace(c.name, nameID).first;
+
+                uint32 length = static_cast<uint32>(strlen(c.name));
+                AppendValue(buffer, RECORD_NAME);
+                AppendValue(buffer, nameID);
+                AppendValue(buffer, length);
+                buffer.insert(buffer.end(), c.name, c.name + length);
+            }
+
+            AppendValue(countersData, c.startTime);
+            AppendValue(countersData, c.endTime);
+            AppendValue(countersData, nameIt->second);
+            AppendValue(countersData, c.frame);
+            ++writtenCount;
+        }
+
+        if (writtenCount > 0)
+        {
+            AppendValue(buffer, RECORD_COUNTERS);
+            AppendValue(buffer, threadCounters->threadID);
+            AppendValue(buffer, writtenCount);
+            buffer.insert(buffer.end(), countersData.begin(), countersData.end());
+        }
+
+        if (droppedCount > 0)
+        {
+            AppendValue(buffer, RECORD_DROPPED);
+            AppendValue(buffer, threadCounters->threadID);
+            AppendValue(buffer, droppedCount);
+        }
+    }
+
+    capture->file->Write(buffer.data(), static_cast<uint32>(buffer.size()));
+    capture->file->Flush();
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -366,11 +803,10 @@ CounterTreeNode* CounterTreeNode::BuildTree(ProfilerCPU::CounterArray::const_ite
 {
     DVASSERT(begin->endTime);
 
-    uint64 threadID = begin->threadID;
     uint64 endTime = begin->endTime;
     Vector<uint64> nodeEndTime;
 
-    CounterTreeNode* node = new CounterTreeNode(nullptr, begin->name, begin->endTime - begin->startTime, 1);
+    CounterTreeNode* node = new CounterTreeNode(nullptr, begin->name, TicksDurationToUs(begin->startTime, begin->endTime), 1);
     nodeEndTime.push_back(begin->endTime);
 
     ProfilerCPU::CounterArray::const_iterator end = array->end();
@@ -378,45 +814,39 @@ CounterTreeNode* CounterTreeNode::BuildTree(ProfilerCPU::CounterArray::const_ite
     {
         const ProfilerCPU::Counter& c = *it;
 
-        if (c.threadID != threadID)
-            continue;
-
         if (c.startTime >= endTime || c.endTime == 0)
             break;
 
-        if (c.threadID == threadID)
+        while (!nodeEndTime.empty() && (c.startTime >= nodeEndTime.back()))
         {
-            while (!nodeEndTime.empty() && (c.startTime >= nodeEndTime.back()))
-            {
-                DVASSERT(node->parent);
+            DVASSERT(node->parent);
 
-                nodeEndTime.pop_back();
-                node = node->parent;
-            }
+            nodeEndTime.pop_back();
+            node = node->parent;
+        }
+
+        if (NameEquals(node->counterName, c.name))
+        {
+            node->counterTime += TicksDurationToUs(c.startTime, c.endTime);
+            node->count++;
+        }
+        else
+        {
+            auto found = std::find_if(node->childs.begin(), node->childs.end(), [&c](CounterTreeNode* nodeArg) {
+                return (NameEquals(c.name, nodeArg->counterName));
+            });
 
-            if (NameEquals(node->counterName, c.name))
+            if (found != node->childs.end())
             {
-                node->counterTime += c.endTime - c.startTime;
-                node->count++;
+                (*found)->counterTime += TicksDurationToUs(c.startTime, c.endTime);
+                (*found)->count++;
             }
             else
             {
-                auto found = std::find_if(node->childs.begin(), node->childs.end(), [&c](CounterTreeNode* nodeArg) {
-                    return (NameEquals(c.name, nodeArg->counterName));
-                });
-
-                if (found != node->childs.end())
-                {
-                    (*found)->counterTime += c.endTime - c.startTime;
-                    (*found)->count++;
-                }
-                else
-                {
-                    node->childs.push_back(new CounterTreeNode(node, c.name, c.endTime - c.startTime, 1));
-                    node = node->childs.back();
+                node->childs.push_back(new CounterTreeNode(node, c.name, TicksDurationToUs(c.startTime, c.endTime), 1));
+                node = node->childs.back();
 
-                    nodeEndTime.push_back(c.endTime);
-                }
+                nodeEndTime.push_back(c.endTime);
             }
         }
     }
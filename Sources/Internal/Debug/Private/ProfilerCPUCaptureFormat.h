@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Binary format of CPU profiler capture (see `ProfilerCPU::StartCapture`).
+    All values are stored in native (little-endian) byte order without alignment.
+
+    File starts with header:
+        char    signature[4]    -- 'DVPC'
+        uint32  version         -- CAPTURE_VERSION
+        float64 usPerTick       -- estimated duration of timestamp tick in microseconds
+
+    Header is followed by sequence of records. Every record starts with `uint8` record type:
+        RECORD_SYNC:     uint64 ticks, uint64 us                      -- timestamp in ticks and the same moment in SystemTimer microseconds
+        RECORD_NAME:     uint32 nameId, uint32 length, char[length]   -- counter name, referenced by id in following counters records
+        RECORD_COUNTERS: uint64 threadID, uint32 count,
+                         count x (uint64 startTicks, uint64 endTicks, uint32 nameId, uint32 frame)
+        RECORD_DROPPED:  uint64 threadID, uint32 count                -- counters lost because capture thread didn't keep up
+
+    Capture is written incrementally, so file of terminated process can end with truncated record. Readers should ignore it.
+*/
+namespace ProfilerCPUCaptureFormat
+{
+const char CAPTURE_SIGNATURE[4] = { 'D', 'V', 'P', 'C' };
+const uint32 CAPTURE_VERSION = 1;
+
+enum eRecordType : uint8
+{
+    RECORD_SYNC = 1,
+    RECORD_NAME = 2,
+    RECORD_COUNTERS = 3,
+    RECORD_DROPPED = 4
+};
+
+const uint32 HEADER_SIZE = sizeof(CAPTURE_SIGNATURE) + sizeof(uint32) + sizeof(float64);
+const uint32 COUNTER_SIZE = sizeof(uint64) + sizeof(uint64) + sizeof(uint32) + sizeof(uint32);
+} // namespace ProfilerCPUCaptureFormat
+} // namespace DAVA
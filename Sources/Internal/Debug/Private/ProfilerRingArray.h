@@ -56,6 +56,28 @@ public:
     {
         return elements[head++ & mask];
     }
+
+    //Single-producer interface. Only one thread may write to array this way.
+    //'peek_next' returns next element without moving head, so readers don't
+    //consider it until writer fills it and calls 'commit_next'.
+    T& peek_next()
+    {
+        return elements[head.load(std::memory_order_relaxed) & mask];
+    }
+    void commit_next()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    //Return total count of elements ever added to array (modulo 2^32)
+    uint32 get_head() const
+    {
+        return head.load(std::memory_order_acquire);
+    }
+    //Return element by absolute index in range [get_head() - size(), get_head())
+    const T& at(uint32 index) const
+    {
+        return elements[index & mask];
+    }
     iterator begin()
     {
         return iterator(elements, (head & mask), mask);
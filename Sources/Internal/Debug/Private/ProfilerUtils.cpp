@@ -7,10 +7,79 @@
 #include "FileSystem/FileSystem.h"
 #include "Render/RHI/rhi_Public.h"
 #include "Base/FastName.h"
+#include "ProfilerCPUCaptureFormat.h"
 #include <sstream>
 
 namespace DAVA
 {
+namespace ProfilerUtilsDetails
+{
+class CaptureReader
+{
+public:
+    CaptureReader(const Vector<uint8>& data_)
+        : data(data_)
+    {
+    }
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        if (offset + sizeof(T) > data.size())
+        {
+            return false;
+        }
+
+        memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(uint32 length, String& value)
+    {
+        if (offset + length > data.size())
+        {
+            return false;
+        }
+
+        value.assign(reinterpret_cast<const char*>(data.data() + offset), length);
+        offset += length;
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return offset >= data.size();
+    }
+
+private:
+    const Vector<uint8>& data;
+    size_t offset = 0;
+};
+
+struct CaptureSync
+{
+    uint64 ticks = 0;
+    uint64 us = 0;
+};
+
+struct CaptureCounter
+{
+    uint64 threadID = 0;
+    uint64 startTicks = 0;
+    uint64 endTicks = 0;
+    uint32 nameID = 0;
+    uint32 frame = 0;
+};
+
+struct CaptureDropped
+{
+    uint64 threadID = 0;
+    uint64 ticks = 0;
+    uint32 count = 0;
+};
+}
+
 namespace ProfilerUtils
 {
 void DumpCPUGPUTrace(ProfilerCPU* cpuProfiler, ProfilerGPU* gpuProfiler, std::ostream& stream)
@@ -57,5 +126,171 @@ void DumpCPUGPUTraceToFile(ProfilerCPU* cpuProfiler, ProfilerGPU* gpuProfiler, c
     SafeRelease(json);
 }
 
+bool LoadCPUCaptureTrace(const FilePath& capturePath, Vector<TraceEvent>& trace)
+{
+    using namespace ProfilerUtilsDetails;
+    using namespace ProfilerCPUCaptureFormat;
+
+    ScopedPtr<File> file(File::Create(capturePath, File::OPEN | File::READ));
+    if (!file)
+    {
+        return false;
+    }
+
+    Vector<uint8> data(static_cast<size_t>(file->GetSize()));
+    if (data.size() < HEADER_SIZE || file->Read(data.data(), static_cast<uint32>(data.size())) != data.size())
+    {
+        return false;
+    }
+
+    CaptureReader reader(data);
+
+    char signature[sizeof(CAPTURE_SIGNATURE)];
+    uint32 version = 0;
+    float64 usPerTick = 0.0;
+    reader.Read(signature);
+    reader.Read(version);
+    reader.Read(usPerTick);
+    if (memcmp(signature, CAPTURE_SIGNATURE, sizeof(CAPTURE_SIGNATURE)) != 0 || version != CAPTURE_VERSION)
+    {
+        return false;
+    }
+
+    Vector<CaptureSync> syncs;
+    Vector<CaptureCounter> counters;
+    Vector<CaptureDropped> dropped;
+    Vector<FastName> names;
+
+    bool truncated = false;
+    while (!reader.IsEnd() && !truncated)
+    {
+        uint8 recordType = 0;
+        reader.Read(recordType);
+
+        switch (recordType)
+        {
+        case RECORD_SYNC:
+        {
+            CaptureSync sync;
+            truncated = !reader.Read(sync.ticks) || !reader.Read(sync.us);
+            if (!truncated)
+            {
+                syncs.push_back(sync);
+            }
+            break;
+        }
+        case RECORD_NAME:
+        {
+            uint32 nameID = 0;
+            uint32 length = 0;
+            String name;
+            truncated = !reader.Read(nameID) || !reader.Read(length) || !reader.ReadString(length, name);
+            if (!truncated)
+            {
+                if (nameID >= names.size())
+                {
+                    names.resize(nameID + 1);
+                }
+                names[nameID] = FastName(name);
+            }
+            break;
+        }
+        case RECORD_COUNTERS:
+        {
+            uint64 threadID = 0;
+            uint32 count = 0;
+            truncated = !reader.Read(threadID) || !reader.Read(count);
+
+            size_t firstCounter = counters.size();
+            for (uint32 i = 0; i < count && !truncated; ++i)
+            {
+                CaptureCounter c;
+                c.threadID = threadID;
+                truncated = !reader.Read(c.startTicks) || !reader.Read(c.endTicks) || !reader.Read(c.nameID) || !reader.Read(c.frame);
+                if (!truncated)
+                {
+                    counters.push_back(c);
+                }
+            }
+
+            if (truncated)
+            {
+                counters.resize(firstCounter);
+            }
+            break;
+        }
+        case RECORD_DROPPED:
+        {
+            CaptureDropped d;
+            d.ticks = syncs.empty() ? 0 : syncs.back().ticks;
+            truncated = !reader.Read(d.threadID) || !reader.Read(d.count);
+            if (!truncated)
+            {
+                dropped.push_back(d);
+            }
+            break;
+        }
+        default:
+            truncated = true;
+            break;
+        }
+    }
+
+    if (syncs.empty())
+    {
+        return false;
+    }
+
+    //Use the whole capture duration to estimate tick duration, that is more precise than calibration written in header
+    const CaptureSync& firstSync = syncs.front();
+    const CaptureSync& lastSync = syncs.back();
+    if (lastSync.ticks > firstSync.ticks && lastSync.us > firstSync.us)
+    {
+        usPerTick = static_cast<float64>(lastSync.us - firstSync.us) / static_cast<float64>(lastSync.ticks - firstSync.ticks);
+    }
+
+    auto ticksToUs = [&firstSync, usPerTick](uint64 ticks) {
+        int64 deltaTicks = static_cast<int64>(ticks - firstSync.ticks);
+        return firstSync.us + static_cast<int64>(static_cast<float64>(deltaTicks) * usPerTick);
+    };
+
+    static const FastName droppedName("ProfilerCPU: dropped counters");
+    static const FastName droppedCountArg("Count");
+
+    trace.reserve(trace.size() + counters.size() + dropped.size());
+    for (const CaptureCounter& c : counters)
+    {
+        FastName name = (c.nameID < names.size()) ? names[c.nameID] : FastName();
+        uint64 startTime = ticksToUs(c.startTicks);
+        trace.push_back({ name, startTime, ticksToUs(c.endTicks) - startTime, c.threadID, 0, TraceEvent::PHASE_DURATION });
+
+        if (c.frame)
+        {
+            trace.back().args.push_back({ ProfilerCPU::TRACE_ARG_FRAME, c.frame });
+        }
+    }
+
+    for (const CaptureDropped& d : dropped)
+    {
+        trace.push_back({ droppedName, ticksToUs(d.ticks), 0, d.threadID, 0, TraceEvent::PHASE_INSTANCE });
+        trace.back().args.push_back({ droppedCountArg, d.count });
+    }
+
+    return true;
+}
+
+bool ConvertCPUCaptureToJSON(const FilePath& capturePath, const FilePath& jsonPath)
+{
+    Vector<TraceEvent> trace;
+    if (LoadCPUCaptureTrace(capturePath, trace) == false)
+    {
+        return false;
+    }
+
+    TraceEvent::DumpJSON(trace, jsonPath);
+    return true;
+}
+
 }; //ns ProfilerDump
+
 }; //ns DAVA
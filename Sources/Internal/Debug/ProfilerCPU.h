@@ -3,6 +3,7 @@
 #include "Base/BaseTypes.h"
 #include "Debug/TraceEvent.h"
 #include "Concurrency/Mutex.h"
+#include <atomic>
 #include <iosfwd>
 
 #ifndef PROFILER_CPU_ENABLED
@@ -13,6 +14,7 @@ namespace DAVA
 {
 template <class T>
 class ProfilerRingArray;
+class FilePath;
 
 /**
     \ingroup profilers
@@ -22,7 +24,10 @@ class ProfilerRingArray;
 
              Any counter has string-name that must be passed to define and will be displayed in dump or trace. Time-measuring occurs in microseconds.
 
-             Profiler is using ring array for counters so you are limited by count passed to ctor. If it's necessary to store counters data for later usage you can use snapshots.
+             Profiler is using ring array for counters so you are limited by count passed to ctor. Every thread writes counters to its own ring array of this size,
+             so threads don't contend for shared data while profiler is started. Timestamps are taken from CPU time-stamp counter where it's available
+             and are converted to microseconds only when counters are dumped.
+             If it's necessary to store counters data for later usage you can use snapshots.
              Snapshot - it just a copy of internal ring buffer. To make snapshot you have to stop profiler because it can be used by other thread.
              After snapshot was made you can dump counted info or build JSON-trace from it. Remember, that dumping or building trace is more expensive in performance than making snapshot.
 
@@ -51,6 +56,11 @@ class ProfilerRingArray;
                  ================================================================
                \endcode
 
+             For long sessions (e.g. soak tests) counters can be streamed to file in compact binary format using `StartCapture`/`StopCapture`.
+             Capture is written by background thread, that reads thread ring arrays while profiler works, so ring array size bounds
+             the amount of counters per thread that can be produced between two flushes. Lost counters are counted and marked in capture.
+             Capture can be converted to Chromium Trace Viewer JSON with `ProfilerUtils::ConvertCPUCaptureToJSON` or ProfilerCaptureConverter tool.
+
 			 Dump everything using:
 			   \code
 			   std::ofstream file("tmp.json");
@@ -68,6 +78,7 @@ public:
     static const FastName TRACE_ARG_FRAME; ///< Name of frame index argument of generated TraceEvent
 
     struct Counter;
+    struct ThreadCounters;
     using CounterArray = ProfilerRingArray<Counter>;
 
     /**
@@ -81,7 +92,7 @@ public:
         ~ScopedCounter();
 
     private:
-        uint64* endTime = nullptr;
+        Counter* counter = nullptr;
         ProfilerCPU* profiler;
     };
 
@@ -156,14 +167,40 @@ public:
     */
     Vector<TraceEvent> GetTrace(const char* counterName, uint32 desiredFrameIndex = 0, int32 snapshotID = NO_SNAPSHOT_ID) const;
 
+    /**
+        Start streaming of counters to binary file with `capturePath`. Only counters started after this call are written.
+        Capture doesn't start profiler, so call `Start` to measure something. Return false if file can't be created.
+    */
+    bool StartCapture(const FilePath& capturePath);
+
+    /**
+        Write remaining completed counters and close capture file.
+    */
+    void StopCapture();
+
+    /**
+        Returns is counters streamed to capture file
+    */
+    bool IsCapturing() const;
+
 private:
-    const CounterArray* GetCounterArray(int32 snapshot) const;
+    struct CaptureContext;
+
+    ThreadCounters* GetThreadCounters();
+    void GetThreadCountersArrays(int32 snapshot, Vector<const ThreadCounters*>& arrays) const;
+    const ThreadCounters* FindLastCounter(const char* counterName, uint32 desiredFrameIndex, int32 snapshot) const;
+
+    void CaptureThreadFunc();
+    void FlushCapture(bool finalFlush);
 
-    CounterArray* counters = nullptr;
-    Vector<CounterArray*> snapshots;
-    Mutex mutex;
+    Vector<ThreadCounters*> threadCounters;
+    Vector<Vector<ThreadCounters*>> snapshots;
+    CaptureContext* capture = nullptr;
+    mutable Mutex mutex;
+    mutable Mutex captureMutex;
     uint32 numCounters = 2048;
-    bool isStarted = false;
+    uint32 profilerID = 0;
+    std::atomic<bool> isStarted{ false };
 
     friend class ScopedCounter;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Base/BaseTypes.h"
 #include <iosfwd>
 
 namespace DAVA
@@ -7,10 +8,22 @@ namespace DAVA
 class ProfilerCPU;
 class ProfilerGPU;
 class FilePath;
+struct TraceEvent;
 namespace ProfilerUtils
 {
 void DumpCPUGPUTrace(ProfilerCPU* cpuProfiler, ProfilerGPU* gpuProfiler, std::ostream& stream);
 void DumpCPUGPUTraceToFile(ProfilerCPU* cpuProfiler, ProfilerGPU* gpuProfiler, const FilePath& filePath);
+
+/**
+    Read binary capture written by `ProfilerCPU::StartCapture` and append its counters to `trace`.
+    Truncated tail of capture (e.g. capture of crashed process) is ignored. Return false if file can't be read or isn't a capture.
+*/
+bool LoadCPUCaptureTrace(const FilePath& capturePath, Vector<TraceEvent>& trace);
+
+/**
+    Convert binary capture written by `ProfilerCPU::StartCapture` to JSON Chromium Trace Viewer format.
+*/
+bool ConvertCPUCaptureToJSON(const FilePath& capturePath, const FilePath& jsonPath);
 }
 
 }; //ns DAVA
\ No newline at end of file
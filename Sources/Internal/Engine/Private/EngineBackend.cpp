@@ -55,6 +55,8 @@
 #include "Render/Image/ImageConverter.h"
 #include "Render/Renderer.h"
 #include "Render/RHI/rhi_ShaderSource.h"
+#include "Render/RHI/rhi_ShaderCache.h"
+#include "Render/ShaderCache.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
 #include "Sound/SoundEvent.h"
 #include "Sound/SoundSystem.h"
@@ -361,6 +363,7 @@ void EngineBackend::OnGameLoopStopped()
     if (!IsConsoleMode())
     {
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        rhi::ShaderCache::Save("~doc:/ShaderCache.bin");
     }
 
     Logger::Info("EngineBackend::OnGameLoopStopped: leave");
@@ -687,6 +690,7 @@ void EngineBackend::HandleAppSuspended(const MainDispatcherEvent& e)
         if (Renderer::IsInitialized())
             rhi::SuspendRendering();
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        rhi::ShaderCache::Save("~doc:/ShaderCache.bin");
         engine->suspended.Emit();
 
         Logger::Info("EngineBackend::HandleAppSuspended: leave");
@@ -810,7 +814,9 @@ void EngineBackend::InitRenderer(Window* w)
     w->InitCustomRenderParams(rendererParams);
 
     rhi::ShaderSourceCache::Load("~doc:/ShaderSource.bin");
+    rhi::ShaderCache::Load("~doc:/ShaderCache.bin");
     Renderer::Initialize(renderer, rendererParams);
+    ShaderDescriptorCache::SetAsyncCompilationEnabled(options->GetBool("shader_async_compilation"));
     context->renderSystem2D->Init();
 
     if (options->GetBool("init_imgui"))
@@ -9,6 +9,7 @@
 #include "FileSystem/FileAPIHelper.h"
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FileSystemDelegate.h"
+#include "FileSystem/Private/ArchiveFileView.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/CheckIOError.h"
 #include "FileSystem/ResourceArchive.h"
@@ -201,20 +202,34 @@ File* File::Create(const FilePath& filename, uint32 attributes)
 File* File::LoadFileFromMountedArchive(const String& packName, const String& relative)
 {
     FileSystem* fs = FileSystem::Instance();
+    std::shared_ptr<ResourceArchive> archive;
     {
         LockGuard<Mutex> lock(fs->accessArchiveMap);
 
         auto it = fs->resArchiveMap.find(packName);
         if (it != end(fs->resArchiveMap))
         {
-            Vector<uint8> fileContent;
-            if (it->second.archive->LoadFile(relative, fileContent))
-            {
-                return DynamicMemoryFile::Create(std::move(fileContent), READ, "~res:/" + relative);
-            }
+            archive = it->second.archive;
+        }
+    }
+
+    // archive is read without map lock, so many threads can load files at once
+    if (archive)
+    {
+        // uncompressed content is read straight from mapped archive without copying
+        File* view = ArchiveFileView::Create(archive, relative, "~res:/" + relative);
+        if (view != nullptr)
+        {
+            return view;
+        }
+
+        Vector<uint8> fileContent;
+        if (archive->LoadFile(relative, fileContent))
+        {
+            return DynamicMemoryFile::Create(std::move(fileContent), READ, "~res:/" + relative);
         }
-        return nullptr;
     }
+    return nullptr;
 }
 
 bool File::IsFileInMountedArchive(const String& packName, const String& relative)
@@ -323,7 +323,7 @@ private:
         {
         }
 
-        std::unique_ptr<ResourceArchive> archive;
+        std::shared_ptr<ResourceArchive> archive; // shared to allow reading from archive without holding accessArchiveMap
         String attachPath;
         FilePath archiveFilePath;
     };
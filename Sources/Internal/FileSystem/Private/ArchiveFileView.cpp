@@ -0,0 +1,113 @@
+#include "FileSystem/Private/ArchiveFileView.h"
+#include "FileSystem/ResourceArchive.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+ArchiveFileView* ArchiveFileView::Create(const std::shared_ptr<ResourceArchive>& archive, const String& relativeFilePath, const FilePath& name)
+{
+    const uint8* data = nullptr;
+    uint32 size = 0;
+    if (!archive->GetFileView(relativeFilePath, data, size))
+    {
+        return nullptr;
+    }
+
+    ArchiveFileView* file = new ArchiveFileView();
+    file->archive = archive;
+    file->data = data;
+    file->size = size;
+    file->filename = name;
+    return file;
+}
+
+uint32 ArchiveFileView::Write(const void* sourceBuffer, uint32 dataSize)
+{
+    return 0;
+}
+
+uint32 ArchiveFileView::Read(void* destinationBuffer, uint32 dataSize)
+{
+    DVASSERT(nullptr != destinationBuffer);
+
+    if (currentPtr == size && !isEof && dataSize > 0)
+    {
+        isEof = true;
+        return 0;
+    }
+
+    uint64 realReadSize = dataSize;
+    if (currentPtr + realReadSize > size)
+    {
+        isEof = true;
+        realReadSize = (currentPtr < size) ? size - currentPtr : 0;
+    }
+    if (realReadSize > 0)
+    {
+        Memcpy(destinationBuffer, data + currentPtr, static_cast<size_t>(realReadSize));
+        currentPtr += realReadSize;
+    }
+
+    return static_cast<uint32>(realReadSize);
+}
+
+uint64 ArchiveFileView::GetPos() const
+{
+    return currentPtr;
+}
+
+uint64 ArchiveFileView::GetSize() const
+{
+    return size;
+}
+
+bool ArchiveFileView::Seek(int64 position, eFileSeek seekType)
+{
+    int64 pos = 0;
+    switch (seekType)
+    {
+    case SEEK_FROM_START:
+        pos = position;
+        break;
+    case SEEK_FROM_CURRENT:
+        pos = static_cast<int64>(GetPos()) + position;
+        break;
+    case SEEK_FROM_END:
+        pos = static_cast<int64>(GetSize()) - 1 + position;
+        break;
+    default:
+        return false;
+    };
+
+    if (pos < 0)
+    {
+        return false;
+    }
+
+    if (pos > static_cast<int64>(size))
+    {
+        Logger::Warning("archive file view is readonly, you about to seek over EOF (POSIX let it)");
+    }
+
+    currentPtr = static_cast<uint64>(pos);
+    // behavior like in std::FILE http://en.cppreference.com/w/c/io/fseek
+    isEof = false;
+
+    return true;
+}
+
+bool ArchiveFileView::IsEof() const
+{
+    return isEof;
+}
+
+bool ArchiveFileView::Truncate(uint64 size)
+{
+    return false;
+}
+
+bool ArchiveFileView::Flush()
+{
+    return true;
+}
+} // end namespace DAVA
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/File.h"
+
+namespace DAVA
+{
+class ResourceArchive;
+
+/**
+    Read-only file over content of the file stored in archive without compression.
+
+    Content isn't copied: file reads straight from memory-mapped archive and keeps the archive alive
+    while file exists, so archive can be unmounted while file is still in use.
+    Reading and seeking behave like in `DynamicMemoryFile` opened for reading.
+*/
+class ArchiveFileView final : public File
+{
+public:
+    /** Return nullptr if file doesn't exist in archive or can't be viewed (compressed or archive isn't memory-mapped). */
+    static ArchiveFileView* Create(const std::shared_ptr<ResourceArchive>& archive, const String& relativeFilePath, const FilePath& name);
+
+    uint32 Write(const void* sourceBuffer, uint32 dataSize) override;
+    uint32 Read(void* destinationBuffer, uint32 dataSize) override;
+    uint64 GetPos() const override;
+    uint64 GetSize() const override;
+    bool Seek(int64 position, eFileSeek seekType) override;
+    bool IsEof() const override;
+    bool Truncate(uint64 size) override;
+    bool Flush() override;
+
+private:
+    ArchiveFileView() = default;
+    ~ArchiveFileView() override = default;
+
+    std::shared_ptr<ResourceArchive> archive;
+    const uint8* data = nullptr;
+    uint32 size = 0;
+    uint64 currentPtr = 0;
+    bool isEof = false;
+};
+} // end namespace DAVA
@@ -0,0 +1,114 @@
+#include "FileSystem/Private/MappedFile.h"
+#include "Logger/Logger.h"
+
+#if defined(__DAVAENGINE_WIN32__)
+#include "Utils/UTF8Utils.h"
+#include <windows.h>
+#elif defined(__DAVAENGINE_POSIX__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DAVA
+{
+#if defined(__DAVAENGINE_WIN32__)
+
+MappedFile::MappedFile(const FilePath& filePath)
+{
+    WideString path = UTF8Utils::EncodeToWideString(filePath.GetAbsolutePathname());
+    HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (::GetFileSizeEx(file, &fileSize) == FALSE || fileSize.QuadPart == 0)
+    {
+        ::CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        ::CloseHandle(file);
+        return;
+    }
+
+    void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        Logger::Warning("Can't map file %s, error %u", filePath.GetStringValue().c_str(), ::GetLastError());
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+    {
+        ::UnmapViewOfFile(data);
+        ::CloseHandle(mappingHandle);
+        ::CloseHandle(fileHandle);
+    }
+}
+
+#elif defined(__DAVAENGINE_POSIX__)
+
+MappedFile::MappedFile(const FilePath& filePath)
+{
+    int fd = ::open(filePath.GetAbsolutePathname().c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return;
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        void* view = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (view != MAP_FAILED)
+        {
+            data = static_cast<const uint8*>(view);
+            size = static_cast<uint64>(fileStat.st_size);
+        }
+        else
+        {
+            Logger::Warning("Can't map file %s, errno %d", filePath.GetStringValue().c_str(), errno);
+        }
+    }
+
+    // mapping stays valid after descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+    {
+        ::munmap(const_cast<uint8*>(data), static_cast<size_t>(size));
+    }
+}
+
+#else
+
+// Memory mapping isn't supported on this platform, callers fall back to regular file reading
+MappedFile::MappedFile(const FilePath& filePath)
+{
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+} // end namespace DAVA
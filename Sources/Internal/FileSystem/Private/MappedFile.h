@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+/**
+    Read-only memory mapping of a whole file.
+
+    Mapped data can be read from any number of threads at once without locks.
+    Mapping isn't available for files that aren't in the native file system (e.g. inside Android APK),
+    in this case `IsMapped` returns false and caller should fall back to regular `File` reading.
+*/
+class MappedFile final
+{
+public:
+    explicit MappedFile(const FilePath& filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsMapped() const;
+    const uint8* GetData() const;
+    uint64 GetSize() const;
+
+private:
+    const uint8* data = nullptr;
+    uint64 size = 0;
+
+#if defined(__DAVAENGINE_WIN32__)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+inline bool MappedFile::IsMapped() const
+{
+    return data != nullptr;
+}
+
+inline const uint8* MappedFile::GetData() const
+{
+    return data;
+}
+
+inline uint64 MappedFile::GetSize() const
+{
+    return size;
+}
+} // end namespace DAVA
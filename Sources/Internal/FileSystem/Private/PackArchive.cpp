@@ -5,6 +5,7 @@
 #include "Utils/CRC32.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
+#include "Concurrency/LockGuard.h"
 
 #include <mutex>
 
@@ -174,6 +175,13 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         }
         packMeta.reset(new PackMetaData(&metaBlock[0], metaBlock.size(), fileNames));
     }
+
+    // all further reads go through mapping when it is available
+    mappedFile.reset(new MappedFile(archiveName));
+    if (!mappedFile->IsMapped() || mappedFile->GetSize() != size)
+    {
+        mappedFile.reset();
+    }
 }
 
 const Vector<ResourceArchive::FileInfo>& PackArchive::GetFilesInfo() const
@@ -206,68 +214,154 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
 {
     using namespace PackFormat;
 
-    if (!HasFile(relativeFilePath))
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
     {
         return false;
     }
 
-    const FileTableEntry& fileEntry = *mapFileData.find(relativeFilePath)->second;
+    const FileTableEntry& fileEntry = *it->second;
     output.resize(fileEntry.originalSize);
 
-    if (!file)
+    bool isOk = mappedFile ? ReadMappedFileContent(fileEntry, relativeFilePath, output) : ReadFileContent(fileEntry, relativeFilePath, output);
+    if (!isOk)
     {
-        DAVA_THROW(DAVA::Exception, "can't open: " + relativeFilePath + " from pack: " + archiveName.GetStringValue());
+        return false;
     }
 
-    bool isOk = file->Seek(fileEntry.startPosition, File::SEEK_FROM_START);
-    if (!isOk)
+    CheckCrc32(fileEntry, relativeFilePath, output.data(), output.size());
+
+    return true;
+}
+
+bool PackArchive::GetFileView(const String& relativeFilePath, const uint8*& data, uint32& size) const
+{
+    using namespace PackFormat;
+
+    if (!mappedFile)
+    {
+        return false;
+    }
+
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
+    {
+        return false;
+    }
+
+    const FileTableEntry& fileEntry = *it->second;
+    if (fileEntry.type != Compressor::Type::None || fileEntry.startPosition + fileEntry.originalSize > mappedFile->GetSize())
+    {
+        return false;
+    }
+
+    data = mappedFile->GetData() + fileEntry.startPosition;
+    size = fileEntry.originalSize;
+
+    CheckCrc32(fileEntry, relativeFilePath, data, size);
+
+    return true;
+}
+
+bool PackArchive::ReadMappedFileContent(const PackFormat::FileTableEntry& fileEntry, const String& relativeFilePath, Vector<uint8>& output) const
+{
+    // content is taken straight from mapping, so no locks and intermediate buffers are needed
+    uint32 storedSize = (fileEntry.type == Compressor::Type::None) ? fileEntry.originalSize : fileEntry.compressedSize;
+    if (fileEntry.startPosition + storedSize > mappedFile->GetSize())
     {
-        Logger::Error("can't load file: %s course: can't find start file position in pack file", relativeFilePath.c_str());
+        Logger::Error("can't load file: %s course: content is out of pack file bounds", relativeFilePath.c_str());
         return false;
     }
 
+    const uint8* content = mappedFile->GetData() + fileEntry.startPosition;
+
     switch (fileEntry.type)
     {
     case Compressor::Type::None:
     {
-        uint32 readOk = file->Read(output.data(), fileEntry.originalSize);
-        if (readOk != fileEntry.originalSize)
-        {
-            Logger::Error("can't load file: %s course: can't read uncompressed content", relativeFilePath.c_str());
-            return false;
-        }
+        std::copy_n(content, fileEntry.originalSize, output.data());
     }
     break;
     case Compressor::Type::Lz4:
     case Compressor::Type::Lz4HC:
     {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
-
-        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
-        if (readOk != fileEntry.compressedSize)
+        if (!LZ4Compressor().Decompress(content, fileEntry.compressedSize, output.data(), output.size()))
         {
-            Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
+            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
             return false;
         }
-
-        if (!LZ4Compressor().Decompress(packedBuf, output))
+    }
+    break;
+    case Compressor::Type::RFC1951:
+    {
+        if (!ZipCompressor().Decompress(content, fileEntry.compressedSize, output.data(), output.size()))
         {
             Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
             return false;
         }
     }
     break;
-    case Compressor::Type::RFC1951:
+    } // end switch
+
+    return true;
+}
+
+bool PackArchive::ReadFileContent(const PackFormat::FileTableEntry& fileEntry, const String& relativeFilePath, Vector<uint8>& output) const
+{
+    if (!file)
     {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
+        DAVA_THROW(DAVA::Exception, "can't open: " + relativeFilePath + " from pack: " + archiveName.GetStringValue());
+    }
+
+    Vector<uint8> packedBuf;
+
+    {
+        LockGuard<Mutex> lock(fileMutex);
+
+        bool isOk = file->Seek(fileEntry.startPosition, File::SEEK_FROM_START);
+        if (!isOk)
+        {
+            Logger::Error("can't load file: %s course: can't find start file position in pack file", relativeFilePath.c_str());
+            return false;
+        }
+
+        if (fileEntry.type == Compressor::Type::None)
+        {
+            uint32 readOk = file->Read(output.data(), fileEntry.originalSize);
+            if (readOk != fileEntry.originalSize)
+            {
+                Logger::Error("can't load file: %s course: can't read uncompressed content", relativeFilePath.c_str());
+                return false;
+            }
+            return true;
+        }
 
+        packedBuf.resize(fileEntry.compressedSize);
         uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
         if (readOk != fileEntry.compressedSize)
         {
             Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
             return false;
         }
+    }
 
+    // decompress outside of lock, so other threads can read the pack meanwhile
+    switch (fileEntry.type)
+    {
+    case Compressor::Type::None:
+        break;
+    case Compressor::Type::Lz4:
+    case Compressor::Type::Lz4HC:
+    {
+        if (!LZ4Compressor().Decompress(packedBuf, output))
+        {
+            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
+            return false;
+        }
+    }
+    break;
+    case Compressor::Type::RFC1951:
+    {
         if (!ZipCompressor().Decompress(packedBuf, output))
         {
             Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
@@ -277,14 +371,17 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     break;
     } // end switch
 
+    return true;
+}
+
+void PackArchive::CheckCrc32(const PackFormat::FileTableEntry& fileEntry, const String& relativeFilePath, const uint8* data, size_t size) const
+{
     // check crc32 for file content
-    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(output.data(), output.size()))
+    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(data, size))
     {
         String msg = "original crc32 not match for: " + relativeFilePath + " during decompress from pack: " + archiveName.GetStringValue();
         throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
     }
-
-    return true;
 }
 
 uint32 PackArchive::GetFileIndex(const String& releativeFilePath) const
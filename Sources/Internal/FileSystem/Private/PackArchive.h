@@ -3,7 +3,9 @@
 #include "FileSystem/Private/ResourceArchivePrivate.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/PackMetaData.h"
+#include "FileSystem/Private/MappedFile.h"
 #include "FileSystem/File.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
@@ -16,6 +18,7 @@ public:
     const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const override;
     bool HasFile(const String& relativeFilePath) const override;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const override;
+    bool GetFileView(const String& relativeFilePath, const uint8*& data, uint32& size) const override;
 
     /**
 		return index of struct with file info, usefull for meta data
@@ -43,8 +46,14 @@ public:
                               Vector<ResourceArchive::FileInfo>& filesInfo);
 
 private:
+    bool ReadFileContent(const PackFormat::FileTableEntry& fileEntry, const String& relativeFilePath, Vector<uint8>& output) const;
+    bool ReadMappedFileContent(const PackFormat::FileTableEntry& fileEntry, const String& relativeFilePath, Vector<uint8>& output) const;
+    void CheckCrc32(const PackFormat::FileTableEntry& fileEntry, const String& relativeFilePath, const uint8* data, size_t size) const;
+
     const FilePath archiveName;
+    mutable Mutex fileMutex; // file can be read from many threads, when pack isn't memory-mapped
     mutable RefPtr<File> file;
+    std::unique_ptr<MappedFile> mappedFile; // if pack is mapped, all content is read without locks
     PackFormat::PackFile packFile;
     std::unique_ptr<PackMetaData> packMeta;
     UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
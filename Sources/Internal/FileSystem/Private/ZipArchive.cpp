@@ -2,6 +2,7 @@
 #include "FileSystem/FilePath.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
+#include "Concurrency/LockGuard.h"
 
 namespace DAVA
 {
@@ -72,6 +73,7 @@ bool ZipArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output)
     {
         output.resize(info->originalSize);
 
+        LockGuard<Mutex> lock(zipFileMutex);
         if (!zipFile.LoadFile(relativeFilePath, output))
         {
             Logger::Error("can't extract file: %s into memory", relativeFilePath.c_str());
@@ -81,4 +83,9 @@ bool ZipArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output)
     }
     return false;
 }
+
+bool ZipArchive::GetFileView(const String& relativeFilePath, const uint8*& data, uint32& size) const
+{
+    return false;
+}
 } // end namespace DAVA
@@ -2,6 +2,7 @@
 
 #include "FileSystem/Private/ResourceArchivePrivate.h"
 #include "Compression/ZipCompressor.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
@@ -14,8 +15,10 @@ public:
     const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const override;
     bool HasFile(const String& relativeFilePath) const override;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const override;
+    bool GetFileView(const String& relativeFilePath, const uint8*& data, uint32& size) const override;
 
 private:
+    mutable Mutex zipFileMutex;
     ZipFile zipFile;
     Vector<ResourceArchive::FileInfo> fileInfos;
 };
@@ -44,6 +44,13 @@ public:
     bool HasFile(const String& relativeFilePath) const;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& outputFileContent) const;
 
+    /**
+        Get content of the file stored in archive without compression, directly from memory-mapped archive.
+        Returned pointer is valid while archive exists.
+        Return false if file doesn't exist, is compressed or archive isn't memory-mapped; use `LoadFile` in this case.
+    */
+    bool GetFileView(const String& relativeFilePath, const uint8*& data, uint32& size) const;
+
     bool UnpackToFolder(const FilePath& dir) const;
 
 private:
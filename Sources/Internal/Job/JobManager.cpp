@@ -5,27 +5,44 @@
 #include "Debug/ProfilerMarkerNames.h"
 #include "Engine/Engine.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/ThreadLocalPtr.h"
 #include "Concurrency/UniqueLock.h"
 #include "Job/JobThread.h"
 #include "Platform/DeviceInfo.h"
 
+#include <atomic>
+
 namespace DAVA
 {
+namespace JobManagerDetails
+{
+// JobThread of the current thread, nullptr for non-worker threads
+static ThreadLocalPtr<JobThread> currentJobThread;
+// Task which function is executed by the current thread
+static ThreadLocalPtr<Private::JobTask> currentJobTask;
+}
+
 JobManager::JobManager(Engine* e)
     : engine(e)
     , mainJobIDCounter(1)
     , mainJobLastExecutedID(0)
-    , workerDoneSem(0)
 {
-    uint32 cpuCoresCount = DeviceInfo::GetCpuCount();
+    uint32 cpuCoresCount = std::max(DeviceInfo::GetCpuCount(), 1);
     workerThreads.reserve(cpuCoresCount);
 
     for (uint32 i = 0; i < cpuCoresCount; ++i)
     {
-        JobThread* thread = new JobThread(&workerQueue, &workerDoneSem);
+        JobThread* thread = new JobThread(this, i);
         workerThreads.push_back(thread);
     }
 
+    // start threads only when all of them are created,
+    // as each thread can steal tasks from any other
+    for (JobThread* thread : workerThreads)
+    {
+        thread->Start();
+    }
+
     e->update.Connect(this, &JobManager::Update);
 }
 
@@ -41,6 +58,12 @@ JobManager::~JobManager()
     mainJobIDCounter = 0;
     mainCV.NotifyAll();
 
+    workersCancel = true;
+    {
+        LockGuard<Mutex> guard(workersSleepMutex);
+        workersSleepCV.NotifyAll();
+    }
+
     for (uint32 i = 0; i < workerThreads.size(); ++i)
     {
         SafeDelete(workerThreads[i]);
@@ -129,6 +152,9 @@ uint32 JobManager::CreateMainJob(const Function<void()>& fn, eMainJobType mainJo
             LockGuard<Mutex> guard(mainQueueMutex);
             mainJobs.push_back(job);
         }
+
+        // main thread can be waiting for worker tasks, wake it up to execute this job
+        NotifyWaiters();
     }
 
     return jobID;
@@ -154,7 +180,7 @@ void JobManager::WaitMainJobs(Thread::Id invokerThreadId /* = 0 */)
     {
         // If main thread is locked by WaitWorkerJobs this instruction will unlock
         // main thread, allowing it to perform all scheduled main-thread jobs
-        workerDoneSem.Post();
+        NotifyWaiters();
 
         // Now check if there are some jobs in the queue and wait for them
         UniqueLock<Mutex> lock(mainCVMutex);
@@ -185,7 +211,7 @@ void JobManager::WaitMainJobID(uint32 mainJobID)
     {
         // If main thread is locked by WaitWorkerJobs this instruction will unlock
         // main thread, allowing it to perform all scheduled main-thread jobs
-        workerDoneSem.Post();
+        NotifyWaiters();
 
         // Now check if there are some jobs in the queue and wait for them
         UniqueLock<Mutex> lock(mainCVMutex);
@@ -237,33 +263,258 @@ bool JobManager::HasMainJobID(uint32 mainJobID)
 
 void JobManager::CreateWorkerJob(const Function<void()>& fn)
 {
-    workerQueue.Push(fn);
-    workerQueue.Signal();
+    CreateWorkerTask(fn);
 }
 
 void JobManager::WaitWorkerJobs()
 {
-    while (HasWorkerJobs())
+    WaitUntil([this]() { return activeTasksCount.Get() == 0; });
+}
+
+bool JobManager::HasWorkerJobs()
+{
+    return activeTasksCount.Get() != 0;
+}
+
+JobHandle JobManager::CreateWorkerTask(const Function<void()>& fn, JobGroup* group, const JobHandle& parent, const Vector<JobHandle>& dependencies)
+{
+    JobHandle task = std::make_shared<Private::JobTask>();
+    task->fn = fn;
+    task->group = group;
+    task->parent = parent;
+
+    activeTasksCount++;
+    if (nullptr != group)
+    {
+        group->pendingCount++;
+    }
+
+    if (parent)
+    {
+        // parent can't finish while it has not finished children
+        int32 parentUnfinished = parent->unfinishedCount++;
+        DVASSERT(parentUnfinished > 0, "Child task can't be added to already finished parent task");
+    }
+
+    for (const JobHandle& dependency : dependencies)
     {
-        if (Thread::IsMainThread())
+        if (dependency)
+        {
+            LockGuard<Spinlock> guard(dependency->continuationsLock);
+            if (!dependency->finished)
+            {
+                task->pendingDependencies++;
+                dependency->continuations.push_back(task);
+            }
+        }
+    }
+
+    // release creation guard, task is scheduled here if all dependencies are already finished,
+    // otherwise it will be scheduled by the last finished dependency
+    if (--task->pendingDependencies == 0)
+    {
+        ScheduleTask(task);
+    }
+
+    return task;
+}
+
+JobHandle JobManager::GetCurrentWorkerTask() const
+{
+    Private::JobTask* task = JobManagerDetails::currentJobTask.Get();
+    return (nullptr != task) ? task->shared_from_this() : JobHandle();
+}
+
+bool JobManager::IsWorkerTaskFinished(const JobHandle& task) const
+{
+    return !task || task->finished;
+}
+
+void JobManager::WaitWorkerTask(const JobHandle& task)
+{
+    WaitUntil([this, &task]() { return IsWorkerTaskFinished(task); });
+}
+
+void JobManager::WaitWorkerGroup(JobGroup* group)
+{
+    DVASSERT(nullptr != group);
+    WaitUntil([group]() { return group->IsDone(); });
+}
+
+void JobManager::ScheduleTask(const JobHandle& task)
+{
+    JobThread* currentThread = JobManagerDetails::currentJobThread.Get();
+    if (nullptr == currentThread)
+    {
+        // tasks created outside of worker threads are distributed between queues in round-robin order
+        uint32 index = nextQueueIndex++ % static_cast<uint32>(workerThreads.size());
+        currentThread = workerThreads[index];
+    }
+
+    // counter is incremented before push, so task can't be taken from the queue before it is counted
+    queuedTasksCount++;
+    currentThread->GetQueue()->Push(task);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepingWorkersCount.Get() > 0)
+    {
+        LockGuard<Mutex> guard(workersSleepMutex);
+        workersSleepCV.NotifyOne();
+    }
+
+    // waiting threads can help with execution
+    NotifyWaiters();
+}
+
+void JobManager::ExecuteTask(const JobHandle& task)
+{
+    // tasks can be executed recursively while waiting, so restore previous task afterwards
+    Private::JobTask* prevTask = JobManagerDetails::currentJobTask.Release();
+    JobManagerDetails::currentJobTask.Reset(task.get());
+
+    task->fn();
+    task->fn = nullptr;
+
+    JobManagerDetails::currentJobTask.Release();
+    JobManagerDetails::currentJobTask.Reset(prevTask);
+
+    FinishTask(task);
+}
+
+void JobManager::FinishTask(JobHandle task)
+{
+    while (task && --task->unfinishedCount == 0)
+    {
+        Vector<JobHandle> continuations;
+        {
+            LockGuard<Spinlock> guard(task->continuationsLock);
+            task->finished = true;
+            continuations.swap(task->continuations);
+        }
+
+        // group can be destroyed right after its counter reaches zero, so don't touch it after that
+        if (nullptr != task->group)
+        {
+            task->group->pendingCount--;
+        }
+        activeTasksCount--;
+
+        for (const JobHandle& continuation : continuations)
+        {
+            if (--continuation->pendingDependencies == 0)
+            {
+                ScheduleTask(continuation);
+            }
+        }
+
+        // task with all its children is finished, so one more part of the parent is finished
+        JobHandle parent = std::move(task->parent);
+        task = std::move(parent);
+    }
+
+    NotifyWaiters();
+}
+
+bool JobManager::RunNextTask(JobThread* currentThread)
+{
+    JobHandle task;
+
+    uint32 threadsCount = static_cast<uint32>(workerThreads.size());
+    uint32 firstVictim = 0;
+
+    if (nullptr != currentThread)
+    {
+        task = currentThread->GetQueue()->Pop();
+        firstVictim = currentThread->GetIndex() + 1;
+    }
+    else
+    {
+        firstVictim = nextQueueIndex.Get();
+    }
+
+    for (uint32 i = 0; !task && i < threadsCount; ++i)
+    {
+        JobThread* victim = workerThreads[(firstVictim + i) % threadsCount];
+        if (victim != currentThread)
+        {
+            task = victim->GetQueue()->Steal();
+        }
+    }
+
+    if (task)
+    {
+        queuedTasksCount--;
+        ExecuteTask(task);
+        return true;
+    }
+
+    return false;
+}
+
+void JobManager::WaitUntil(const Function<bool()>& isDone)
+{
+    JobThread* currentThread = JobManagerDetails::currentJobThread.Get();
+    bool isMainThread = Thread::IsMainThread();
+
+    while (!isDone())
+    {
+        if (RunNextTask(currentThread))
+        {
+            continue;
+        }
+
+        if (isMainThread && HasQueuedMainJobs())
         {
             // We want to be able to wait worker jobs, but at the same time
-            // allow any worker job execute main job. Potentially this will cause
-            // dead lock, but there is a simple solution:
-            //
-            // Every time, worker job is trying to execute WaitMainJobs it will
-            // post workerDoneSem semaphore, that will give a chance to execute main jobs
-            // in the following Update() call
-            //
+            // allow any worker job execute main job, so execute them here
             Update();
+            continue;
         }
 
-        workerDoneSem.Wait();
+        UniqueLock<Mutex> lock(waitingThreadsMutex);
+        waitingThreadsCount++;
+        while (!isDone() && queuedTasksCount.Get() == 0 && !(isMainThread && HasQueuedMainJobs()))
+        {
+            waitingThreadsCV.Wait(lock);
+        }
+        waitingThreadsCount--;
     }
 }
 
-bool JobManager::HasWorkerJobs()
+void JobManager::NotifyWaiters()
 {
-    return !workerQueue.IsEmpty();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waitingThreadsCount.Get() > 0)
+    {
+        LockGuard<Mutex> guard(waitingThreadsMutex);
+        waitingThreadsCV.NotifyAll();
+    }
+}
+
+bool JobManager::HasQueuedMainJobs()
+{
+    LockGuard<Mutex> guard(mainQueueMutex);
+    return !mainJobs.empty();
+}
+
+void JobManager::WorkerThreadFunc(JobThread* jobThread)
+{
+    JobManagerDetails::currentJobThread.Reset(jobThread);
+
+    while (!workersCancel)
+    {
+        if (!RunNextTask(jobThread))
+        {
+            UniqueLock<Mutex> lock(workersSleepMutex);
+            sleepingWorkersCount++;
+            while (queuedTasksCount.Get() == 0 && !workersCancel)
+            {
+                workersSleepCV.Wait(lock);
+            }
+            sleepingWorkersCount--;
+        }
+    }
+
+    JobManagerDetails::currentJobThread.Release();
 }
 }
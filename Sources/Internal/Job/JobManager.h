@@ -2,11 +2,11 @@
 
 #include "Base/BaseTypes.h"
 #include "Concurrency/Atomic.h"
+#include "Concurrency/ConditionVariable.h"
 #include "Concurrency/Mutex.h"
-#include "Concurrency/Semaphore.h"
 #include "Concurrency/Thread.h"
 #include "Functional/Function.h"
-#include "Job/JobQueue.h"
+#include "Job/JobTask.h"
 
 namespace DAVA
 {
@@ -70,7 +70,46 @@ public:
 	*/
     bool HasWorkerJobs();
 
+    /*! Add task to execute in the worker-thread.
+        Tasks are distributed between per-thread queues, idle worker-threads steal tasks from busy ones.
+        \param [in] fn Function to execute.
+        \param [in] group Optional group the task belongs to. Group is done when all of its tasks are finished.
+        \param [in] parent Optional not finished task, that will be considered finished only after this task is finished.
+        \param [in] dependencies Tasks that should be finished before this task starts.
+        \return Handle of created task.
+    */
+    JobHandle CreateWorkerTask(const Function<void()>& fn, JobGroup* group = nullptr, const JobHandle& parent = JobHandle(), const Vector<JobHandle>& dependencies = Vector<JobHandle>());
+
+    /*! Return handle of the task executed by the current thread, or empty handle if there is no such task.
+        Can be used inside of task function to add children to the current task.
+    */
+    JobHandle GetCurrentWorkerTask() const;
+
+    /*! Check if task and all of its children are finished. Empty handle is considered finished. */
+    bool IsWorkerTaskFinished(const JobHandle& task) const;
+
+    /*! Wait until task and all of its children are finished.
+        Calling thread executes queued worker tasks while waiting, so it is safe to wait from the worker task.
+    */
+    void WaitWorkerTask(const JobHandle& task);
+
+    /*! Wait until all tasks of the group are finished.
+        Calling thread executes queued worker tasks while waiting, so it is safe to wait from the worker task.
+    */
+    void WaitWorkerGroup(JobGroup* group);
+
 protected:
+    friend class JobThread;
+
+    void ScheduleTask(const JobHandle& task);
+    void ExecuteTask(const JobHandle& task);
+    void FinishTask(JobHandle task);
+    bool RunNextTask(JobThread* currentThread);
+    void WaitUntil(const Function<bool()>& isDone);
+    void NotifyWaiters();
+    bool HasQueuedMainJobs();
+    void WorkerThreadFunc(JobThread* jobThread);
+
     struct MainJob
     {
         MainJob()
@@ -97,8 +136,18 @@ protected:
     ConditionVariable mainCV;
     MainJob curMainJob;
 
-    Semaphore workerDoneSem;
-    JobQueueWorker workerQueue;
     Vector<JobThread*> workerThreads;
+    Atomic<bool> workersCancel{ false };
+    Atomic<uint32> nextQueueIndex{ 0 };
+    Atomic<int32> queuedTasksCount{ 0 };
+    Atomic<int32> activeTasksCount{ 0 };
+
+    Atomic<int32> sleepingWorkersCount{ 0 };
+    Mutex workersSleepMutex;
+    ConditionVariable workersSleepCV;
+
+    Atomic<int32> waitingThreadsCount{ 0 };
+    Mutex waitingThreadsMutex;
+    ConditionVariable waitingThreadsCV;
 };
 }
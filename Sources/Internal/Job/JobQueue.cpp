@@ -1,91 +1,39 @@
 #include "Job/JobQueue.h"
-#include "Job/JobManager.h"
 #include "Concurrency/LockGuard.h"
 
 namespace DAVA
 {
-JobQueueWorker::JobQueueWorker(uint32 maxCount /* = 1024 */)
-    : jobsMaxCount(maxCount)
-    , nextPushIndex(0)
-    , nextPopIndex(0)
-    , processingCount(0)
+void JobStealingQueue::Push(const JobHandle& task)
 {
-    jobs = new Function<void()>[jobsMaxCount];
+    LockGuard<Spinlock> guard(lock);
+    tasks.push_back(task);
 }
 
-JobQueueWorker::~JobQueueWorker()
+JobHandle JobStealingQueue::Pop()
 {
-    SafeDeleteArray(jobs);
-}
+    JobHandle task;
 
-void JobQueueWorker::Push(const Function<void()>& fn)
-{
-    if (fn != nullptr)
+    LockGuard<Spinlock> guard(lock);
+    if (!tasks.empty())
     {
-        LockGuard<Spinlock> guard(lock);
-        if (nextPushIndex == nextPopIndex && 0 == processingCount)
-        {
-            nextPushIndex = 0;
-            nextPopIndex = 0;
-        }
-
-        DVASSERT(nextPushIndex < jobsMaxCount);
-
-        jobs[nextPushIndex++] = fn;
-        processingCount++;
+        task = std::move(tasks.back());
+        tasks.pop_back();
     }
+
+    return task;
 }
 
-bool JobQueueWorker::PopAndExec()
+JobHandle JobStealingQueue::Steal()
 {
-    bool ret = false;
-    Function<void()> fn;
+    JobHandle task;
 
+    LockGuard<Spinlock> guard(lock);
+    if (!tasks.empty())
     {
-        LockGuard<Spinlock> guard(lock);
-        if (nextPopIndex < nextPushIndex)
-        {
-            fn = std::move(jobs[nextPopIndex++]);
-        }
-    }
-
-    if (fn != nullptr)
-    {
-        fn();
-
-        {
-            LockGuard<Spinlock> guard(lock);
-            DVASSERT(processingCount > 0);
-            processingCount--;
-        }
-
-        ret = true;
+        task = std::move(tasks.front());
+        tasks.pop_front();
     }
 
-    return ret;
-}
-
-bool JobQueueWorker::IsEmpty()
-{
-    LockGuard<Spinlock> guard(lock);
-    return (nextPopIndex == nextPushIndex && 0 == processingCount);
-}
-
-void JobQueueWorker::Signal()
-{
-    LockGuard<Mutex> guard(jobsInQueueMutex);
-    jobsInQueueCV.NotifyOne();
-}
-
-void JobQueueWorker::Broadcast()
-{
-    LockGuard<Mutex> guard(jobsInQueueMutex);
-    jobsInQueueCV.NotifyAll();
-}
-
-void JobQueueWorker::Wait()
-{
-    UniqueLock<Mutex> lock(jobsInQueueMutex);
-    jobsInQueueCV.Wait(lock);
+    return task;
 }
 }
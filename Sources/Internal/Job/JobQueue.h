@@ -1,38 +1,28 @@
 #pragma once
 
 #include "Base/BaseTypes.h"
-#include "Functional/Function.h"
-#include "Concurrency/ConditionVariable.h"
-#include "Concurrency/Mutex.h"
 #include "Concurrency/Spinlock.h"
+#include "Job/JobTask.h"
 
 namespace DAVA
 {
-class JobQueueWorker
+/**
+    \ingroup job
+    Per-thread queue of worker tasks.
+
+    Owner thread pushes and pops tasks from the back of the queue (LIFO, keeps data hot in cache),
+    other threads steal tasks from the front (FIFO, takes the oldest and usually the biggest work).
+    Each worker thread has its own queue, so threads contend only when one of them is stealing.
+*/
+class JobStealingQueue
 {
 public:
-    JobQueueWorker(uint32 maxCount = 1024);
-    virtual ~JobQueueWorker();
-
-    void Push(const Function<void()>& fn);
-    bool PopAndExec();
-
-    bool IsEmpty();
-
-    void Signal();
-    void Broadcast();
-    void Wait();
-
-protected:
-    uint32 jobsMaxCount;
-    Function<void()>* jobs;
-
-    uint32 nextPushIndex;
-    uint32 nextPopIndex;
-    int32 processingCount;
+    void Push(const JobHandle& task);
+    JobHandle Pop();
+    JobHandle Steal();
 
+private:
     Spinlock lock;
-    ConditionVariable jobsInQueueCV;
-    Mutex jobsInQueueMutex;
+    Deque<JobHandle> tasks;
 };
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Spinlock.h"
+#include "Functional/Function.h"
+
+#include <memory>
+
+namespace DAVA
+{
+class JobManager;
+class JobGroup;
+
+namespace Private
+{
+/**
+    \ingroup job
+    Internal representation of a worker task created by `JobManager::CreateWorkerTask`.
+
+    Task is considered finished when its own function and all of its children have been executed.
+    Task is scheduled for execution only when all of its dependencies are finished.
+*/
+struct JobTask : public std::enable_shared_from_this<JobTask>
+{
+    Function<void()> fn;
+
+    /** Own function plus not finished children. */
+    Atomic<int32> unfinishedCount{ 1 };
+    /** Not finished dependencies plus one creation guard. */
+    Atomic<int32> pendingDependencies{ 1 };
+    Atomic<bool> finished{ false };
+
+    std::shared_ptr<JobTask> parent;
+    JobGroup* group = nullptr;
+
+    /** Protects `continuations` and transition of `finished` flag. */
+    Spinlock continuationsLock;
+    Vector<std::shared_ptr<JobTask>> continuations;
+};
+} // namespace Private
+
+/**
+    \ingroup job
+    Handle of a worker task. Can be used to wait for the task, to make it a parent of other tasks or to
+    specify it as a dependency of other tasks. Empty handle means "no task".
+*/
+using JobHandle = std::shared_ptr<Private::JobTask>;
+
+/**
+    \ingroup job
+    Set of worker tasks that can be waited for as a whole with `JobManager::WaitWorkerGroup`.
+
+    Group should outlive all tasks that have been added to it.
+*/
+class JobGroup
+{
+public:
+    JobGroup() = default;
+    JobGroup(const JobGroup&) = delete;
+    JobGroup& operator=(const JobGroup&) = delete;
+
+    /** Return true if all tasks of the group are finished. */
+    bool IsDone() const;
+
+private:
+    friend class JobManager;
+    Atomic<uint32> pendingCount{ 0 };
+};
+
+inline bool JobGroup::IsDone() const
+{
+    return pendingCount.Get() == 0;
+}
+} // namespace DAVA
@@ -1,48 +1,30 @@
-#include "JobThread.h"
+#include "Job/JobThread.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
-JobThread::JobThread(JobQueueWorker* _workerQueue, Semaphore* _workerDoneSem)
-    : workerQueue(_workerQueue)
-    , workerDoneSem(_workerDoneSem)
-    , threadCancel(false)
-    , threadFinished(false)
+JobThread::JobThread(JobManager* jobManager_, uint32 index_)
+    : jobManager(jobManager_)
+    , index(index_)
 {
     thread = Thread::Create(MakeFunction(this, &JobThread::ThreadFunc));
     thread->SetName("DAVA::JobThread");
+}
+
+void JobThread::Start()
+{
     thread->Start();
 }
 
 JobThread::~JobThread()
 {
-    // cancel thread
-    threadCancel = true;
-    while (!threadFinished)
-    {
-        workerQueue->Broadcast();
-        Thread::Sleep(10); // sleep 10 ms until other check
-    }
-
-    // join and release thread
+    // JobManager has already asked workers to stop, so just wait until thread exits
     thread->Join();
     SafeRelease(thread);
 }
 
 void JobThread::ThreadFunc()
 {
-    while (!threadCancel)
-    {
-        workerQueue->Wait();
-
-        while (workerQueue->PopAndExec())
-        {
-        }
-
-        workerDoneSem->Post();
-    }
-
-    threadFinished = true;
+    jobManager->WorkerThreadFunc(this);
+}
 }
-
-};
-;
\ No newline at end of file
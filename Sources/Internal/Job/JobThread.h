@@ -1,26 +1,38 @@
 #pragma once
 
-#include "Concurrency/Semaphore.h"
 #include "Concurrency/Thread.h"
-#include "JobQueue.h"
+#include "Job/JobQueue.h"
 
 namespace DAVA
 {
+class JobManager;
 class JobThread
 {
 public:
-    JobThread(JobQueueWorker* workerQueue, Semaphore* workerDoneSem);
+    JobThread(JobManager* jobManager, uint32 index);
     ~JobThread();
 
-    void Cancel();
+    void Start();
+
+    uint32 GetIndex() const;
+    JobStealingQueue* GetQueue();
 
 protected:
     Thread* thread;
-    JobQueueWorker* workerQueue;
-    Semaphore* workerDoneSem;
-    volatile bool threadCancel;
-    volatile bool threadFinished;
+    JobManager* jobManager;
+    JobStealingQueue queue;
+    uint32 index;
 
     void ThreadFunc();
 };
+
+inline uint32 JobThread::GetIndex() const
+{
+    return index;
+}
+
+inline JobStealingQueue* JobThread::GetQueue()
+{
+    return &queue;
+}
 }
@@ -1,11 +1,20 @@
 #include "Logger/Logger.h"
+#include "Logger/Private/LogRecordQueue.h"
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
 #include "Debug/DVAssert.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Concurrency/UniqueLock.h"
 #include <cstdarg>
 #include <array>
 #include <ctime>
 
+#if defined(__DAVAENGINE_POSIX__)
+#include <csignal>
+#endif
+
 #include "Utils/Utils.h"
 #include "Utils/StringFormat.h"
 #include "Engine/Engine.h"
@@ -15,8 +24,392 @@ namespace DAVA
 namespace
 {
 const size_t defaultBufferSize{ 4096 };
+
+void WriteLogFileLine(File* file, Logger::eLogLevel ll, const char8* text, size_t length)
+{
+    Array<char8, 128> prefix;
+
+    time_t timestamp = time(nullptr); //Time in UTC format
+    int32 seconds = timestamp % 60;
+    int32 minutes = (timestamp / 60) % 60;
+    int32 hours = (timestamp / (60 * 60)) % 24;
+
+    Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, Logger::GetLogLevelString(ll));
+    file->Write(prefix.data(), static_cast<uint32>(strlen(prefix.data())));
+    file->Write(text, static_cast<uint32>(length));
+}
+}
+
+/**
+    Writer thread of asynchronous logger mode.
+
+    Producers format message, put it into lock-free queue and wake writer only if it sleeps.
+    Writer takes all queued records at once, writes them to outputs opening every log file once per batch
+    and wakes threads waiting in `Logger::Flush` or waiting for free space in queue.
+*/
+struct Logger::AsyncWriter
+{
+    static const uint32 MAX_BATCH_SIZE = 256;
+    static const uint32 CRASH_FLUSH_TIMEOUT_MS = 2000;
+
+    explicit AsyncWriter(Logger* logger);
+    ~AsyncWriter();
+
+    void Push(eLogLevel ll, const FilePath& logFilename, const char8* text);
+    void Flush();
+    void FlushOnCrash();
+    bool IsWriterThread() const;
+
+    void WriterThreadFunc();
+    void WriteBatch(const Vector<Private::LogRecord*>& batch);
+    void NotifyWaiters();
+
+    static void InstallCrashHandlers(AsyncWriter* writer);
+    static void UninstallCrashHandlers();
+    static void FlushCrashWriter();
+
+    Logger* logger = nullptr;
+    Thread* thread = nullptr;
+    Private::LogRecordQueue queue;
+
+    std::atomic<uint64> writerThreadId{ 0 };
+    std::atomic<uint32> queuedCount{ 0 };
+    std::atomic<uint64> pushedCount{ 0 };
+    std::atomic<uint64> writtenCount{ 0 };
+    std::atomic<uint32> droppedCount{ 0 };
+    std::atomic<uint32> waitingCount{ 0 };
+    std::atomic<bool> writerSleeping{ false };
+    std::atomic<bool> stopRequested{ false };
+
+    Mutex mutex;
+    ConditionVariable writerCondition;
+    ConditionVariable writtenCondition;
+
+    static std::atomic<AsyncWriter*> crashWriter;
+};
+
+std::atomic<Logger::AsyncWriter*> Logger::AsyncWriter::crashWriter{ nullptr };
+
+void Logger::AsyncWriter::FlushCrashWriter()
+{
+    AsyncWriter* writer = crashWriter.exchange(nullptr);
+    if (writer != nullptr)
+    {
+        writer->FlushOnCrash();
+    }
+}
+
+Logger::AsyncWriter::AsyncWriter(Logger* logger_)
+    : logger(logger_)
+{
+    thread = Thread::Create([this]() { WriterThreadFunc(); });
+    thread->SetName("DAVA.AsyncLogger");
+    thread->Start();
+}
+
+Logger::AsyncWriter::~AsyncWriter()
+{
+    {
+        LockGuard<Mutex> lock(mutex);
+        stopRequested = true;
+        writerCondition.NotifyOne();
+    }
+
+    thread->Join();
+    SafeRelease(thread);
+}
+
+bool Logger::AsyncWriter::IsWriterThread() const
+{
+    return writerThreadId.load() == Thread::GetCurrentIdAsUInt64();
+}
+
+void Logger::AsyncWriter::Push(eLogLevel ll, const FilePath& logFilename, const char8* text)
+{
+    if (queuedCount.load() >= logger->asyncQueueLimit)
+    {
+        if (logger->asyncOverflowPolicy == ASYNC_OVERFLOW_DROP_LOW_LEVELS && ll < LEVEL_WARNING)
+        {
+            droppedCount++;
+            return;
+        }
+
+        UniqueLock<Mutex> lock(mutex);
+        waitingCount++;
+        writtenCondition.Wait(lock, [this]() { return queuedCount.load() < logger->asyncQueueLimit || stopRequested.load(); });
+        waitingCount--;
+    }
+
+    Private::LogRecord* record = new Private::LogRecord();
+    record->level = ll;
+    record->logFilename = logFilename;
+    record->text = text;
+
+    queuedCount++;
+    pushedCount++;
+    queue.Push(record);
+
+    if (writerSleeping.load())
+    {
+        LockGuard<Mutex> lock(mutex);
+        writerCondition.NotifyOne();
+    }
+}
+
+void Logger::AsyncWriter::Flush()
+{
+    if (IsWriterThread())
+    {
+        return;
+    }
+
+    const uint64 target = pushedCount.load();
+
+    UniqueLock<Mutex> lock(mutex);
+    waitingCount++;
+    writtenCondition.Wait(lock, [this, target]() { return writtenCount.load() >= target; });
+    waitingCount--;
+}
+
+void Logger::AsyncWriter::FlushOnCrash()
+{
+    // Crashed thread can hold any lock, so only poll counters here
+    if (IsWriterThread())
+    {
+        return;
+    }
+
+    const uint64 target = pushedCount.load();
+    for (uint32 waitedMs = 0; writtenCount.load() < target && waitedMs < CRASH_FLUSH_TIMEOUT_MS; ++waitedMs)
+    {
+        Thread::Sleep(1);
+    }
+}
+
+void Logger::AsyncWriter::NotifyWaiters()
+{
+    if (waitingCount.load() > 0)
+    {
+        LockGuard<Mutex> lock(mutex);
+        writtenCondition.NotifyAll();
+    }
+}
+
+void Logger::AsyncWriter::WriterThreadFunc()
+{
+    writerThreadId = Thread::GetCurrentIdAsUInt64();
+
+    Vector<Private::LogRecord*> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+
+    while (true)
+    {
+        {
+            UniqueLock<Mutex> lock(mutex);
+            writerSleeping = true;
+            writerCondition.Wait(lock, [this]() { return queuedCount.load() > 0 || stopRequested.load(); });
+            writerSleeping = false;
+        }
+
+        if (queuedCount.load() == 0 && stopRequested.load())
+        {
+            break;
+        }
+
+        while (batch.size() < MAX_BATCH_SIZE)
+        {
+            Private::LogRecord* record = queue.Pop();
+            if (record == nullptr)
+            {
+                break;
+            }
+            batch.push_back(record);
+        }
+
+        if (batch.empty())
+        {
+            // Producer is in the middle of push
+            Thread::Yield();
+            continue;
+        }
+
+        WriteBatch(batch);
+
+        for (Private::LogRecord* record : batch)
+        {
+            delete record;
+        }
+
+        queuedCount -= static_cast<uint32>(batch.size());
+        writtenCount += batch.size();
+        batch.clear();
+
+        NotifyWaiters();
+    }
+
+    NotifyWaiters();
+}
+
+void Logger::AsyncWriter::WriteBatch(const Vector<Private::LogRecord*>& batch)
+{
+    uint32 dropped = droppedCount.exchange(0);
+    if (dropped > 0)
+    {
+        logger->Output(LEVEL_WARNING, Format("Logger: %u messages were dropped by asynchronous logger\n", dropped).c_str());
+    }
+
+    File* file = nullptr;
+    FilePath filePath;
+
+    for (const Private::LogRecord* record : batch)
+    {
+        const eLogLevel ll = record->level;
+        const char8* text = record->text.c_str();
+
+        logger->CustomLog(ll, text);
+        if (ll >= logger->logLevel)
+        {
+            PlatformLog(ll, text);
+            if (logger->consoleModeEnabled)
+            {
+                logger->ConsoleLog(ll, text);
+            }
+
+            if (!record->logFilename.IsEmpty() && nullptr != FileSystem::Instance())
+            {
+                // Keep file opened while the following records go to the same file
+                if (file == nullptr || filePath != record->logFilename)
+                {
+                    SafeRelease(file);
+                    filePath = record->logFilename;
+                    if (filePath != logger->logFilename)
+                    {
+                        logger->CutOldLogFileIfExist(filePath);
+                    }
+                    file = File::Create(filePath, File::APPEND | File::WRITE);
+                }
+
+                if (file != nullptr)
+                {
+                    WriteLogFileLine(file, ll, text, record->text.size());
+                }
+            }
+        }
+    }
+
+    SafeRelease(file);
+}
+
+#if defined(__DAVAENGINE_POSIX__)
+
+namespace LoggerDetails
+{
+void (*crashFlushFunction)() = nullptr;
+const int CRASH_SIGNALS[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+struct sigaction previousCrashActions[COUNT_OF(CRASH_SIGNALS)];
+
+void CrashSignalHandler(int signal)
+{
+    if (crashFlushFunction != nullptr)
+    {
+        crashFlushFunction();
+    }
+
+    // Restore previous handlers and let them process the signal
+    for (size_t i = 0; i < COUNT_OF(CRASH_SIGNALS); ++i)
+    {
+        sigaction(CRASH_SIGNALS[i], &previousCrashActions[i], nullptr);
+    }
+    raise(signal);
+}
+}
+
+void Logger::AsyncWriter::InstallCrashHandlers(AsyncWriter* writer)
+{
+    using namespace LoggerDetails;
+
+    if (crashWriter.exchange(writer) != nullptr)
+    {
+        return;
+    }
+
+    crashFlushFunction = &FlushCrashWriter;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = &CrashSignalHandler;
+    sigemptyset(&action.sa_mask);
+
+    for (size_t i = 0; i < COUNT_OF(CRASH_SIGNALS); ++i)
+    {
+        sigaction(CRASH_SIGNALS[i], &action, &previousCrashActions[i]);
+    }
+}
+
+void Logger::AsyncWriter::UninstallCrashHandlers()
+{
+    using namespace LoggerDetails;
+
+    if (crashWriter.exchange(nullptr) == nullptr)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < COUNT_OF(CRASH_SIGNALS); ++i)
+    {
+        sigaction(CRASH_SIGNALS[i], &previousCrashActions[i], nullptr);
+    }
+}
+
+#elif defined(__DAVAENGINE_WIN32__)
+
+namespace LoggerDetails
+{
+void (*crashFlushFunction)() = nullptr;
+LPTOP_LEVEL_EXCEPTION_FILTER previousExceptionFilter = nullptr;
+
+LONG WINAPI CrashExceptionFilter(EXCEPTION_POINTERS* exceptionInfo)
+{
+    if (crashFlushFunction != nullptr)
+    {
+        crashFlushFunction();
+    }
+
+    return previousExceptionFilter != nullptr ? previousExceptionFilter(exceptionInfo) : EXCEPTION_CONTINUE_SEARCH;
+}
+}
+
+void Logger::AsyncWriter::InstallCrashHandlers(AsyncWriter* writer)
+{
+    if (crashWriter.exchange(writer) == nullptr)
+    {
+        LoggerDetails::crashFlushFunction = &FlushCrashWriter;
+        LoggerDetails::previousExceptionFilter = ::SetUnhandledExceptionFilter(&LoggerDetails::CrashExceptionFilter);
+    }
 }
 
+void Logger::AsyncWriter::UninstallCrashHandlers()
+{
+    if (crashWriter.exchange(nullptr) != nullptr)
+    {
+        ::SetUnhandledExceptionFilter(LoggerDetails::previousExceptionFilter);
+    }
+}
+
+#else
+
+void Logger::AsyncWriter::InstallCrashHandlers(AsyncWriter* writer)
+{
+    crashWriter = writer;
+}
+
+void Logger::AsyncWriter::UninstallCrashHandlers()
+{
+    crashWriter = nullptr;
+}
+
+#endif
+
 #if defined(__DAVAENGINE_WIN32__)
 void Win32AttachStdoutToConsole(bool attach);
 #endif
@@ -61,6 +454,14 @@ void Logger::Logv(const FilePath& customLogFilename, eLogLevel ll, const char8*
     if (!text || text[0] == '\0')
         return;
 
+    // Nobody is interested in message, don't spend time on formatting
+    if (ll < logLevel)
+    {
+        LockGuard<RecursiveMutex> lock(customOutputsMutex);
+        if (customOutputs.empty())
+            return;
+    }
+
     // try use stack first
     Array<char8, defaultBufferSize> stackbuf;
 
@@ -105,6 +506,13 @@ Logger::Logger()
 
 Logger::~Logger()
 {
+    if (asyncWriter != nullptr)
+    {
+        AsyncWriter::UninstallCrashHandlers();
+        asyncModeEnabled = false;
+        SafeDelete(asyncWriter);
+    }
+
     for (auto logOutput : customOutputs)
     {
         delete logOutput;
@@ -293,7 +701,10 @@ void Logger::AddCustomOutput(DAVA::LoggerOutput* lo)
 {
     Logger* log = GetLoggerInstance();
     if (nullptr != log && nullptr != lo)
+    {
+        LockGuard<RecursiveMutex> lock(log->customOutputsMutex);
         log->customOutputs.push_back(lo);
+    }
 }
 
 void Logger::RemoveCustomOutput(DAVA::LoggerOutput* lo)
@@ -301,6 +712,7 @@ void Logger::RemoveCustomOutput(DAVA::LoggerOutput* lo)
     Logger* log = GetLoggerInstance();
     if (nullptr != log && nullptr != lo)
     {
+        LockGuard<RecursiveMutex> lock(log->customOutputsMutex);
         auto& outputs = log->customOutputs;
 
         outputs.erase(std::remove(outputs.begin(), outputs.end(), lo));
@@ -338,6 +750,52 @@ void Logger::SetMaxFileSize(uint32 size)
     cutLogSize = size;
 }
 
+void Logger::SetAsyncModeEnabled(bool enabled)
+{
+    if (enabled == asyncModeEnabled)
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        // Writer is kept until logger destruction, so threads that are logging right now can safely finish
+        if (asyncWriter == nullptr)
+        {
+            asyncWriter = new AsyncWriter(this);
+        }
+        AsyncWriter::InstallCrashHandlers(asyncWriter);
+        asyncModeEnabled = true;
+    }
+    else
+    {
+        asyncModeEnabled = false;
+        AsyncWriter::UninstallCrashHandlers();
+        asyncWriter->Flush();
+    }
+}
+
+bool Logger::IsAsyncModeEnabled() const
+{
+    return asyncModeEnabled;
+}
+
+void Logger::SetAsyncQueueLimit(uint32 maxQueuedMessages, eAsyncOverflowPolicy policy)
+{
+    DVASSERT(maxQueuedMessages > 0);
+    asyncQueueLimit = maxQueuedMessages;
+    asyncOverflowPolicy = policy;
+}
+
+void Logger::Flush()
+{
+    Logger* log = GetLoggerInstance();
+    if (nullptr != log && nullptr != log->asyncWriter)
+    {
+        log->asyncWriter->Flush();
+    }
+}
+
 DAVA::Logger* Logger::GetLoggerInstance()
 {
     const EngineContext* context = GetEngineContext();
@@ -414,22 +872,14 @@ void Logger::FileLog(const FilePath& customLogFileName, eLogLevel ll, const char
         ScopedPtr<File> file(File::Create(customLogFileName, File::APPEND | File::WRITE));
         if (file)
         {
-            Array<char8, 128> prefix;
-
-            time_t timestamp = time(nullptr); //Time in UTC format
-            int32 seconds = timestamp % 60;
-            int32 minutes = (timestamp / 60) % 60;
-            int32 hours = (timestamp / (60 * 60)) % 24;
-
-            Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, GetLogLevelString(ll));
-            file->Write(prefix.data(), static_cast<uint32>(strlen(prefix.data())));
-            file->Write(text, static_cast<uint32>(strlen(text)));
+            WriteLogFileLine(file, ll, text, strlen(text));
         }
     }
 }
 
 void Logger::CustomLog(eLogLevel ll, const char8* text) const
 {
+    LockGuard<RecursiveMutex> lock(customOutputsMutex);
     for (auto output : customOutputs)
     {
         output->Output(ll, text);
@@ -460,6 +910,12 @@ void Logger::Output(eLogLevel ll, const char8* formatedMsg) const
 
 void Logger::Output(const FilePath& customLogFilename, eLogLevel ll, const char8* formatedMsg) const
 {
+    if (asyncModeEnabled && !asyncWriter->IsWriterThread())
+    {
+        asyncWriter->Push(ll, customLogFilename, formatedMsg);
+        return;
+    }
+
     CustomLog(ll, formatedMsg);
     // print platform log or write log to file
     // only if log level is acceptable
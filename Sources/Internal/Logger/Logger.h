@@ -12,7 +12,9 @@
 #include "Base/BaseTypes.h"
 
 #include "FileSystem/FilePath.h"
+#include "Concurrency/Mutex.h"
 
+#include <atomic>
 #include <cstdarg>
 
 namespace DAVA
@@ -33,6 +35,13 @@ public:
         LEVEL__DISABLE //<! Disable logs.
     };
 
+    //! Behaviour of asynchronous mode when queue of not written messages is full.
+    enum eAsyncOverflowPolicy
+    {
+        ASYNC_OVERFLOW_BLOCK = 0, //<! Calling thread waits until writer thread frees space in queue.
+        ASYNC_OVERFLOW_DROP_LOW_LEVELS, //<! Messages below LEVEL_WARNING are dropped, warnings and errors wait. Count of dropped messages is logged.
+    };
+
     Logger();
     virtual ~Logger();
 
@@ -115,7 +124,26 @@ public:
     //TODO: insert Optional
     static eLogLevel GetLogLevelFromString(const char8* ll);
 
+    //! Enables/disables asynchronous mode. Disabled by default.
+    //! In asynchronous mode message is formatted on calling thread and put into queue,
+    //! writer thread takes messages from queue in batches and passes them to file, console, platform and custom outputs.
+    //! Messages logged from writer thread itself (e.g. by custom outputs) are written synchronously.
+    //! Disabling waits until all queued messages are written.
+    void SetAsyncModeEnabled(bool enabled);
+    bool IsAsyncModeEnabled() const;
+
+    //! Sets maximum count of queued messages in asynchronous mode and policy for messages that don't fit.
+    //! Default is 4096 messages and ASYNC_OVERFLOW_DROP_LOW_LEVELS.
+    void SetAsyncQueueLimit(uint32 maxQueuedMessages, eAsyncOverflowPolicy policy);
+
+    //! Blocks until all messages logged before this call are written to outputs. Does nothing in synchronous mode.
+    //! Called automatically on DVASSERT failure and on process crash while asynchronous mode is enabled.
+    static void Flush();
+
 private:
+    struct AsyncWriter;
+    friend struct AsyncWriter;
+
     static Logger* GetLoggerInstance();
     bool CutOldLogFileIfExist(const FilePath& logFile) const;
 
@@ -128,6 +156,11 @@ private:
     eLogLevel logLevel;
     FilePath logFilename;
     Vector<LoggerOutput*> customOutputs;
+    mutable RecursiveMutex customOutputsMutex;
+    AsyncWriter* asyncWriter = nullptr;
+    uint32 asyncQueueLimit = 4096;
+    eAsyncOverflowPolicy asyncOverflowPolicy = ASYNC_OVERFLOW_DROP_LOW_LEVELS;
+    std::atomic<bool> asyncModeEnabled{ false };
     bool consoleModeEnabled;
     uint32 cutLogSize = 512 * 1024; //0.5 MB;
 };
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+#include "Logger/Logger.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+namespace Private
+{
+/** Formatted log message waiting for asynchronous logger writer thread. */
+struct LogRecord
+{
+    std::atomic<LogRecord*> next{ nullptr };
+    Logger::eLogLevel level = Logger::LEVEL_FRAMEWORK;
+    FilePath logFilename;
+    String text;
+};
+
+/**
+    Intrusive multiple producers single consumer queue of log records.
+    `Push` is wait-free and can be called from any thread, `Pop` must be called only from one consumer thread.
+    Records are returned in order of `Push` calls.
+*/
+class LogRecordQueue final
+{
+public:
+    LogRecordQueue();
+    LogRecordQueue(const LogRecordQueue&) = delete;
+    LogRecordQueue& operator=(const LogRecordQueue&) = delete;
+
+    void Push(LogRecord* record);
+
+    /**
+        Take the oldest record. Return nullptr if queue is empty or if the oldest record
+        is being pushed by other thread right now, in latter case consumer should try again later.
+    */
+    LogRecord* Pop();
+
+private:
+    std::atomic<LogRecord*> head;
+    LogRecord* tail = nullptr;
+    LogRecord stub;
+};
+
+inline LogRecordQueue::LogRecordQueue()
+    : head(&stub)
+    , tail(&stub)
+{
+}
+
+inline void LogRecordQueue::Push(LogRecord* record)
+{
+    record->next.store(nullptr, std::memory_order_relaxed);
+    LogRecord* prev = head.exchange(record, std::memory_order_acq_rel);
+    prev->next.store(record, std::memory_order_release);
+}
+
+inline LogRecord* LogRecordQueue::Pop()
+{
+    LogRecord* first = tail;
+    LogRecord* next = first->next.load(std::memory_order_acquire);
+
+    if (first == &stub)
+    {
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+
+    if (first != head.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    // `first` is the last record, put stub after it to be able to take it out
+    Push(&stub);
+
+    next = first->next.load(std::memory_order_acquire);
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+
+    return nullptr;
+}
+} // namespace Private
+} // namespace DAVA
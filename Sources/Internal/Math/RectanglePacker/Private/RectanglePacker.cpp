@@ -1,10 +1,45 @@
 #include "Math/RectanglePacker/RectanglePacker.h"
 #include "Math/RectanglePacker/Spritesheet.h"
 #include "Render/Texture.h"
+#include "Concurrency/Atomic.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 #include "Logger/Logger.h"
 
+#include <limits>
+
 namespace DAVA
 {
+namespace RectanglePackerDetails
+{
+bool IsSpritePackedBefore(PackingSortOrder sortOrder, const RectanglePacker::SpriteItem& a, const RectanglePacker::SpriteItem& b)
+{
+    const Size2i sizeA = a.defFile->GetFrameSize(a.frameIndex);
+    const Size2i sizeB = b.defFile->GetFrameSize(b.frameIndex);
+
+    switch (sortOrder)
+    {
+    case PackingSortOrder::SORT_BY_AREA:
+        return a.spriteWeight > b.spriteWeight;
+    case PackingSortOrder::SORT_BY_MAX_SIDE:
+    {
+        const int32 maxSideA = Max(sizeA.dx, sizeA.dy);
+        const int32 maxSideB = Max(sizeB.dx, sizeB.dy);
+        return (maxSideA > maxSideB) || (maxSideA == maxSideB && Min(sizeA.dx, sizeA.dy) > Min(sizeB.dx, sizeB.dy));
+    }
+    case PackingSortOrder::SORT_BY_PERIMETER:
+        return (sizeA.dx + sizeA.dy) > (sizeB.dx + sizeB.dy);
+    case PackingSortOrder::SORT_BY_WIDTH:
+        return (sizeA.dx > sizeB.dx) || (sizeA.dx == sizeB.dx && sizeA.dy > sizeB.dy);
+    case PackingSortOrder::SORT_BY_HEIGHT:
+        return (sizeA.dy > sizeB.dy) || (sizeA.dy == sizeB.dy && sizeA.dx > sizeB.dx);
+    default:
+        DVASSERT(false, "Unknown sort order");
+        return false;
+    }
+}
+} // namespace RectanglePackerDetails
+
 RectanglePacker::RectanglePacker()
 {
 }
@@ -12,6 +47,7 @@ RectanglePacker::RectanglePacker()
 std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::Pack(RectanglePacker::PackTask& packTask) const
 {
     DVASSERT(packAlgorithms.empty() == false, "Packing algorithm was not specified");
+    DVASSERT(sortOrders.empty() == false, "Sort order was not specified");
     Vector<SpriteItem> spritesToPack;
     for (const std::shared_ptr<SpriteDefinition>& defFile : packTask.spriteList)
     {
@@ -26,65 +62,141 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::Pack(RectanglePack
         }
     }
 
-    std::stable_sort(spritesToPack.begin(), spritesToPack.end(),
-                     [](const SpriteItem& a, const SpriteItem& b) { return a.spriteWeight > b.spriteWeight; });
-
     return PackSprites(spritesToPack, packTask);
 }
 
 std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::PackSprites(Vector<RectanglePacker::SpriteItem>& spritesToPack, RectanglePacker::PackTask& packTask) const
 {
+    using namespace RectanglePackerDetails;
+
     auto packResult = std::make_unique<PackResult>();
 
+    // every combination of sheet size, sort order and algorithm is a candidate layout of the next sheet
+    Vector<PackCandidate> candidates;
+    bool needOnlySquareTexture = onlySquareTextures || packTask.needSquareTextureOverriden;
+    for (uint32 yResolution = Texture::MINIMAL_HEIGHT; yResolution <= maxTextureSize; yResolution *= 2)
+    {
+        for (uint32 xResolution = Texture::MINIMAL_WIDTH; xResolution <= maxTextureSize; xResolution *= 2)
+        {
+            if (needOnlySquareTexture && (xResolution != yResolution))
+                continue;
+
+            for (uint32 sortOrderIndex = 0; sortOrderIndex < sortOrders.size(); ++sortOrderIndex)
+            {
+                for (const PackingAlgorithm alg : packAlgorithms)
+                {
+                    PackCandidate candidate;
+                    candidate.width = xResolution;
+                    candidate.height = yResolution;
+                    candidate.sortOrderIndex = sortOrderIndex;
+                    candidate.algorithm = alg;
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+    }
+
+    JobManager* jobManager = useParallelSearch ? GetEngineContext()->jobManager : nullptr;
+    const uint32 candidatesCount = static_cast<uint32>(candidates.size());
+    const uint32 lanesCount = (nullptr != jobManager) ? Min(jobManager->GetWorkersCount(), candidatesCount) : 0;
+
     while (false == spritesToPack.empty())
     {
         Logger::FrameworkDebug("* Packing attempts started: ");
 
-        std::unique_ptr<SpritesheetLayout> bestSheet;
-        uint32 bestSpritesWeight = 0;
-        uint32 bestSheetWeight = 0;
-        bool wasFullyPacked = false;
-        Vector<SpriteItem> bestSpritesRemaining;
-
-        bool needOnlySquareTexture = onlySquareTextures || packTask.needSquareTextureOverriden;
-        for (uint32 yResolution = Texture::MINIMAL_HEIGHT; yResolution <= maxTextureSize; yResolution *= 2)
+        Vector<Vector<SpriteItem>> sortedSprites(sortOrders.size());
+        for (size_t i = 0; i < sortOrders.size(); ++i)
         {
-            for (uint32 xResolution = Texture::MINIMAL_WIDTH; xResolution <= maxTextureSize; xResolution *= 2)
-            {
-                if (needOnlySquareTexture && (xResolution != yResolution))
-                    continue;
-
-                uint32 sheetWeight = xResolution * yResolution;
+            const PackingSortOrder sortOrder = sortOrders[i];
+            sortedSprites[i] = spritesToPack;
+            std::stable_sort(sortedSprites[i].begin(), sortedSprites[i].end(), [sortOrder](const SpriteItem& a, const SpriteItem& b) {
+                return IsSpritePackedBefore(sortOrder, a, b);
+            });
+        }
 
-                if (wasFullyPacked && sheetWeight >= bestSheetWeight)
-                    continue;
+        Vector<PackAttempt> attempts(candidatesCount);
+        if (lanesCount > 1)
+        {
+            // Candidates are taken in order, so small sheets are tried first.
+            // Candidate is skipped if smaller sheet has already been fully packed, as it can't be chosen anyway
+            Atomic<uint32> nextIndex(0);
+            Atomic<uint32> fullyPackedSheetWeight(std::numeric_limits<uint32>::max());
 
-                for (const PackingAlgorithm alg : packAlgorithms)
+            auto tryCandidates = [&]() {
+                for (uint32 index = nextIndex++; index < candidatesCount; index = nextIndex++)
                 {
-                    std::unique_ptr<SpritesheetLayout> sheet = SpritesheetLayout::Create(xResolution, yResolution, useTwoSideMargin, texturesMargin, alg);
-
-                    Vector<SpriteItem> tempSpritesRemaining = spritesToPack;
-                    uint32 spritesWeight = TryToPack(sheet.get(), tempSpritesRemaining, wasFullyPacked);
+                    const PackCandidate& candidate = candidates[index];
+                    const uint32 sheetWeight = candidate.width * candidate.height;
+                    const uint32 bestSheetWeight = fullyPackedSheetWeight.Get();
+                    if (sheetWeight > bestSheetWeight)
+                        continue;
 
-                    bool nowFullyPacked = tempSpritesRemaining.empty();
+                    PackAttempt& attempt = attempts[index];
+                    TryCandidate(candidate, sortedSprites[candidate.sortOrderIndex], sheetWeight == bestSheetWeight, attempt);
 
-                    if (wasFullyPacked && !nowFullyPacked)
-                        continue;
+                    // Only result of attempt is kept, best candidate is packed again after it is chosen
+                    attempt.sheet.reset();
+                    Vector<SpriteItem>().swap(attempt.spritesRemaining);
 
-                    if (nowFullyPacked || spritesWeight > bestSpritesWeight || (spritesWeight == bestSpritesWeight && sheetWeight < bestSheetWeight))
+                    if (attempt.fullyPacked)
                     {
-                        bestSpritesWeight = spritesWeight;
-                        bestSheetWeight = sheetWeight;
-                        bestSheet = std::move(sheet);
-                        bestSpritesRemaining.swap(tempSpritesRemaining);
-
-                        if (nowFullyPacked)
+                        uint32 currentWeight = fullyPackedSheetWeight.Get();
+                        while (sheetWeight < currentWeight && !fullyPackedSheetWeight.CompareAndSwap(currentWeight, sheetWeight))
                         {
-                            wasFullyPacked = true;
-                            break;
+                            currentWeight = fullyPackedSheetWeight.Get();
                         }
                     }
                 }
+            };
+
+            JobGroup group;
+            for (uint32 lane = 0; lane < lanesCount; ++lane)
+            {
+                jobManager->CreateWorkerTask(tryCandidates, &group);
+            }
+            jobManager->WaitWorkerGroup(&group);
+        }
+
+        // Best attempt is chosen in order of candidates, so result doesn't depend on order attempts were finished in.
+        // Without parallel search attempts are made here on demand, skipping candidates which can't be chosen
+        PackAttempt bestAttempt;
+        uint32 bestCandidateIndex = 0;
+        uint32 bestSpritesWeight = 0;
+        uint32 bestSheetWeight = 0;
+        bool wasFullyPacked = false;
+
+        for (uint32 index = 0; index < candidatesCount; ++index)
+        {
+            const PackCandidate& candidate = candidates[index];
+            const uint32 sheetWeight = candidate.width * candidate.height;
+
+            if (wasFullyPacked && sheetWeight >= bestSheetWeight)
+                continue;
+
+            PackAttempt& attempt = attempts[index];
+            if (attempt.tried == false)
+            {
+                if (lanesCount > 1)
+                    continue;
+
+                TryCandidate(candidate, sortedSprites[candidate.sortOrderIndex], wasFullyPacked, attempt);
+            }
+
+            bool nowFullyPacked = attempt.fullyPacked;
+
+            if ((wasFullyPacked && !nowFullyPacked) == false &&
+                (nowFullyPacked || attempt.spritesWeight > bestSpritesWeight || (attempt.spritesWeight == bestSpritesWeight && sheetWeight < bestSheetWeight)))
+            {
+                bestSpritesWeight = attempt.spritesWeight;
+                bestSheetWeight = sheetWeight;
+                bestCandidateIndex = index;
+                bestAttempt = std::move(attempt);
+                wasFullyPacked = nowFullyPacked;
+            }
+            else
+            {
+                attempt.sheet.reset();
+                Vector<SpriteItem>().swap(attempt.spritesRemaining);
             }
         }
 
@@ -94,8 +206,17 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::PackSprites(Vector
             break;
         }
 
-        spritesToPack.swap(bestSpritesRemaining);
-        packResult->resultSheets.emplace_back(std::move(bestSheet));
+        if (bestAttempt.sheet == nullptr)
+        {
+            // Winner of parallel search is either fully packed or was tried without full pack restriction,
+            // so packing it again without restriction gives the same layout
+            const PackCandidate& candidate = candidates[bestCandidateIndex];
+            TryCandidate(candidate, sortedSprites[candidate.sortOrderIndex], false, bestAttempt);
+            DVASSERT(bestAttempt.spritesWeight == bestSpritesWeight);
+        }
+
+        spritesToPack.swap(bestAttempt.spritesRemaining);
+        packResult->resultSheets.emplace_back(std::move(bestAttempt.sheet));
     }
     if (packResult->Success())
     {
@@ -104,6 +225,15 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::PackSprites(Vector
     return packResult;
 }
 
+void RectanglePacker::TryCandidate(const PackCandidate& candidate, const Vector<SpriteItem>& sortedSprites, bool fullPackOnly, PackAttempt& attempt) const
+{
+    attempt.sheet = SpritesheetLayout::Create(candidate.width, candidate.height, useTwoSideMargin, texturesMargin, candidate.algorithm);
+    attempt.spritesRemaining = sortedSprites;
+    attempt.spritesWeight = TryToPack(attempt.sheet.get(), attempt.spritesRemaining, fullPackOnly);
+    attempt.fullyPacked = attempt.spritesRemaining.empty();
+    attempt.tried = true;
+}
+
 uint32 RectanglePacker::TryToPack(SpritesheetLayout* sheet, Vector<SpriteItem>& tempSortVector, bool fullPackOnly) const
 {
     uint32 weight = 0;
@@ -162,4 +292,25 @@ void RectanglePacker::CreateSpritesIndex(RectanglePacker::PackTask& packTask, Re
     }
     DVASSERT(packResult->resultIndexedSprites.size() == packTask.spriteList.size());
 }
+
+float32 RectanglePacker::PackResult::GetOccupancy() const
+{
+    uint64 sheetsArea = 0;
+    for (const std::unique_ptr<SpritesheetLayout>& sheet : resultSheets)
+    {
+        sheetsArea += sheet->GetWeight();
+    }
+
+    uint64 framesArea = 0;
+    for (const SpriteIndexedData& spriteData : resultIndexedSprites)
+    {
+        uint32 frameCount = spriteData.spriteDef->GetFrameCount();
+        for (uint32 frame = 0; frame < frameCount; ++frame)
+        {
+            framesArea += spriteData.spriteDef->GetFrameWidth(frame) * spriteData.spriteDef->GetFrameHeight(frame);
+        }
+    }
+
+    return (sheetsArea > 0) ? static_cast<float32>(framesArea) / static_cast<float32>(sheetsArea) : 0.f;
+}
 }
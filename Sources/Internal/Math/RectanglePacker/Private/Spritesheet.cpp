@@ -13,6 +13,17 @@ ENUM_DECLARE(DAVA::PackingAlgorithm)
     ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT), "ALG_MAXRECTS_BEST_SHORT_SIDE_FIT");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT), "ALG_MAXRECTS_BEST_LONG_SIDE_FIT");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT), "ALG_MAXRRECT_BEST_CONTACT_POINT");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT), "ALG_SKYLINE_BOTTOM_LEFT");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_SKYLINE_MIN_WASTE), "ALG_SKYLINE_MIN_WASTE");
+};
+
+ENUM_DECLARE(DAVA::PackingSortOrder)
+{
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingSortOrder::SORT_BY_AREA), "SORT_BY_AREA");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingSortOrder::SORT_BY_MAX_SIDE), "SORT_BY_MAX_SIDE");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingSortOrder::SORT_BY_PERIMETER), "SORT_BY_PERIMETER");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingSortOrder::SORT_BY_WIDTH), "SORT_BY_WIDTH");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingSortOrder::SORT_BY_HEIGHT), "SORT_BY_HEIGHT");
 };
 
 namespace DAVA
@@ -608,6 +619,230 @@ protected:
 
 //////////////////////////////////////////////////////////////////////////
 
+class SkylineSpritesheetLayout : public SpritesheetLayout
+{
+public:
+    explicit SkylineSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 spritesMargin);
+
+    // SpritesheetLayout
+    bool AddSprite(const Size2i& spriteSize, const void* searchPtr) override;
+    const SpriteBoundsRect* GetSpriteBoundsRect(const void* searchPtr) const override;
+    const Rect2i& GetRect() const override
+    {
+        return sheetRect;
+    }
+    uint32 GetWeight() const override
+    {
+        return sheetRect.dx * sheetRect.dy;
+    }
+
+protected:
+    // Horizontal segment of skyline: everything below y is occupied
+    struct SkylineNode
+    {
+        int32 x;
+        int32 y;
+        int32 width;
+    };
+
+    // Lower score is better
+    struct PlacementScore
+    {
+        int32 primary = 0;
+        int32 secondary = 0;
+
+        bool operator<(const PlacementScore& other) const
+        {
+            return (primary < other.primary) || (primary == other.primary && secondary < other.secondary);
+        }
+    };
+
+    virtual PlacementScore ScorePlacement(size_t nodeIndex, const SpriteBoundsRect& cell) const = 0;
+    bool FitSprite(size_t nodeIndex, const Size2i& spriteSize, SpriteBoundsRect& cell) const;
+    void AddSkylineNode(size_t nodeIndex, const Rect2i& occupiedRect);
+
+    const int32 edgePixel;
+    const int32 spritesMargin;
+
+    Rect2i sheetRect;
+    Vector<SkylineNode> skyline;
+    UnorderedMap<const void*, SpriteBoundsRect> spriteRects;
+};
+
+SkylineSpritesheetLayout::SkylineSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 margin)
+    : edgePixel(duplicateEdgePixel ? 1 : 0)
+    , spritesMargin(margin)
+{
+    sheetRect = Rect2i(0, 0, w, h);
+    skyline.push_back({ 0, 0, sheetRect.dx });
+}
+
+bool SkylineSpritesheetLayout::AddSprite(const Size2i& spriteSize, const void* spritePtr)
+{
+    // skyline alg in brief:
+    // step1: try to put sprite on top of skyline at the left edge of every skyline node, keep best scored position
+    // step2: insert new sprite rect
+    // step3: raise skyline under new sprite rect
+
+    size_t bestIndex = skyline.size();
+    SpriteBoundsRect bestCell;
+    PlacementScore bestScore;
+
+    for (size_t i = 0; i < skyline.size(); ++i)
+    {
+        SpriteBoundsRect cell;
+        if (FitSprite(i, spriteSize, cell))
+        {
+            PlacementScore score = ScorePlacement(i, cell);
+            if (bestIndex == skyline.size() || score < bestScore)
+            {
+                bestIndex = i;
+                bestCell = cell;
+                bestScore = score;
+            }
+        }
+    }
+
+    if (bestIndex == skyline.size())
+        return false;
+
+    auto insertResult = spriteRects.insert(std::make_pair(spritePtr, bestCell));
+    DVASSERT(insertResult.second == true, "Second attempt to insert same sprite");
+
+    AddSkylineNode(bestIndex, bestCell.marginsRect);
+    return true;
+}
+
+bool SkylineSpritesheetLayout::FitSprite(size_t nodeIndex, const Size2i& spriteSize, SpriteBoundsRect& cell) const
+{
+    // edge pixels and margin are needed only between sprites, they are cut off at sheet bounds like in maxrects layout
+    const int32 x = skyline[nodeIndex].x;
+    const int32 leftEdgePixel = (x > 0) ? edgePixel : 0;
+    const int32 spriteWidth = leftEdgePixel + spriteSize.dx;
+    if (x + spriteWidth > sheetRect.dx)
+        return false;
+
+    const int32 restWidth = Min(edgePixel + spritesMargin, sheetRect.dx - x - spriteWidth);
+    const int32 cellWidth = spriteWidth + restWidth;
+
+    // skyline nodes cover whole sheet width, so cell is always over some nodes
+    int32 y = 0;
+    int32 widthLeft = cellWidth;
+    for (size_t i = nodeIndex; widthLeft > 0; ++i)
+    {
+        y = Max(y, skyline[i].y);
+        widthLeft -= skyline[i].width;
+    }
+
+    const int32 topEdgePixel = (y > 0) ? edgePixel : 0;
+    const int32 spriteHeight = topEdgePixel + spriteSize.dy;
+    if (y + spriteHeight > sheetRect.dy)
+        return false;
+
+    const int32 restHeight = Min(edgePixel + spritesMargin, sheetRect.dy - y - spriteHeight);
+
+    cell.leftEdgePixel = leftEdgePixel;
+    cell.topEdgePixel = topEdgePixel;
+    cell.rightEdgePixel = Min(edgePixel, restWidth);
+    cell.bottomEdgePixel = Min(edgePixel, restHeight);
+    cell.rightMargin = restWidth - cell.rightEdgePixel;
+    cell.bottomMargin = restHeight - cell.bottomEdgePixel;
+    cell.marginsRect = Rect2i(x, y, cellWidth, spriteHeight + restHeight);
+    cell.spriteRect = Rect2i(x + leftEdgePixel, y + topEdgePixel, spriteSize.dx, spriteSize.dy);
+    return true;
+}
+
+void SkylineSpritesheetLayout::AddSkylineNode(size_t nodeIndex, const Rect2i& occupiedRect)
+{
+    skyline.insert(skyline.begin() + nodeIndex, { occupiedRect.x, occupiedRect.y + occupiedRect.dy, occupiedRect.dx });
+
+    // shrink or remove nodes covered by new one
+    const int32 occupiedRight = occupiedRect.x + occupiedRect.dx;
+    for (size_t i = nodeIndex + 1; i < skyline.size();)
+    {
+        SkylineNode& node = skyline[i];
+        if (node.x >= occupiedRight)
+            break;
+
+        int32 shrink = occupiedRight - node.x;
+        if (shrink < node.width)
+        {
+            node.x += shrink;
+            node.width -= shrink;
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // merge neighbour nodes of same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+const SpriteBoundsRect* SkylineSpritesheetLayout::GetSpriteBoundsRect(const void* searchPtr) const
+{
+    auto result = spriteRects.find(searchPtr);
+    return (result == spriteRects.end() ? nullptr : &(result->second));
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+struct SkylineSpritesheetLayout_BL : public SkylineSpritesheetLayout
+{
+    SkylineSpritesheetLayout_BL(uint32 w, uint32 h, bool dup, int32 margin)
+        : SkylineSpritesheetLayout(w, h, dup, margin)
+    {
+    }
+
+protected:
+    PlacementScore ScorePlacement(size_t nodeIndex, const SpriteBoundsRect& cell) const override
+    {
+        // lowest top of sprite, then narrowest node
+        PlacementScore score;
+        score.primary = cell.marginsRect.y + cell.marginsRect.dy;
+        score.secondary = skyline[nodeIndex].width;
+        return score;
+    }
+};
+
+struct SkylineSpritesheetLayout_MW : public SkylineSpritesheetLayout
+{
+    SkylineSpritesheetLayout_MW(uint32 w, uint32 h, bool dup, int32 margin)
+        : SkylineSpritesheetLayout(w, h, dup, margin)
+    {
+    }
+
+protected:
+    PlacementScore ScorePlacement(size_t nodeIndex, const SpriteBoundsRect& cell) const override
+    {
+        // least area left unusable under sprite, then lowest top of sprite
+        const Rect2i& rect = cell.marginsRect;
+        int32 wastedArea = 0;
+        for (size_t i = nodeIndex; i < skyline.size() && skyline[i].x < rect.x + rect.dx; ++i)
+        {
+            const int32 nodeRight = Min(skyline[i].x + skyline[i].width, rect.x + rect.dx);
+            wastedArea += (rect.y - skyline[i].y) * (nodeRight - skyline[i].x);
+        }
+
+        PlacementScore score;
+        score.primary = wastedArea;
+        score.secondary = rect.y + rect.dy;
+        return score;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+
 std::unique_ptr<SpritesheetLayout> SpritesheetLayout::Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg)
 {
     switch (alg)
@@ -624,6 +859,10 @@ std::unique_ptr<SpritesheetLayout> SpritesheetLayout::Create(uint32 w, uint32 h,
         return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_LSF(w, h, duplicateEdgePixel, spritesMargin));
     case PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT:
         return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_CP(w, h, duplicateEdgePixel, spritesMargin));
+    case PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT:
+        return std::unique_ptr<SpritesheetLayout>(new SkylineSpritesheetLayout_BL(w, h, duplicateEdgePixel, spritesMargin));
+    case PackingAlgorithm::ALG_SKYLINE_MIN_WASTE:
+        return std::unique_ptr<SpritesheetLayout>(new SkylineSpritesheetLayout_MW(w, h, duplicateEdgePixel, spritesMargin));
     default:
         DVASSERT(false, Format("Unknown algorithm id: %d", alg).c_str());
         return nullptr;
@@ -46,6 +46,8 @@ public:
         /** Indexed sprites data for fast processing */
         Vector<RectanglePacker::SpriteIndexedData> resultIndexedSprites;
         bool Success() const;
+        /** Part of result spritesheets area covered by sprites frames, from 0 to 1 */
+        float32 GetOccupancy() const;
     };
 
     struct SpriteItem
@@ -63,6 +65,10 @@ public:
     void SetUseOnlySquareTextures(bool value);
     void SetMaxTextureSize(uint32 maxTextureSize);
     void SetAlgorithms(const Vector<PackingAlgorithm>& algorithms);
+    /** Set orders of sprites to try with every algorithm, sprites are sorted by area by default */
+    void SetSortOrders(const Vector<PackingSortOrder>& sortOrders);
+    /** Try combinations of sheet size, sort order and algorithm in job worker threads. Result is the same as without it */
+    void SetUseParallelSearch(bool value = true);
     // set visible 1 pixel border for each texture
     void SetTwoSideMargin(bool val = true);
     void SetTexturesMargin(uint32 margin);
@@ -71,14 +77,34 @@ public:
     std::unique_ptr<PackResult> Pack(PackTask& packTask) const;
 
 private:
+    struct PackCandidate
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        uint32 sortOrderIndex = 0;
+        PackingAlgorithm algorithm = PackingAlgorithm::ALG_BASIC;
+    };
+
+    struct PackAttempt
+    {
+        std::unique_ptr<SpritesheetLayout> sheet;
+        Vector<SpriteItem> spritesRemaining;
+        uint32 spritesWeight = 0;
+        bool fullyPacked = false;
+        bool tried = false;
+    };
+
     std::unique_ptr<PackResult> PackSprites(Vector<SpriteItem>& spritesToPack, PackTask& packTask) const;
+    void TryCandidate(const PackCandidate& candidate, const Vector<SpriteItem>& sortedSprites, bool fullPackOnly, PackAttempt& attempt) const;
     uint32 TryToPack(SpritesheetLayout* sheet, Vector<SpriteItem>& tempSortVector, bool fullPackOnly) const;
     void CreateSpritesIndex(RectanglePacker::PackTask& packTask, RectanglePacker::PackResult* packResult) const;
 
     Vector<PackingAlgorithm> packAlgorithms;
+    Vector<PackingSortOrder> sortOrders = { PackingSortOrder::SORT_BY_AREA };
     uint32 maxTextureSize = DEFAULT_TEXTURE_SIZE;
     bool onlySquareTextures = false;
     bool useTwoSideMargin = false;
+    bool useParallelSearch = false;
     uint32 texturesMargin = 1;
 };
 
@@ -105,6 +131,16 @@ inline void RectanglePacker::SetAlgorithms(const Vector<PackingAlgorithm>& algor
 {
     packAlgorithms = algorithms;
 }
+
+inline void RectanglePacker::SetSortOrders(const Vector<PackingSortOrder>& sortOrders_)
+{
+    sortOrders = sortOrders_;
+}
+
+inline void RectanglePacker::SetUseParallelSearch(bool value)
+{
+    useParallelSearch = value;
+}
 inline uint32 RectanglePacker::SpriteDefinition::GetFrameCount() const
 {
     return static_cast<uint32>(frameRects.size());
@@ -5,6 +5,7 @@
 #include "Concurrency/Thread.h"
 #include "Engine/EngineContext.h"
 #include "Job/JobManager.h"
+#include "Logger/Logger.h"
 #include "Render/2D/Systems/DynamicAtlasSystem.h"
 #include "Render/Texture.h"
 #include "Render/TextureDescriptor.h"
@@ -136,4 +137,219 @@ DAVA_TESTCLASS (RectanglePackerTest)
         TEST_VERIFY(packResult->resultSheets.size() == 1);
         TEST_VERIFY(packResult->resultErrors.size() == 1);
     }
+
+    DAVA_TEST (SkylineTest)
+    {
+        RectanglePacker rectanglePacker;
+        rectanglePacker.SetMaxTextureSize(1024);
+        rectanglePacker.SetUseOnlySquareTextures(false);
+        rectanglePacker.SetTwoSideMargin(true);
+        rectanglePacker.SetTexturesMargin(1);
+        rectanglePacker.SetAlgorithms({
+        // "skyline"
+        PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT,
+        PackingAlgorithm::ALG_SKYLINE_MIN_WASTE
+        });
+
+        RectanglePacker::PackTask packTask;
+        FillVariousSprites(packTask);
+
+        auto packResult = rectanglePacker.Pack(packTask);
+        TEST_VERIFY(packResult->Success());
+        TEST_VERIFY(packResult->resultErrors.size() == 0);
+        VerifyLayout(*packResult);
+
+        float32 occupancy = packResult->GetOccupancy();
+        TEST_VERIFY(occupancy > 0.f && occupancy <= 1.f);
+    }
+
+    DAVA_TEST (ParallelSearchTest)
+    {
+        auto createPacker = [](bool useParallelSearch) {
+            RectanglePacker rectanglePacker;
+            rectanglePacker.SetMaxTextureSize(512);
+            rectanglePacker.SetUseOnlySquareTextures(false);
+            rectanglePacker.SetTwoSideMargin(false);
+            rectanglePacker.SetTexturesMargin(2);
+            rectanglePacker.SetAlgorithms({
+            // "best"
+            PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT,
+            PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT,
+            PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT,
+            PackingAlgorithm::ALG_SKYLINE_MIN_WASTE
+            });
+            rectanglePacker.SetSortOrders({ PackingSortOrder::SORT_BY_AREA, PackingSortOrder::SORT_BY_MAX_SIDE, PackingSortOrder::SORT_BY_PERIMETER,
+                                            PackingSortOrder::SORT_BY_WIDTH, PackingSortOrder::SORT_BY_HEIGHT });
+            rectanglePacker.SetUseParallelSearch(useParallelSearch);
+            return rectanglePacker;
+        };
+
+        RectanglePacker::PackTask packTask;
+        FillVariousSprites(packTask);
+
+        auto sequentialResult = createPacker(false).Pack(packTask);
+        auto parallelResult = createPacker(true).Pack(packTask);
+        TEST_VERIFY(sequentialResult->Success());
+        TEST_VERIFY(parallelResult->Success());
+        VerifyLayout(*parallelResult);
+
+        // parallel search should choose exactly the same layout
+        TEST_VERIFY(sequentialResult->resultSheets.size() == parallelResult->resultSheets.size());
+        for (size_t i = 0; i < sequentialResult->resultSheets.size() && i < parallelResult->resultSheets.size(); ++i)
+        {
+            TEST_VERIFY(sequentialResult->resultSheets[i]->GetRect() == parallelResult->resultSheets[i]->GetRect());
+        }
+        for (size_t i = 0; i < sequentialResult->resultIndexedSprites.size(); ++i)
+        {
+            const RectanglePacker::SpriteIndexedData& sequentialData = sequentialResult->resultIndexedSprites[i];
+            const RectanglePacker::SpriteIndexedData& parallelData = parallelResult->resultIndexedSprites[i];
+            TEST_VERIFY(sequentialData.frameToSheetIndex == parallelData.frameToSheetIndex);
+            for (size_t frame = 0; frame < sequentialData.frameToPackedInfo.size(); ++frame)
+            {
+                TEST_VERIFY(sequentialData.frameToPackedInfo[frame]->spriteRect == parallelData.frameToPackedInfo[frame]->spriteRect);
+            }
+        }
+    }
+
+    DAVA_TEST (OccupancyBenchmark)
+    {
+        // Occupancy of every heuristic is compared with default MaxRects search on synthetic sprite sets,
+        // measuring it on real sprite sets is left to ResourcePacker2D runs
+        const Vector<PackingAlgorithm> defaultAlgorithms = {
+            PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT,
+            PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT
+        };
+        const Vector<PackingAlgorithm> allAlgorithms = {
+            PackingAlgorithm::ALG_BASIC,
+            PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT,
+            PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT,
+            PackingAlgorithm::ALG_SKYLINE_MIN_WASTE
+        };
+        const Vector<PackingSortOrder> allSortOrders = {
+            PackingSortOrder::SORT_BY_AREA,
+            PackingSortOrder::SORT_BY_MAX_SIDE,
+            PackingSortOrder::SORT_BY_PERIMETER,
+            PackingSortOrder::SORT_BY_WIDTH,
+            PackingSortOrder::SORT_BY_HEIGHT
+        };
+
+        auto measureOccupancy = [](const RectanglePacker::PackTask& packTask, const Vector<PackingAlgorithm>& algorithms, const Vector<PackingSortOrder>& sortOrders, size_t* sheetsCount) {
+            RectanglePacker rectanglePacker;
+            rectanglePacker.SetMaxTextureSize(1024);
+            rectanglePacker.SetUseOnlySquareTextures(false);
+            rectanglePacker.SetTwoSideMargin(false);
+            rectanglePacker.SetTexturesMargin(1);
+            rectanglePacker.SetAlgorithms(algorithms);
+            rectanglePacker.SetSortOrders(sortOrders);
+            rectanglePacker.SetUseParallelSearch(true);
+
+            RectanglePacker::PackTask task = packTask;
+            auto packResult = rectanglePacker.Pack(task);
+            TEST_VERIFY(packResult->Success());
+            *sheetsCount = packResult->resultSheets.size();
+            return packResult->GetOccupancy();
+        };
+
+        Vector<RectanglePacker::PackTask> packTasks(3);
+        FillVariousSprites(packTasks[0]);
+        for (int32 i = 0; i < 60; ++i)
+        { // long and thin sprites, like progress bars and separators
+            auto spriteDef = std::make_shared<RectanglePacker::SpriteDefinition>();
+            spriteDef->frameRects.push_back((i % 2) ? Rect2i(0, 0, 40 + (i * 29) % 300, 4 + i % 12) : Rect2i(0, 0, 4 + i % 12, 40 + (i * 29) % 300));
+            packTasks[1].spriteList.push_back(spriteDef);
+        }
+        for (int32 i = 0; i < 30; ++i)
+        { // sprites which don't fit into one sheet
+            auto spriteDef = std::make_shared<RectanglePacker::SpriteDefinition>();
+            spriteDef->frameRects.push_back(Rect2i(0, 0, 100 + (i * 67) % 300, 100 + (i * 41) % 300));
+            packTasks[2].spriteList.push_back(spriteDef);
+        }
+
+        for (size_t taskIndex = 0; taskIndex < packTasks.size(); ++taskIndex)
+        {
+            const RectanglePacker::PackTask& packTask = packTasks[taskIndex];
+
+            size_t defaultSheets = 0;
+            const float32 defaultOccupancy = measureOccupancy(packTask, defaultAlgorithms, { PackingSortOrder::SORT_BY_AREA }, &defaultSheets);
+            Logger::Info("Sprite set %u: default occupancy %.3f, %u sheets", static_cast<uint32>(taskIndex), defaultOccupancy, static_cast<uint32>(defaultSheets));
+
+            for (PackingAlgorithm algorithm : allAlgorithms)
+            {
+                size_t sheets = 0;
+                const float32 occupancy = measureOccupancy(packTask, { algorithm }, { PackingSortOrder::SORT_BY_AREA }, &sheets);
+                Logger::Info("    algorithm %d: occupancy %.3f (%+.3f), %u sheets", static_cast<int32>(algorithm), occupancy, occupancy - defaultOccupancy, static_cast<uint32>(sheets));
+            }
+            for (PackingSortOrder sortOrder : allSortOrders)
+            {
+                size_t sheets = 0;
+                const float32 occupancy = measureOccupancy(packTask, defaultAlgorithms, { sortOrder }, &sheets);
+                Logger::Info("    sort order %d: occupancy %.3f (%+.3f), %u sheets", static_cast<int32>(sortOrder), occupancy, occupancy - defaultOccupancy, static_cast<uint32>(sheets));
+            }
+
+            size_t bestSheets = 0;
+            const float32 bestOccupancy = measureOccupancy(packTask, allAlgorithms, allSortOrders, &bestSheets);
+            Logger::Info("    all algorithms and sort orders: occupancy %.3f (%+.3f), %u sheets", bestOccupancy, bestOccupancy - defaultOccupancy, static_cast<uint32>(bestSheets));
+
+            // search over all heuristics includes default candidates, so single sheet can't get worse
+            if (defaultSheets == 1)
+            {
+                TEST_VERIFY(bestSheets == 1);
+                TEST_VERIFY(bestOccupancy >= defaultOccupancy);
+            }
+        }
+    }
+
+    void FillVariousSprites(RectanglePacker::PackTask & packTask)
+    {
+        for (int32 i = 0; i < 40; ++i)
+        {
+            auto spriteDef = std::make_shared<RectanglePacker::SpriteDefinition>();
+            spriteDef->frameRects.push_back(Rect2i(0, 0, 8 + (i * 37) % 120, 8 + (i * 53) % 90));
+            packTask.spriteList.push_back(spriteDef);
+        }
+    }
+
+    void VerifyLayout(const RectanglePacker::PackResult& packResult)
+    {
+        Vector<Vector<const SpriteBoundsRect*>> sheetCells(packResult.resultSheets.size());
+        for (const RectanglePacker::SpriteIndexedData& spriteData : packResult.resultIndexedSprites)
+        {
+            for (size_t frame = 0; frame < spriteData.frameToSheetIndex.size(); ++frame)
+            {
+                int32 sheetIndex = spriteData.frameToSheetIndex[frame];
+                const SpriteBoundsRect* cell = spriteData.frameToPackedInfo[frame];
+                TEST_VERIFY(cell != nullptr);
+                TEST_VERIFY(cell->spriteRect.GetSize() == spriteData.spriteDef->GetFrameSize(static_cast<uint32>(frame)));
+                sheetCells[sheetIndex].push_back(cell);
+            }
+        }
+
+        for (size_t sheetIndex = 0; sheetIndex < sheetCells.size(); ++sheetIndex)
+        {
+            const Rect2i& sheetRect = packResult.resultSheets[sheetIndex]->GetRect();
+            const Vector<const SpriteBoundsRect*>& cells = sheetCells[sheetIndex];
+            for (size_t i = 0; i < cells.size(); ++i)
+            {
+                const Rect2i& a = cells[i]->marginsRect;
+                TEST_VERIFY(a.x >= sheetRect.x && a.y >= sheetRect.y);
+                TEST_VERIFY(a.x + a.dx <= sheetRect.x + sheetRect.dx && a.y + a.dy <= sheetRect.y + sheetRect.dy);
+                for (size_t j = i + 1; j < cells.size(); ++j)
+                {
+                    const Rect2i& b = cells[j]->marginsRect;
+                    bool overlaps = (a.x < b.x + b.dx) && (b.x < a.x + a.dx) && (a.y < b.y + b.dy) && (b.y < a.y + a.dy);
+                    TEST_VERIFY(overlaps == false);
+                }
+            }
+        }
+    }
 };
@@ -13,7 +13,19 @@ enum class PackingAlgorithm
     ALG_MAXRECTS_BEST_AREA_FIT,
     ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
     ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
-    ALG_MAXRRECT_BEST_CONTACT_POINT
+    ALG_MAXRRECT_BEST_CONTACT_POINT,
+    ALG_SKYLINE_BOTTOM_LEFT,
+    ALG_SKYLINE_MIN_WASTE
+};
+
+/** Order in which sprites are tried to be added to spritesheet */
+enum class PackingSortOrder
+{
+    SORT_BY_AREA,
+    SORT_BY_MAX_SIDE,
+    SORT_BY_PERIMETER,
+    SORT_BY_WIDTH,
+    SORT_BY_HEIGHT
 };
 
 struct SpriteBoundsRect
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+#include <algorithm>
+
+/**
+    Thin wrappers over four-wide float vector instructions for batch kernels.
+    SSE is used on x86/x64 and NEON on ARM. `DAVA_SIMD` is defined when any of them is available,
+    `DAVA_SIMD_DIV` and `DAVA_SIMD_SQRT` when division and square root are native (not on 32-bit NEON).
+    Kernels are expected to have a plain scalar loop for the tail and for builds without `DAVA_SIMD`.
+*/
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DAVA_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DAVA_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace SIMD
+{
+#if defined(DAVA_SIMD_SSE)
+#define DAVA_SIMD
+#define DAVA_SIMD_DIV
+#define DAVA_SIMD_SQRT
+using Float4 = __m128;
+
+inline Float4 Load(const float32* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void Store(float32* p, Float4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline Float4 Splat(float32 v)
+{
+    return _mm_set1_ps(v);
+}
+inline Float4 Add(Float4 a, Float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+inline Float4 Sub(Float4 a, Float4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+inline Float4 Mul(Float4 a, Float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline Float4 Div(Float4 a, Float4 b)
+{
+    return _mm_div_ps(a, b);
+}
+inline Float4 Min(Float4 a, Float4 b)
+{
+    return _mm_min_ps(a, b);
+}
+inline Float4 Max(Float4 a, Float4 b)
+{
+    return _mm_max_ps(a, b);
+}
+inline Float4 Sqrt(Float4 v)
+{
+    return _mm_sqrt_ps(v);
+}
+inline Float4 And(Float4 a, Float4 b)
+{
+    return _mm_and_ps(a, b);
+}
+inline Float4 Xor(Float4 a, Float4 b)
+{
+    return _mm_xor_ps(a, b);
+}
+/** 1 / sqrt(v) with about 22 bits of precision. */
+inline Float4 ReciprocalSqrt(Float4 v)
+{
+    Float4 y = _mm_rsqrt_ps(v);
+    Float4 yyv = _mm_mul_ps(_mm_mul_ps(y, y), v);
+    return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), yyv));
+}
+#elif defined(DAVA_SIMD_NEON)
+#define DAVA_SIMD
+using Float4 = float32x4_t;
+
+inline Float4 Load(const float32* p)
+{
+    return vld1q_f32(p);
+}
+inline void Store(float32* p, Float4 v)
+{
+    vst1q_f32(p, v);
+}
+inline Float4 Splat(float32 v)
+{
+    return vdupq_n_f32(v);
+}
+inline Float4 Add(Float4 a, Float4 b)
+{
+    return vaddq_f32(a, b);
+}
+inline Float4 Sub(Float4 a, Float4 b)
+{
+    return vsubq_f32(a, b);
+}
+inline Float4 Mul(Float4 a, Float4 b)
+{
+    return vmulq_f32(a, b);
+}
+inline Float4 Min(Float4 a, Float4 b)
+{
+    return vminq_f32(a, b);
+}
+inline Float4 Max(Float4 a, Float4 b)
+{
+    return vmaxq_f32(a, b);
+}
+inline Float4 And(Float4 a, Float4 b)
+{
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline Float4 Xor(Float4 a, Float4 b)
+{
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+/** 1 / sqrt(v) with about 22 bits of precision. */
+inline Float4 ReciprocalSqrt(Float4 v)
+{
+    Float4 y = vrsqrteq_f32(v);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(v, y), y));
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(v, y), y));
+    return y;
+}
+#if defined(__aarch64__)
+#define DAVA_SIMD_DIV
+#define DAVA_SIMD_SQRT
+inline Float4 Div(Float4 a, Float4 b)
+{
+    return vdivq_f32(a, b);
+}
+inline Float4 Sqrt(Float4 v)
+{
+    return vsqrtq_f32(v);
+}
+#endif
+#endif
+
+#if defined(DAVA_SIMD)
+const uint32 WIDTH = 4;
+
+/** Count of leading elements of `count` which can be processed by whole vectors. */
+inline uint32 GetVectorizedCount(uint32 count)
+{
+    return count & ~(WIDTH - 1);
+}
+
+/** Vector with only sign bits set, for `And` and `Xor` with sign masks. */
+inline Float4 SignMask()
+{
+    return Splat(-0.0f);
+}
+
+inline float32 HorizontalMin(Float4 v)
+{
+    float32 values[WIDTH];
+    Store(values, v);
+    return std::min(std::min(values[0], values[1]), std::min(values[2], values[3]));
+}
+
+inline float32 HorizontalMax(Float4 v)
+{
+    float32 values[WIDTH];
+    Store(values, v);
+    return std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+}
+#else
+inline uint32 GetVectorizedCount(uint32 /*count*/)
+{
+    return 0;
+}
+#endif
+} // namespace SIMD
+} // namespace DAVA
@@ -44,13 +44,67 @@
 
 namespace DAVA
 {
+namespace MemoryManagerDetails
+{
+// Counters of thread state are changed only by owning thread, so there is no need in atomic read-modify-write
+inline void IncreaseCounter(std::atomic<int64>& counter, uint32 value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void DecreaseCounter(std::atomic<int64>& counter, uint32 value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) - value, std::memory_order_relaxed);
+}
+
+inline void UpdateMaxCounter(std::atomic<uint32>& counter, uint32 value)
+{
+    if (counter.load(std::memory_order_relaxed) < value)
+    {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+// Thread may free blocks allocated by other threads, so its counters are signed
+struct ThreadAllocPoolStat
+{
+    std::atomic<int64> allocByApp{ 0 };
+    std::atomic<int64> allocTotal{ 0 };
+    std::atomic<int64> blockCount{ 0 };
+    std::atomic<uint32> maxBlockSize{ 0 };
+};
+
+struct ThreadTagAllocStat
+{
+    std::atomic<int64> allocByApp{ 0 };
+    std::atomic<int64> blockCount{ 0 };
+};
+
+// Backtrace table entry state: backtrace hash in high half and number of live blocks in low half,
+// they are changed together so entry can't be taken for other backtrace while it is referenced
+inline uint64 MakeBacktraceState(uint32 hash, uint32 nref)
+{
+    return (static_cast<uint64>(hash) << 32) | nref;
+}
+
+inline uint32 BacktraceStateHash(uint64 state)
+{
+    return static_cast<uint32>(state >> 32);
+}
+
+inline uint32 BacktraceStateRefCount(uint64 state)
+{
+    return static_cast<uint32>(state);
+}
+} // namespace MemoryManagerDetails
+
 struct MemoryManager::MemoryBlock
 {
     MemoryBlock* prev; // Pointer to previous block
     MemoryBlock* next; // Pointer to next block
     void* realBlockStart; // Pointer to real block start
-    void* padding1; // Padding to make sure that
-    uint32 padding2; //          struct size is integral multiple of 16 bytes
+    ThreadState* owner; // State of thread whose list contains block, nullptr if block is not listed
+    uint32 padding; // Padding to make sure that struct size is integral multiple of 16 bytes
     uint32 orderNo; // Block order number
     uint32 allocByApp; // Size requested by application
     uint32 allocTotal; // Total allocated size
@@ -72,10 +126,28 @@ static_assert(sizeof(MemoryManager::InternalMemoryBlock) % 16 == 0, "sizeof(Memo
 
 struct MemoryManager::Backtrace
 {
-    size_t nref;
     uint32 hash;
     bool symbolsCollected;
     Array<void*, BACKTRACE_DEPTH> frames;
+    Backtrace* nextRetired; // Next backtrace in list of replaced backtraces waiting to be freed
+};
+
+struct MemoryManager::BacktraceEntry
+{
+    std::atomic<uint64> state; // Backtrace hash and number of live blocks with it, zero for free entry
+    std::atomic<Backtrace*> backtrace; // Backtrace frames, published after entry has been claimed
+};
+
+// Per-thread memory tracking state: statistics changes made by thread and list of blocks allocated by it.
+// Only owning thread changes statistics; list is locked by other threads when they free its blocks or make snapshot.
+// States are never freed, so blocks and statistics of exited threads are still accounted.
+struct MemoryManager::ThreadState
+{
+    ThreadState* next = nullptr;
+    MutexType blockListMutex;
+    MemoryBlock* head = nullptr;
+    MemoryManagerDetails::ThreadAllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT];
+    MemoryManagerDetails::ThreadTagAllocStat statTag[MAX_TAG_COUNT];
 };
 
 struct MemoryManager::AllocScopeItem
@@ -227,25 +299,12 @@ DAVA_NOINLINE void* MemoryManager::Allocate(size_t size, uint32 poolIndex)
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
+        TrackBlock(block);
         if (!lightWeightMode)
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
-            block->bktraceHash = backtrace.hash;
-
-            LockType lock(bktraceMutex);
-            InsertBacktrace(backtrace);
+            block->bktraceHash = InsertBacktrace(backtrace) ? backtrace.hash : 0;
         }
         return static_cast<void*>(block + 1);
     }
@@ -296,25 +355,12 @@ DAVA_NOINLINE void* MemoryManager::AlignedAllocate(size_t size, size_t align, ui
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
+        TrackBlock(block);
         if (!lightWeightMode)
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
-            block->bktraceHash = backtrace.hash;
-
-            LockType lock(bktraceMutex);
-            InsertBacktrace(backtrace);
+            block->bktraceHash = InsertBacktrace(backtrace) ? backtrace.hash : 0;
         }
         return reinterpret_cast<void*>(aligned);
     }
@@ -425,18 +471,14 @@ void MemoryManager::Deallocate(void* ptr)
         bool isAccessible = IsMemoryAddressAccessible(block);
         if (isAccessible && BLOCK_MARK == block->mark)
         {
+            RemoveBlock(block);
+            ThreadState* threadState = GetThreadState();
+            if (threadState != nullptr)
             {
-                LockType lock(allocMutex);
-                RemoveBlock(block);
-            }
-            {
-                uint32 systemMemoryUsage = GetSystemMemoryUsage();
-                LockType lock(statMutex);
-                UpdateStatAfterDealloc(block, systemMemoryUsage);
+                UpdateStatAfterDealloc(threadState, block);
             }
-            if (!lightWeightMode)
+            if (block->bktraceHash != 0)
             {
-                LockType lock(bktraceMutex);
                 RemoveBacktrace(block->bktraceHash);
             }
 
@@ -449,9 +491,8 @@ void MemoryManager::Deallocate(void* ptr)
         }
         else
         {
-            LockType lock(statMutex);
-            statGeneral.ghostBlockCount += 1;
-            statGeneral.ghostSize += static_cast<uint32>(MallocHook::MallocSize(ptr));
+            ghostBlockCount.fetch_add(1, std::memory_order_relaxed);
+            ghostSize.fetch_add(static_cast<uint32>(MallocHook::MallocSize(ptr)), std::memory_order_relaxed);
             ptrToFree = ptr;
         }
         MallocHook::Free(ptrToFree);
@@ -486,12 +527,9 @@ void* MemoryManager::InternalAllocate(size_t size)
             block->allocTotal = static_cast<uint32>(totalSize);
 
         // Update stat
-        {
-            LockType lock(statMutex);
-            statGeneral.allocInternal += block->allocByApp;
-            statGeneral.allocInternalTotal += block->allocTotal;
-            statGeneral.internalBlockCount += 1;
-        }
+        allocInternal.fetch_add(block->allocByApp, std::memory_order_relaxed);
+        allocInternalTotal.fetch_add(block->allocTotal, std::memory_order_relaxed);
+        internalBlockCount.fetch_add(1, std::memory_order_relaxed);
         return static_cast<void*>(block + 1);
     }
     return nullptr;
@@ -505,12 +543,9 @@ void MemoryManager::InternalDeallocate(void* ptr)
         assert(INTERNAL_BLOCK_MARK == block->mark);
 
         // Update stat
-        {
-            LockType lock(statMutex);
-            statGeneral.allocInternal -= block->allocByApp;
-            statGeneral.allocInternalTotal -= block->allocTotal;
-            statGeneral.internalBlockCount -= 1;
-        }
+        allocInternal.fetch_sub(block->allocByApp, std::memory_order_relaxed);
+        allocInternalTotal.fetch_sub(block->allocTotal, std::memory_order_relaxed);
+        internalBlockCount.fetch_sub(1, std::memory_order_relaxed);
 
         // Clear mark of deallocated block
         block->mark = DEAD_BLOCK_MARK;
@@ -547,8 +582,10 @@ uint32 MemoryManager::GetTrackedMemoryUsage(uint32 poolIndex) const
 {
     assert(ALLOC_POOL_TOTAL <= poolIndex && poolIndex < MAX_ALLOC_POOL_COUNT);
 
-    LockType lock(statMutex);
-    return statAllocPool[poolIndex].allocByApp;
+    AllocPoolStat pools[MAX_ALLOC_POOL_COUNT];
+    TagAllocStat tags[MAX_TAG_COUNT];
+    MergeStat(pools, tags);
+    return pools[poolIndex].allocByApp;
 }
 
 uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
@@ -559,20 +596,19 @@ uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
 
     DVASSERT(index < MAX_TAG_COUNT);
 
-    LockType lock(statMutex);
-    return statTag[index].allocByApp;
+    AllocPoolStat pools[MAX_ALLOC_POOL_COUNT];
+    TagAllocStat tags[MAX_TAG_COUNT];
+    MergeStat(pools, tags);
+    return tags[index].allocByApp;
 }
 
 void MemoryManager::EnterTagScope(uint32 tag)
 {
     DVASSERT(tag != 0 && IsPowerOf2(tag));
-    DVASSERT((statGeneral.activeTags & tag) == 0); // Tag shouldn't be set earlier
+    DVASSERT((activeTags & tag) == 0); // Tag shouldn't be set earlier
 
-    {
-        LockType lock(allocMutex);
-        statGeneral.activeTags |= tag;
-        statGeneral.activeTagCount += 1;
-    }
+    activeTags.fetch_or(tag);
+    activeTagCount.fetch_add(1);
     if (tagCallback != nullptr)
     {
         tagCallback(tag, true);
@@ -582,13 +618,10 @@ void MemoryManager::EnterTagScope(uint32 tag)
 void MemoryManager::LeaveTagScope(uint32 tag)
 {
     DVASSERT(tag != 0 && IsPowerOf2(tag));
-    DVASSERT((statGeneral.activeTags & tag) == tag); // Tag should be set earlier
+    DVASSERT((activeTags & tag) == tag); // Tag should be set earlier
 
-    {
-        LockType lock(allocMutex);
-        statGeneral.activeTags &= ~tag;
-        statGeneral.activeTagCount -= 1;
-    }
+    activeTags.fetch_and(~tag);
+    activeTagCount.fetch_sub(1);
     if (tagCallback != nullptr)
     {
         tagCallback(tag, false);
@@ -616,6 +649,7 @@ void MemoryManager::LeaveAllocScope(uint32 allocPool)
 
 void MemoryManager::TrackGpuAlloc(uint32 id, size_t size, uint32 gpuPoolIndex)
 {
+    ThreadState* threadState = GetThreadState();
     LockType lock(gpuMutex);
 
     if (nullptr == gpuBlockMap)
@@ -639,14 +673,15 @@ void MemoryManager::TrackGpuAlloc(uint32 id, size_t size, uint32 gpuPoolIndex)
     gpuBlock.allocByApp += static_cast<uint32>(size);
     gpuBlock.allocTotal = gpuBlock.allocByApp;
     gpuBlock.mark += 1; // Make use field 'mark' as number of GPU allocations with given id and pool index
+    if (threadState != nullptr)
     {
-        LockType lock(statMutex);
-        UpdateStatAfterGPUAlloc(&gpuBlock, size);
+        UpdateStatAfterGPUAlloc(threadState, &gpuBlock, size);
     }
 }
 
 void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
 {
+    ThreadState* threadState = GetThreadState();
     LockType lock(gpuMutex);
 
     uint64 key = PackGPUKey(id, gpuPoolIndex);
@@ -654,101 +689,136 @@ void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
     DVASSERT(iter != gpuBlockMap->end());
 
     MemoryBlock& gpuBlock = iter->second;
+    if (threadState != nullptr)
     {
-        LockType lock(statMutex);
-        UpdateStatAfterGPUDealloc(&gpuBlock);
+        UpdateStatAfterGPUDealloc(threadState, &gpuBlock);
     }
     gpuBlockMap->erase(iter);
 }
 
-void MemoryManager::InsertBlock(MemoryBlock* block)
+MemoryManager::ThreadState* MemoryManager::GetThreadState()
 {
-    if (head != nullptr)
+    // Thread local storage is already destroyed when memory is freed during static deinitialization,
+    // such allocations and deallocations are not accounted as it was done for allocation scopes
+    if (!tlsThreadState.IsCreated())
     {
-        block->next = head;
-        block->prev = nullptr;
-        head->prev = block;
-        head = block;
+        return nullptr;
     }
-    else
+
+    ThreadState* threadState = tlsThreadState.Get();
+    if (nullptr == threadState)
     {
-        block->next = nullptr;
-        block->prev = nullptr;
-        head = block;
+        threadState = new (InternalAllocate(sizeof(ThreadState))) ThreadState();
+
+        threadState->next = threadStates.load();
+        while (!threadStates.compare_exchange_weak(threadState->next, threadState))
+        {
+        }
+        tlsThreadState.Reset(threadState);
     }
+    return threadState;
 }
 
-void MemoryManager::RemoveBlock(MemoryBlock* block)
+void MemoryManager::TrackBlock(MemoryBlock* block)
+{
+    ThreadState* threadState = GetThreadState();
+
+    block->tags = activeTags.load(std::memory_order_relaxed);
+    block->orderNo = nextBlockNo.fetch_add(1, std::memory_order_relaxed);
+    block->owner = nullptr;
+    if (threadState != nullptr)
+    {
+        if (!lightWeightMode)
+        { // In lightweight mode there are no snapshots, so there is no need to list blocks
+            InsertBlock(threadState, block);
+        }
+        UpdateStatAfterAlloc(threadState, block);
+    }
+}
+
+void MemoryManager::InsertBlock(ThreadState* threadState, MemoryBlock* block)
 {
-    if (block->prev != nullptr)
-        block->prev->next = block->next;
-    if (block->next != nullptr)
-        block->next->prev = block->prev;
-    if (block == head)
-        head = head->next;
+    LockType lock(threadState->blockListMutex);
+
+    block->owner = threadState;
+    block->prev = nullptr;
+    block->next = threadState->head;
+    if (threadState->head != nullptr)
+        threadState->head->prev = block;
+    threadState->head = block;
 }
 
-void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::RemoveBlock(MemoryBlock* block)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+    ThreadState* owner = block->owner;
+    if (owner != nullptr)
+    {
+        LockType lock(owner->blockListMutex);
+
+        if (block->prev != nullptr)
+            block->prev->next = block->next;
+        if (block->next != nullptr)
+            block->next->prev = block->prev;
+        if (block == owner->head)
+            owner->head = owner->head->next;
     }
-    { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount += 1;
+}
 
-        if (block->allocByApp > statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize)
-            statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
+void MemoryManager::UpdateStatAfterAlloc(ThreadState* threadState, MemoryBlock* block)
+{
+    using namespace MemoryManagerDetails;
+
+    { // Update total statistics
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[ALLOC_POOL_TOTAL];
+        IncreaseCounter(stat.allocByApp, block->allocByApp);
+        IncreaseCounter(stat.allocTotal, block->allocTotal);
+        IncreaseCounter(stat.blockCount, 1);
+        UpdateMaxCounter(stat.maxBlockSize, block->allocByApp);
     }
     { // Update pool statistics
-        const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp += block->allocByApp;
-        statAllocPool[poolIndex].allocTotal += block->allocTotal;
-        statAllocPool[poolIndex].blockCount += 1;
-
-        if (block->allocByApp > statAllocPool[poolIndex].maxBlockSize)
-            statAllocPool[poolIndex].maxBlockSize = block->allocByApp;
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[block->pool];
+        IncreaseCounter(stat.allocByApp, block->allocByApp);
+        IncreaseCounter(stat.allocTotal, block->allocTotal);
+        IncreaseCounter(stat.blockCount, 1);
+        UpdateMaxCounter(stat.maxBlockSize, block->allocByApp);
     }
 
     { // Update tag statistics
-        uint32 tags = statGeneral.activeTags;
+        uint32 tags = block->tags;
         if (tags != 0)
         {
             for (size_t index = 0; tags != 0; ++index, tags >>= 1)
             {
                 if (tags & 0x01)
                 {
-                    statTag[index].allocByApp += block->allocByApp;
-                    statTag[index].blockCount += 1;
+                    IncreaseCounter(threadState->statTag[index].allocByApp, block->allocByApp);
+                    IncreaseCounter(threadState->statTag[index].blockCount, 1);
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp += block->allocByApp;
-            statTag[UNTAGGED].blockCount += 1;
+            IncreaseCounter(threadState->statTag[UNTAGGED].allocByApp, block->allocByApp);
+            IncreaseCounter(threadState->statTag[UNTAGGED].blockCount, 1);
         }
     }
 }
 
-void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::UpdateStatAfterDealloc(ThreadState* threadState, MemoryBlock* block)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
-    }
+    using namespace MemoryManagerDetails;
+
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount -= 1;
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[ALLOC_POOL_TOTAL];
+        DecreaseCounter(stat.allocByApp, block->allocByApp);
+        DecreaseCounter(stat.allocTotal, block->allocTotal);
+        DecreaseCounter(stat.blockCount, 1);
     }
     { // Update pool statistics
-        const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp -= block->allocByApp;
-        statAllocPool[poolIndex].allocTotal -= block->allocTotal;
-        statAllocPool[poolIndex].blockCount -= 1;
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[block->pool];
+        DecreaseCounter(stat.allocByApp, block->allocByApp);
+        DecreaseCounter(stat.allocTotal, block->allocTotal);
+        DecreaseCounter(stat.blockCount, 1);
     }
     { // Update tag statistics
         uint32 tags = block->tags;
@@ -758,85 +828,190 @@ void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemo
             {
                 if (tags & 0x01)
                 {
-                    statTag[index].allocByApp -= block->allocByApp;
-                    statTag[index].blockCount -= 1;
+                    DecreaseCounter(threadState->statTag[index].allocByApp, block->allocByApp);
+                    DecreaseCounter(threadState->statTag[index].blockCount, 1);
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp -= block->allocByApp;
-            statTag[UNTAGGED].blockCount -= 1;
+            DecreaseCounter(threadState->statTag[UNTAGGED].allocByApp, block->allocByApp);
+            DecreaseCounter(threadState->statTag[UNTAGGED].blockCount, 1);
         }
     }
 }
 
-void MemoryManager::UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr)
+void MemoryManager::UpdateStatAfterGPUAlloc(ThreadState* threadState, MemoryBlock* block, size_t sizeIncr)
 {
+    using namespace MemoryManagerDetails;
+
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp += static_cast<uint32>(sizeIncr);
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal += static_cast<uint32>(sizeIncr);
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[ALLOC_POOL_TOTAL];
+        IncreaseCounter(stat.allocByApp, static_cast<uint32>(sizeIncr));
+        IncreaseCounter(stat.allocTotal, static_cast<uint32>(sizeIncr));
     }
     { // Update pool statistics
-        statAllocPool[block->pool].allocByApp += static_cast<uint32>(sizeIncr);
-        statAllocPool[block->pool].allocTotal += static_cast<uint32>(sizeIncr);
-        statAllocPool[block->pool].blockCount += 1;
-
-        if (block->allocByApp > statAllocPool[block->pool].maxBlockSize)
-            statAllocPool[block->pool].maxBlockSize = block->allocByApp;
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[block->pool];
+        IncreaseCounter(stat.allocByApp, static_cast<uint32>(sizeIncr));
+        IncreaseCounter(stat.allocTotal, static_cast<uint32>(sizeIncr));
+        IncreaseCounter(stat.blockCount, 1);
+        UpdateMaxCounter(stat.maxBlockSize, block->allocByApp);
     }
 }
 
-void MemoryManager::UpdateStatAfterGPUDealloc(MemoryBlock* block)
+void MemoryManager::UpdateStatAfterGPUDealloc(ThreadState* threadState, MemoryBlock* block)
 {
+    using namespace MemoryManagerDetails;
+
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[ALLOC_POOL_TOTAL];
+        DecreaseCounter(stat.allocByApp, block->allocByApp);
+        DecreaseCounter(stat.allocTotal, block->allocTotal);
     }
     { // Update pool statistics
-        statAllocPool[block->pool].allocByApp -= block->allocByApp;
-        statAllocPool[block->pool].allocTotal -= block->allocTotal;
-        statAllocPool[block->pool].blockCount -= block->mark;
+        ThreadAllocPoolStat& stat = threadState->statAllocPool[block->pool];
+        DecreaseCounter(stat.allocByApp, block->allocByApp);
+        DecreaseCounter(stat.allocTotal, block->allocTotal);
+        DecreaseCounter(stat.blockCount, block->mark);
     }
 }
 
-void MemoryManager::InsertBacktrace(Backtrace& backtrace)
+void MemoryManager::MergeStat(AllocPoolStat* pools, TagAllocStat* tags) const
 {
-    if (nullptr == bktraceMap)
+    // Thread may free blocks allocated by other threads, so its own values can be negative.
+    // Clamp sum of them as threads are not stopped while their values are read.
+    int64 poolValues[MAX_ALLOC_POOL_COUNT][3] = {};
+    int64 tagValues[MAX_TAG_COUNT][2] = {};
+    Memset(pools, 0, sizeof(AllocPoolStat) * MAX_ALLOC_POOL_COUNT);
+    Memset(tags, 0, sizeof(TagAllocStat) * MAX_TAG_COUNT);
+
+    for (const ThreadState* threadState = threadStates.load(); threadState != nullptr; threadState = threadState->next)
     {
-        static uint8 bufferForMap[sizeof(BacktraceMap)];
-
-        bktraceMap = new (bufferForMap) BacktraceMap;
+        for (uint32 i = 0; i < MAX_ALLOC_POOL_COUNT; ++i)
+        {
+            const MemoryManagerDetails::ThreadAllocPoolStat& stat = threadState->statAllocPool[i];
+            poolValues[i][0] += stat.allocByApp.load(std::memory_order_relaxed);
+            poolValues[i][1] += stat.allocTotal.load(std::memory_order_relaxed);
+            poolValues[i][2] += stat.blockCount.load(std::memory_order_relaxed);
+            pools[i].maxBlockSize = std::max(pools[i].maxBlockSize, stat.maxBlockSize.load(std::memory_order_relaxed));
+        }
+        for (uint32 i = 0; i < MAX_TAG_COUNT; ++i)
+        {
+            const MemoryManagerDetails::ThreadTagAllocStat& stat = threadState->statTag[i];
+            tagValues[i][0] += stat.allocByApp.load(std::memory_order_relaxed);
+            tagValues[i][1] += stat.blockCount.load(std::memory_order_relaxed);
+        }
     }
 
-    auto i = bktraceMap->find(backtrace.hash);
-    if (i == bktraceMap->end())
+    for (uint32 i = 0; i < MAX_ALLOC_POOL_COUNT; ++i)
+    {
+        pools[i].allocByApp = static_cast<uint32>(std::max(poolValues[i][0], int64(0)));
+        pools[i].allocTotal = static_cast<uint32>(std::max(poolValues[i][1], int64(0)));
+        pools[i].blockCount = static_cast<uint32>(std::max(poolValues[i][2], int64(0)));
+    }
+    for (uint32 i = 0; i < MAX_TAG_COUNT; ++i)
     {
-        backtrace.nref = 1;
-        backtrace.symbolsCollected = false;
+        tags[i].allocByApp = static_cast<uint32>(std::max(tagValues[i][0], int64(0)));
+        tags[i].blockCount = static_cast<uint32>(std::max(tagValues[i][1], int64(0)));
+    }
+
+    // Memory usage reported by system is requested only when statistics is read
+    const uint32 systemMemoryUsage = GetSystemMemoryUsage();
+    pools[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
+    pools[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+}
 
-        const size_t BKTRACE_THRESHOLD = 100;
-        bktraceGrowDelta += 1;
-        if (bktraceGrowDelta >= BKTRACE_THRESHOLD)
+MemoryManager::BacktraceEntry* MemoryManager::GetBacktraceTable()
+{
+    BacktraceEntry* table = bktraceTable.load(std::memory_order_acquire);
+    if (nullptr == table)
+    {
+        const size_t tableSize = sizeof(BacktraceEntry) * BACKTRACE_TABLE_SIZE;
+        BacktraceEntry* newTable = static_cast<BacktraceEntry*>(InternalAllocate(tableSize));
+        Memset(newTable, 0, tableSize);
+        if (bktraceTable.compare_exchange_strong(table, newTable))
         {
-            bktraceGrowDelta -= BKTRACE_THRESHOLD;
-            symbolCollectorCondVar.NotifyOne();
+            table = newTable;
+        }
+        else
+        { // Other thread has created table first
+            InternalDeallocate(newTable);
         }
-        bktraceMap->emplace(backtrace.hash, backtrace);
     }
-    else
+    return table;
+}
+
+bool MemoryManager::InsertBacktrace(const Backtrace& backtrace)
+{
+    using namespace MemoryManagerDetails;
+
+    BacktraceEntry* table = GetBacktraceTable();
+    for (uint32 i = 0; i < BACKTRACE_MAX_PROBES; ++i)
     {
-        i->second.nref += 1;
+        BacktraceEntry& entry = table[(backtrace.hash + i) & (BACKTRACE_TABLE_SIZE - 1)];
+        uint64 state = entry.state.load(std::memory_order_acquire);
+        for (;;)
+        {
+            // If entry has been changed by other thread, failed exchange reloads state and it is checked again
+            const uint32 entryHash = BacktraceStateHash(state);
+            if (entryHash == backtrace.hash)
+            {
+                if (entry.state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel))
+                    return true;
+            }
+            else if (0 == entryHash || 0 == BacktraceStateRefCount(state))
+            { // Free entry or entry whose blocks have all been freed is taken for new backtrace
+                if (entry.state.compare_exchange_weak(state, MakeBacktraceState(backtrace.hash, 1), std::memory_order_acq_rel))
+                {
+                    Backtrace* newBacktrace = new (InternalAllocate(sizeof(Backtrace))) Backtrace(backtrace);
+                    Backtrace* oldBacktrace = entry.backtrace.exchange(newBacktrace, std::memory_order_acq_rel);
+                    if (oldBacktrace != nullptr)
+                    { // Replaced backtrace can be read by symbol collector or snapshot, so it is freed by symbol collector later
+                        oldBacktrace->nextRetired = retiredBktraces.load(std::memory_order_relaxed);
+                        while (!retiredBktraces.compare_exchange_weak(oldBacktrace->nextRetired, oldBacktrace, std::memory_order_release))
+                        {
+                        }
+                    }
+
+                    const uint32 BKTRACE_THRESHOLD = 100;
+                    if ((bktraceGrowDelta.fetch_add(1, std::memory_order_relaxed) + 1) % BKTRACE_THRESHOLD == 0)
+                    {
+                        symbolCollectorCondVar.NotifyOne();
+                    }
+                    return true;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
     }
+    // Too many live backtraces collide: backtrace is not stored and will be missing in snapshot
+    return false;
 }
 
 void MemoryManager::RemoveBacktrace(uint32 hash)
 {
-    auto i = bktraceMap->find(hash);
-    i->second.nref -= 1;
-    if (i->second.nref == 0)
+    using namespace MemoryManagerDetails;
+
+    BacktraceEntry* table = bktraceTable.load(std::memory_order_acquire);
+    if (table != nullptr)
     {
-        bktraceMap->erase(i);
+        for (uint32 i = 0; i < BACKTRACE_MAX_PROBES; ++i)
+        {
+            BacktraceEntry& entry = table[(hash + i) & (BACKTRACE_TABLE_SIZE - 1)];
+            uint64 state = entry.state.load(std::memory_order_relaxed);
+            // Same backtrace can occupy several entries if it has been inserted while entry before it was reused,
+            // so entry which is not referenced anymore is skipped
+            while (BacktraceStateHash(state) == hash && BacktraceStateRefCount(state) > 0)
+            {
+                if (entry.state.compare_exchange_weak(state, state - 1, std::memory_order_acq_rel))
+                    return;
+            }
+            if (0 == BacktraceStateHash(state))
+                return;
+        }
     }
 }
 
@@ -881,15 +1056,21 @@ DAVA_NOINLINE void MemoryManager::CollectBacktrace(Backtrace* backtrace, size_t
         bktraceStringLength += n;
     }
     backtrace->hash = HashValue_N(bktraceString, static_cast<uint32>(bktraceStringLength));
-    backtrace->nref = 1;
+    if (0 == backtrace->hash)
+    { // Zero hash marks free entry in backtrace table
+        backtrace->hash = 1;
+    }
     backtrace->symbolsCollected = false;
 }
 
 void MemoryManager::ObtainBacktraceSymbols(const Backtrace* backtrace)
 {
+    // Symbol map is changed only by symbol collector thread, so it's locked only for changing
     if (nullptr == symbolMap)
     {
         static uint8 bufferForMap[sizeof(SymbolMap)];
+
+        LockType lock(symbolMutex);
         symbolMap = new (bufferForMap) SymbolMap;
     }
 
@@ -899,7 +1080,12 @@ void MemoryManager::ObtainBacktraceSymbols(const Backtrace* backtrace)
         {
             String symbol = Debug::GetFrameSymbol(backtrace->frames[i], true);
             if (!symbol.empty())
-                symbolMap->emplace(backtrace->frames[i], InternalString(symbol.c_str()));
+            {
+                InternalString name(symbol.c_str());
+
+                LockType lock(symbolMutex);
+                symbolMap->emplace(backtrace->frames[i], std::move(name));
+            }
         }
     }
 }
@@ -942,13 +1128,23 @@ void MemoryManager::GetCurStat(uint64 timestamp, void* buffer, uint32 bufSize) c
     const uint32 requiredSize = CalcCurStatSize();
     DVASSERT(requiredSize <= bufSize);
 
-    LockType lockAlloc(allocMutex);
-    LockType lockStat(statMutex);
+    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT];
+    TagAllocStat statTag[MAX_TAG_COUNT];
+    MergeStat(statAllocPool, statTag);
 
     MMCurStat* curStat = static_cast<MMCurStat*>(buffer);
     curStat->timestamp = timestamp;
     curStat->size = static_cast<uint32>(requiredSize);
-    curStat->statGeneral = statGeneral;
+
+    GeneralAllocStat& statGeneral = curStat->statGeneral;
+    statGeneral.nextBlockNo = nextBlockNo.load(std::memory_order_relaxed);
+    statGeneral.activeTags = activeTags.load(std::memory_order_relaxed);
+    statGeneral.activeTagCount = activeTagCount.load(std::memory_order_relaxed);
+    statGeneral.allocInternal = allocInternal.load(std::memory_order_relaxed);
+    statGeneral.internalBlockCount = internalBlockCount.load(std::memory_order_relaxed);
+    statGeneral.ghostBlockCount = ghostBlockCount.load(std::memory_order_relaxed);
+    statGeneral.ghostSize = ghostSize.load(std::memory_order_relaxed);
+    statGeneral.allocInternalTotal = allocInternalTotal.load(std::memory_order_relaxed);
 
     AllocPoolStat* pools = OffsetPointer<AllocPoolStat>(curStat, sizeof(MMCurStat));
     for (uint32 i = 0; i < registeredAllocPoolCount; ++i)
@@ -989,17 +1185,19 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
     snapshot.bktraceDepth = BACKTRACE_DEPTH;
 
     // Write empty header to force file internal buffer allocation to exclude
-    // memory allocations under allocMutex (primarily for Win32 release builds)
+    // memory allocations under block list mutex (primarily for Win32 release builds)
     if (file->Write(&snapshot) != sizeof(MMSnapshot))
         return false;
 
-    { // Store memory blocks into file
-        LockType lock(allocMutex);
+    // Store memory blocks into file, lists of threads are locked one by one
+    for (ThreadState* threadState = threadStates.load(); threadState != nullptr; threadState = threadState->next)
+    {
+        LockType lock(threadState->blockListMutex);
 
         const uint32 BLOCKS_IN_BUF = BUF_SIZE / sizeof(MMBlock);
         MMBlock* destBegin = static_cast<MMBlock*>(buffer);
 
-        MemoryBlock* curBlock = head;
+        MemoryBlock* curBlock = threadState->head;
         while (curBlock != nullptr)
         {
             uint32 k = 0;
@@ -1020,8 +1218,9 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
                 return false;
         }
     }
+    if (symbolMap != nullptr)
     { // Store function names into file
-        LockType lock(bktraceMutex);
+        LockType lock(symbolMutex);
 
         const size_t SYMBOLS_IN_BUF = BUF_SIZE / sizeof(MMSymbol);
         MMSymbol* symbols = static_cast<MMSymbol*>(buffer);
@@ -1048,30 +1247,34 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
                 return false;
         }
     }
-    { // Store backtraces into file
-        LockType lock(bktraceMutex);
+    if (bktraceTable.load() != nullptr)
+    { // Store backtraces of live blocks into file, lock prevents symbol collector from freeing replaced backtraces
+        LockGuard<Mutex> lock(symbolCollectorMutex);
 
         const size_t BKTRACE_IN_BUF = BUF_SIZE / bktraceSize;
         MMBacktrace* bktrace = static_cast<MMBacktrace*>(buffer);
 
-        auto itBegin = bktraceMap->cbegin();
-        auto itEnd = bktraceMap->cend();
+        const BacktraceEntry* itBegin = bktraceTable.load();
+        const BacktraceEntry* itEnd = itBegin + BACKTRACE_TABLE_SIZE;
         while (itBegin != itEnd)
         {
             uint32 k = 0;
-            for (; k < BKTRACE_IN_BUF && itBegin != itEnd; ++k)
+            for (; k < BKTRACE_IN_BUF && itBegin != itEnd; ++itBegin)
             {
-                auto& o = itBegin->second;
+                const uint64 state = itBegin->state.load(std::memory_order_acquire);
+                const Backtrace* o = itBegin->backtrace.load(std::memory_order_acquire);
+                if (nullptr == o || 0 == MemoryManagerDetails::BacktraceStateRefCount(state) || o->hash != MemoryManagerDetails::BacktraceStateHash(state))
+                    continue;
 
-                bktrace->hash = o.hash;
+                bktrace->hash = o->hash;
                 uint64* frames = OffsetPointer<uint64>(bktrace, sizeof(MMBacktrace));
                 for (size_t i = 0; i < BACKTRACE_DEPTH; ++i)
                 {
-                    frames[i] = reinterpret_cast<uint64>(o.frames[i]);
+                    frames[i] = reinterpret_cast<uint64>(o->frames[i]);
                 }
 
                 bktrace = OffsetPointer<MMBacktrace>(bktrace, bktraceSize);
-                ++itBegin;
+                k += 1;
             }
             snapshot.bktraceCount += k;
             if (file->Write(buffer, bktraceSize * k) != bktraceSize * k)
@@ -1101,41 +1304,29 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
 
 void MemoryManager::SymbolCollectorThread()
 {
-    const size_t BUF_CAPACITY = 1000; // Select some reasonable buffer for backtraces
-    // to give some job to symbol collector
-    Backtrace* bktraceBuf = new Backtrace[BUF_CAPACITY];
-
     while (!symbolCollectorThread->IsCancelling())
     {
-        {
-            UniqueLock<Mutex> lock(symbolCollectorMutex);
-            symbolCollectorCondVar.Wait(lock);
-        }
+        UniqueLock<Mutex> lock(symbolCollectorMutex);
+        symbolCollectorCondVar.Wait(lock);
 
-        size_t nplaced = 0;
+        // Nobody else reads backtraces under lock, so backtraces replaced in table can be freed
+        Backtrace* retired = retiredBktraces.exchange(nullptr, std::memory_order_acquire);
+        while (retired != nullptr)
         {
-            LockType lock(bktraceMutex);
-
-            for (auto i = bktraceMap->begin(), e = bktraceMap->end(); i != e && nplaced < BUF_CAPACITY; ++i)
-            {
-                const Backtrace& bktrace = i->second;
-                if (!bktrace.symbolsCollected)
-                {
-                    bktraceBuf[nplaced] = bktrace;
-                    nplaced += 1;
-                }
-            }
+            Backtrace* next = retired->nextRetired;
+            retired->~Backtrace();
+            InternalDeallocate(retired);
+            retired = next;
         }
 
-        for (size_t i = 0; i < nplaced && !symbolCollectorThread->IsCancelling(); ++i)
+        BacktraceEntry* table = bktraceTable.load(std::memory_order_acquire);
+        for (uint32 i = 0; table != nullptr && i < BACKTRACE_TABLE_SIZE && !symbolCollectorThread->IsCancelling(); ++i)
         {
-            ObtainBacktraceSymbols(&bktraceBuf[i]);
-
-            LockType lock(bktraceMutex);
-            auto ibktrace = bktraceMap->find(bktraceBuf[i].hash);
-            if (ibktrace != bktraceMap->end())
+            Backtrace* bktrace = table[i].backtrace.load(std::memory_order_acquire);
+            if (bktrace != nullptr && !bktrace->symbolsCollected)
             {
-                ibktrace->second.symbolsCollected = true;
+                ObtainBacktraceSymbols(bktrace);
+                bktrace->symbolsCollected = true;
             }
         }
     }
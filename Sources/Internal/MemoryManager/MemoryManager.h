@@ -6,6 +6,7 @@
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
 #include <type_traits>
+#include <atomic>
 
 #include "Functional/Function.h"
 #include "Concurrency/Spinlock.h"
@@ -43,7 +44,9 @@ public:
     struct MemoryBlock;
     struct InternalMemoryBlock;
     struct Backtrace;
+    struct BacktraceEntry;
     struct AllocScopeItem;
+    struct ThreadState;
 
 public:
     class AllocPoolScope final
@@ -121,18 +124,25 @@ private:
     friend void InternalDealloc(void* ptr);
 
 private:
-    void InsertBlock(MemoryBlock* block);
+    // Get state of calling thread creating it on first use, returns nullptr if thread local storage is already destroyed
+    ThreadState* GetThreadState();
+
+    void TrackBlock(MemoryBlock* block);
+    void InsertBlock(ThreadState* threadState, MemoryBlock* block);
     void RemoveBlock(MemoryBlock* block);
 
-    void UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage);
-    void UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage);
+    void UpdateStatAfterAlloc(ThreadState* threadState, MemoryBlock* block);
+    void UpdateStatAfterDealloc(ThreadState* threadState, MemoryBlock* block);
+
+    void UpdateStatAfterGPUAlloc(ThreadState* threadState, MemoryBlock* block, size_t sizeIncr);
+    void UpdateStatAfterGPUDealloc(ThreadState* threadState, MemoryBlock* block);
 
-    void UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr);
-    void UpdateStatAfterGPUDealloc(MemoryBlock* block);
+    void MergeStat(AllocPoolStat* pools, TagAllocStat* tags) const;
 
     uint64 PackGPUKey(uint32 id, uint32 allocPool) const;
 
-    void InsertBacktrace(Backtrace& backtrace);
+    BacktraceEntry* GetBacktraceTable();
+    bool InsertBacktrace(const Backtrace& backtrace);
     void RemoveBacktrace(uint32 hash);
 
     DAVA_NOINLINE void CollectBacktrace(Backtrace* backtrace, size_t nskip);
@@ -141,17 +151,23 @@ private:
     void SymbolCollectorThread();
 
 private:
-    MemoryBlock* head = nullptr; // Linked list of tracked memory blocks
+    // Every thread tracks its blocks and statistics changes in its own state, they are merged when statistics is requested
+    std::atomic<ThreadState*> threadStates{ nullptr }; // List of states of all threads which have ever allocated memory
 
-    GeneralAllocStat statGeneral; // General statistics
-    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT]; // Statistics by allocation pools
-    TagAllocStat statTag[MAX_TAG_COUNT]; // Statistics by tags
+    std::atomic<uint32> nextBlockNo{ 0 }; // Order number which will be assigned to next allocated memory block
+    std::atomic<uint32> activeTags{ 0 }; // Current active tags
+    std::atomic<uint32> activeTagCount{ 0 }; // Number of active tags
+
+    // Rarely changed general statistics
+    std::atomic<uint32> allocInternal{ 0 };
+    std::atomic<uint32> allocInternalTotal{ 0 };
+    std::atomic<uint32> internalBlockCount{ 0 };
+    std::atomic<uint32> ghostBlockCount{ 0 };
+    std::atomic<uint32> ghostSize{ 0 };
 
     using MutexType = Spinlock;
     using LockType = LockGuard<MutexType>;
 
-    mutable MutexType allocMutex; // Mutex for managing list of allocated memory blocks
-    mutable MutexType statMutex; // Mutex for updating memory statistics
     mutable MutexType gpuMutex; // Mutex for managing GPU allocations
 
     using GpuBlockMap = std::unordered_map<uint64, MemoryBlock, std::hash<uint64>, std::equal_to<uint64>, InternalAllocator<std::pair<const uint64, MemoryBlock>>>;
@@ -159,18 +175,23 @@ private:
     GpuBlockMap* gpuBlockMap = nullptr;
 
     using InternalString = std::basic_string<char8, std::char_traits<char8>, InternalAllocator<char8>>;
-    using BacktraceMap = std::unordered_map<uint32, Backtrace, std::hash<uint32>, std::equal_to<uint32>, InternalAllocator<std::pair<const uint32, Backtrace>>>;
     using SymbolMap = std::unordered_map<void*, InternalString, std::hash<void*>, std::equal_to<void*>, InternalAllocator<std::pair<void* const, InternalString>>>;
 
-    mutable MutexType bktraceMutex; // Mutex for working with backtraces
+    // Open addressing hash table of backtraces, entries are claimed and referenced without locking,
+    // entry which is not referenced anymore is reused for new backtrace
+    static const uint32 BACKTRACE_TABLE_SIZE = 1 << 18;
+    static const uint32 BACKTRACE_MAX_PROBES = 32;
+    std::atomic<BacktraceEntry*> bktraceTable{ nullptr };
+
+    mutable MutexType symbolMutex; // Mutex for working with symbols
 
-    BacktraceMap* bktraceMap = nullptr;
     SymbolMap* symbolMap = nullptr;
 
     Thread* symbolCollectorThread = nullptr;
     ConditionVariable symbolCollectorCondVar;
     Mutex symbolCollectorMutex;
-    size_t bktraceGrowDelta = 0;
+    std::atomic<uint32> bktraceGrowDelta{ 0 };
+    std::atomic<Backtrace*> retiredBktraces{ nullptr }; // Backtraces replaced in table, freed by symbol collector
     bool lightWeightMode = false; // Flag enabling lightweight mode: no backtrace and symbols, should increase performance
 
     Function<void()> updateCallback;
@@ -185,6 +206,7 @@ private:
     static MMItemName allocPoolNames[MAX_ALLOC_POOL_COUNT]; // Names of allocation pools
 
     ThreadLocalPtr<AllocScopeItem> tlsAllocScopeStack;
+    ThreadLocalPtr<ThreadState> tlsThreadState;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -30,8 +30,15 @@ struct IChannelListener
     virtual void OnPacketDelivered(const std::shared_ptr<IChannel>& channel, uint32 packetId) = 0;
 };
 
+/*
+ Ref-counted data which channel keeps alive until it has been sent.
+ Sender may drop its reference right after Send, so there is no need to copy data or to free it in OnPacketSent.
+*/
+using SharedBuffer = std::shared_ptr<const Vector<uint8>>;
+
 /*
  This interface is passed to IChannelListener methods to allow clients to send data to channels.
+ Send methods may be called from any thread.
 */
 class Endpoint;
 struct IChannel
@@ -39,7 +46,10 @@ struct IChannel
     // There should be a virtual destructor defined as objects may be deleted through this interface
     virtual ~IChannel();
 
+    // Buffer should stay valid until OnPacketSent is called for it
     virtual bool Send(const void* data, size_t length, uint32 flags, uint32* packetId) = 0;
+    // OnPacketSent is also called for shared buffer, with pointer to its data
+    virtual bool Send(const SharedBuffer& data, uint32 flags, uint32* packetId) = 0;
     virtual const Endpoint& RemoteEndpoint() const = 0;
 };
 
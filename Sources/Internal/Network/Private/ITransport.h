@@ -35,6 +35,9 @@ struct IClientListener;
 
 struct IClientTransport
 {
+    // Maximum number of buffers that can be passed to Send in one call
+    static const size_t MAX_SEND_BUFFERS = 32;
+
     virtual ~IClientTransport();
 
     virtual int32 Start(IClientListener* listener) = 0;
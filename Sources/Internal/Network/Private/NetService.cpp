@@ -51,5 +51,13 @@ bool NetService::Send(const void* data, size_t length, uint32* packetId)
                              false;
 }
 
+bool NetService::Send(const SharedBuffer& data, uint32* packetId)
+{
+    DVASSERT(data != nullptr && false == data->empty() && true == IsChannelOpen());
+    return IsChannelOpen() ? channel->Send(data, 0, packetId)
+                             :
+                             false;
+}
+
 } // namespace Net
 } // namespace DAVA
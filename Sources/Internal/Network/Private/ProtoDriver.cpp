@@ -1,7 +1,6 @@
 #include <Functional/Function.h>
 #include <Debug/DVAssert.h>
 #include <Concurrency/Atomic.h>
-#include <Concurrency/LockGuard.h>
 
 #include <Network/Base/IOLoop.h>
 #include <Network/ServiceRegistrar.h>
@@ -14,17 +13,38 @@ namespace Net
 {
 ProtoDriver::Channel::~Channel() = default;
 
+ProtoDriver::Packet* ProtoDriver::SendQueue::Front()
+{
+    if (nullptr == head)
+    {
+        // Pushed list is in reverse order, so reverse it while grabbing
+        Packet* packet = pushed.Swap(nullptr);
+        while (packet != nullptr)
+        {
+            Packet* next = packet->next;
+            packet->next = head;
+            head = packet;
+            packet = next;
+        }
+    }
+    return head;
+}
+
+void ProtoDriver::SendQueue::PopFront()
+{
+    DVASSERT(head != nullptr);
+    head = head->next;
+}
+
 ProtoDriver::ProtoDriver(IOLoop* aLoop, eNetworkRole aRole, const ServiceRegistrar& aRegistrar, void* aServiceContext)
     : loop(aLoop)
     , role(aRole)
     , registrar(aRegistrar)
     , serviceContext(aServiceContext)
     , transport(NULL)
-    , whatIsSending()
     , pendingPong(false)
 {
     DVASSERT(loop != NULL);
-    Memset(&curPacket, 0, sizeof(curPacket));
 }
 
 ProtoDriver::~ProtoDriver()
@@ -32,7 +52,17 @@ ProtoDriver::~ProtoDriver()
     for (std::shared_ptr<Channel>& ch : channels)
     {
         ch->driver = nullptr;
+        for (Packet* packet = ch->sendQueue.Front(); packet != nullptr; packet = ch->sendQueue.Front())
+        {
+            ch->sendQueue.PopFront();
+            delete packet;
+        }
+    }
+    for (Packet* packet : writtenPackets)
+    {
+        delete packet;
     }
+    delete curPacket;
 }
 
 void ProtoDriver::SetTransport(IClientTransport* aTransport, const uint32* sourceChannels, size_t channelCount)
@@ -51,37 +81,33 @@ void ProtoDriver::SendData(uint32 channelId, const void* buffer, size_t length,
 {
     DVASSERT(transport != NULL && buffer != NULL && length > 0);
 
-    Packet packet;
-    PreparePacket(&packet, channelId, buffer, length);
+    Packet* packet = PreparePacket(channelId, buffer, length);
     if (outPacketId != NULL)
-        *outPacketId = packet.packetId;
+        *outPacketId = packet->packetId;
+    EnqueuePacket(packet);
+}
 
-    // This method may be invoked from different threads
-    if (true == senderLock.TryLock())
-    {
-        // TODO: consider optimization when called from IOLoop's thread
-        curPacket = packet;
-        loop->Post(MakeFunction(this, &ProtoDriver::SendCurPacket));
-    }
-    else
-    {
-        EnqueuePacket(&packet);
-    }
+void ProtoDriver::SendData(uint32 channelId, const SharedBuffer& buffer, uint32* outPacketId)
+{
+    DVASSERT(transport != NULL && buffer != nullptr && false == buffer->empty());
+
+    Packet* packet = PreparePacket(channelId, buffer->data(), buffer->size());
+    packet->sharedData = buffer;
+    if (outPacketId != NULL)
+        *outPacketId = packet->packetId;
+    EnqueuePacket(packet);
 }
 
 void ProtoDriver::SendControl(uint32 code, uint32 channelId, uint32 packetId)
 {
     ProtoHeader header;
     proto.EncodeControlFrame(&header, code, channelId, packetId);
-    if (true == senderLock.TryLock()) // Control frame can be sent directly without queueing
-    {
-        curControl = header;
-        SendCurControl();
-    }
-    else
+
+    // No need for locking as control frames are always sent from handlers
+    controlQueue.push_back(header);
+    if (true == senderLock.TryLock()) // Control frame can be sent directly if nothing is being sent
     {
-        // No need for mutex locking as control frames are always sent from handlers
-        controlQueue.push_back(header);
+        SendPending();
     }
 }
 
@@ -183,29 +209,13 @@ bool ProtoDriver::OnDataReceived(const void* buffer, size_t length)
 
 void ProtoDriver::OnSendComplete()
 {
-    if (SENDING_DATA_FRAME == whatIsSending)
+    for (Packet* packet : writtenPackets)
     {
-        curPacket.sentLength += curPacket.chunkLength;
-        if (curPacket.sentLength == curPacket.dataLength)
-        {
-            std::shared_ptr<Channel> ch = GetChannel(curPacket.channelId);
-            ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
-            curPacket.data = NULL;
-        }
+        NotifyPacketSent(packet);
     }
+    writtenPackets.clear();
 
-    if (true == DequeueControl(&curControl)) // First send control packets if any
-    {
-        SendCurControl();
-    }
-    else if (curPacket.data != NULL || true == DequeuePacket(&curPacket)) // Send current packet further or send new packet
-    {
-        SendCurPacket();
-    }
-    else
-    {
-        senderLock.Unlock(); // Nothing to send, unlock sender
-    }
+    SendPending();
 }
 
 bool ProtoDriver::OnTimeout()
@@ -312,95 +322,167 @@ bool ProtoDriver::ProcessDeliveryAck(ProtoDecoder::DecodeResult* result)
 
 void ProtoDriver::ClearQueues()
 {
-    if (curPacket.data != NULL)
+    for (Packet* packet : writtenPackets)
     {
-        std::shared_ptr<Channel> ch = GetChannel(curPacket.channelId);
-        ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
+        NotifyPacketSent(packet);
+    }
+    writtenPackets.clear();
+    startedPacketIds.clear();
 
-        curPacket.data = NULL;
+    if (curPacket != nullptr)
+    {
+        NotifyPacketSent(curPacket);
+        curPacket = nullptr;
     }
-    for (Deque<Packet>::iterator i = dataQueue.begin(), e = dataQueue.end(); i != e; ++i)
+    for (Packet* packet = DequeuePacket(); packet != nullptr; packet = DequeuePacket())
     {
-        Packet& packet = *i;
-        std::shared_ptr<Channel> ch = GetChannel(packet.channelId);
-        ch->service->OnPacketSent(ch, packet.data, packet.dataLength);
+        NotifyPacketSent(packet);
     }
-    dataQueue.clear();
     pendingAckQueue.clear();
     controlQueue.clear();
     senderLock.Unlock();
 }
 
-void ProtoDriver::SendCurPacket()
+void ProtoDriver::NotifyPacketSent(Packet* packet)
 {
-    DVASSERT(curPacket.sentLength < curPacket.dataLength);
+    std::shared_ptr<Channel> ch = GetChannel(packet->channelId);
+    ch->service->OnPacketSent(ch, packet->data, packet->dataLength);
+    delete packet;
+}
+
+void ProtoDriver::SendPending()
+{
+    // Sender is locked here, so it is the only place where write operation is started
+    while (false == WritePending())
+    {
+        senderLock.Unlock(); // Nothing to send, unlock sender
 
-    whatIsSending = SENDING_DATA_FRAME;
-    curPacket.chunkLength = proto.EncodeDataFrame(&header, curPacket.channelId, curPacket.packetId, curPacket.dataLength, curPacket.sentLength);
+        // Packet could be enqueued while sender was locked, its sender has failed to lock and relies on this thread
+        if (false == HasPendingFrames() || false == senderLock.TryLock())
+        {
+            break;
+        }
+    }
+}
+
+bool ProtoDriver::WritePending()
+{
+    const size_t maxBufferCount = IClientTransport::MAX_SEND_BUFFERS;
+    size_t bufferCount = 0;
 
-    Buffer buffers[2];
-    buffers[0] = CreateBuffer(&header);
-    buffers[1] = CreateBuffer(curPacket.data + curPacket.sentLength, curPacket.chunkLength);
-    if (0 == transport->Send(buffers, 2) && 0 == curPacket.sentLength)
+    // First send control frames if any
+    while (bufferCount < maxBufferCount && false == controlQueue.empty())
     {
-        pendingAckQueue.push_back(curPacket.packetId);
+        writeHeaders[bufferCount] = controlQueue.front();
+        writeBuffers[bufferCount] = CreateBuffer(&writeHeaders[bufferCount]);
+        controlQueue.pop_front();
+        bufferCount += 1;
+    }
+
+    // Then gather as many data frames as fit into one write, each frame takes header and chunk buffers
+    // Frames of different packets are not interleaved as other side assembles one packet at a time
+    while (bufferCount + 2 <= maxBufferCount)
+    {
+        if (nullptr == curPacket)
+        {
+            curPacket = DequeuePacket();
+            if (nullptr == curPacket)
+                break;
+        }
+
+        ProtoHeader* header = &writeHeaders[bufferCount];
+        size_t chunkLength = proto.EncodeDataFrame(header, curPacket->channelId, curPacket->packetId, curPacket->dataLength, curPacket->sentLength);
+        writeBuffers[bufferCount] = CreateBuffer(header);
+        writeBuffers[bufferCount + 1] = CreateBuffer(curPacket->data + curPacket->sentLength, chunkLength);
+        bufferCount += 2;
+
+        if (0 == curPacket->sentLength)
+        {
+            startedPacketIds.push_back(curPacket->packetId);
+        }
+        curPacket->sentLength += chunkLength;
+        if (curPacket->sentLength == curPacket->dataLength)
+        {
+            writtenPackets.push_back(curPacket);
+            curPacket = nullptr;
+        }
     }
+
+    if (0 == bufferCount)
+    {
+        return false;
+    }
+
+    if (0 == transport->Send(writeBuffers, bufferCount))
+    {
+        pendingAckQueue.insert(pendingAckQueue.end(), startedPacketIds.begin(), startedPacketIds.end());
+    }
+    startedPacketIds.clear();
+    return true;
 }
 
-void ProtoDriver::SendCurControl()
+bool ProtoDriver::HasPendingFrames() const
 {
-    whatIsSending = SENDING_CONTROL_FRAME;
+    if (curPacket != nullptr || false == controlQueue.empty())
+    {
+        return true;
+    }
+    for (const std::shared_ptr<Channel>& channel : channels)
+    {
+        if (false == channel->sendQueue.IsEmpty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
-    Buffer buffer = CreateBuffer(&curControl);
-    transport->Send(&buffer, 1);
+ProtoDriver::Packet* ProtoDriver::DequeuePacket()
+{
+    // Take packets from channels in turn, so busy channel does not hold up others
+    size_t channelCount = channels.size();
+    for (size_t i = 0; i < channelCount; ++i)
+    {
+        size_t index = (nextChannelIndex + i) % channelCount;
+        SendQueue& queue = channels[index]->sendQueue;
+        Packet* packet = queue.Front();
+        if (packet != nullptr)
+        {
+            queue.PopFront();
+            nextChannelIndex = (index + 1) % channelCount;
+            return packet;
+        }
+    }
+    return nullptr;
 }
 
-void ProtoDriver::PreparePacket(Packet* packet, uint32 channelId, const void* buffer, size_t length)
+ProtoDriver::Packet* ProtoDriver::PreparePacket(uint32 channelId, const void* buffer, size_t length)
 {
     static Atomic<uint32> nextPacketId{ 0 };
 
     DVASSERT(buffer != NULL && length > 0);
 
+    Packet* packet = new Packet;
     packet->channelId = channelId;
     packet->packetId = ++nextPacketId;
     packet->dataLength = length;
     packet->sentLength = 0;
-    packet->chunkLength = 0;
     packet->data = static_cast<uint8*>(const_cast<void*>(buffer));
+    return packet;
 }
 
-bool ProtoDriver::EnqueuePacket(Packet* packet)
-{
-    bool queueWasEmpty = false;
-
-    LockGuard<Mutex> lock(queueMutex);
-    queueWasEmpty = dataQueue.empty();
-    dataQueue.push_back(*packet);
-    return queueWasEmpty;
-}
-
-bool ProtoDriver::DequeuePacket(Packet* dest)
+void ProtoDriver::EnqueuePacket(Packet* packet)
 {
-    LockGuard<Mutex> lock(queueMutex);
-    if (false == dataQueue.empty())
-    {
-        *dest = dataQueue.front();
-        dataQueue.pop_front();
-        return true;
-    }
-    return false;
-}
+    // This method may be invoked from different threads
+    std::shared_ptr<Channel>& ch = GetChannel(packet->channelId);
+    DVASSERT(ch != nullptr);
+    ch->sendQueue.Push(packet);
 
-bool ProtoDriver::DequeueControl(ProtoHeader* dest)
-{
-    // No need for mutex locking as control packets are always dequeued from handler
-    if (false == controlQueue.empty())
+    if (true == senderLock.TryLock())
     {
-        *dest = controlQueue.front();
-        controlQueue.pop_front();
-        return true;
+        // TODO: consider optimization when called from IOLoop's thread
+        loop->Post(MakeFunction(this, &ProtoDriver::SendPending));
     }
-    return false;
 }
 
 } // namespace Net
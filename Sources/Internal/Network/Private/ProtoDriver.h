@@ -2,7 +2,7 @@
 #define __DAVAENGINE_PROTODRIVER_H__
 
 #include <Base/BaseTypes.h>
-#include <Concurrency/Mutex.h>
+#include <Concurrency/Atomic.h>
 #include <Concurrency/Spinlock.h>
 
 #include <Network/Base/Endpoint.h>
@@ -28,8 +28,28 @@ private:
         uint32 packetId;
         uint8* data = nullptr; // Data
         size_t dataLength; //  and its length
-        size_t sentLength; // Number of bytes that have been already transfered
-        size_t chunkLength; // Number of bytes transfered during last operation
+        size_t sentLength; // Number of bytes that have been already put into write operations
+        SharedBuffer sharedData; // Keeps ref-counted data alive until packet is sent
+        Packet* next = nullptr; // Link in channel's send queue
+    };
+
+    /*
+     Queue of packets waiting for sending through channel.
+     Packets can be pushed from any thread without locking, only IOLoop's thread takes packets from queue:
+     it grabs all pushed packets at once and restores their order.
+    */
+    class SendQueue
+    {
+    public:
+        void Push(Packet* packet);
+
+        Packet* Front();
+        void PopFront();
+        bool IsEmpty() const;
+
+    private:
+        Atomic<Packet*> pushed{ nullptr }; // Recently pushed packets in reverse order
+        Packet* head = nullptr; // Grabbed packets in order of pushing
     };
 
     struct Channel : public IChannel
@@ -38,6 +58,7 @@ private:
         ~Channel() override;
 
         bool Send(const void* data, size_t length, uint32 flags, uint32* packetId) override;
+        bool Send(const SharedBuffer& data, uint32 flags, uint32* packetId) override;
         const Endpoint& RemoteEndpoint() const override;
 
         bool confirmed; // Channel is confirmed by other side
@@ -45,12 +66,7 @@ private:
         Endpoint remoteEndpoint;
         ProtoDriver* driver = nullptr;
         IChannelListener* service = nullptr;
-    };
-
-    enum eSendingFrameType
-    {
-        SENDING_DATA_FRAME = false,
-        SENDING_CONTROL_FRAME = true
+        SendQueue sendQueue;
     };
 
 public:
@@ -59,6 +75,7 @@ public:
 
     void SetTransport(IClientTransport* aTransport, const uint32* sourceChannels, size_t channelCount);
     void SendData(uint32 channelId, const void* buffer, size_t length, uint32* outPacketId);
+    void SendData(uint32 channelId, const SharedBuffer& buffer, uint32* outPacketId);
 
     void ReleaseServices();
 
@@ -79,14 +96,15 @@ private:
     bool ProcessDeliveryAck(ProtoDecoder::DecodeResult* result);
 
     void ClearQueues();
+    void NotifyPacketSent(Packet* packet);
 
-    void SendCurPacket();
-    void SendCurControl();
+    void SendPending();
+    bool WritePending();
+    bool HasPendingFrames() const;
+    Packet* DequeuePacket();
 
-    void PreparePacket(Packet* packet, uint32 channelId, const void* buffer, size_t length);
-    bool EnqueuePacket(Packet* packet);
-    bool DequeuePacket(Packet* dest);
-    bool DequeueControl(ProtoHeader* dest);
+    Packet* PreparePacket(uint32 channelId, const void* buffer, size_t length);
+    void EnqueuePacket(Packet* packet);
 
 private:
     IOLoop* loop = nullptr;
@@ -96,20 +114,20 @@ private:
     IClientTransport* transport = nullptr;
     Vector<std::shared_ptr<Channel>> channels;
 
-    Spinlock senderLock;
-    Mutex queueMutex;
-    eSendingFrameType whatIsSending;
+    Spinlock senderLock; // Locked while some write operation is pending or is being prepared
     bool pendingPong;
 
-    Packet curPacket;
-    Deque<Packet> dataQueue;
+    Packet* curPacket = nullptr; // Packet which frames are being written, frames of different packets are not mixed
+    size_t nextChannelIndex = 0; // Channel to take next packet from, so channels are served in turn
+    Vector<Packet*> writtenPackets; // Packets which last frames are in pending write operation
+    Vector<uint32> startedPacketIds; // Packets which first frames are in pending write operation
     Deque<uint32> pendingAckQueue;
 
-    ProtoHeader curControl;
     Deque<ProtoHeader> controlQueue;
 
     ProtoDecoder proto;
-    ProtoHeader header;
+    ProtoHeader writeHeaders[IClientTransport::MAX_SEND_BUFFERS];
+    Buffer writeBuffers[IClientTransport::MAX_SEND_BUFFERS];
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -130,11 +148,33 @@ inline bool ProtoDriver::Channel::Send(const void* data, size_t length, uint32 f
     return true;
 }
 
+inline bool ProtoDriver::Channel::Send(const SharedBuffer& data, uint32 flags, uint32* outPacketId)
+{
+    if (driver != nullptr)
+    {
+        driver->SendData(channelId, data, outPacketId);
+    }
+    return true;
+}
+
 inline const Endpoint& ProtoDriver::Channel::RemoteEndpoint() const
 {
     return remoteEndpoint;
 }
 
+inline void ProtoDriver::SendQueue::Push(Packet* packet)
+{
+    do
+    {
+        packet->next = pushed.Get();
+    } while (false == pushed.CompareAndSwap(packet->next, packet));
+}
+
+inline bool ProtoDriver::SendQueue::IsEmpty() const
+{
+    return nullptr == head && nullptr == pushed.Get();
+}
+
 inline std::shared_ptr<ProtoDriver::Channel>& ProtoDriver::GetChannel(uint32 channelId)
 {
     for (std::shared_ptr<ProtoDriver::Channel>& channel : channels)
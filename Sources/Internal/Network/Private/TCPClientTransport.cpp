@@ -69,7 +69,8 @@ void TCPClientTransport::Reset()
 
 int32 TCPClientTransport::Send(const Buffer* buffers, size_t bufferCount)
 {
-    DVASSERT(buffers != NULL && 0 < bufferCount && bufferCount <= SENDBUF_COUNT);
+    static_assert(MAX_SEND_BUFFERS <= TCPSocket::MAX_WRITE_BUFFERS, "Socket should accept all transport buffers in one write");
+    DVASSERT(buffers != NULL && 0 < bufferCount && bufferCount <= MAX_SEND_BUFFERS);
     DVASSERT(0 == sendBufferCount);
     if (false == isConnected)
         return 0;
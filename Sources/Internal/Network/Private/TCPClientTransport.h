@@ -63,8 +63,7 @@ private:
     static const size_t INBUF_SIZE = 10 * 1024;
     uint8 inbuf[INBUF_SIZE];
 
-    static const size_t SENDBUF_COUNT = 2;
-    Buffer sendBuffers[SENDBUF_COUNT];
+    Buffer sendBuffers[MAX_SEND_BUFFERS];
     size_t sendBufferCount;
 };
 
@@ -2,16 +2,16 @@
 
 #include "Base/BaseTypes.h"
 #include "Base/BaseMath.h"
-#include "Base/AllocatorFactory.h"
 
 namespace DAVA
 {
+/**
+    Values of single particle.
+    Particles of `ParticleGroup` are kept in `ParticleStorage`, this struct is used
+    to build new particle and to access all particle fields at once where performance doesn't matter.
+*/
 struct Particle
 {
-    IMPLEMENT_POOL_ALLOCATOR(Particle, 1000);
-
-    Particle* next = nullptr;
-
     float32 life = 0.0f;
     float32 lifeTime = 0.0f;
 
@@ -43,5 +43,6 @@ struct Particle
     Color color = {};
 
     int32 positionTarget = 0; //superemitter particles only
+    uint32 seed = 0; //stable per particle value for noise lookups in forces
 };
 }
@@ -110,6 +110,8 @@ void ParticleDebugRenderPass::PrepareParticlesVisibilityArray(Camera* camera, Re
 
 void ParticleDebugRenderPass::PrepareParticlesBatchesArray(const Vector<RenderObject*> objectsArray, Camera* camera)
 {
+    particleBatches.PrepareSorting(camera);
+
     size_t size = objectsArray.size();
     for (size_t ro = 0; ro < size; ++ro)
     {
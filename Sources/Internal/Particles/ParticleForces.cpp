@@ -3,7 +3,6 @@
 #include <random>
 #include <chrono>
 
-#include "Particles/Particle.h"
 #include "Particles/ParticleForce.h"
 #include "Math/MathHelpers.h"
 #include "Math/Noise.h"
@@ -30,11 +29,11 @@ T GetValue(const ParticleForce* force, float32 particleOverLife, float32 layerOv
     case ParticleForce::eTimingType::CONSTANT:
         return value;
     case ParticleForce::eTimingType::OVER_PARTICLE_LIFE:
-        return line->GetValue(particleOverLife);
+        return line->Evaluate(particleOverLife);
     case ParticleForce::eTimingType::OVER_LAYER_LIFE:
-        return line->GetValue(layerOverLife);
+        return line->Evaluate(layerOverLife);
     case ParticleForce::eTimingType::SECONDS_PARTICLE_LIFE:
-        return line->GetValue(particleLife);
+        return line->Evaluate(particleLife);
     default:
         return value;
     }
@@ -56,12 +55,12 @@ Vector3 GetNoiseValue(float32 particleOverLife, float32 frequency, uint32 clampe
     return Lerp(t1, t2, fractPart);
 }
 
-inline void KillParticle(Particle* particle)
+inline void KillParticle(ParticleForces::ParticleInfo& particle)
 {
-    particle->life = particle->lifeTime + 0.1f;
+    particle.life = particle.lifeTime + 0.1f;
 }
 
-inline void KillParticlePlaneCollision(const ParticleForce* force, Particle* particle, Vector3& effectSpaceVelocity)
+inline void KillParticlePlaneCollision(const ParticleForce* force, ParticleForces::ParticleInfo& particle, Vector3& effectSpaceVelocity)
 {
     if (force->killParticles)
         KillParticle(particle);
@@ -88,14 +87,14 @@ inline bool IsPositionInForceShape(const ParticleForce* force, const Vector3& pa
     return false;
 }
 
-void ApplyDragForce(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle, const Vector3& forcePosition)
+void ApplyDragForce(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleForces::ParticleInfo& particle, const Vector3& forcePosition)
 {
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle.life, force->forcePowerLine.Get(), force->forcePower) * dt;
     Vector3 v(Max(Vector3::Zero, 1.0f - forceStrength));
     velocity *= v;
 }
 
-void ApplyVortex(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle, const Vector3& forcePosition)
+void ApplyVortex(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleForces::ParticleInfo& particle, const Vector3& forcePosition)
 {
     Vector3 forceDir = (position - forcePosition).CrossProduct(force->direction);
     float32 len = forceDir.SquareLength();
@@ -104,26 +103,24 @@ void ApplyVortex(const ParticleForce* force, Vector3& velocity, const Vector3& p
         float32 d = 1.0f / std::sqrt(len);
         forceDir *= d;
     }
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle.life, force->forcePowerLine.Get(), force->forcePower) * dt;
     velocity += forceStrength * forceDir;
 }
 
-void ApplyGravity(const ParticleForce* force, Vector3& velocity, const Vector3& down, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle)
+void ApplyGravity(const ParticleForce* force, Vector3& velocity, const Vector3& down, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleForces::ParticleInfo& particle)
 {
-    velocity += down * GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower).x * dt;
+    velocity += down * GetValue(force, particleOverLife, layerOverLife, particle.life, force->forcePowerLine.Get(), force->forcePower).x * dt;
 }
 
-void ApplyWind(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle, const Vector3& forcePosition)
+void ApplyWind(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleForces::ParticleInfo& particle, const Vector3& forcePosition)
 {
     static const float32 windScale = 100.0f; // Artiom request.
 
-    uintptr_t partInd = reinterpret_cast<uintptr_t>(particle);
-    uint64 particleIndex = static_cast<uint64>(partInd);
     Vector3 turbulence;
 
-    uint32 clampedIndex = particleIndex % noiseWidth;
+    uint32 clampedIndex = particle.seed % noiseWidth;
     float32 windMultiplier = 1.0f;
-    float32 tubulencePower = GetValue(force, particleOverLife, layerOverLife, particle->life, force->turbulenceLine.Get(), force->windTurbulence);
+    float32 tubulencePower = GetValue(force, particleOverLife, layerOverLife, particle.life, force->turbulenceLine.Get(), force->windTurbulence);
     if (Abs(tubulencePower) > EPSILON)
     {
         turbulence = GetNoiseValue(particleOverLife, force->windTurbulenceFrequency, clampedIndex);
@@ -141,11 +138,11 @@ void ApplyWind(const ParticleForce* force, Vector3& velocity, Vector3& position,
         float32 noiseVal = GetNoiseValue(particleOverLife, force->windFrequency, clampedIndex).x;
         windMultiplier = noiseVal + force->windBias;
     }
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle.life, force->forcePowerLine.Get(), force->forcePower) * dt;
     velocity += force->direction * dt * windMultiplier * forceStrength.x * windScale;
 }
 
-void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, Particle* particle, const Vector3& forcePosition)
+void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, ParticleForces::ParticleInfo& particle, const Vector3& forcePosition)
 {
     Vector3 toCenter = forcePosition - position;
     float32 sqrToCenterDist = toCenter.SquareLength();
@@ -155,9 +152,7 @@ void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& p
     Vector3 forceDirection = toCenter;
     if (force->pointGravityUseRandomPointsOnSphere)
     {
-        uintptr_t partInd = reinterpret_cast<uintptr_t>(particle);
-        size_t particleIndex = static_cast<size_t>(partInd);
-        particleIndex %= sphereRandomVectorsSize;
+        uint32 particleIndex = particle.seed % sphereRandomVectorsSize;
         Vector3 forcePositionModified = forcePosition + sphereRandomVectors[particleIndex] * force->pointGravityRadius;
         forceDirection = forcePositionModified - position;
         float32 sqrDistToTarget = forceDirection.SquareLength();
@@ -165,7 +160,7 @@ void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& p
             forceDirection /= sqrt(sqrDistToTarget);
     }
 
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle.life, force->forcePowerLine.Get(), force->forcePower) * dt;
     if (sqrToCenterDist > force->pointGravityRadius * force->pointGravityRadius)
         velocity += forceDirection * forceStrength;
     else
@@ -177,7 +172,7 @@ void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& p
     }
 }
 
-void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3& position, Particle* particle, const Vector3& prevPosition, const Vector3& forcePosition)
+void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3& position, ParticleForces::ParticleInfo& particle, const Vector3& prevPosition, const Vector3& forcePosition)
 {
     Vector3 normal = Normalize(force->direction);
     Vector3 a = prevPosition - forcePosition;
@@ -229,7 +224,7 @@ void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3&
 }
 }
 
-void ParticleForces::ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, Particle* particle, const Vector3& prevPosition, const Vector3& forcePosition)
+void ParticleForces::ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, ParticleInfo& particle, const Vector3& prevPosition, const Vector3& forcePosition)
 {
     using ForceType = ParticleForce::eType;
 
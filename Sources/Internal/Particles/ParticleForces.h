@@ -7,12 +7,19 @@ namespace DAVA
 class ParticleForce;
 class Vector3;
 class Entity;
-struct Particle;
 
 class ParticleForces
 {
 public:
-    static void ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, Particle* particle, const Vector3& prevPosition, const Vector3& forcePosition);
+    /** Particle values used by forces. Force kills particle by setting `life` past `lifeTime`. */
+    struct ParticleInfo
+    {
+        float32 life;
+        float32 lifeTime;
+        uint32 seed;
+    };
+
+    static void ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, ParticleInfo& particle, const Vector3& prevPosition, const Vector3& forcePosition);
 };
 
 class ParticleForcesUtils
@@ -4,6 +4,8 @@
 #include "FileSystem/YamlParser.h"
 #include "FileSystem/YamlNode.h"
 #include "Base/RefPtr.h"
+#include "Debug/DVAssert.h"
+#include <algorithm>
 #include <limits>
 
 namespace DAVA
@@ -31,12 +33,62 @@ public:
 
     virtual const T& GetValue(float32 t) = 0;
 
+    /**
+        Evaluate line at `count` points `t` and write values to `result`.
+        Unlike `GetValue` it doesn't modify line, so shared line can be evaluated from several threads at once.
+    */
+    virtual void Evaluate(const float32* t, T* result, uint32 count) const;
+    T Evaluate(float32 t) const;
+
     virtual PropertyLine<T>* Clone()
     {
         return 0;
     }
 };
 
+template <class T>
+void PropertyLine<T>::Evaluate(const float32* t, T* result, uint32 count) const
+{
+    DVASSERT(!keys.empty());
+
+    const PropertyKey& first = keys.front();
+    const PropertyKey& last = keys.back();
+    if (keys.size() == 1)
+    {
+        std::fill(result, result + count, first.value);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float32 ti = t[i];
+        if (ti > last.t)
+        {
+            result[i] = last.value;
+        }
+        else if (ti <= first.t)
+        {
+            result[i] = first.value;
+        }
+        else
+        {
+            // first key with `key.t >= ti`, the same segment as `PropertyLineKeyframes::BinaryFind` gives
+            auto next = std::lower_bound(keys.begin() + 1, keys.end(), ti, [](const PropertyKey& key, float32 value) { return key.t < value; });
+            auto prev = next - 1;
+            float32 k = (ti - prev->t) / (next->t - prev->t);
+            result[i] = prev->value + (next->value - prev->value) * k;
+        }
+    }
+}
+
+template <class T>
+T PropertyLine<T>::Evaluate(float32 t) const
+{
+    T result;
+    Evaluate(&t, &result, 1);
+    return result;
+}
+
 class PropertyValueHelper
 {
 public:
@@ -181,6 +233,8 @@ public:
     {
     }
     virtual void SetModifier(float32 v);
+    void Evaluate(const float32* t, T* result, uint32 count) const override;
+    using PropertyLine<T>::Evaluate;
     void SetModificationLine(RefPtr<PropertyLine<T>> line)
     {
         this->modificationLine = line;
@@ -231,6 +285,23 @@ const T& ModifiablePropertyLine<T>::GetValue(float32 t)
     return resultValue;
 }
 
+template <class T>
+void ModifiablePropertyLine<T>::Evaluate(const float32* t, T* result, uint32 count) const
+{
+    if (!valueLine)
+    {
+        std::fill(result, result + count, T());
+    }
+    else
+    {
+        valueLine->Evaluate(t, result, count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            result[i] = modifier * result[i];
+        }
+    }
+}
+
 template <class T>
 PropertyLine<T>* ModifiablePropertyLine<T>::Clone()
 {
@@ -0,0 +1,209 @@
+#include "Particles/ParticleStorage.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+template <typename F>
+void ParticleStorage::ForEachArray(F&& f)
+{
+    f(life);
+    f(lifeTime);
+    f(positionX);
+    f(positionY);
+    f(positionZ);
+    f(speedX);
+    f(speedY);
+    f(speedZ);
+    f(angle);
+    f(spin);
+    f(frame);
+    f(animTime);
+    f(baseFlowSpeed);
+    f(currFlowSpeed);
+    f(baseFlowOffset);
+    f(currFlowOffset);
+    f(baseNoiseScale);
+    f(currNoiseScale);
+    f(baseNoiseUScrollSpeed);
+    f(currNoiseUOffset);
+    f(baseNoiseVScrollSpeed);
+    f(currNoiseVOffset);
+    f(currRadius);
+    f(alphaRemap);
+    f(baseSizeX);
+    f(baseSizeY);
+    f(currSizeX);
+    f(currSizeY);
+    f(color);
+    f(positionTarget);
+    f(seed);
+}
+
+uint32 ParticleStorage::Add(const Particle& particle)
+{
+    uint32 index = GetCount();
+
+    life.push_back(particle.life);
+    lifeTime.push_back(particle.lifeTime);
+    positionX.push_back(particle.position.x);
+    positionY.push_back(particle.position.y);
+    positionZ.push_back(particle.position.z);
+    speedX.push_back(particle.speed.x);
+    speedY.push_back(particle.speed.y);
+    speedZ.push_back(particle.speed.z);
+    angle.push_back(particle.angle);
+    spin.push_back(particle.spin);
+    frame.push_back(particle.frame);
+    animTime.push_back(particle.animTime);
+    baseFlowSpeed.push_back(particle.baseFlowSpeed);
+    currFlowSpeed.push_back(particle.currFlowSpeed);
+    baseFlowOffset.push_back(particle.baseFlowOffset);
+    currFlowOffset.push_back(particle.currFlowOffset);
+    baseNoiseScale.push_back(particle.baseNoiseScale);
+    currNoiseScale.push_back(particle.currNoiseScale);
+    baseNoiseUScrollSpeed.push_back(particle.baseNoiseUScrollSpeed);
+    currNoiseUOffset.push_back(particle.currNoiseUOffset);
+    baseNoiseVScrollSpeed.push_back(particle.baseNoiseVScrollSpeed);
+    currNoiseVOffset.push_back(particle.currNoiseVOffset);
+    currRadius.push_back(particle.currRadius);
+    alphaRemap.push_back(particle.alphaRemap);
+    baseSizeX.push_back(particle.baseSize.x);
+    baseSizeY.push_back(particle.baseSize.y);
+    currSizeX.push_back(particle.currSize.x);
+    currSizeY.push_back(particle.currSize.y);
+    color.push_back(particle.color);
+    positionTarget.push_back(particle.positionTarget);
+    seed.push_back(particle.seed);
+
+    return index;
+}
+
+Particle ParticleStorage::Get(uint32 index) const
+{
+    DVASSERT(index < GetCount());
+
+    Particle particle;
+    particle.life = life[index];
+    particle.lifeTime = lifeTime[index];
+    particle.position = GetPosition(index);
+    particle.speed = GetSpeed(index);
+    particle.angle = angle[index];
+    particle.spin = spin[index];
+    particle.frame = frame[index];
+    particle.animTime = animTime[index];
+    particle.baseFlowSpeed = baseFlowSpeed[index];
+    particle.currFlowSpeed = currFlowSpeed[index];
+    particle.baseFlowOffset = baseFlowOffset[index];
+    particle.currFlowOffset = currFlowOffset[index];
+    particle.baseNoiseScale = baseNoiseScale[index];
+    particle.currNoiseScale = currNoiseScale[index];
+    particle.baseNoiseUScrollSpeed = baseNoiseUScrollSpeed[index];
+    particle.currNoiseUOffset = currNoiseUOffset[index];
+    particle.baseNoiseVScrollSpeed = baseNoiseVScrollSpeed[index];
+    particle.currNoiseVOffset = currNoiseVOffset[index];
+    particle.currRadius = currRadius[index];
+    particle.alphaRemap = alphaRemap[index];
+    particle.baseSize = Vector2(baseSizeX[index], baseSizeY[index]);
+    particle.currSize = GetSize(index);
+    particle.color = color[index];
+    particle.positionTarget = positionTarget[index];
+    particle.seed = seed[index];
+    return particle;
+}
+
+void ParticleStorage::Set(uint32 index, const Particle& particle)
+{
+    DVASSERT(index < GetCount());
+
+    life[index] = particle.life;
+    lifeTime[index] = particle.lifeTime;
+    SetPosition(index, particle.position);
+    SetSpeed(index, particle.speed);
+    angle[index] = particle.angle;
+    spin[index] = particle.spin;
+    frame[index] = particle.frame;
+    animTime[index] = particle.animTime;
+    baseFlowSpeed[index] = particle.baseFlowSpeed;
+    currFlowSpeed[index] = particle.currFlowSpeed;
+    baseFlowOffset[index] = particle.baseFlowOffset;
+    currFlowOffset[index] = particle.currFlowOffset;
+    baseNoiseScale[index] = particle.baseNoiseScale;
+    currNoiseScale[index] = particle.currNoiseScale;
+    baseNoiseUScrollSpeed[index] = particle.baseNoiseUScrollSpeed;
+    currNoiseUOffset[index] = particle.currNoiseUOffset;
+    baseNoiseVScrollSpeed[index] = particle.baseNoiseVScrollSpeed;
+    currNoiseVOffset[index] = particle.currNoiseVOffset;
+    currRadius[index] = particle.currRadius;
+    alphaRemap[index] = particle.alphaRemap;
+    baseSizeX[index] = particle.baseSize.x;
+    baseSizeY[index] = particle.baseSize.y;
+    currSizeX[index] = particle.currSize.x;
+    currSizeY[index] = particle.currSize.y;
+    color[index] = particle.color;
+    positionTarget[index] = particle.positionTarget;
+    seed[index] = particle.seed;
+}
+
+uint32 ParticleStorage::RemoveDead()
+{
+    uint32 count = GetCount();
+    uint32 firstDead = 0;
+    while (firstDead < count && life[firstDead] < lifeTime[firstDead])
+    {
+        ++firstDead;
+    }
+
+    if (firstDead == count)
+    {
+        return 0;
+    }
+
+    Vector<uint8> keep(count, 1);
+    for (uint32 i = firstDead; i < count; ++i)
+    {
+        keep[i] = life[i] < lifeTime[i] ? 1 : 0;
+    }
+    return Compact(keep);
+}
+
+uint32 ParticleStorage::RemoveEverySecond()
+{
+    uint32 count = GetCount();
+    if (count < 2)
+    {
+        return 0;
+    }
+
+    Vector<uint8> keep(count, 1);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        keep[i] = ((count - 1 - i) % 2 == 0) ? 1 : 0;
+    }
+    return Compact(keep);
+}
+
+void ParticleStorage::Clear()
+{
+    ForEachArray([](auto& array) { array.clear(); });
+}
+
+uint32 ParticleStorage::Compact(const Vector<uint8>& keep)
+{
+    uint32 count = GetCount();
+    DVASSERT(keep.size() == count);
+
+    ForEachArray([&keep, count](auto& array) {
+        uint32 dst = 0;
+        for (uint32 src = 0; src < count; ++src)
+        {
+            if (keep[src] != 0)
+            {
+                array[dst++] = array[src];
+            }
+        }
+        array.resize(dst);
+    });
+
+    return count - GetCount();
+}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+#include "Particles/Particle.h"
+
+namespace DAVA
+{
+/**
+    Particles of one `ParticleGroup` in structure-of-arrays layout.
+    Every particle field is stored in its own contiguous array, so simulation kernels
+    (see `ParticleKernels`) process whole group at once instead of chasing particles one by one.
+    Particles are stored in order of generation: index 0 is the oldest particle, the last index is the newest one.
+*/
+struct ParticleStorage
+{
+    uint32 GetCount() const;
+    bool IsEmpty() const;
+
+    /** Append `particle` as the newest one and return its index. */
+    uint32 Add(const Particle& particle);
+
+    /** Gather all fields of particle at `index`. */
+    Particle Get(uint32 index) const;
+    /** Scatter all fields of `particle` to `index`. */
+    void Set(uint32 index, const Particle& particle);
+
+    Vector3 GetPosition(uint32 index) const;
+    void SetPosition(uint32 index, const Vector3& position);
+    Vector3 GetSpeed(uint32 index) const;
+    void SetSpeed(uint32 index, const Vector3& speed);
+    Vector2 GetSize(uint32 index) const;
+
+    /** Remove particles which lived their lifetime (`life >= lifeTime`), order of the others is preserved. Return count of removed particles. */
+    uint32 RemoveDead();
+    /** Remove every second particle counting from the newest one. Return count of removed particles. */
+    uint32 RemoveEverySecond();
+    void Clear();
+
+    Vector<float32> life;
+    Vector<float32> lifeTime;
+
+    Vector<float32> positionX;
+    Vector<float32> positionY;
+    Vector<float32> positionZ;
+    Vector<float32> speedX;
+    Vector<float32> speedY;
+    Vector<float32> speedZ;
+
+    Vector<float32> angle;
+    Vector<float32> spin;
+
+    Vector<int32> frame;
+    Vector<float32> animTime;
+
+    Vector<float32> baseFlowSpeed;
+    Vector<float32> currFlowSpeed;
+    Vector<float32> baseFlowOffset;
+    Vector<float32> currFlowOffset;
+
+    Vector<float32> baseNoiseScale;
+    Vector<float32> currNoiseScale;
+    Vector<float32> baseNoiseUScrollSpeed;
+    Vector<float32> currNoiseUOffset;
+    Vector<float32> baseNoiseVScrollSpeed;
+    Vector<float32> currNoiseVOffset;
+
+    Vector<float32> currRadius;
+    Vector<float32> alphaRemap;
+    Vector<float32> baseSizeX;
+    Vector<float32> baseSizeY;
+    Vector<float32> currSizeX;
+    Vector<float32> currSizeY;
+
+    Vector<Color> color;
+
+    Vector<int32> positionTarget;
+    Vector<uint32> seed;
+
+private:
+    template <typename F>
+    void ForEachArray(F&& f);
+    uint32 Compact(const Vector<uint8>& keep);
+};
+
+inline uint32 ParticleStorage::GetCount() const
+{
+    return static_cast<uint32>(life.size());
+}
+
+inline bool ParticleStorage::IsEmpty() const
+{
+    return life.empty();
+}
+
+inline Vector3 ParticleStorage::GetPosition(uint32 index) const
+{
+    return Vector3(positionX[index], positionY[index], positionZ[index]);
+}
+
+inline void ParticleStorage::SetPosition(uint32 index, const Vector3& position)
+{
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+}
+
+inline Vector3 ParticleStorage::GetSpeed(uint32 index) const
+{
+    return Vector3(speedX[index], speedY[index], speedZ[index]);
+}
+
+inline void ParticleStorage::SetSpeed(uint32 index, const Vector3& speed)
+{
+    speedX[index] = speed.x;
+    speedY[index] = speed.y;
+    speedZ[index] = speed.z;
+}
+
+inline Vector2 ParticleStorage::GetSize(uint32 index) const
+{
+    return Vector2(currSizeX[index], currSizeY[index]);
+}
+}
@@ -0,0 +1,208 @@
+#include "Particles/Private/ParticleKernels.h"
+
+#include "Math/SIMD.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DAVA
+{
+void ParticleKernels::Add(float32* values, float32 delta, uint32 count)
+{
+    using namespace SIMD;
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD)
+    Float4 delta4 = Splat(delta);
+    for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+    {
+        Store(values + i, SIMD::Add(Load(values + i), delta4));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        values[i] += delta;
+    }
+}
+
+void ParticleKernels::Integrate(float32* values, const float32* rates, const float32* scale, float32 dt, uint32 count)
+{
+    using namespace SIMD;
+
+    uint32 i = 0;
+    if (scale == nullptr)
+    {
+#if defined(DAVA_SIMD)
+        Float4 dt4 = Splat(dt);
+        for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+        {
+            Store(values + i, SIMD::Add(Load(values + i), Mul(Load(rates + i), dt4)));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            values[i] += rates[i] * dt;
+        }
+    }
+    else
+    {
+#if defined(DAVA_SIMD)
+        Float4 dt4 = Splat(dt);
+        for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+        {
+            Float4 step = Mul(Load(rates + i), Mul(Load(scale + i), dt4));
+            Store(values + i, SIMD::Add(Load(values + i), step));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            values[i] += rates[i] * (scale[i] * dt);
+        }
+    }
+}
+
+void ParticleKernels::AddScaled(float32* x, float32* y, float32* z, const Vector3& value, const float32* scale, uint32 count)
+{
+    using namespace SIMD;
+
+    if (scale == nullptr)
+    {
+        ParticleKernels::Add(x, value.x, count);
+        ParticleKernels::Add(y, value.y, count);
+        ParticleKernels::Add(z, value.z, count);
+        return;
+    }
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD)
+    Float4 vx = Splat(value.x);
+    Float4 vy = Splat(value.y);
+    Float4 vz = Splat(value.z);
+    for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+    {
+        Float4 s = Load(scale + i);
+        Store(x + i, SIMD::Add(Load(x + i), Mul(vx, s)));
+        Store(y + i, SIMD::Add(Load(y + i), Mul(vy, s)));
+        Store(z + i, SIMD::Add(Load(z + i), Mul(vz, s)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        x[i] += value.x * scale[i];
+        y[i] += value.y * scale[i];
+        z[i] += value.z * scale[i];
+    }
+}
+
+void ParticleKernels::Multiply(const float32* a, const float32* b, float32* result, uint32 count)
+{
+    using namespace SIMD;
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD)
+    for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+    {
+        Store(result + i, Mul(Load(a + i), Load(b + i)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        result[i] = a[i] * b[i];
+    }
+}
+
+void ParticleKernels::ComputeOverLife(const float32* life, const float32* lifeTime, float32* overLife, uint32 count)
+{
+    using namespace SIMD;
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD_DIV)
+    for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+    {
+        Store(overLife + i, Div(Load(life + i), Load(lifeTime + i)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        overLife[i] = life[i] / lifeTime[i];
+    }
+}
+
+void ParticleKernels::ComputeRadius(const float32* sizeX, const float32* sizeY, const Vector2& pivotOffset, float32* radius, uint32 count)
+{
+    using namespace SIMD;
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD_SQRT)
+    Float4 px = Splat(pivotOffset.x);
+    Float4 py = Splat(pivotOffset.y);
+    for (uint32 simdCount = GetVectorizedCount(count); i < simdCount; i += WIDTH)
+    {
+        Float4 x = Mul(Load(sizeX + i), px);
+        Float4 y = Mul(Load(sizeY + i), py);
+        Store(radius + i, Sqrt(SIMD::Add(Mul(x, x), Mul(y, y))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float32 x = sizeX[i] * pivotOffset.x;
+        float32 y = sizeY[i] * pivotOffset.y;
+        radius[i] = std::sqrt(x * x + y * y);
+    }
+}
+
+void ParticleKernels::AccumulateBBox(const float32* x, const float32* y, const float32* z, const float32* radius, const Vector3& offset, AABBox3& bbox, uint32 count)
+{
+    using namespace SIMD;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // extents of these particles only, box may already contain other groups with their own offsets
+    Vector3 minPoint(AABBOX_INFINITY, AABBOX_INFINITY, AABBOX_INFINITY);
+    Vector3 maxPoint(-AABBOX_INFINITY, -AABBOX_INFINITY, -AABBOX_INFINITY);
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD)
+    uint32 simdCount = GetVectorizedCount(count);
+    if (simdCount > 0)
+    {
+        Float4 minX = Splat(minPoint.x);
+        Float4 minY = Splat(minPoint.y);
+        Float4 minZ = Splat(minPoint.z);
+        Float4 maxX = Splat(maxPoint.x);
+        Float4 maxY = Splat(maxPoint.y);
+        Float4 maxZ = Splat(maxPoint.z);
+        for (; i < simdCount; i += WIDTH)
+        {
+            Float4 r = Load(radius + i);
+            Float4 px = Load(x + i);
+            Float4 py = Load(y + i);
+            Float4 pz = Load(z + i);
+            minX = Min(minX, Sub(px, r));
+            minY = Min(minY, Sub(py, r));
+            minZ = Min(minZ, Sub(pz, r));
+            maxX = Max(maxX, SIMD::Add(px, r));
+            maxY = Max(maxY, SIMD::Add(py, r));
+            maxZ = Max(maxZ, SIMD::Add(pz, r));
+        }
+        minPoint = Vector3(HorizontalMin(minX), HorizontalMin(minY), HorizontalMin(minZ));
+        maxPoint = Vector3(HorizontalMax(maxX), HorizontalMax(maxY), HorizontalMax(maxZ));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        minPoint.x = std::min(minPoint.x, x[i] - radius[i]);
+        minPoint.y = std::min(minPoint.y, y[i] - radius[i]);
+        minPoint.z = std::min(minPoint.z, z[i] - radius[i]);
+        maxPoint.x = std::max(maxPoint.x, x[i] + radius[i]);
+        maxPoint.y = std::max(maxPoint.y, y[i] + radius[i]);
+        maxPoint.z = std::max(maxPoint.z, z[i] + radius[i]);
+    }
+
+    bbox.AddPoint(minPoint + offset);
+    bbox.AddPoint(maxPoint + offset);
+}
+} // namespace DAVA
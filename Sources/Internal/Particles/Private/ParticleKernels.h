@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/AABBox3.h"
+
+namespace DAVA
+{
+/**
+    Batch operations over `ParticleStorage` arrays used by `ParticleEffectSystem` simulation.
+    Kernels use SSE on x86/x64 and NEON on ARM processing four particles per iteration, and fall back to plain loops elsewhere.
+    Optional `scale` arguments may be nullptr which means scale of 1 for every particle.
+*/
+namespace ParticleKernels
+{
+/** values[i] += delta */
+void Add(float32* values, float32 delta, uint32 count);
+
+/** values[i] += rates[i] * (scale[i] * dt) */
+void Integrate(float32* values, const float32* rates, const float32* scale, float32 dt, uint32 count);
+
+/** x[i] += value.x * scale[i], y[i] += value.y * scale[i], z[i] += value.z * scale[i] */
+void AddScaled(float32* x, float32* y, float32* z, const Vector3& value, const float32* scale, uint32 count);
+
+/** result[i] = a[i] * b[i], `result` may be the same array as `a` or `b` */
+void Multiply(const float32* a, const float32* b, float32* result, uint32 count);
+
+/** overLife[i] = life[i] / lifeTime[i] */
+void ComputeOverLife(const float32* life, const float32* lifeTime, float32* overLife, uint32 count);
+
+/** radius[i] = length(Vector2(sizeX[i] * pivotOffset.x, sizeY[i] * pivotOffset.y)) */
+void ComputeRadius(const float32* sizeX, const float32* sizeY, const Vector2& pivotOffset, float32* radius, uint32 count);
+
+/** Extend `bbox` with spheres at (x[i], y[i], z[i]) + `offset` with radius[i]. */
+void AccumulateBBox(const float32* x, const float32* y, const float32* z, const float32* radius, const Vector3& offset, AABBox3& bbox, uint32 count);
+} // namespace ParticleKernels
+} // namespace DAVA
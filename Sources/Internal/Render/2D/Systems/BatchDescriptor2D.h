@@ -2,6 +2,7 @@
 
 #include "Base/BaseTypes.h"
 #include "Math/Color.h"
+#include "Math/Rect.h"
 #include "Render/RHI/rhi_Public.h"
 
 namespace DAVA
@@ -9,6 +10,14 @@ namespace DAVA
 class NMaterial;
 struct Matrix4;
 
+/** Vertex of batching buffer with single texture coordinates stream. */
+struct BatchVertex2D
+{
+    float32 position[3];
+    float32 texCoord[2];
+    uint32 color;
+};
+
 struct BatchDescriptor2D
 {
     static const uint32 MAX_TEXTURE_STREAMS_COUNT = 4;
@@ -26,8 +35,53 @@ struct BatchDescriptor2D
     Array<const float32*, MAX_TEXTURE_STREAMS_COUNT> texCoordPointer = {};
     const uint32* colorPointer = nullptr;
     const uint16* indexPointer = nullptr;
+    /** Optional copy of vertices in batching format, if it is set (with single texture stream) vertices are copied without conversion. */
+    const BatchVertex2D* preparedVertexPointer = nullptr;
     NMaterial* material = nullptr;
     Matrix4* worldMatrix = nullptr;
     Color singleColor = Color::White;
 };
+
+/**
+    Batches captured by RenderSystem2D between BeginRetainedBatches and EndRetainedBatches.
+    Vertices are kept in batching format, consecutive batches with the same material, texture and
+    primitive type are merged into one range, so replaying them costs a memcpy per range.
+*/
+struct RetainedBatches2D
+{
+    struct Range
+    {
+        uint32 vertexOffset = 0;
+        uint32 vertexCount = 0;
+        uint32 indexOffset = 0;
+        uint32 indexCount = 0;
+        rhi::HTextureSet textureSetHandle;
+        rhi::HSamplerState samplerStateHandle;
+        rhi::PrimitiveType primitiveType = rhi::PRIMITIVE_TRIANGLELIST;
+        NMaterial* material = nullptr;
+    };
+
+    Vector<BatchVertex2D> vertices;
+    Vector<uint16> indices;
+    Vector<Range> ranges;
+
+    /** Render state batches were captured with, they can be replayed only with the same state. */
+    Rect clip;
+    Vector2 screenSize;
+    Vector2 physicalToVirtualScale;
+    bool spriteClipping = true;
+    bool spriteDraw = true;
+    /** False if some of captured batches can't be replayed (custom world matrix, several texture streams, highlighting). */
+    bool replayable = false;
+
+    void Clear();
+};
+
+inline void RetainedBatches2D::Clear()
+{
+    vertices.clear();
+    indices.clear();
+    ranges.clear();
+    replayable = false;
+}
 }
\ No newline at end of file
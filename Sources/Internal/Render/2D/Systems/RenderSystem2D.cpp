@@ -28,6 +28,22 @@ const bool virtualToPhysicalTransformEnabledDefaultValue = true;
 const uint32 MAX_VERTICES = 1024;
 const uint32 MAX_INDECES = MAX_VERTICES * 2;
 const float32 SEGMENT_LENGTH = 15.0f;
+
+// Cached geometry is kept in format of batching buffer, so unchanged controls are copied into it as is
+void PrepareBatchVertices(const Vector<Vector2>& vertices, const Vector<Vector2>& texCoords, uint32 color, Vector<BatchVertex2D>& result)
+{
+    result.resize(vertices.size());
+    for (size_t i = 0, sz = vertices.size(); i < sz; ++i)
+    {
+        BatchVertex2D& v = result[i];
+        v.position[0] = vertices[i].x;
+        v.position[1] = vertices[i].y;
+        v.position[2] = 0.f;
+        v.texCoord[0] = texCoords[i].x;
+        v.texCoord[1] = texCoords[i].y;
+        v.color = color;
+    }
+}
 }
 
 const FastName RenderSystem2D::RENDER_PASS_NAME("2d");
@@ -668,7 +684,8 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
 
     // Begin define draw color
     Color useColor = batchDesc.singleColor;
-    if (highlightControlsVerticesLimit > 0 && batchDesc.vertexCount > highlightControlsVerticesLimit && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::HIGHLIGHT_HARD_CONTROLS))
+    bool highlightControl = highlightControlsVerticesLimit > 0 && batchDesc.vertexCount > highlightControlsVerticesLimit && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::HIGHLIGHT_HARD_CONTROLS);
+    if (highlightControl)
     {
         // Highlight too big controls with magenta color
         static Color magenta = Color(1.f, 0.f, 1.f, 1.f);
@@ -710,16 +727,24 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     currentVertexBuffer.resize(vertexStride * (vertexIndex + batchDesc.vertexCount));
     currentIndexBuffer.resize(indexIndex + batchDesc.indexCount);
 
-    for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+    if (batchDesc.preparedVertexPointer != nullptr && batchDesc.texCoordCount == 1 && !highlightControl)
+    {
+        DVASSERT(vertexStride == sizeof(BatchVertex2D));
+        Memcpy(currentVertexBuffer.data() + vertexStride * vertexIndex, batchDesc.preparedVertexPointer, vertexStride * batchDesc.vertexCount);
+    }
+    else
     {
-        BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
-        v.pos.x = batchDesc.vertexPointer[i * batchDesc.vertexStride];
-        v.pos.y = batchDesc.vertexPointer[i * batchDesc.vertexStride + 1];
-        //TODO: rethink do we still require z in rhi?
-        v.pos.z = 0.f; // axis Z, empty but need for EVF_VERTEX format
-        v.uv.x = texPtr[i * texStride];
-        v.uv.y = texPtr[i * texStride + 1];
-        v.color = colorPtr[i * colorStride];
+        for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+        {
+            BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+            v.pos.x = batchDesc.vertexPointer[i * batchDesc.vertexStride];
+            v.pos.y = batchDesc.vertexPointer[i * batchDesc.vertexStride + 1];
+            //TODO: rethink do we still require z in rhi?
+            v.pos.z = 0.f; // axis Z, empty but need for EVF_VERTEX format
+            v.uv.x = texPtr[i * texStride];
+            v.uv.y = texPtr[i * texStride + 1];
+            v.color = colorPtr[i * colorStride];
+        }
     }
     //add optional texture streams
     for (uint32 texStream = 1; texStream < batchDesc.texCoordCount; ++texStream)
@@ -753,10 +778,126 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         break;
     }
 
+    if (retainedBatches != nullptr)
+    {
+        RetainBatch(batchDesc, highlightControl);
+    }
+
     indexIndex += batchDesc.indexCount;
     vertexIndex += batchDesc.vertexCount;
 }
 
+void RenderSystem2D::RetainBatch(const BatchDescriptor2D& batchDesc, bool highlightControl)
+{
+    if (batchDesc.texCoordCount > 1 || batchDesc.worldMatrix != nullptr || highlightControl)
+    {
+        retainedBatches->replayable = false;
+    }
+    if (!retainedBatches->replayable)
+    {
+        return;
+    }
+
+    // Vertices were just written to batching buffer, copy them as is
+    DVASSERT(GetVBOStride(currentTexcoordStreamCount) == sizeof(BatchVertex2D));
+    const BatchVertex2D* batchVertices = OffsetPointer<BatchVertex2D>(currentVertexBuffer.data(), sizeof(BatchVertex2D) * vertexIndex);
+    uint32 vertexOffset = static_cast<uint32>(retainedBatches->vertices.size());
+    retainedBatches->vertices.insert(retainedBatches->vertices.end(), batchVertices, batchVertices + batchDesc.vertexCount);
+
+    Vector<RetainedBatches2D::Range>& ranges = retainedBatches->ranges;
+    bool mergeWithLast = !ranges.empty() &&
+    ranges.back().material == batchDesc.material &&
+    ranges.back().textureSetHandle == batchDesc.textureSetHandle &&
+    ranges.back().samplerStateHandle == batchDesc.samplerStateHandle &&
+    ranges.back().primitiveType == batchDesc.primitiveType &&
+    batchDesc.primitiveType != rhi::PRIMITIVE_TRIANGLESTRIP &&
+    ranges.back().vertexCount + batchDesc.vertexCount <= MAX_VERTICES &&
+    ranges.back().indexCount + batchDesc.indexCount <= MAX_INDECES;
+    if (!mergeWithLast)
+    {
+        RetainedBatches2D::Range range;
+        range.vertexOffset = vertexOffset;
+        range.indexOffset = static_cast<uint32>(retainedBatches->indices.size());
+        range.textureSetHandle = batchDesc.textureSetHandle;
+        range.samplerStateHandle = batchDesc.samplerStateHandle;
+        range.primitiveType = batchDesc.primitiveType;
+        range.material = batchDesc.material;
+        ranges.push_back(range);
+    }
+
+    RetainedBatches2D::Range& range = ranges.back();
+    uint32 baseIndex = vertexOffset - range.vertexOffset;
+    for (uint32 i = 0; i < batchDesc.indexCount; ++i)
+    {
+        retainedBatches->indices.push_back(static_cast<uint16>(baseIndex + batchDesc.indexPointer[i]));
+    }
+    range.vertexCount += batchDesc.vertexCount;
+    range.indexCount += batchDesc.indexCount;
+}
+
+bool RenderSystem2D::IsRetainedStateEqual(const RetainedBatches2D& batches)
+{
+    const Size2i& screenSize = GetEngineContext()->uiControlSystem->vcs->GetVirtualScreenSize();
+    bool highlightEnabled = highlightControlsVerticesLimit > 0 && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::HIGHLIGHT_HARD_CONTROLS);
+    return !IsRenderTargetPass() && !highlightEnabled &&
+    batches.clip == currentClip &&
+    batches.screenSize == Vector2(static_cast<float32>(screenSize.dx), static_cast<float32>(screenSize.dy)) &&
+    batches.physicalToVirtualScale == currentPhysicalToVirtualScale &&
+    batches.spriteClipping == spriteClipping &&
+    batches.spriteDraw == Renderer::GetOptions()->IsOptionEnabled(RenderOptions::SPRITE_DRAW);
+}
+
+void RenderSystem2D::BeginRetainedBatches(RetainedBatches2D* batches)
+{
+    DVASSERT(retainedBatches == nullptr, "Nested capture of retained batches");
+
+    const Size2i& screenSize = GetEngineContext()->uiControlSystem->vcs->GetVirtualScreenSize();
+    batches->Clear();
+    batches->clip = currentClip;
+    batches->screenSize = Vector2(static_cast<float32>(screenSize.dx), static_cast<float32>(screenSize.dy));
+    batches->physicalToVirtualScale = currentPhysicalToVirtualScale;
+    batches->spriteClipping = spriteClipping;
+    batches->spriteDraw = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::SPRITE_DRAW);
+    batches->replayable = IsRetainedStateEqual(*batches);
+    retainedBatches = batches;
+}
+
+void RenderSystem2D::EndRetainedBatches()
+{
+    retainedBatches = nullptr;
+}
+
+bool RenderSystem2D::PushRetainedBatches(const RetainedBatches2D& batches)
+{
+    if (!batches.replayable || !IsRetainedStateEqual(batches))
+    {
+        return false;
+    }
+
+    for (const RetainedBatches2D::Range& range : batches.ranges)
+    {
+        const BatchVertex2D* vertices = batches.vertices.data() + range.vertexOffset;
+
+        BatchDescriptor2D batch;
+        batch.vertexCount = range.vertexCount;
+        batch.indexCount = range.indexCount;
+        batch.vertexStride = sizeof(BatchVertex2D) / sizeof(float32);
+        batch.texCoordStride = sizeof(BatchVertex2D) / sizeof(float32);
+        batch.colorStride = sizeof(BatchVertex2D) / sizeof(uint32);
+        batch.textureSetHandle = range.textureSetHandle;
+        batch.samplerStateHandle = range.samplerStateHandle;
+        batch.primitiveType = range.primitiveType;
+        batch.vertexPointer = vertices->position;
+        batch.texCoordPointer[0] = vertices->texCoord;
+        batch.colorPointer = &vertices->color;
+        batch.indexPointer = batches.indices.data() + range.indexOffset;
+        batch.preparedVertexPointer = vertices;
+        batch.material = range.material;
+        PushBatch(batch);
+    }
+    return true;
+}
+
 void RenderSystem2D::Draw(Sprite* sprite, SpriteDrawState* drawState, const Color& color)
 {
     if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::SPRITE_DRAW))
@@ -1186,6 +1327,15 @@ void RenderSystem2D::DrawStretched(Sprite* sprite, SpriteDrawState* state, Vecto
         sd.transformMatr = transformMatr;
         sd.usePerPixelAccuracy = state->usePerPixelAccuracy;
         sd.GenerateTransformData();
+        sd.preparedVertices.clear();
+    }
+
+    // only persistent data keeps vertices in batching format
+    uint32 colorRGBA = rhi::NativeColorRGBA(color.r, color.g, color.b, color.a);
+    if (pStreachData && (sd.preparedVertices.empty() || sd.preparedColor != colorRGBA))
+    {
+        sd.preparedColor = colorRGBA;
+        PrepareBatchVertices(sd.transformedVertices, sd.texCoords, colorRGBA, sd.preparedVertices);
     }
 
     spriteVertexCount = int32(sd.transformedVertices.size());
@@ -1205,6 +1355,7 @@ void RenderSystem2D::DrawStretched(Sprite* sprite, SpriteDrawState* state, Vecto
         batch.vertexPointer = sd.transformedVertices.data()->data;
         batch.texCoordPointer[0] = sd.texCoords.data()->data;
         batch.indexPointer = sd.indeces;
+        batch.preparedVertexPointer = sd.preparedVertices.empty() ? nullptr : sd.preparedVertices.data();
 
         PushBatch(batch);
     }
@@ -1280,16 +1431,28 @@ void RenderSystem2D::DrawTiled(Sprite* sprite, SpriteDrawState* state, const Vec
     Matrix3 transformMatr;
     gd.BuildTransformMatrix(transformMatr);
 
+    bool needPrepareVertices = false;
     if (needGenerateData || td.transformMatr != transformMatr)
     {
         td.transformMatr = transformMatr;
         td.GenerateTransformData();
+        needPrepareVertices = true;
     }
 
+    // only persistent data keeps vertices in batching format
+    uint32 colorRGBA = rhi::NativeColorRGBA(color.r, color.g, color.b, color.a);
+    needPrepareVertices = pTiledData && (needPrepareVertices || td.preparedColor != colorRGBA);
+    td.preparedColor = colorRGBA;
+
     const uint32 uCount = static_cast<uint32>(td.units.size());
     for (uint32 uIndex = 0; uIndex < uCount; ++uIndex)
     {
         TiledDrawData::Unit& unit = td.units[uIndex];
+        if (needPrepareVertices)
+        {
+            PrepareBatchVertices(unit.transformedVertices, unit.texCoords, colorRGBA, unit.preparedVertices);
+        }
+
         BatchDescriptor2D batch;
         batch.singleColor = color;
         batch.material = state->GetMaterial();
@@ -1302,6 +1465,7 @@ void RenderSystem2D::DrawTiled(Sprite* sprite, SpriteDrawState* state, const Vec
         batch.vertexPointer = unit.transformedVertices.data()->data;
         batch.texCoordPointer[0] = unit.texCoords.data()->data;
         batch.indexPointer = unit.indeces.data();
+        batch.preparedVertexPointer = unit.preparedVertices.empty() ? nullptr : unit.preparedVertices.data();
         PushBatch(batch);
     }
 
@@ -22,6 +22,7 @@ struct TiledDrawData
         Vector<Vector2> texCoords;
         Vector<Vector2> transformedVertices;
         Vector<uint16> indeces;
+        Vector<BatchVertex2D> preparedVertices;
     };
     Vector<Unit> units;
 
@@ -35,6 +36,7 @@ struct TiledDrawData
     Vector2 size;
     Vector2 stretchCap;
     Matrix3 transformMatr;
+    uint32 preparedColor = 0;
 };
 
 struct StretchDrawData
@@ -42,6 +44,7 @@ struct StretchDrawData
     Vector<Vector2> vertices;
     Vector<Vector2> transformedVertices;
     Vector<Vector2> texCoords;
+    Vector<BatchVertex2D> preparedVertices;
     static const uint16 indeces[18 * 3];
 
     void GenerateStretchData();
@@ -55,6 +58,7 @@ struct StretchDrawData
     int32 type;
     Vector2 stretchCap;
     Matrix3 transformMatr;
+    uint32 preparedColor = 0;
     bool usePerPixelAccuracy;
 };
 
@@ -176,6 +180,19 @@ public:
 
     void PushBatch(const BatchDescriptor2D& batchDesc);
 
+    /**
+     * Start capturing of pushed batches into `batches` (previous content is cleared).
+     * Batches are still drawn as usual, captured copy can be replayed with PushRetainedBatches
+     * while render state it depends on (clip, screen size, sprite options) stays the same.
+     */
+    void BeginRetainedBatches(RetainedBatches2D* batches);
+    void EndRetainedBatches();
+    /**
+     * Push previously captured batches.
+     * @return false if batches can't be replayed with current render state and should be rebuilt
+     */
+    bool PushRetainedBatches(const RetainedBatches2D& batches);
+
     /*
      *  note - it will flush currently batched!
      *  it will also modify packet to add current clip
@@ -333,6 +350,9 @@ private:
     uint32 GetVertexLayoutId(uint32 texCoordStreamCount);
     uint32 GetVBOStride(uint32 texCoordStreamCount);
 
+    void RetainBatch(const BatchDescriptor2D& batchDesc, bool highlightControl);
+    bool IsRetainedStateEqual(const RetainedBatches2D& batches);
+
 private:
     Matrix4 currentVirtualToPhysicalMatrix;
     Vector2 currentPhysicalToVirtualScale;
@@ -385,6 +405,8 @@ private:
     uint32 currFrameErrorsFlags = NO_ERRORS;
     uint32 highlightControlsVerticesLimit = 0;
 
+    RetainedBatches2D* retainedBatches = nullptr;
+
     rhi::HRenderPass pass2DHandle;
     rhi::HPacketList packetList2DHandle;
     rhi::HRenderPass passTargetHandle;
@@ -354,6 +354,14 @@ void PolygonGroup::Save(KeyedArchive* keyedArchive, SerializationContext* serial
 }
 
 void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams)
+{
+    if (DecodePolygonData(keyedArchive, requiredFlags, cutUnusedStreams))
+    {
+        FinishPolygonDataLoading();
+    }
+}
+
+bool PolygonGroup::DecodePolygonData(KeyedArchive* keyedArchive, int32 requiredFlags, bool cutUnusedStreams)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
@@ -373,7 +381,7 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
         if (size != vertexCount * vertexStride)
         {
             Logger::Error("PolygonGroup::Load - Something is going wrong, size of vertex array is incorrect");
-            return;
+            return false;
         }
 
         const uint8* archiveData = keyedArchive->GetByteArray("vertices");
@@ -429,7 +437,7 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
         if (size != indexCount * INDEX_FORMAT_SIZE[indexFormat])
         {
             Logger::Error("PolygonGroup::Load - Something is going wrong, size of index array is incorrect");
-            return;
+            return false;
         }
         SafeDeleteArray(indexArray);
         indexArray = new int16[indexCount];
@@ -437,10 +445,15 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
         memcpy(indexArray, archiveData, indexCount * INDEX_FORMAT_SIZE[indexFormat]);
     }
 
+    RecalcAABBoxFromMeshData();
+    return true;
+}
+
+void PolygonGroup::FinishPolygonDataLoading()
+{
+    // vertex layouts registry and rhi buffers can be used only from main thread
     std::fill(std::begin(textureCoordArray), std::end(textureCoordArray), nullptr);
     UpdateDataPointersAndStreams();
-
-    RecalcAABBox();
     BuildBuffers();
 }
 
@@ -459,6 +472,19 @@ void PolygonGroup::RecalcAABBox()
     }
 }
 
+void PolygonGroup::RecalcAABBoxFromMeshData()
+{
+    // the same as RecalcAABBox, but doesn't need data pointers: position is always the first vertex element
+    aabbox = AABBox3();
+    if ((meshData != nullptr) && (vertexFormat & EVF_VERTEX))
+    {
+        for (int32 vi = 0; vi < vertexCount; ++vi)
+        {
+            aabbox.AddPoint(*reinterpret_cast<const Vector3*>(meshData + vi * vertexStride));
+        }
+    }
+}
+
 void PolygonGroup::CopyData(const uint8** meshData, uint8** newMeshData, uint32 vertexFormat, uint32 newVertexFormat, uint32 format)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
@@ -163,6 +163,15 @@ public:
     void Save(KeyedArchive* keyedArchive, SerializationContext* serializationContext) override;
     void LoadPolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams);
 
+    /*
+        Two halves of LoadPolygonData for loading of several polygon groups in parallel.
+        DecodePolygonData fills vertex and index data and bounding box, it doesn't touch render resources
+        and can be called from worker thread. FinishPolygonDataLoading should be called after it on the main thread.
+        DecodePolygonData returns false if data in archive is inconsistent, FinishPolygonDataLoading shouldn't be called then.
+     */
+    bool DecodePolygonData(KeyedArchive* keyedArchive, int32 requiredFlags, bool cutUnusedStreams);
+    void FinishPolygonDataLoading();
+
     static void CopyData(const uint8** meshData, uint8** newMeshData, uint32 vertexFormat, uint32 newVertexFormat, uint32 format);
 
     rhi::HVertexBuffer vertexBuffer;
@@ -171,6 +180,7 @@ public:
 
 private:
     void UpdateDataPointersAndStreams();
+    void RecalcAABBoxFromMeshData();
 
     template <class T>
     void SetVertexData(int32 i, T* basePtr, const T& value);
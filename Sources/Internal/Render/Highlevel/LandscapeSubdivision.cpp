@@ -5,9 +5,21 @@
 #include "Render/RHI/rhi_Public.h"
 #include "Reflection/ReflectionRegistrator.h"
 #include "Reflection/ReflectedMeta.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Math/SIMD.h"
 
 namespace DAVA
 {
+namespace LandscapeSubdivisionDetails
+{
+//subtrees of patches on this level are subdivided by separate jobs
+const uint32 PARALLEL_LEVEL = 2;
+//landscapes with less levels are subdivided on calling thread
+const uint32 PARALLEL_MIN_LEVEL_COUNT = 7;
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(LandscapeSubdivision::SubdivisionMetrics)
 {
     ReflectionRegistrator<SubdivisionMetrics>::Begin()
@@ -65,33 +77,78 @@ void LandscapeSubdivision::ReleaseInternalData()
     subdivLevelInfoArray.clear();
     patchQuadArray.clear();
     subdivPatchArray.clear();
+    subdivisionValid = false;
 
     SafeRelease(heightmap);
 }
 
 void LandscapeSubdivision::PrepareSubdivision(Camera* camera, const Matrix4* worldTransform)
 {
+    using namespace LandscapeSubdivisionDetails;
+
+    Matrix4 viewProjMatrix = (*worldTransform) * camera->GetViewProjMatrix();
+
+    float32 fovLerp = Clamp((camera->GetFOV() - metrics.zoomFov) / (metrics.normalFov - metrics.zoomFov), 0.f, 1.f);
+    float32 heightError = metrics.zoomMaxHeightError + (metrics.normalMaxHeightError - metrics.zoomMaxHeightError) * fovLerp;
+    float32 patchRadiusError = metrics.zoomMaxPatchRadiusError + (metrics.normalMaxPatchRadiusError - metrics.zoomMaxPatchRadiusError) * fovLerp;
+    float32 absoluteHeightError = metrics.zoomMaxAbsoluteHeightError + (metrics.normalMaxAbsoluteHeightError - metrics.zoomMaxAbsoluteHeightError) * fovLerp;
+
+    float32 cameraTanFovY = tanf(camera->GetFOV() * PI / 360.f) / camera->GetAspect();
+    //used for calculate metrics projection on screen. Projection calculate as '1.0 / (distance * tan(fov / 2))'. See errors calculation in SubdividePatch()
+
+    //static camera, e.g. several passes with the same camera or paused game
+    if (subdivisionValid && subdivisionViewProjMatrix == viewProjMatrix && cameraPos == camera->GetPosition() && tanFovY == cameraTanFovY &&
+        maxHeightError == heightError && maxPatchRadiusError == patchRadiusError && maxAbsoluteHeightError == absoluteHeightError)
+    {
+        return;
+    }
+
     ++updateID;
 
     cameraPos = camera->GetPosition();
+    subdivisionViewProjMatrix = viewProjMatrix;
+    frustum->Build(viewProjMatrix, rhi::DeviceCaps().isZeroBaseClipRange);
 
-    frustum->Build((*worldTransform) * camera->GetViewProjMatrix(), rhi::DeviceCaps().isZeroBaseClipRange);
+    maxHeightError = heightError;
+    maxPatchRadiusError = patchRadiusError;
+    maxAbsoluteHeightError = absoluteHeightError;
+    tanFovY = cameraTanFovY;
 
-    float32 fovLerp = Clamp((camera->GetFOV() - metrics.zoomFov) / (metrics.normalFov - metrics.zoomFov), 0.f, 1.f);
-    maxHeightError = metrics.zoomMaxHeightError + (metrics.normalMaxHeightError - metrics.zoomMaxHeightError) * fovLerp;
-    maxPatchRadiusError = metrics.zoomMaxPatchRadiusError + (metrics.normalMaxPatchRadiusError - metrics.zoomMaxPatchRadiusError) * fovLerp;
-    maxAbsoluteHeightError = metrics.zoomMaxAbsoluteHeightError + (metrics.normalMaxAbsoluteHeightError - metrics.zoomMaxAbsoluteHeightError) * fovLerp;
+    PatchSubdivision root = { 0, 0, 0, 0x3f, maxHeightError, maxPatchRadiusError, 0.f, 0.f };
+    CalculatePatchErrors(GetPatchQuadInfo(0, 0, 0), root.heightError, root.radiusError);
 
-    tanFovY = tanf(camera->GetFOV() * PI / 360.f) / camera->GetAspect();
-    //used for calculate metrics projection on screen. Projection calculate as '1.0 / (distance * tan(fov / 2))'. See errors calculation in SubdividePatch()
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (nullptr != jobManager && subdivLevelCount >= PARALLEL_MIN_LEVEL_COUNT)
+    {
+        //patches in different subtrees are independent, every job writes only its own ones
+        deferredPatches.clear();
+        terminatedPatchesCount = SubdividePatch(root, &deferredPatches);
+
+        deferredTerminatedCounts.assign(deferredPatches.size(), 0);
+        JobGroup group;
+        for (size_t i = 0; i < deferredPatches.size(); ++i)
+        {
+            jobManager->CreateWorkerTask([this, i]() { deferredTerminatedCounts[i] = SubdividePatch(deferredPatches[i], nullptr); }, &group);
+        }
+        jobManager->WaitWorkerGroup(&group);
+
+        for (uint32 count : deferredTerminatedCounts)
+        {
+            terminatedPatchesCount += count;
+        }
+    }
+    else
+    {
+        terminatedPatchesCount = SubdividePatch(root, nullptr);
+    }
 
-    terminatedPatchesCount = 0;
-    SubdividePatch(0, 0, 0, 0x3f, maxHeightError, maxPatchRadiusError);
+    subdivisionValid = true;
 }
 
 void LandscapeSubdivision::UpdatePatchInfo(const Rect2i& heighmapRect)
 {
     UpdatePatchInfo(0, 0, 0, nullptr, heighmapRect);
+    subdivisionValid = false;
 }
 
 void LandscapeSubdivision::UpdatePatchInfo(uint32 level, uint32 x, uint32 y, PatchQuadInfo* parentPatch, const Rect2i& updateRect)
@@ -207,8 +264,13 @@ void LandscapeSubdivision::UpdatePatchInfo(uint32 level, uint32 x, uint32 y, Pat
     }
 }
 
-void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0)
+uint32 LandscapeSubdivision::SubdividePatch(const PatchSubdivision& patchSubdivision, Vector<PatchSubdivision>* deferredPatches)
 {
+    uint32 level = patchSubdivision.level;
+    uint32 x = patchSubdivision.x;
+    uint32 y = patchSubdivision.y;
+    uint8 clippingFlags = patchSubdivision.clippingFlags;
+
     SubdivisionLevelInfo& levelInfo = subdivLevelInfoArray[level];
     uint32 offset = levelInfo.offset + (y << level) + x;
     PatchQuadInfo* patch = &patchQuadArray[offset];
@@ -224,9 +286,66 @@ void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint
     if (frustumRes == Frustum::EFR_OUTSIDE)
     {
         subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::CLIPPED;
-        return;
+        return 0;
     }
 
+    float32 heightError = patchSubdivision.heightError;
+    float32 radiusError = patchSubdivision.radiusError;
+
+    if ((level < subdivLevelCount - 1) && ((maxPatchRadiusError <= radiusError) || (maxHeightError <= heightError) || (maxAbsoluteHeightError < Abs(patch->maxError)) || (minSubdivLevel > level) || forceMaxSubdiv))
+    {
+        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::SUBDIVIDED;
+
+        uint32 x2 = x << 1;
+        uint32 y2 = y << 1;
+
+        float32 childrenHeightErrors[4];
+        float32 childrenRadiusErrors[4];
+        CalculateChildrenErrors(level + 1, x2, y2, childrenHeightErrors, childrenRadiusErrors);
+
+        uint32 terminatedCount = 0;
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            PatchSubdivision child = { level + 1, x2 + (i & 1), y2 + (i >> 1), clippingFlags, heightError, radiusError, childrenHeightErrors[i], childrenRadiusErrors[i] };
+            if (deferredPatches != nullptr && child.level == LandscapeSubdivisionDetails::PARALLEL_LEVEL)
+            {
+                deferredPatches->push_back(child);
+            }
+            else
+            {
+                terminatedCount += SubdividePatch(child, deferredPatches);
+            }
+        }
+
+        return terminatedCount;
+    }
+    else
+    {
+        float32 heightError0 = patchSubdivision.heightError0;
+        float32 radiusError0 = patchSubdivision.radiusError0;
+
+        if (calculateMorph)
+        {
+            float32 radiusError0Rel = Max(radiusError0, maxPatchRadiusError) / maxPatchRadiusError;
+            float32 radiusErrorRel = Min(radiusError, maxPatchRadiusError) / maxPatchRadiusError;
+
+            float32 heightError0Rel = Max(heightError0, maxHeightError) / maxHeightError;
+            float32 heightErrorRel = Min(heightError, maxHeightError) / maxHeightError;
+
+            float32 error0Delta = Max(radiusError0Rel, heightError0Rel) - 1.f;
+            float32 errorDelta = 1.f - Max(radiusErrorRel, heightErrorRel);
+
+            subdivPatchInfo->subdivMorph = 1.f - errorDelta / (error0Delta + errorDelta);
+        }
+
+        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::TERMINATED;
+
+        return 1;
+    }
+}
+
+void LandscapeSubdivision::CalculatePatchErrors(const PatchQuadInfo& patch, float32& heightError, float32& radiusError) const
+{
     ////////////////////////////////////////////////////////////////////////////////////
 
     //Metrics errors we calculate as projection on screen
@@ -248,45 +367,56 @@ void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint
     // So, screen space error = error / (D * tg(fov/2))
     // tg(fov/2) calculating one per-frame, see 'tanFovY' in PrepareSubdivision()
 
-    float32 distance = Distance(cameraPos, patch->positionOfMaxError);
-    float32 heightError = Abs(patch->maxError) / (distance * tanFovY);
+    float32 distance = Distance(cameraPos, patch.positionOfMaxError);
+    heightError = Abs(patch.maxError) / (distance * tanFovY);
 
-    Vector3 patchOrigin = patch->bbox.GetCenter();
+    Vector3 patchOrigin = patch.bbox.GetCenter();
     float32 patchDistance = Distance(cameraPos, patchOrigin);
-    float32 radiusError = patch->radius / (patchDistance * tanFovY);
+    radiusError = patch.radius / (patchDistance * tanFovY);
+}
 
-    if ((level < subdivLevelCount - 1) && ((maxPatchRadiusError <= radiusError) || (maxHeightError <= heightError) || (maxAbsoluteHeightError < Abs(patch->maxError)) || (minSubdivLevel > level) || forceMaxSubdiv))
+void LandscapeSubdivision::CalculateChildrenErrors(uint32 level, uint32 x2, uint32 y2, float32* heightErrors, float32* radiusErrors) const
+{
+    //the same as CalculatePatchErrors(), but for four children at once
+    alignas(16) float32 errorX[4], errorY[4], errorZ[4], errorValue[4];
+    alignas(16) float32 originX[4], originY[4], originZ[4], radius[4];
+    for (uint32 i = 0; i < 4; ++i)
     {
-        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::SUBDIVIDED;
-
-        uint32 x2 = x << 1;
-        uint32 y2 = y << 1;
-
-        SubdividePatch(level + 1, x2 + 0, y2 + 0, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 1, y2 + 0, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 0, y2 + 1, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 1, y2 + 1, clippingFlags, heightError, radiusError);
+        const PatchQuadInfo& patch = GetPatchQuadInfo(level, x2 + (i & 1), y2 + (i >> 1));
+        errorX[i] = patch.positionOfMaxError.x - cameraPos.x;
+        errorY[i] = patch.positionOfMaxError.y - cameraPos.y;
+        errorZ[i] = patch.positionOfMaxError.z - cameraPos.z;
+        errorValue[i] = Abs(patch.maxError);
+
+        Vector3 patchOrigin = patch.bbox.GetCenter();
+        originX[i] = patchOrigin.x - cameraPos.x;
+        originY[i] = patchOrigin.y - cameraPos.y;
+        originZ[i] = patchOrigin.z - cameraPos.z;
+        radius[i] = patch.radius;
     }
-    else
-    {
-        if (calculateMorph)
-        {
-            float32 radiusError0Rel = Max(radiusError0, maxPatchRadiusError) / maxPatchRadiusError;
-            float32 radiusErrorRel = Min(radiusError, maxPatchRadiusError) / maxPatchRadiusError;
 
-            float32 heightError0Rel = Max(heightError0, maxHeightError) / maxHeightError;
-            float32 heightErrorRel = Min(heightError, maxHeightError) / maxHeightError;
+#if defined(DAVA_SIMD) && defined(DAVA_SIMD_SQRT) && defined(DAVA_SIMD_DIV)
+    using namespace SIMD;
 
-            float32 error0Delta = Max(radiusError0Rel, heightError0Rel) - 1.f;
-            float32 errorDelta = 1.f - Max(radiusErrorRel, heightErrorRel);
+    Float4 tanFov = Splat(tanFovY);
 
-            subdivPatchInfo->subdivMorph = 1.f - errorDelta / (error0Delta + errorDelta);
-        }
+    Float4 ex = Load(errorX), ey = Load(errorY), ez = Load(errorZ);
+    Float4 distance = Sqrt(Add(Add(Mul(ex, ex), Mul(ey, ey)), Mul(ez, ez)));
+    Store(heightErrors, Div(Load(errorValue), Mul(distance, tanFov)));
 
-        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::TERMINATED;
+    Float4 ox = Load(originX), oy = Load(originY), oz = Load(originZ);
+    Float4 patchDistance = Sqrt(Add(Add(Mul(ox, ox), Mul(oy, oy)), Mul(oz, oz)));
+    Store(radiusErrors, Div(Load(radius), Mul(patchDistance, tanFov)));
+#else
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        float32 distance = std::sqrt(errorX[i] * errorX[i] + errorY[i] * errorY[i] + errorZ[i] * errorZ[i]);
+        heightErrors[i] = errorValue[i] / (distance * tanFovY);
 
-        terminatedPatchesCount++;
+        float32 patchDistance = std::sqrt(originX[i] * originX[i] + originY[i] * originY[i] + originZ[i] * originZ[i]);
+        radiusErrors[i] = radius[i] / (patchDistance * tanFovY);
     }
+#endif
 }
 
 const LandscapeSubdivision::SubdivisionPatchInfo* LandscapeSubdivision::GetTerminatedPatchInfo(uint32 level, uint32 x, uint32 y, uint32& patchLevel) const
@@ -84,8 +84,24 @@ private:
         float32 radius;
     };
 
+    struct PatchSubdivision
+    {
+        uint32 level;
+        uint32 x;
+        uint32 y;
+        uint8 clippingFlags;
+        float32 heightError0; //errors of parent patch
+        float32 radiusError0;
+        float32 heightError;
+        float32 radiusError;
+    };
+
     void UpdatePatchInfo(uint32 level, uint32 x, uint32 y, PatchQuadInfo* parentPatch, const Rect2i& updateRect);
-    void SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0);
+
+    /** Returns count of terminated patches. If `deferredPatches` is set, patches of parallel level are put there instead of processing. */
+    uint32 SubdividePatch(const PatchSubdivision& patchSubdivision, Vector<PatchSubdivision>* deferredPatches);
+    void CalculatePatchErrors(const PatchQuadInfo& patch, float32& heightError, float32& radiusError) const;
+    void CalculateChildrenErrors(uint32 level, uint32 x2, uint32 y2, float32* heightErrors, float32* radiusErrors) const;
 
     const PatchQuadInfo& GetPatchQuadInfo(uint32 level, uint32 x, uint32 y) const;
 
@@ -94,6 +110,9 @@ private:
     Vector<SubdivisionPatchInfo> subdivPatchArray;
     uint32 terminatedPatchesCount = 0;
 
+    Vector<PatchSubdivision> deferredPatches;
+    Vector<uint32> deferredTerminatedCounts;
+
     uint32 minSubdivLevel = 0;
     uint32 subdivLevelCount = 0;
     uint32 subdivPatchCount = 0;
@@ -109,6 +128,10 @@ private:
     Vector3 cameraPos;
     float32 tanFovY = 0.f;
 
+    //subdivision is kept while camera and metrics are the same
+    Matrix4 subdivisionViewProjMatrix;
+    bool subdivisionValid = false;
+
     Frustum* frustum = nullptr;
     Heightmap* heightmap = nullptr;
 
@@ -144,6 +167,7 @@ inline const LandscapeSubdivision::PatchQuadInfo& LandscapeSubdivision::GetPatch
 
 inline void LandscapeSubdivision::SetForceMaxSubdivision(bool forceSubdivide)
 {
+    subdivisionValid &= (forceMaxSubdiv == forceSubdivide);
     forceMaxSubdiv = forceSubdivide;
 }
 
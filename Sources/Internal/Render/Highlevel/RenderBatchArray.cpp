@@ -4,6 +4,23 @@
 
 namespace DAVA
 {
+namespace RenderBatchArrayDetails
+{
+const uint32 RADIX_SORT_MIN_COUNT = 64;
+const uint32 RADIX_DIGITS_COUNT = sizeof(uint64);
+const uint32 RADIX_DIGIT_VALUES = 256;
+
+const uint64 BATCH_SORTING_KEY_SHIFT = 60;
+const uint64 MATERIAL_KEY_SHIFT = 28;
+const uint64 MATERIAL_DISTANCE_MASK = 0x0fffffff;
+const uint64 DISTANCE_MASK = 0x0fffffffffffffff;
+
+inline uint64 ClampDistance(float32 distance, uint64 mask)
+{
+    return (distance < static_cast<float32>(mask)) ? static_cast<uint64>(distance) : mask;
+}
+}
+
 RenderBatchArray::RenderBatchArray()
     : sortFlags(0)
 {
@@ -11,75 +28,198 @@ RenderBatchArray::RenderBatchArray()
     //renderBatchArray.reserve(4096);
 }
 
-bool RenderBatchArray::MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b)
+void RenderBatchArray::PrepareSorting(Camera* camera)
 {
-    return a->layerSortingKey > b->layerSortingKey;
+    if ((sortFlags & SORT_ENABLED) == 0)
+    {
+        return;
+    }
+
+    sortingCamera = camera;
+    cameraPosition = camera->GetPosition();
+    cameraDirection = camera->GetDirection();
 }
 
-void RenderBatchArray::Sort(Camera* camera)
+uint64 RenderBatchArray::ComputeSortingKey(RenderBatch* batch) const
 {
-    // Need sort
-    sortFlags |= SORT_REQUIRED;
+    using namespace RenderBatchArrayDetails;
 
-    if ((sortFlags & SORT_THIS_FRAME) == SORT_THIS_FRAME)
+    uint64 key = uint64(batch->GetSortingKey()) << BATCH_SORTING_KEY_SHIFT;
+    RenderObject* renderObject = batch->GetRenderObject();
+
+    if (sortFlags & SORT_BY_MATERIAL)
     {
-        if (sortFlags & SORT_BY_MATERIAL)
-        {
-            //Vector3 cameraPosition = camera->GetPosition();
+        //sorting key has the following layout: (s:4)(m:32)(d:28), batches with the same material are drawn from front to back
+        Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
+        uint64 distance = ClampDistance((position - cameraPosition).Length() * 100.0f, MATERIAL_DISTANCE_MASK);
+        key |= (uint64(batch->GetMaterial()->GetSortingKey()) << MATERIAL_KEY_SHIFT) | (MATERIAL_DISTANCE_MASK - distance);
+    }
+    else if (sortFlags & SORT_BY_DISTANCE_BACK_TO_FRONT)
+    {
+        //sorting key has the following layout: (s:4)(d:60)
+        Vector3 delta = renderObject->GetWorldMatrixPtr()->GetTranslationVector() - cameraPosition;
+        uint64 distance = delta.DotProduct(cameraDirection) < 0 ? 0 : ClampDistance(delta.Length() * 1000.0f, DISTANCE_MASK - 31); //x1000.0f is to prevent resorting of nearby objects
+        key |= distance + 31 - batch->GetSortingOffset();
+    }
+    else if (sortFlags & SORT_BY_DISTANCE_FRONT_TO_BACK)
+    {
+        Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
+        uint64 distance = ClampDistance((position - cameraPosition).Length() * 100.0f, DISTANCE_MASK - 31) + 31 - batch->GetSortingOffset();
+        key |= DISTANCE_MASK - distance;
+    }
 
-            for (RenderBatch* batch : renderBatchArray)
-            {
-                //pointer_size renderObjectId = (pointer_size)batch->GetRenderObject();
-                //RenderObject * renderObject = batch->GetRenderObject();
-                //Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
-                //float32 distance = (position - cameraPosition).Length();
-                //uint32 distanceBits = (0xFFFF - ((uint32)distance) & 0xFFFF);
-                uint32 materialIndex = batch->GetMaterial()->GetSortingKey();
-                //VI: sorting key has the following layout: (m:8)(s:4)(d:20)
-                //batch->layerSortingKey = (pointer_size)((materialIndex << 20) | (batch->GetSortingKey() << 28) | (distanceBits));
-                batch->layerSortingKey = static_cast<pointer_size>((materialIndex & 0x0FFFFFFF) | (batch->GetSortingKey() << 28));
-                //batch->layerSortingKey = (pointer_size)((batch->GetMaterial()->GetSortingKey() << 20) | (batch->GetSortingKey() << 28) | (renderObjectId & 0x000FFFFF));
-            }
+    return key;
+}
+
+void RenderBatchArray::AddSortItem(RenderBatch* batch)
+{
+    SortItem item;
+    item.key = ~ComputeSortingKey(batch); // batches with greater keys are drawn first
+    item.index = static_cast<uint32>(sortItems.size());
+    sortItems.push_back(item);
+}
+
+void RenderBatchArray::SortItems()
+{
+    using namespace RenderBatchArrayDetails;
+
+    size_t count = sortItems.size();
+    if (count < RADIX_SORT_MIN_COUNT)
+    {
+        std::stable_sort(sortItems.begin(), sortItems.end(), [](const SortItem& a, const SortItem& b) {
+            return a.key < b.key;
+        });
+        return;
+    }
+
+    // LSD radix sort by bytes, histograms of all digits are collected in one pass
+    uint32 histograms[RADIX_DIGITS_COUNT][RADIX_DIGIT_VALUES] = {};
+    for (const SortItem& item : sortItems)
+    {
+        for (uint32 digit = 0; digit < RADIX_DIGITS_COUNT; ++digit)
+        {
+            ++histograms[digit][(item.key >> (digit * 8)) & 0xff];
+        }
+    }
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+    sortItemsBuffer.resize(count);
+    SortItem* src = sortItems.data();
+    SortItem* dst = sortItemsBuffer.data();
+    for (uint32 digit = 0; digit < RADIX_DIGITS_COUNT; ++digit)
+    {
+        uint32 shift = digit * 8;
+        uint32* histogram = histograms[digit];
+        if (histogram[(src[0].key >> shift) & 0xff] == count)
+        {
+            continue; // all keys have the same digit, e.g. high bytes of distance
+        }
 
-            sortFlags &= ~SORT_REQUIRED;
+        uint32 offset = 0;
+        for (uint32 value = 0; value < RADIX_DIGIT_VALUES; ++value)
+        {
+            uint32 valueCount = histogram[value];
+            histogram[value] = offset;
+            offset += valueCount;
         }
-        else if (sortFlags & SORT_BY_DISTANCE_BACK_TO_FRONT)
+
+        for (size_t i = 0; i < count; ++i)
         {
-            Vector3 cameraPosition = camera->GetPosition();
-            Vector3 cameraDirection = camera->GetDirection();
+            dst[histogram[(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != sortItems.data())
+    {
+        sortItems.swap(sortItemsBuffer);
+    }
+}
+
+bool RenderBatchArray::SortItemsIncrementally()
+{
+    // the same batches as in previous sort, so their previous order is almost sorted if only distances changed slightly
+    size_t count = sortItems.size();
+    if (lastSortedOrder.size() != count || lastAddedBatches != renderBatchArray)
+    {
+        return false;
+    }
 
-            for (RenderBatch* batch : renderBatchArray)
+    sortItemsBuffer.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        sortItemsBuffer[i] = sortItems[lastSortedOrder[i]];
+    }
+
+    // insertion sort, fall back to full sort when order changed too much
+    size_t movesLeft = count;
+    for (size_t i = 1; i < count; ++i)
+    {
+        SortItem item = sortItemsBuffer[i];
+        size_t j = i;
+        while (j > 0 && item.key < sortItemsBuffer[j - 1].key)
+        {
+            if (movesLeft == 0)
             {
-                Vector3 delta = batch->GetRenderObject()->GetWorldMatrixPtr()->GetTranslationVector() - cameraPosition;
-                uint32 distance = delta.DotProduct(cameraDirection) < 0 ? 0 : (static_cast<uint32>(delta.Length() * 1000.0f)); //x1000.0f is to prevent resorting of nearby objects (still 26 km range)
-                distance = distance + 31 - batch->GetSortingOffset();
-                batch->layerSortingKey = (distance & 0x0fffffff) | (batch->GetSortingKey() << 28);
+                return false;
             }
+            --movesLeft;
 
-            std::stable_sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
-
-            sortFlags |= SORT_REQUIRED;
+            sortItemsBuffer[j] = sortItemsBuffer[j - 1];
+            --j;
         }
-        else if (sortFlags & SORT_BY_DISTANCE_FRONT_TO_BACK)
-        {
-            Vector3 cameraPosition = camera->GetPosition();
+        sortItemsBuffer[j] = item;
+    }
 
-            for (RenderBatch* batch : renderBatchArray)
-            {
-                RenderObject* renderObject = batch->GetRenderObject();
-                Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
-                uint32 distance = static_cast<uint32>((position - cameraPosition).Length() * 100.0f) + 31 - batch->GetSortingOffset();
-                uint32 distanceBits = 0x0fffffff - distance & 0x0fffffff;
+    sortItems.swap(sortItemsBuffer);
+    return true;
+}
 
-                batch->layerSortingKey = distanceBits | (batch->GetSortingKey() << 28);
-            }
+void RenderBatchArray::Sort(Camera* camera)
+{
+    // Need sort
+    sortFlags |= SORT_REQUIRED;
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+    uint32 sortingMode = sortFlags & (SORT_BY_MATERIAL | SORT_BY_DISTANCE_BACK_TO_FRONT | SORT_BY_DISTANCE_FRONT_TO_BACK);
+    if ((sortFlags & SORT_THIS_FRAME) != SORT_THIS_FRAME || sortingMode == 0)
+    {
+        return;
+    }
 
-            sortFlags |= SORT_REQUIRED;
+    // keys were not computed while batches were added
+    if (sortingCamera != camera || sortItems.size() != renderBatchArray.size())
+    {
+        sortItems.clear();
+        PrepareSorting(camera);
+        for (RenderBatch* batch : renderBatchArray)
+        {
+            AddSortItem(batch);
         }
     }
+
+    if (!SortItemsIncrementally())
+    {
+        SortItems();
+    }
+
+    size_t count = renderBatchArray.size();
+    lastAddedBatches = renderBatchArray;
+    lastSortedOrder.resize(count);
+    sortedBatchesBuffer.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32 index = sortItems[i].index;
+        lastSortedOrder[i] = index;
+        sortedBatchesBuffer[i] = renderBatchArray[index];
+    }
+    renderBatchArray.swap(sortedBatchesBuffer);
+
+    // keys refer to adding order, so they are not valid for sorted array
+    sortItems.clear();
+    sortingCamera = nullptr;
+
+    if (sortFlags & SORT_BY_MATERIAL)
+    {
+        sortFlags &= ~SORT_REQUIRED;
+    }
 }
 };
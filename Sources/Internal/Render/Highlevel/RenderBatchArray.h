@@ -29,23 +29,56 @@ public:
     inline uint32 GetRenderBatchCount() const;
     inline RenderBatch* Get(uint32 index) const;
 
+    /**
+        Compute sorting keys of batches added after this call for given camera, while batches data is still in cache.
+        Batches added without prepared camera get their keys in `Sort`.
+    */
+    void PrepareSorting(Camera* camera);
     void Sort(Camera* camera);
     inline void SetSortingFlags(uint32 flags);
 
 private:
+    /** Packed sorting key with index of batch in adding order. Keys are inverted so that ascending order is the drawing order. */
+    struct SortItem
+    {
+        uint64 key;
+        uint32 index;
+    };
+
+    uint64 ComputeSortingKey(RenderBatch* batch) const;
+    void AddSortItem(RenderBatch* batch);
+    void SortItems();
+    bool SortItemsIncrementally();
+
     Vector<RenderBatch*> renderBatchArray;
+    Vector<SortItem> sortItems;
+    Vector<SortItem> sortItemsBuffer;
+    Vector<RenderBatch*> sortedBatchesBuffer;
+
+    // batches in adding order and resulting order of previous sort, used to re-sort almost sorted array
+    Vector<RenderBatch*> lastAddedBatches;
+    Vector<uint32> lastSortedOrder;
+
+    Camera* sortingCamera = nullptr;
+    Vector3 cameraPosition;
+    Vector3 cameraDirection;
     uint32 sortFlags;
-    static bool MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b);
 };
 
 inline void RenderBatchArray::Clear()
 {
     renderBatchArray.clear();
+    sortItems.clear();
+    sortingCamera = nullptr;
 }
 
 inline void RenderBatchArray::AddRenderBatch(RenderBatch* batch)
 {
     renderBatchArray.push_back(batch);
+    if (sortingCamera != nullptr)
+    {
+        AddSortItem(batch);
+    }
 }
 
 inline void RenderBatchArray::SetSortingFlags(uint32 _flags)
@@ -129,6 +129,11 @@ void RenderPass::PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSys
 
 void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera)
 {
+    for (RenderBatchArray& batchArray : layersBatchArrays)
+    {
+        batchArray.PrepareSorting(camera);
+    }
+
     size_t size = objectsArray.size();
     for (size_t ro = 0; ro < size; ++ro)
     {
@@ -4,6 +4,9 @@
 #include "Render/Highlevel/GeometryOctTree.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/RenderHelper.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
@@ -439,7 +442,7 @@ void QuadTree::ObjectUpdated(RenderObject* renderObject)
     } while (sizeUpdeted && (currIndex != INVALID_TREE_NODE_INDEX));
 }
 
-void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
+bool QuadTree::ProcessNodeObjectsClipping(uint16 nodeId, uint8& clippingFlags, Vector<RenderObject*>& visibilityArray)
 {
     QuadTreeNode& currNode = nodes[nodeId];
     int32 objectsSize = static_cast<int32>(currNode.objects.size());
@@ -449,7 +452,7 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     {
         uint8 startClipPlane = (currNode.nodeInfo & QuadTreeNode::START_CLIP_PLANE_MASK) >> QuadTreeNode::START_CLIP_PLANE_OFFSET;
         if (currFrustum->Classify(currNode.bbox, clippingFlags, startClipPlane) == Frustum::EFR_OUTSIDE)
-            return; //node box is outside - return
+            return false; //node box is outside - return
         currNode.nodeInfo &= ~QuadTreeNode::START_CLIP_PLANE_MASK;
         currNode.nodeInfo |= (uint16(startClipPlane)) << QuadTreeNode::START_CLIP_PLANE_OFFSET;
     }
@@ -463,9 +466,6 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
             if ((flags & currVisibilityCriteria) == currVisibilityCriteria)
             {
                 visibilityArray.push_back(obj);
-#if defined(__DAVAENGINE_RENDERSTATS__)
-                ++Renderer::GetRenderStats().visibleRenderObjects;
-#endif
             }
         }
     }
@@ -481,15 +481,21 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
                     || currFrustum->IsInside(obj->GetWorldBoundingBox(), clippingFlags, obj->startClippingPlane))
                 {
                     visibilityArray.push_back(obj);
-#if defined(__DAVAENGINE_RENDERSTATS__)
-                    ++Renderer::GetRenderStats().visibleRenderObjects;
-#endif
                 }
             }
         }
     }
 
+    return true;
+}
+
+void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
+{
+    if (!ProcessNodeObjectsClipping(nodeId, clippingFlags, visibilityArray))
+        return;
+
     //process children
+    const QuadTreeNode& currNode = nodes[nodeId];
     for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
     {
         uint16 childNodeId = currNode.children[i];
@@ -500,13 +506,111 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     }
 }
 
+QuadTree::ClippingSubtree& QuadTree::AddClippingSubtree(uint16 nodeId, uint8 clippingFlags)
+{
+    if (clippingSubtreesCount == clippingSubtrees.size())
+    {
+        clippingSubtrees.emplace_back();
+    }
+
+    ClippingSubtree& subtree = clippingSubtrees[clippingSubtreesCount++];
+    subtree.nodeId = nodeId;
+    subtree.clippingFlags = clippingFlags;
+    subtree.visibilityArray.clear();
+    return subtree;
+}
+
+void QuadTree::CollectClippingSubtrees(uint16 nodeId, uint8 clippingFlags, uint32 depth)
+{
+    // objects of upper nodes are clipped right here and stored in place, so merged result keeps the order of serial traversal
+    if (clippingSubtreesCount == 0 || clippingSubtrees[clippingSubtreesCount - 1].nodeId != INVALID_TREE_NODE_INDEX)
+    {
+        AddClippingSubtree(INVALID_TREE_NODE_INDEX, 0);
+    }
+
+    if (!ProcessNodeObjectsClipping(nodeId, clippingFlags, clippingSubtrees[clippingSubtreesCount - 1].visibilityArray))
+        return;
+
+    const QuadTreeNode& currNode = nodes[nodeId];
+    for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
+    {
+        uint16 childNodeId = currNode.children[i];
+        if (childNodeId != INVALID_TREE_NODE_INDEX)
+        {
+            if (depth + 1 < PARALLEL_CLIPPING_SPLIT_DEPTH)
+            {
+                CollectClippingSubtrees(childNodeId, clippingFlags, depth + 1);
+            }
+            else
+            {
+                AddClippingSubtree(childNodeId, clippingFlags);
+            }
+        }
+    }
+}
+
+void QuadTree::ProcessParallelClipping(JobManager* jobManager, Vector<RenderObject*>& visibilityArray)
+{
+    clippingSubtreesCount = 0;
+    CollectClippingSubtrees(0, 0x3f, 0);
+
+    // every subtree touches only its own nodes and objects (node clip plane cache, object start clipping plane),
+    // so subtrees can be processed simultaneously without synchronization
+    JobGroup group;
+    for (size_t i = 0; i < clippingSubtreesCount; ++i)
+    {
+        ClippingSubtree& subtree = clippingSubtrees[i];
+        if (subtree.nodeId != INVALID_TREE_NODE_INDEX)
+        {
+            jobManager->CreateWorkerTask([this, &subtree]() {
+                ProcessNodeClipping(subtree.nodeId, subtree.clippingFlags, subtree.visibilityArray);
+            },
+                                         &group);
+        }
+    }
+    jobManager->WaitWorkerGroup(&group);
+
+    for (size_t i = 0; i < clippingSubtreesCount; ++i)
+    {
+        const Vector<RenderObject*>& subtreeVisibilityArray = clippingSubtrees[i].visibilityArray;
+        visibilityArray.insert(visibilityArray.end(), subtreeVisibilityArray.begin(), subtreeVisibilityArray.end());
+    }
+}
+
 void QuadTree::Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria)
 {
     DVASSERT(worldInitialized);
     currCamera = camera;
     currVisibilityCriteria = visibilityCriteria;
     currFrustum = camera->GetFrustum();
-    ProcessNodeClipping(0, 0x3f, visibilityArray);
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+    size_t initialVisibleCount = visibilityArray.size();
+#endif
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (parallelClippingEnabled && (nodes.size() >= PARALLEL_CLIPPING_MIN_NODES) && (nullptr != jobManager) && (jobManager->GetWorkersCount() > 1))
+    {
+        ProcessParallelClipping(jobManager, visibilityArray);
+    }
+    else
+    {
+        ProcessNodeClipping(0, 0x3f, visibilityArray);
+    }
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+    Renderer::GetRenderStats().visibleRenderObjects += static_cast<uint32>(visibilityArray.size() - initialVisibleCount);
+#endif
+}
+
+void QuadTree::SetParallelClippingEnabled(bool enabled)
+{
+    parallelClippingEnabled = enabled;
+}
+
+bool QuadTree::IsParallelClippingEnabled() const
+{
+    return parallelClippingEnabled;
 }
 
 void QuadTree::GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray)
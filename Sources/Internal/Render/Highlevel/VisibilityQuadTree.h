@@ -10,6 +10,7 @@
 namespace DAVA
 {
 class Frustum;
+class JobManager;
 class RenderObject;
 class QuadTree : public RenderHierarchy
 {
@@ -37,6 +38,14 @@ public:
     void Update() override;
     void DebugDraw(const Matrix4& cameraMatrix, RenderHelper* renderHelper) override;
 
+    /**
+        Enable or disable splitting of `Clip` work between job workers.
+        Upper tree levels are clipped on calling thread, deeper subtrees are clipped by worker tasks.
+        Content and order of resulting visibility array do not depend on this setting. Enabled by default.
+    */
+    void SetParallelClippingEnabled(bool enabled);
+    bool IsParallelClippingEnabled() const;
+
     struct QuadTreeNode // still basic implementation - later move it to more compact
     {
         enum eNodeType
@@ -70,7 +79,18 @@ private:
     void UpdateChildBox(AABBox3& parentBox, QuadTreeNode::eNodeType childType);
     void UpdateParentBox(AABBox3& childBox, QuadTreeNode::eNodeType childType);
 
+    struct ClippingSubtree
+    {
+        uint16 nodeId = INVALID_TREE_NODE_INDEX; // INVALID_TREE_NODE_INDEX for objects already clipped on calling thread
+        uint8 clippingFlags = 0;
+        Vector<RenderObject*> visibilityArray;
+    };
+
+    bool ProcessNodeObjectsClipping(uint16 nodeId, uint8& clippingFlags, Vector<RenderObject*>& visibilityArray);
     void ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray);
+    void ProcessParallelClipping(JobManager* jobManager, Vector<RenderObject*>& visibilityArray);
+    void CollectClippingSubtrees(uint16 nodeId, uint8 clippingFlags, uint32 depth);
+    ClippingSubtree& AddClippingSubtree(uint16 nodeId, uint8 clippingFlags);
     void GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray);
     void RecalculateNodeZLimits(uint16 nodeId);
     void MarkNodeDirty(uint16 nodeId);
@@ -83,6 +103,8 @@ private:
 private:
     static const int32 RECALCULATE_Z_PER_FRAME = 10;
     static const int32 RECALCULATE_OBJECTS_PER_FRAME = 10;
+    static const uint32 PARALLEL_CLIPPING_SPLIT_DEPTH = 3; // up to 64 subtrees
+    static const size_t PARALLEL_CLIPPING_MIN_NODES = 256;
 
     Vector<BroadPhaseCollision> broadPhaseCollisions;
     Vector<QuadTreeNode> nodes;
@@ -91,6 +113,8 @@ private:
     List<RenderObject*> dirtyObjects;
     List<RenderObject*> worldInitObjects;
     std::queue<uint16> broadPhaseQueue;
+    Vector<ClippingSubtree> clippingSubtrees; // reused between frames to keep allocated memory
+    size_t clippingSubtreesCount = 0;
 
 #if (DAVA_DEBUG_DRAW_OCTREE)
     UniqueHandle debugDrawStateHandle = InvalidUniqueHandle;
@@ -104,5 +128,6 @@ private:
     uint32 localRayBoxTraceCount = 0;
     bool worldInitialized = false;
     bool preparedForShutdown = false;
+    bool parallelClippingEnabled = true;
 };
 }
@@ -103,6 +103,9 @@ public:
 
     Vector<Image*> CreateMipMapsImages(bool isNormalMap = false);
 
+    // creates mipmaps for several images (e.g. cube faces) in parallel, result for every image is the same as CreateMipMapsImages
+    static Vector<Vector<Image*>> CreateMipMapsImageSets(const Vector<Image*>& images, bool isNormalMap = false);
+
     bool Normalize();
 
     // changes size of image canvas to required size, if new size is bigger, sets 0 to all new pixels
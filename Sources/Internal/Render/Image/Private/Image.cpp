@@ -4,6 +4,8 @@
 #include "Render/Image/ImageConvert.h"
 #include "Render/Image/ImageSystem.h"
 #include "Render/PixelFormatDescriptor.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
@@ -188,10 +190,10 @@ Vector<Image*> Image::CreateMipMapsImages(bool isNormalMap /* = false */)
         if (halfHeight > 1)
             halfHeight >>= 1;
 
+        // every pixel of level is written by downscale, so there is no need to clear it
         Image* halfImage = Image::Create(halfWidth, halfHeight, format);
         halfImage->cubeFaceID = curImage->cubeFaceID;
         halfImage->mipmapLevel = curImage->mipmapLevel + 1;
-        Memset(halfImage->GetData(), 0, halfImage->dataSize);
 
         imageSet.push_back(halfImage);
 
@@ -219,6 +221,32 @@ Vector<Image*> Image::CreateMipMapsImages(bool isNormalMap /* = false */)
     return imageSet;
 }
 
+Vector<Vector<Image*>> Image::CreateMipMapsImageSets(const Vector<Image*>& images, bool isNormalMap /* = false */)
+{
+    Vector<Vector<Image*>> imageSets(images.size());
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (nullptr != jobManager && jobManager->GetWorkersCount() > 0 && images.size() > 1)
+    {
+        // large levels of every image are also downscaled by tiles in worker threads, waiting in worker is allowed
+        JobGroup group;
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            jobManager->CreateWorkerTask([&imageSets, &images, i, isNormalMap]() { imageSets[i] = images[i]->CreateMipMapsImages(isNormalMap); }, &group);
+        }
+        jobManager->WaitWorkerGroup(&group);
+    }
+    else
+    {
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            imageSets[i] = images[i]->CreateMipMapsImages(isNormalMap);
+        }
+    }
+
+    return imageSets;
+}
+
 bool Image::ResizeImage(uint32 newWidth, uint32 newHeight)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
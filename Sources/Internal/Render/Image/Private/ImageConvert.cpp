@@ -3,7 +3,16 @@
 #include "Render/Image/Image.h"
 #include "Engine/Engine.h"
 #include "Functional/Function.h"
+#include "Job/JobManager.h"
 #include "Math/HalfFloat.h"
+#include "Math/SIMD.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DAVA_DOWNSCALE_RGBA8888_SSE2
+#include <emmintrin.h>
+#elif defined(DAVA_SIMD_NEON)
+#define DAVA_DOWNSCALE_RGBA8888_NEON
+#endif
 
 namespace DAVA
 {
@@ -18,6 +27,177 @@ float32 ChannelIntToFloat(uint32 ch)
     return (static_cast<float32>(ch) / std::numeric_limits<uint8>::max());
 }
 
+namespace ImageConvertDetails
+{
+/*
+    Vectorized versions of ConvertDownscaleTwiceBillinear for the most used formats.
+    Results are bit-identical to the scalar template: integer channels are summed without overflow and
+    divided with truncation, float channels are summed in the same order and scaled by exact 0.25.
+*/
+class DownscaleTwiceRGBA8888
+{
+public:
+    void operator()(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                    void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+    {
+        if (inWidth == outWidth || inHeight == outHeight)
+        { // one pixel wide or high levels are too small to bother
+            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
+            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            return;
+        }
+
+        const uint8* readPtr = reinterpret_cast<const uint8*>(inData);
+        uint8* writePtr = reinterpret_cast<uint8*>(outData);
+
+        for (uint32 y = 0; y < outHeight; ++y)
+        {
+            const uint32* readLine0 = reinterpret_cast<const uint32*>(readPtr);
+            const uint32* readLine1 = readLine0 + inWidth;
+            uint32* writeLine = reinterpret_cast<uint32*>(writePtr);
+
+            uint32 x = 0;
+#if defined(DAVA_DOWNSCALE_RGBA8888_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            for (; x + 4 <= outWidth; x += 4)
+            {
+                const __m128i* in0 = reinterpret_cast<const __m128i*>(readLine0 + 2 * x);
+                const __m128i* in1 = reinterpret_cast<const __m128i*>(readLine1 + 2 * x);
+                const __m128i a0 = _mm_loadu_si128(in0);
+                const __m128i a1 = _mm_loadu_si128(in0 + 1);
+                const __m128i b0 = _mm_loadu_si128(in1);
+                const __m128i b1 = _mm_loadu_si128(in1 + 1);
+
+                // vertical sums of 8 input pixels in 16-bit channels, two pixels per register
+                const __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+                const __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+                const __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+                const __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+                // horizontal sums of even and odd pixels give 4 output pixels
+                const __m128i out01 = _mm_add_epi16(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+                const __m128i out23 = _mm_add_epi16(_mm_unpacklo_epi64(s45, s67), _mm_unpackhi_epi64(s45, s67));
+                const __m128i result = _mm_packus_epi16(_mm_srli_epi16(out01, 2), _mm_srli_epi16(out23, 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(writeLine + x), result);
+            }
+#elif defined(DAVA_DOWNSCALE_RGBA8888_NEON)
+            for (; x + 2 <= outWidth; x += 2)
+            {
+                // even and odd input pixels are loaded into separate registers
+                const uint32x2x2_t a = vld2_u32(readLine0 + 2 * x);
+                const uint32x2x2_t b = vld2_u32(readLine1 + 2 * x);
+
+                const uint16x8_t sumA = vaddl_u8(vreinterpret_u8_u32(a.val[0]), vreinterpret_u8_u32(a.val[1]));
+                const uint16x8_t sumB = vaddl_u8(vreinterpret_u8_u32(b.val[0]), vreinterpret_u8_u32(b.val[1]));
+                vst1_u32(writeLine + x, vreinterpret_u32_u8(vshrn_n_u16(vaddq_u16(sumA, sumB), 2)));
+            }
+#endif
+            for (; x < outWidth; ++x)
+            {
+                const uint32 p00 = readLine0[2 * x];
+                const uint32 p01 = readLine0[2 * x + 1];
+                const uint32 p10 = readLine1[2 * x];
+                const uint32 p11 = readLine1[2 * x + 1];
+
+                uint32 result = 0;
+                for (uint32 shift = 0; shift < 32; shift += 8)
+                {
+                    const uint32 sum = ((p00 >> shift) & 0xFF) + ((p01 >> shift) & 0xFF) + ((p10 >> shift) & 0xFF) + ((p11 >> shift) & 0xFF);
+                    result |= (sum / 4) << shift;
+                }
+                writeLine[x] = result;
+            }
+
+            readPtr += inPitch * 2;
+            writePtr += outPitch;
+        }
+    }
+};
+
+class DownscaleTwiceRGBA32F
+{
+public:
+    void operator()(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                    void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+    {
+#if defined(DAVA_SIMD)
+        using namespace SIMD;
+
+        const uint8* readPtr = reinterpret_cast<const uint8*>(inData);
+        uint8* writePtr = reinterpret_cast<uint8*>(outData);
+
+        // one pixel is four floats, so it fits exactly in one vector
+        const uint32 lineStride = (inHeight > outHeight) ? inWidth * 4 : 0;
+        const uint32 pixelStride = (inWidth > outWidth) ? 4 : 0;
+        const Float4 quarter = Splat(0.25f);
+
+        for (uint32 y = 0; y < outHeight; ++y)
+        {
+            const float32* readLine = reinterpret_cast<const float32*>(readPtr);
+            float32* writeLine = reinterpret_cast<float32*>(writePtr);
+
+            for (uint32 x = 0; x < outWidth; ++x)
+            {
+                const Float4 p00 = Load(readLine);
+                const Float4 p01 = Load(readLine + pixelStride);
+                const Float4 p10 = Load(readLine + lineStride);
+                const Float4 p11 = Load(readLine + lineStride + pixelStride);
+                Store(writeLine, Mul(Add(Add(Add(p00, p01), p10), p11), quarter));
+
+                readLine += 8;
+                writeLine += 4;
+            }
+            readPtr += inPitch * 2;
+            writePtr += outPitch;
+        }
+#else
+        ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+#endif
+    }
+};
+
+/*
+    Downscale large images by horizontal tiles in worker threads.
+    Every tile is processed by the same `downscale` functor as a smaller image, so result doesn't depend on tiling.
+*/
+template <typename DOWNSCALE>
+void DownscaleTwiceInTiles(DOWNSCALE downscale,
+                           const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                           void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    const uint32 PARALLEL_MIN_PIXEL_COUNT = 256 * 256;
+    const uint32 TILE_MIN_HEIGHT = 16;
+
+    const uint32 inLinesPerOutLine = (inHeight > outHeight) ? 2 : 1;
+    auto downscaleTile = [=](uint32 firstLine, uint32 lineCount) mutable
+    {
+        downscale(reinterpret_cast<const uint8*>(inData) + firstLine * inLinesPerOutLine * inPitch, inWidth, lineCount * inLinesPerOutLine, inPitch,
+                  reinterpret_cast<uint8*>(outData) + firstLine * outPitch, outWidth, lineCount, outPitch);
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    const uint32 workersCount = (nullptr != jobManager) ? jobManager->GetWorkersCount() : 0;
+    if (workersCount == 0 || outWidth * outHeight < PARALLEL_MIN_PIXEL_COUNT || outHeight < 2 * TILE_MIN_HEIGHT)
+    {
+        downscaleTile(0, outHeight);
+        return;
+    }
+
+    // several tiles per worker to balance load with other tasks, e.g. other cube faces
+    const uint32 tileCount = Min(outHeight / TILE_MIN_HEIGHT, 4 * (workersCount + 1));
+    const uint32 tileHeight = (outHeight + tileCount - 1) / tileCount;
+
+    JobGroup group;
+    for (uint32 firstLine = 0; firstLine < outHeight; firstLine += tileHeight)
+    {
+        const uint32 lineCount = Min(tileHeight, outHeight - firstLine);
+        jobManager->CreateWorkerTask([downscaleTile, firstLine, lineCount]() mutable { downscaleTile(firstLine, lineCount); }, &group);
+    }
+    jobManager->WaitWorkerGroup(&group);
+}
+} // namespace ImageConvertDetails
+
 namespace ImageConvert
 {
 bool Normalize(PixelFormat format, const void* inData, uint32 width, uint32 height, uint32 pitch, void* outData)
@@ -329,58 +509,58 @@ bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
         if (normalize)
         {
             ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         }
         else
         {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            ImageConvertDetails::DownscaleTwiceRGBA8888 convert;
+            ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         }
     }
     else if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA4444))
     {
         ConvertDownscaleTwiceBillinear<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA4444) && (outFormat == FORMAT_RGBA8888))
     {
         ConvertDownscaleTwiceBillinear<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_A8) && (outFormat == FORMAT_A8))
     {
         ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGB888) && (outFormat == FORMAT_RGB888))
     {
         ConvertDownscaleTwiceBillinear<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA5551) && (outFormat == FORMAT_RGBA5551))
     {
         ConvertDownscaleTwiceBillinear<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA16161616) && (outFormat == FORMAT_RGBA16161616))
     {
         ConvertDownscaleTwiceBillinear<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA32323232) && (outFormat == FORMAT_RGBA32323232))
     {
         ConvertDownscaleTwiceBillinear<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA16F) && (outFormat == FORMAT_RGBA16F))
     {
         ConvertDownscaleTwiceBillinear<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA32F) && (outFormat == FORMAT_RGBA32F))
     {
-        ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::DownscaleTwiceRGBA32F convert;
+        ImageConvertDetails::DownscaleTwiceInTiles(convert, inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else
     {
@@ -7,6 +7,7 @@
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Material/FXCache.h"
 #include "Render/Shader.h"
+#include "Render/ShaderCache.h"
 #include "Render/Texture.h"
 
 #include "Utils/Utils.h"
@@ -229,6 +230,10 @@ uint32 NMaterial::GetRequiredVertexFormat()
     uint32 res = 0;
     for (auto& variant : renderVariants)
     {
+        // vertex format is known only after compilation
+        if ((nullptr != variant.second) && variant.second->shader->IsPending())
+            ShaderDescriptorCache::CompletePendingShader(variant.second->shader);
+
         bool shaderValid = (nullptr != variant.second) && (variant.second->shader->IsValid());
         DVASSERT(shaderValid, "Shader is invalid. Check log for details.");
 
@@ -888,10 +893,13 @@ void NMaterial::RebuildBindings()
 {
     InvalidateBufferBindings();
 
+    hasPendingShaders = false;
     for (auto& variant : renderVariants)
     {
         RenderVariantInstance* currRenderVariant = variant.second;
         ShaderDescriptor* currShader = currRenderVariant->shader;
+        currRenderVariant->shaderPending = currShader->IsPending();
+        hasPendingShaders |= currRenderVariant->shaderPending;
         if (!currShader->IsValid()) //cant build for empty shader
             continue;
         currRenderVariant->vertexConstBuffers.resize(currShader->GetVertexConstBuffersCount());
@@ -1068,9 +1076,25 @@ void NMaterial::RebuildTextureBindings()
     needRebuildTextures = false;
 }
 
+void NMaterial::CheckPendingShaders()
+{
+    for (auto& variant : renderVariants)
+    {
+        if (variant.second->shaderPending && !variant.second->shader->IsPending())
+        {
+            needRebuildBindings = true;
+            needRebuildTextures = true;
+            return;
+        }
+    }
+}
+
 bool NMaterial::PreBuildMaterial(const FastName& passName)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+    if (hasPendingShaders)
+        CheckPendingShaders();
+
     //shader rebuild first - as it sets needRebuildBindings and needRebuildTextures
     if (needRebuildVariants)
         RebuildRenderVariants();
@@ -75,6 +75,7 @@ class RenderVariantInstance
     bool wireFrame = false;
     bool alphablend = false;
     bool alphatest = false;
+    bool shaderPending = false; // bindings were not built because shader is still compiling
 
     RenderVariantInstance() = default;
     RenderVariantInstance(const RenderVariantInstance&) = delete;
@@ -202,6 +203,7 @@ private:
     void LoadConfigFromArchive(uint32 configId, KeyedArchive* archive, SerializationContext* serializationContext);
 
     void RebuildBindings();
+    void CheckPendingShaders();
     void RebuildTextureBindings();
     void RebuildRenderVariants();
 
@@ -247,6 +249,7 @@ private:
     bool needRebuildBindings = true;
     bool needRebuildTextures = true;
     bool needRebuildVariants = true;
+    bool hasPendingShaders = false;
 
 public:
     INTROSPECTION(NMaterial,
@@ -1,17 +1,29 @@
     #include "../rhi_ShaderCache.h"
     #include "../rhi_ShaderSource.h"
 
+    #include "Base/TemplateHelpers.h"
+    #include "Concurrency/LockGuard.h"
+    #include "Concurrency/Mutex.h"
+    #include "FileSystem/FileSystem.h"
+    #include "Logger/Logger.h"
+
 namespace rhi
 {
 static ShaderBuilder _ShaderBuilder = nullptr;
 
 struct ProgInfo
 {
-    DAVA::FastName uid;
+    uint32 api = 0;
+    uint32 srcHash = 0;
     std::vector<uint8> bin;
 };
 
-static std::vector<ProgInfo> _ProgInfo;
+//version increment history:
+//1 is initial, entries are uid, api, source hash and binary
+static const uint32 _ProgCacheFormatVersion = 1;
+
+static std::unordered_map<DAVA::FastName, ProgInfo> _ProgInfo;
+static DAVA::Mutex _ProgInfoMutex;
 
 namespace ShaderCache
 {
@@ -27,35 +39,150 @@ bool Initialize(ShaderBuilder builder)
 
 void Unitialize()
 {
+    Clear();
 }
 
 //------------------------------------------------------------------------------
 
 void Clear()
 {
+    DAVA::LockGuard<DAVA::Mutex> guard(_ProgInfoMutex);
+    _ProgInfo.clear();
 }
 
 //------------------------------------------------------------------------------
 
 void Load(const char* binFileName)
 {
+    using namespace DAVA;
+
+    ScopedPtr<File> file(File::Create(binFileName, File::READ | File::OPEN));
+    if (!file)
+        return;
+
+    LockGuard<Mutex> guard(_ProgInfoMutex);
+    _ProgInfo.clear();
+
+    bool success = true;
+    SCOPE_EXIT
+    {
+        if (!success)
+        {
+            _ProgInfo.clear();
+            Logger::Warning("Shader-Cache failed to load, ignoring cached programs");
+        }
+    };
+
+#define READ_CHECK(exp) if (!(exp)) { success = false; return; }
+
+    uint32 formatVersion = 0;
+    READ_CHECK(file->Read(&formatVersion) == sizeof(formatVersion));
+    if (formatVersion != _ProgCacheFormatVersion)
+    {
+        Logger::Warning("Shader-Cache version mismatch, ignoring cached programs");
+        _ProgInfo.clear();
+        return;
+    }
+
+    uint32 progCount = 0;
+    READ_CHECK(file->Read(&progCount) == sizeof(progCount));
+    _ProgInfo.reserve(progCount);
+
+    String uid;
+    for (uint32 i = 0; i != progCount; ++i)
+    {
+        uint32 uidLength = 0;
+        READ_CHECK(file->Read(&uidLength) == sizeof(uidLength));
+        uid.resize(uidLength);
+        READ_CHECK(file->Read(&uid[0], uidLength) == uidLength);
+
+        ProgInfo info;
+        uint32 binSize = 0;
+        READ_CHECK(file->Read(&info.api) == sizeof(info.api));
+        READ_CHECK(file->Read(&info.srcHash) == sizeof(info.srcHash));
+        READ_CHECK(file->Read(&binSize) == sizeof(binSize));
+        info.bin.resize(binSize);
+        READ_CHECK(binSize == 0 || file->Read(info.bin.data(), binSize) == binSize);
+
+        _ProgInfo[FastName(uid)] = std::move(info);
+    }
+
+#undef READ_CHECK
+
+    Logger::Info("loaded cached programs (%u)", progCount);
 }
 
 //------------------------------------------------------------------------------
 
-const std::vector<uint8>& GetProg(const DAVA::FastName& uid)
+void Save(const char* binFileName)
 {
-    static const std::vector<uint8> empty(0);
+    using namespace DAVA;
+
+    static const FilePath cacheTempFile("~doc:/shader_cache_temp.bin");
 
-    for (unsigned i = 0; i != _ProgInfo.size(); ++i)
+    File* file = File::Create(cacheTempFile, File::WRITE | File::CREATE);
+    if (!file)
+        return;
+
+    LockGuard<Mutex> guard(_ProgInfoMutex);
+
+    bool success = true;
+    SCOPE_EXIT
     {
-        if (_ProgInfo[i].uid == uid)
+        SafeRelease(file);
+
+        if (success)
         {
-            return _ProgInfo[i].bin;
+            FileSystem::Instance()->MoveFile(cacheTempFile, binFileName, true);
         }
+        else
+        {
+            FileSystem::Instance()->DeleteFile(cacheTempFile);
+        }
+    };
+
+#define WRITE_CHECK(exp) if (!(exp)) { success = false; return; }
+
+    const uint32 progCount = static_cast<uint32>(_ProgInfo.size());
+    WRITE_CHECK(file->Write(&_ProgCacheFormatVersion) == sizeof(_ProgCacheFormatVersion));
+    WRITE_CHECK(file->Write(&progCount) == sizeof(progCount));
+
+    for (const auto& prog : _ProgInfo)
+    {
+        const uint32 uidLength = static_cast<uint32>(strlen(prog.first.c_str()));
+        const uint32 binSize = static_cast<uint32>(prog.second.bin.size());
+        WRITE_CHECK(file->Write(&uidLength) == sizeof(uidLength));
+        WRITE_CHECK(file->Write(prog.first.c_str(), uidLength) == uidLength);
+        WRITE_CHECK(file->Write(&prog.second.api) == sizeof(prog.second.api));
+        WRITE_CHECK(file->Write(&prog.second.srcHash) == sizeof(prog.second.srcHash));
+        WRITE_CHECK(file->Write(&binSize) == sizeof(binSize));
+        WRITE_CHECK(binSize == 0 || file->Write(prog.second.bin.data(), binSize) == binSize);
     }
 
-    return empty;
+#undef WRITE_CHECK
+
+    Logger::Info("saved cached programs (%u)", progCount);
+}
+
+//------------------------------------------------------------------------------
+
+std::vector<uint8> GetProg(const DAVA::FastName& uid)
+{
+    DAVA::LockGuard<DAVA::Mutex> guard(_ProgInfoMutex);
+
+    // copy is made under lock, program can be updated or cache cleared by other thread right after return
+    auto prog = _ProgInfo.find(uid);
+    return (prog != _ProgInfo.end()) ? prog->second.bin : std::vector<uint8>();
+}
+
+//------------------------------------------------------------------------------
+
+bool HasProg(Api targetApi, const DAVA::FastName& uid, uint32 srcHash)
+{
+    DAVA::LockGuard<DAVA::Mutex> guard(_ProgInfoMutex);
+
+    auto prog = _ProgInfo.find(uid);
+    return (prog != _ProgInfo.end()) && (prog->second.api == uint32(targetApi)) && (prog->second.srcHash == srcHash) && !prog->second.bin.empty();
 }
 
 //------------------------------------------------------------------------------
@@ -876,29 +1003,17 @@ void UpdateProg(Api targetApi, ProgType progType, const DAVA::FastName& uid, con
 
 //------------------------------------------------------------------------------
 
-void UpdateProgBinary(Api targetApi, ProgType progType, const DAVA::FastName& uid, const void* bin, unsigned binSize)
+void UpdateProgBinary(Api targetApi, ProgType progType, const DAVA::FastName& uid, const void* bin, unsigned binSize, uint32 srcHash)
 {
-    std::vector<uint8>* pbin = nullptr;
-
-    for (unsigned i = 0; i != _ProgInfo.size(); ++i)
-    {
-        if (_ProgInfo[i].uid == uid)
-        {
-            pbin = &(_ProgInfo[i].bin);
-            break;
-        }
-    }
+    DAVA::LockGuard<DAVA::Mutex> guard(_ProgInfoMutex);
 
-    if (!pbin)
-    {
-        _ProgInfo.push_back(ProgInfo());
-
-        _ProgInfo.back().uid = uid;
-        pbin = &(_ProgInfo.back().bin);
-    }
+    ProgInfo& prog = _ProgInfo[uid];
+    prog.api = uint32(targetApi);
+    prog.srcHash = srcHash;
 
     //- DAVA::Logger::Info("\n\n--shader  \"%s\"", uid.c_str());
     //- DAVA::Logger::Info((const char*)bin);
+    std::vector<uint8>* pbin = &prog.bin;
     pbin->clear();
     pbin->insert(pbin->begin(), reinterpret_cast<const uint8*>(bin), reinterpret_cast<const uint8*>(bin) + binSize);
     pbin->push_back(0);
@@ -14,10 +14,12 @@ void Unitialize();
 
 void Clear();
 void Load(const char* binFileName);
+void Save(const char* binFileName);
 
-const std::vector<uint8>& GetProg(const DAVA::FastName& uid);
+std::vector<uint8> GetProg(const DAVA::FastName& uid);
+bool HasProg(Api targetApi, const DAVA::FastName& uid, uint32 srcHash);
 void UpdateProg(Api targetApi, ProgType progType, const DAVA::FastName& uid, const char* srcText);
-void UpdateProgBinary(Api targetApi, ProgType progType, const DAVA::FastName& uid, const void* bin, unsigned binSize);
+void UpdateProgBinary(Api targetApi, ProgType progType, const DAVA::FastName& uid, const void* bin, unsigned binSize, uint32 srcHash = 0);
 
 } // namespace ShaderCache
 } // namespace rhi
@@ -42,6 +42,7 @@ class ShaderDescriptor;
 namespace ShaderDescriptorCache
 {
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
+void CompletePendingShader(ShaderDescriptor* shader);
 void ReloadShaders();
 }
 
@@ -84,6 +85,8 @@ public:
     }
 
     bool IsValid();
+    /** Shader is compiled asynchronously and is not valid yet (see `ShaderDescriptorCache::SetAsyncCompilationEnabled`). */
+    bool IsPending() const;
 
 private:
     ShaderDescriptor(rhi::HPipelineState pipelineState, FastName vProgUid, FastName fProgUid);
@@ -107,12 +110,14 @@ private:
     rhi::ShaderSamplerList vertexSamplerList;
 
     bool valid;
+    bool pending = false;
 
     //for storing and further debug simplification
     FastName sourceName;
     UnorderedMap<FastName, int32> defines;
 
     friend ShaderDescriptor* ShaderDescriptorCache::GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
+    friend void ShaderDescriptorCache::CompletePendingShader(ShaderDescriptor* shader);
     friend void ShaderDescriptorCache::ReloadShaders();
 };
 
@@ -120,6 +125,11 @@ inline bool ShaderDescriptor::IsValid()
 {
     return valid;
 }
+
+inline bool ShaderDescriptor::IsPending() const
+{
+    return pending;
+}
 };
 
 #endif // __DAVAENGINE_SHADER_H__
@@ -2,6 +2,9 @@
 #include "Render/RHI/rhi_ShaderCache.h"
 #include "FileSystem/FileSystem.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/ManualResetEvent.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 #include "Logger/Logger.h"
 #include "Utils/StringFormat.h"
 #include "Render/RHI/rhi_ShaderSource.h"
@@ -26,10 +29,22 @@ struct ShaderSourceCode
 
 namespace
 {
+/** Shader which sources are being constructed, descriptor stays invalid until `CompletePendingShader`. */
+struct PendingShader
+{
+    ShaderSourceCode sourceCode;
+    Vector<String> progDefines;
+    ManualResetEvent sourcesReady{ false };
+    bool isCachedShader = false;
+};
+
 Map<Vector<size_t>, ShaderDescriptor*> shaderDescriptors;
 Map<FastName, ShaderSourceCode> shaderSourceCodes;
-Mutex shaderCacheMutex;
+UnorderedMap<ShaderDescriptor*, std::shared_ptr<PendingShader>> pendingShaders;
+RecursiveMutex shaderCacheMutex;
+Mutex shaderCompileMutex;
 bool loadingNotifyEnabled = false;
+bool asyncCompilationEnabled = false;
 bool initialized = false;
 }
 
@@ -42,6 +57,15 @@ void Initialize()
 void Uninitialize()
 {
     DVASSERT(initialized);
+    {
+        // wait for worker jobs, they reference pending shaders data
+        LockGuard<RecursiveMutex> guard(shaderCacheMutex);
+        for (auto& pending : pendingShaders)
+        {
+            pending.second->sourcesReady.Wait();
+        }
+        pendingShaders.clear();
+    }
     Clear();
     initialized = false;
 }
@@ -49,7 +73,7 @@ void Uninitialize()
 void Clear()
 {
     DVASSERT(initialized);
-    LockGuard<Mutex> guard(shaderCacheMutex);
+    LockGuard<RecursiveMutex> guard(shaderCacheMutex);
     shaderSourceCodes.clear();
 }
 
@@ -57,7 +81,7 @@ void ClearDynamicBindigs()
 {
     DVASSERT(initialized);
 
-    LockGuard<Mutex> guard(shaderCacheMutex);
+    LockGuard<RecursiveMutex> guard(shaderCacheMutex);
 
     for (auto& it : shaderDescriptors)
     {
@@ -179,6 +203,11 @@ void SetLoadingNotifyEnabled(bool enable)
     loadingNotifyEnabled = enable;
 }
 
+void SetAsyncCompilationEnabled(bool enable)
+{
+    asyncCompilationEnabled = enable;
+}
+
 
 #define DUMP_SOURCES 0
 #define TRACE_CACHE_USAGE 0
@@ -189,11 +218,37 @@ void SetLoadingNotifyEnabled(bool enable)
 #define LOG_TRACE_USAGE(...)
 #endif
 
+void CompileShaderSources(const FastName& vProgUid, const FastName& fProgUid, const ShaderSourceCode& sourceCode, const Vector<String>& progDefines)
+{
+    // shader parser and include files cache are shared, so sources are constructed one by one
+    LockGuard<Mutex> compileGuard(shaderCompileMutex);
+
+    rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), progDefines);
+    rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), progDefines);
+}
+
+void UpdateProgBinaries(const FastName& vProgUid, const FastName& fProgUid, const rhi::ShaderSource* vSource, const rhi::ShaderSource* fSource, const ShaderSourceCode& sourceCode, bool forceUpdate)
+{
+    rhi::Api api = rhi::HostApi();
+    LockGuard<Mutex> compileGuard(shaderCompileMutex);
+
+    if (forceUpdate || !rhi::ShaderCache::HasProg(api, vProgUid, sourceCode.vSrcHash))
+    {
+        const std::string& vpBin = vSource->GetSourceCode(api);
+        rhi::ShaderCache::UpdateProgBinary(api, rhi::PROG_VERTEX, vProgUid, vpBin.c_str(), unsigned(vpBin.length()), sourceCode.vSrcHash);
+    }
+    if (forceUpdate || !rhi::ShaderCache::HasProg(api, fProgUid, sourceCode.fSrcHash))
+    {
+        const std::string& fpBin = fSource->GetSourceCode(api);
+        rhi::ShaderCache::UpdateProgBinary(api, rhi::PROG_FRAGMENT, fProgUid, fpBin.c_str(), unsigned(fpBin.length()), sourceCode.fSrcHash);
+    }
+}
+
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
 {
     DVASSERT(initialized);
 
-    LockGuard<Mutex> guard(shaderCacheMutex);
+    LockGuard<RecursiveMutex> guard(shaderCacheMutex);
 
     Vector<size_t> key = BuildFlagsKey(name, defines);
 
@@ -202,7 +257,8 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
         return descriptorIt->second;
 
     //not found - create new shader
-    Vector<String> progDefines;
+    std::shared_ptr<PendingShader> pending = std::make_shared<PendingShader>();
+    Vector<String>& progDefines = pending->progDefines;
     progDefines.reserve(defines.size() * 2);
     String resName(name.c_str());
     resName += "  defines: ";
@@ -240,27 +296,68 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     vProgUid = FastName(String("vSource: ") + resName);
     fProgUid = FastName(String("fSource: ") + resName);
 
-    ShaderSourceCode sourceCode = GetSourceCode(name);
-    const uint32 vSrcHash = HashValue_N(sourceCode.vertexProgText.data(), static_cast<uint32>(strlen(sourceCode.vertexProgText.data())));
-    const uint32 fSrcHash = HashValue_N(sourceCode.fragmentProgText.data(), static_cast<uint32>(strlen(sourceCode.fragmentProgText.data())));
+    pending->sourceCode = GetSourceCode(name);
+    const ShaderSourceCode& sourceCode = pending->sourceCode;
 
-    const rhi::ShaderSource* vSource = rhi::ShaderSourceCache::Get(vProgUid, vSrcHash);
-    const rhi::ShaderSource* fSource = rhi::ShaderSourceCache::Get(fProgUid, fSrcHash);
+    ShaderDescriptor* res = new ShaderDescriptor(rhi::HPipelineState(rhi::InvalidHandle), vProgUid, fProgUid);
+    res->sourceName = name;
+    res->defines = defines;
+    res->valid = false;
+    res->pending = true;
+    shaderDescriptors[key] = res;
+    pendingShaders[res] = pending;
 
-    bool isCachedShader = false;
+    const rhi::ShaderSource* vSource = rhi::ShaderSourceCache::Get(vProgUid, sourceCode.vSrcHash);
+    const rhi::ShaderSource* fSource = rhi::ShaderSourceCache::Get(fProgUid, sourceCode.fSrcHash);
 
-    if (!vSource || !fSource)
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (vSource && fSource)
     {
-        LOG_TRACE_USAGE("building \"%s\"", vProgUid.c_str());
-        vSource = rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), progDefines);
-        fSource = rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), progDefines);
+        LOG_TRACE_USAGE("using cached \"%s\"", vProgUid.c_str());
+        pending->isCachedShader = true;
+    }
+    else if (asyncCompilationEnabled && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        LOG_TRACE_USAGE("building async \"%s\"", vProgUid.c_str());
+        jobManager->CreateWorkerJob([res, pending, vProgUid, fProgUid]() {
+            CompileShaderSources(vProgUid, fProgUid, pending->sourceCode, pending->progDefines);
+            pending->sourcesReady.Signal();
+
+            GetEngineContext()->jobManager->CreateMainJob([res]() { CompletePendingShader(res); }, JobManager::JOB_MAINLAZY);
+        });
+        return res;
     }
     else
     {
-        LOG_TRACE_USAGE("using cached \"%s\"", vProgUid.c_str());
-        isCachedShader = true;
+        LOG_TRACE_USAGE("building \"%s\"", vProgUid.c_str());
+        CompileShaderSources(vProgUid, fProgUid, sourceCode, progDefines);
     }
 
+    pending->sourcesReady.Signal();
+    CompletePendingShader(res);
+    return res;
+}
+
+void CompletePendingShader(ShaderDescriptor* shader)
+{
+    LockGuard<RecursiveMutex> guard(shaderCacheMutex);
+
+    auto pendingIt = pendingShaders.find(shader);
+    if (pendingIt == pendingShaders.end())
+        return;
+
+    std::shared_ptr<PendingShader> pending = pendingIt->second;
+    pendingShaders.erase(pendingIt);
+    pending->sourcesReady.Wait();
+    shader->pending = false;
+
+    const FastName& vProgUid = shader->vProgUid;
+    const FastName& fProgUid = shader->fProgUid;
+    const ShaderSourceCode& sourceCode = pending->sourceCode;
+
+    const rhi::ShaderSource* vSource = rhi::ShaderSourceCache::Get(vProgUid, sourceCode.vSrcHash);
+    const rhi::ShaderSource* fSource = rhi::ShaderSourceCache::Get(fProgUid, sourceCode.fSrcHash);
+
     if (!vSource || !fSource)
     {
         if (!vSource)
@@ -268,16 +365,8 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
         if (!fSource)
             Logger::Error("failed to construct fSource for \"%s\"", fProgUid.c_str());
 
-        // don't try to create pipeline-state, return 'not-valid'
-        rhi::PipelineState::Descriptor psDesc;
-        psDesc.vprogUid = vProgUid;
-        psDesc.fprogUid = fProgUid;
-        ShaderDescriptor* res = new ShaderDescriptor(rhi::HPipelineState(rhi::InvalidHandle), vProgUid, fProgUid);
-        res->sourceName = name;
-        res->defines = defines;
-        res->valid = false;
-        shaderDescriptors[key] = res;
-        return res;
+        // don't try to create pipeline-state, leave 'not-valid'
+        return;
     }
 
 #if DUMP_SOURCES
@@ -287,10 +376,7 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     fSource->Dump();
 #endif
 
-    const std::string& vpBin = vSource->GetSourceCode(rhi::HostApi());
-    rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_VERTEX, vProgUid, vpBin.c_str(), unsigned(vpBin.length()));
-    const std::string& fpBin = fSource->GetSourceCode(rhi::HostApi());
-    rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_FRAGMENT, fProgUid, fpBin.c_str(), unsigned(fpBin.length()));
+    UpdateProgBinaries(vProgUid, fProgUid, vSource, fSource, sourceCode, false);
     //ShaderDescr
     rhi::PipelineState::Descriptor psDesc;
     psDesc.vprogUid = vProgUid;
@@ -300,20 +386,23 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     rhi::HPipelineState piplineState = rhi::AcquireRenderPipelineState(psDesc);
 
     //in case we have broken shaders in cache, replace them with newly compiled
-    if ((!piplineState.IsValid()) && isCachedShader)
+    if ((!piplineState.IsValid()) && pending->isCachedShader)
     {
         DAVA::Logger::Info("cached shader compilation failed ");
         DAVA::Logger::Info("  vprog-uid = %s", vProgUid.c_str());
         DAVA::Logger::Info("  fprog-uid = %s", fProgUid.c_str());
         DAVA::Logger::Info("trying to replace from source files");
 
-        vSource = rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), progDefines);
-        fSource = rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), progDefines);
+        CompileShaderSources(vProgUid, fProgUid, sourceCode, pending->progDefines);
+        vSource = rhi::ShaderSourceCache::Get(vProgUid, sourceCode.vSrcHash);
+        fSource = rhi::ShaderSourceCache::Get(fProgUid, sourceCode.fSrcHash);
+        if (!vSource || !fSource)
+        {
+            DAVA::Logger::Error("failed to construct sources for \"%s\"", vProgUid.c_str());
+            return;
+        }
 
-        const std::string& vpBin = vSource->GetSourceCode(rhi::HostApi());
-        rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_VERTEX, vProgUid, vpBin.c_str(), unsigned(vpBin.length()));
-        const std::string& fpBin = fSource->GetSourceCode(rhi::HostApi());
-        rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_FRAGMENT, fProgUid, fpBin.c_str(), unsigned(fpBin.length()));
+        UpdateProgBinaries(vProgUid, fProgUid, vSource, fSource, sourceCode, true);
 
         psDesc.vprogUid = vProgUid;
         psDesc.fprogUid = fProgUid;
@@ -322,14 +411,12 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
         piplineState = rhi::AcquireRenderPipelineState(psDesc);
     }
 
-    ShaderDescriptor* res = new ShaderDescriptor(piplineState, vProgUid, fProgUid);
-    res->sourceName = name;
-    res->defines = defines;
-    res->valid = piplineState.IsValid(); //later add another conditions
-    if (res->valid)
+    shader->piplineState = piplineState;
+    shader->valid = piplineState.IsValid(); //later add another conditions
+    if (shader->valid)
     {
-        res->UpdateConfigFromSource(const_cast<rhi::ShaderSource*>(vSource), const_cast<rhi::ShaderSource*>(fSource));
-        res->requiredVertexFormat = GetVertexLayoutRequiredFormat(psDesc.vertexLayout);
+        shader->UpdateConfigFromSource(const_cast<rhi::ShaderSource*>(vSource), const_cast<rhi::ShaderSource*>(fSource));
+        shader->requiredVertexFormat = GetVertexLayoutRequiredFormat(psDesc.vertexLayout);
     }
     else
     {
@@ -337,16 +424,26 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
         DAVA::Logger::Info("  vprog-uid = %s", vProgUid.c_str());
         DAVA::Logger::Info("  fprog-uid = %s", fProgUid.c_str());
     }
+}
 
-    shaderDescriptors[key] = res;
-    return res;
+void CompletePendingShaders()
+{
+    LockGuard<RecursiveMutex> guard(shaderCacheMutex);
+
+    while (!pendingShaders.empty())
+    {
+        CompletePendingShader(pendingShaders.begin()->first);
+    }
 }
 
 void ReloadShaders()
 {
     DVASSERT(initialized);
 
-    LockGuard<Mutex> guard(shaderCacheMutex);
+    LockGuard<RecursiveMutex> guard(shaderCacheMutex);
+    CompletePendingShaders();
+
+    LockGuard<Mutex> compileGuard(shaderCompileMutex);
     shaderSourceCodes.clear();
     rhi::ShaderSource::PurgeIncludesCache();
 
@@ -370,9 +467,9 @@ void ReloadShaders()
         fSource.Construct(rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), progDefines);
 
         const std::string& vpBin = vSource.GetSourceCode(rhi::HostApi());
-        rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_VERTEX, shader->vProgUid, vpBin.c_str(), unsigned(vpBin.length()));
+        rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_VERTEX, shader->vProgUid, vpBin.c_str(), unsigned(vpBin.length()), sourceCode.vSrcHash);
         const std::string& fpBin = fSource.GetSourceCode(rhi::HostApi());
-        rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_FRAGMENT, shader->fProgUid, fpBin.c_str(), unsigned(fpBin.length()));
+        rhi::ShaderCache::UpdateProgBinary(rhi::HostApi(), rhi::PROG_FRAGMENT, shader->fProgUid, fpBin.c_str(), unsigned(fpBin.length()), sourceCode.fSrcHash);
 
         //ShaderDescr
         rhi::PipelineState::Descriptor psDesc;
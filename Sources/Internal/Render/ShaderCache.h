@@ -16,7 +16,18 @@ void ClearDynamicBindigs();
 void ReloadShaders();
 
 void SetLoadingNotifyEnabled(bool enable);
+
+/**
+    Enable construction of shader sources for new variants in worker jobs.
+    In this mode `GetShaderDescriptor` returns pending not valid descriptor for shader which is not found in sources cache,
+    descriptor becomes valid on main thread when compilation is finished. Disabled by default.
+*/
+void SetAsyncCompilationEnabled(bool enable);
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
+
+/** Finish compilation of pending shader right now, waiting for its worker job if needed. Does nothing for not pending shader. */
+void CompletePendingShader(ShaderDescriptor* shader);
+void CompletePendingShaders();
 Vector<size_t> BuildFlagsKey(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 size_t GetUniqueFlagKey(FastName flagName);
 };
@@ -151,13 +151,7 @@ void ParticleEffectComponent::StopWhenEmpty(bool value /*= true*/)
 
 void ParticleEffectComponent::ClearGroup(ParticleGroup& group)
 {
-    Particle* current = group.head;
-    while (current)
-    {
-        Particle* next = current->next;
-        delete current;
-        current = next;
-    }
+    group.particles.Clear();
     group.layer->Release();
     group.emitter->Release();
 }
@@ -522,11 +516,10 @@ float32 ParticleEffectComponent::GetLayerActiveParticlesSquare(ParticleLayer* la
     {
         if (it->layer == layer)
         {
-            Particle* currParticle = it->head;
-            while (currParticle)
+            const ParticleStorage& particles = it->particles;
+            for (uint32 i = 0, count = particles.GetCount(); i < count; ++i)
             {
-                square += currParticle->currSize.x * currParticle->currSize.y;
-                currParticle = currParticle->next;
+                square += particles.currSizeX[i] * particles.currSizeY[i];
             }
         }
     }
@@ -5,7 +5,12 @@
 #include "Render/Highlevel/RenderSystem.h"
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Render/Material/NMaterial.h"
+#include "Render/3D/PolygonGroup.h"
 
+#include "Engine/Engine.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/KeyedArchive.h"
+#include "Job/JobManager.h"
 #include "Utils/StringFormat.h"
 
 #include "Render/Material/NMaterialNames.h"
@@ -13,6 +18,32 @@
 
 namespace DAVA
 {
+namespace SerializationContextDetails
+{
+// Maximum size of polygon group archives read from file and waiting for decoding by workers
+const uint32 MAX_PENDING_GEOMETRY_SIZE = 32 * 1024 * 1024;
+
+struct PolygonGroupData
+{
+    PolygonGroup* group = nullptr;
+    int32 requestedFormat = 0;
+    Vector<uint8> archiveData;
+    bool archiveLoaded = false;
+    bool decoded = false;
+};
+
+void DecodePolygonGroup(PolygonGroupData& data, bool cutUnusedStreams)
+{
+    ScopedPtr<DynamicMemoryFile> file(DynamicMemoryFile::Create(std::move(data.archiveData), File::OPEN | File::READ, FilePath()));
+    ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+    data.archiveLoaded = archive->Load(file);
+    if (data.archiveLoaded)
+    {
+        data.decoded = data.group->DecodePolygonData(archive, data.requestedFormat, cutUnusedStreams);
+    }
+}
+}
+
 SerializationContext::SerializationContext()
     : globalMaterialKey(0)
 {
@@ -60,11 +91,12 @@ void SerializationContext::ResolveMaterialBindings()
     materialBindings.clear();
 }
 
-void SerializationContext::AddLoadedPolygonGroup(PolygonGroup* group, uint32 dataFilePos)
+void SerializationContext::AddLoadedPolygonGroup(PolygonGroup* group, uint32 dataFilePos, uint32 dataSize)
 {
     DVASSERT(loadedPolygonGroups.find(group) == loadedPolygonGroups.end());
     PolygonGroupLoadInfo loadInfo;
     loadInfo.filePos = dataFilePos;
+    loadInfo.dataSize = dataSize;
     loadedPolygonGroups[group] = loadInfo;
 }
 void SerializationContext::AddRequestedPolygonGroupFormat(PolygonGroup* group, int32 format)
@@ -77,19 +109,73 @@ void SerializationContext::AddRequestedPolygonGroupFormat(PolygonGroup* group, i
 
 bool SerializationContext::LoadPolygonGroupData(File* file)
 {
+    using namespace SerializationContextDetails;
+
     bool resultLoaded = true;
     bool cutUnusedStreams = QualitySettingsSystem::Instance()->GetAllowCutUnusedVertexStreams();
-    for (Map<PolygonGroup *, PolygonGroupLoadInfo>::iterator it = loadedPolygonGroups.begin(), e = loadedPolygonGroups.end(); it != e; ++it)
+
+    Vector<PolygonGroupData> groupsData;
+    groupsData.reserve(loadedPolygonGroups.size());
+    for (const auto& it : loadedPolygonGroups)
     {
-        if (it->second.onScene || !cutUnusedStreams)
+        if (it.second.onScene || !cutUnusedStreams)
         {
-            resultLoaded &= file->Seek(it->second.filePos, File::SEEK_FROM_START);
-            KeyedArchive* archive = new KeyedArchive();
-            resultLoaded &= archive->Load(file);
-            it->first->LoadPolygonData(archive, this, it->second.requestedFormat, cutUnusedStreams);
-            SafeRelease(archive);
+            groupsData.emplace_back();
+            groupsData.back().group = it.first;
+            groupsData.back().requestedFormat = it.second.requestedFormat;
         }
     }
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    const bool parallelLoading = parallelLoadingEnabled && (jobManager != nullptr) && (jobManager->GetWorkersCount() > 1) && (groupsData.size() > 1);
+
+    // Reading of file is sequential, decoding of already read groups is done by workers meanwhile
+    JobGroup decodingGroup;
+    uint32 pendingSize = 0;
+    for (PolygonGroupData& data : groupsData)
+    {
+        const PolygonGroupLoadInfo& loadInfo = loadedPolygonGroups[data.group];
+
+        data.archiveData.resize(loadInfo.dataSize);
+        bool dataRead = file->Seek(loadInfo.filePos, File::SEEK_FROM_START) && (file->Read(data.archiveData.data(), loadInfo.dataSize) == loadInfo.dataSize);
+        if (!dataRead)
+        {
+            resultLoaded = false;
+            data.archiveData.clear();
+            continue;
+        }
+
+        if (parallelLoading)
+        {
+            if (pendingSize > MAX_PENDING_GEOMETRY_SIZE)
+            {
+                jobManager->WaitWorkerGroup(&decodingGroup);
+                pendingSize = 0;
+            }
+
+            pendingSize += loadInfo.dataSize;
+            jobManager->CreateWorkerTask([&data, cutUnusedStreams]() { DecodePolygonGroup(data, cutUnusedStreams); }, &decodingGroup);
+        }
+        else
+        {
+            DecodePolygonGroup(data, cutUnusedStreams);
+        }
+    }
+
+    if (parallelLoading)
+    {
+        jobManager->WaitWorkerGroup(&decodingGroup);
+    }
+
+    for (PolygonGroupData& data : groupsData)
+    {
+        resultLoaded &= data.archiveLoaded;
+        if (data.decoded)
+        {
+            data.group->FinishPolygonDataLoading();
+        }
+    }
+
     return resultLoaded;
 }
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ public:
     struct PolygonGroupLoadInfo
     {
         uint32 filePos = 0;
+        uint32 dataSize = 0;
         int32 requestedFormat = EVF_VERTEX; //vertex position loading is required as all code assumes it is there
         bool onScene = false;
     };
@@ -50,6 +51,16 @@ public:
         return debugLogEnabled;
     }
 
+    inline void SetParallelLoadingEnabled(bool state)
+    {
+        parallelLoadingEnabled = state;
+    }
+
+    inline bool IsParallelLoadingEnabled() const
+    {
+        return parallelLoadingEnabled;
+    }
+
     inline void SetScene(Scene* target)
     {
         scene = target;
@@ -134,8 +145,14 @@ public:
 
     void ResolveMaterialBindings();
 
-    void AddLoadedPolygonGroup(PolygonGroup* group, uint32 dataFilePos);
+    void AddLoadedPolygonGroup(PolygonGroup* group, uint32 dataFilePos, uint32 dataSize);
     void AddRequestedPolygonGroupFormat(PolygonGroup* group, int32 format);
+
+    /*
+        Load vertex data of polygon groups added by AddLoadedPolygonGroup.
+        Archives are read from file on the calling thread and decoded by job workers if parallel loading is enabled,
+        render buffers are created on the calling thread after all groups are decoded.
+    */
     bool LoadPolygonGroupData(File* file);
 
     template <template <typename, typename> class Container, class T, class A>
@@ -162,6 +179,7 @@ private:
     uint32 version = 0;
 
     bool debugLogEnabled = false;
+    bool parallelLoadingEnabled = true;
 };
 
 template <template <typename, typename> class Container, class T, class A>
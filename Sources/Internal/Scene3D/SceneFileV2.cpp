@@ -71,6 +71,11 @@ void SceneFileV2::EnableDebugLog(bool _isDebugLogEnabled)
     serializationContext.SetDebugLogEnabled(isDebugLogEnabled);
 }
 
+void SceneFileV2::EnableParallelLoading(bool isParallelLoadingEnabled)
+{
+    serializationContext.SetParallelLoadingEnabled(isParallelLoadingEnabled);
+}
+
 bool SceneFileV2::DebugLogEnabled()
 {
     return isDebugLogEnabled;
@@ -801,7 +806,8 @@ bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 
         if (name == "PolygonGroup")
         {
-            serializationContext.AddLoadedPolygonGroup(static_cast<PolygonGroup*>(node), currFilePos);
+            uint32 archiveSize = static_cast<uint32>(file->GetPos()) - currFilePos;
+            serializationContext.AddLoadedPolygonGroup(static_cast<PolygonGroup*>(node), currFilePos, archiveSize);
         }
 
         int32 childrenCount = archive->GetInt32("#childrenCount", 0);
@@ -130,6 +130,8 @@ public:
     void EnableDebugLog(bool _isDebugLogEnabled);
     bool DebugLogEnabled();
     void EnableSaveForGame(bool _isSaveForGame);
+    /** Decode geometry of loaded scene by job workers. Enabled by default */
+    void EnableParallelLoading(bool isParallelLoadingEnabled);
 
     //Material * GetMaterial(int32 index);
     //StaticMesh * GetStaticMesh(int32 index);
@@ -53,6 +53,8 @@ private:
     Vector3 position;
     float32 scale = 1.f;
     uint8 flags = 0;
+
+    friend class SkeletonPose;
 };
 
 inline void JointTransform::Reset()
@@ -34,6 +34,7 @@ void SkeletonAnimation::BindSkeleton(const SkeletonComponent* skeleton)
     for (SkeletonAnimationClip& clip : animationClips)
     {
         clip.boundTracks.clear();
+        clip.keyCursors.clear();
 
         uint32 trackCount = clip.animationClip->GetTrackCount();
         uint32 jointCount = skeleton->GetJointsCount();
@@ -48,6 +49,7 @@ void SkeletonAnimation::BindSkeleton(const SkeletonComponent* skeleton)
             if (track != nullptr)
             {
                 clip.boundTracks.emplace_back(std::make_pair(j, track));
+                clip.keyCursors.resize(clip.keyCursors.size() + track->GetChannelsCount(), 0);
                 maxJointIndex = Max(maxJointIndex, j);
             }
         }
@@ -83,13 +85,15 @@ void SkeletonAnimation::EvaluatePose(float32 animationLocalTime, SkeletonPose* o
 
     SkeletonAnimationClip* clip = FindClip(animationLocalTime);
 
+    uint32 keyCursorsOffset = 0;
     uint32 boundTrackCount = uint32(clip->boundTracks.size());
     for (uint32 t = 0; t < boundTrackCount; ++t)
     {
         uint32 jointIndex = clip->boundTracks[t].first;
         const AnimationTrack* track = clip->boundTracks[t].second;
 
-        outPose->SetTransform(jointIndex, EvaluateJointTransform(animationLocalTime, track));
+        outPose->SetTransform(jointIndex, EvaluateJointTransform(animationLocalTime, track, clip->keyCursors.data() + keyCursorsOffset));
+        keyCursorsOffset += track->GetChannelsCount();
     }
 }
 
@@ -137,7 +141,7 @@ float32 SkeletonAnimation::GetDuration() const
 
 //////////////////////////////////////////////////////////////////////////
 
-JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track)
+JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track, uint32* keyCursors)
 {
     static const uint32 MAX_CHANNEL_VALUE_SIZE = 4;
     DVASSERT(MAX_CHANNEL_VALUE_SIZE >= track->GetMaxChannelValueSize());
@@ -146,7 +150,7 @@ JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const Ani
     Array<float32, MAX_CHANNEL_VALUE_SIZE> workData;
     for (uint32 c = 0; c < track->GetChannelsCount(); ++c)
     {
-        track->Evaluate(time, c, workData.data(), uint32(workData.size()));
+        track->Evaluate(time, c, workData.data(), uint32(workData.size()), keyCursors[c]);
 
         AnimationTrack::eChannelTarget target = track->GetChannelTarget(c);
         switch (target)
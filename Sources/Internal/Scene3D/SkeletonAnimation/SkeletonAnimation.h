@@ -31,6 +31,7 @@ protected:
         UnorderedSet<uint32> jointsIgnoreMask;
 
         Vector<std::pair<uint32, const AnimationTrack*>> boundTracks; //[jointIndex, track]
+        Vector<uint32> keyCursors; //sampling positions of every channel of bound tracks, so clips are shared read-only
         const AnimationTrack* rootNodeTrack = nullptr; //for root-node transform extraction
         uint32 rootNodePositionChannel = std::numeric_limits<uint32>::max();
 
@@ -39,7 +40,7 @@ protected:
         float32 animationStartTimestamp = 0.f;
     };
 
-    static JointTransform EvaluateJointTransform(float32 time, const AnimationTrack* track);
+    static JointTransform EvaluateJointTransform(float32 time, const AnimationTrack* track, uint32* keyCursors);
     void EvaluateRootPosition(SkeletonAnimationClip* clip, float32 animationLocalTime, Vector3* outPosition);
     SkeletonAnimationClip* FindClip(float32 animationTime);
     float32 GetClipLocalTime(SkeletonAnimationClip* clip, float32 animationLocalTime);
@@ -1,8 +1,150 @@
 #include "SkeletonPose.h"
 #include "Math/MathHelpers.h"
+#include "Math/SIMD.h"
+
+#include <cmath>
 
 namespace DAVA
 {
+namespace SkeletonPoseDetails
+{
+const uint32 SLERP_TERMS_COUNT = 8;
+
+/**
+    Polynomial approximation of slerp weights sin(t * angle) / sin(angle) by cosine of angle,
+    from D. Eberly 'A Fast and Accurate Algorithm for Computing SLERP'. It uses only multiplications and additions,
+    so it is computed for four joints at once. Max error of weight is about 2e-5, result is normalized afterwards.
+*/
+struct SlerpWeights
+{
+    SlerpWeights(float32 t)
+    {
+        const float32 mu = 1.85298109240830f;
+        float32 d = 1.f - t;
+        for (uint32 i = 0; i < SLERP_TERMS_COUNT; ++i)
+        {
+            float32 n = float32(i + 1);
+            float32 u = 1.f / (n * (2.f * n + 1.f));
+            float32 v = n / (2.f * n + 1.f);
+            if (i == SLERP_TERMS_COUNT - 1)
+            {
+                u *= mu;
+                v *= mu;
+            }
+
+            coeffs0[i] = u * d * d - v;
+            coeffs1[i] = u * t * t - v;
+        }
+        weight0 = d;
+        weight1 = t;
+    }
+
+    //weight = t * (1 + c[0] * (x - 1) * (1 + c[1] * (x - 1) * (...)))
+    static float32 Evaluate(float32 weight, const float32* coeffs, float32 xm1)
+    {
+        float32 result = 1.f;
+        for (uint32 i = SLERP_TERMS_COUNT; i-- > 0;)
+            result = 1.f + coeffs[i] * xm1 * result;
+        return weight * result;
+    }
+
+    float32 coeffs0[SLERP_TERMS_COUNT];
+    float32 coeffs1[SLERP_TERMS_COUNT];
+    float32 weight0;
+    float32 weight1;
+};
+
+void Lerp(float32* values, const float32* other, float32 factor, uint32 count)
+{
+    using namespace SIMD;
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD)
+    Float4 factor4 = Splat(factor);
+    for (uint32 vectorizedCount = GetVectorizedCount(count); i < vectorizedCount; i += WIDTH)
+    {
+        Float4 v = Load(values + i);
+        Store(values + i, SIMD::Add(v, Mul(factor4, Sub(Load(other + i), v))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        values[i] = DAVA::Lerp(values[i], other[i], factor);
+    }
+}
+
+void Slerp(float32* x, float32* y, float32* z, float32* w, const float32* otherX, const float32* otherY, const float32* otherZ, const float32* otherW, float32 factor, uint32 count)
+{
+    using namespace SIMD;
+
+    const SlerpWeights weights(factor);
+
+    uint32 i = 0;
+#if defined(DAVA_SIMD)
+    Float4 one = Splat(1.f);
+    Float4 signMask = SignMask();
+    Float4 coeffs0[SLERP_TERMS_COUNT];
+    Float4 coeffs1[SLERP_TERMS_COUNT];
+    for (uint32 c = 0; c < SLERP_TERMS_COUNT; ++c)
+    {
+        coeffs0[c] = Splat(weights.coeffs0[c]);
+        coeffs1[c] = Splat(weights.coeffs1[c]);
+    }
+
+    for (uint32 vectorizedCount = GetVectorizedCount(count); i < vectorizedCount; i += WIDTH)
+    {
+        Float4 x0 = Load(x + i), y0 = Load(y + i), z0 = Load(z + i), w0 = Load(w + i);
+        Float4 x1 = Load(otherX + i), y1 = Load(otherY + i), z1 = Load(otherZ + i), w1 = Load(otherW + i);
+
+        Float4 dot = SIMD::Add(SIMD::Add(Mul(x0, x1), Mul(y0, y1)), SIMD::Add(Mul(z0, z1), Mul(w0, w1)));
+        Float4 sign = And(dot, signMask); //take shortest path
+        Float4 xm1 = Sub(Xor(dot, sign), one);
+
+        Float4 result0 = one;
+        Float4 result1 = one;
+        for (uint32 c = SLERP_TERMS_COUNT; c-- > 0;)
+        {
+            result0 = SIMD::Add(one, Mul(Mul(coeffs0[c], xm1), result0));
+            result1 = SIMD::Add(one, Mul(Mul(coeffs1[c], xm1), result1));
+        }
+        Float4 weight0 = Mul(Splat(weights.weight0), result0);
+        Float4 weight1 = Xor(Mul(Splat(weights.weight1), result1), sign);
+
+        Float4 rx = SIMD::Add(Mul(x0, weight0), Mul(x1, weight1));
+        Float4 ry = SIMD::Add(Mul(y0, weight0), Mul(y1, weight1));
+        Float4 rz = SIMD::Add(Mul(z0, weight0), Mul(z1, weight1));
+        Float4 rw = SIMD::Add(Mul(w0, weight0), Mul(w1, weight1));
+
+        Float4 invLength = ReciprocalSqrt(SIMD::Add(SIMD::Add(Mul(rx, rx), Mul(ry, ry)), SIMD::Add(Mul(rz, rz), Mul(rw, rw))));
+        Store(x + i, Mul(rx, invLength));
+        Store(y + i, Mul(ry, invLength));
+        Store(z + i, Mul(rz, invLength));
+        Store(w + i, Mul(rw, invLength));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float32 dot = x[i] * otherX[i] + y[i] * otherY[i] + z[i] * otherZ[i] + w[i] * otherW[i];
+        float32 sign = (dot < 0.f) ? -1.f : 1.f;
+        float32 xm1 = dot * sign - 1.f;
+
+        float32 weight0 = SlerpWeights::Evaluate(weights.weight0, weights.coeffs0, xm1);
+        float32 weight1 = SlerpWeights::Evaluate(weights.weight1, weights.coeffs1, xm1) * sign;
+
+        float32 rx = x[i] * weight0 + otherX[i] * weight1;
+        float32 ry = y[i] * weight0 + otherY[i] * weight1;
+        float32 rz = z[i] * weight0 + otherZ[i] * weight1;
+        float32 rw = w[i] * weight0 + otherW[i] * weight1;
+
+        float32 invLength = 1.f / std::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+        x[i] = rx * invLength;
+        y[i] = ry * invLength;
+        z[i] = rz * invLength;
+        w[i] = rw * invLength;
+    }
+}
+}
+
 SkeletonPose::SkeletonPose(uint32 jointCount)
 {
     SetJointCount(jointCount);
@@ -15,8 +157,8 @@ void SkeletonPose::Add(const SkeletonPose& other)
 
     for (uint32 j = 0; j < jointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
+        JointTransform transform0 = GetJointTransform(j);
+        JointTransform transform1 = other.GetJointTransform(j);
         SetTransform(j, transform0.AppendTransform(transform1));
     }
 }
@@ -28,8 +170,8 @@ void SkeletonPose::Diff(const SkeletonPose& other)
 
     for (uint32 j = 0; j < jointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
+        JointTransform transform0 = GetJointTransform(j);
+        JointTransform transform1 = other.GetJointTransform(j);
         SetTransform(j, transform0.GetInverse().AppendTransform(transform1));
     }
 }
@@ -41,9 +183,25 @@ void SkeletonPose::Override(const SkeletonPose& other)
 
     for (uint32 j = 0; j < jointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
-        SetTransform(j, JointTransform::Override(transform0, transform1));
+        uint8 otherFlags = other.flags[j];
+        if (otherFlags & JointTransform::FLAG_POSITION)
+        {
+            positionX[j] = other.positionX[j];
+            positionY[j] = other.positionY[j];
+            positionZ[j] = other.positionZ[j];
+        }
+        if (otherFlags & JointTransform::FLAG_ORIENTATION)
+        {
+            orientationX[j] = other.orientationX[j];
+            orientationY[j] = other.orientationY[j];
+            orientationZ[j] = other.orientationZ[j];
+            orientationW[j] = other.orientationW[j];
+        }
+        if (otherFlags & JointTransform::FLAG_SCALE)
+        {
+            scale[j] = other.scale[j];
+        }
+        flags[j] |= otherFlags;
     }
 }
 
@@ -52,12 +210,38 @@ void SkeletonPose::Lerp(const SkeletonPose& other, float32 factor)
     uint32 jointCount = other.GetJointsCount();
     SetJointCount(Max(GetJointsCount(), jointCount));
 
-    for (uint32 j = 0; j < jointCount; ++j)
+    //joints which have the same components in both poses are blended in batches,
+    //the others take missing components from one of the poses as in `JointTransform::Lerp`
+    uint32 j = 0;
+    while (j < jointCount)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
-        SetTransform(j, JointTransform::Lerp(transform0, transform1, factor));
+        uint32 batchEnd = j;
+        while (batchEnd < jointCount && flags[batchEnd] == other.flags[batchEnd])
+            ++batchEnd;
+
+        if (batchEnd > j)
+        {
+            LerpJoints(other, j, batchEnd, factor);
+            j = batchEnd;
+        }
+        else
+        {
+            SetTransform(j, JointTransform::Lerp(GetJointTransform(j), other.GetJointTransform(j), factor));
+            ++j;
+        }
     }
 }
 
-} //ns
\ No newline at end of file
+void SkeletonPose::LerpJoints(const SkeletonPose& other, uint32 begin, uint32 end, float32 factor)
+{
+    uint32 count = end - begin;
+    SkeletonPoseDetails::Lerp(positionX.data() + begin, other.positionX.data() + begin, factor, count);
+    SkeletonPoseDetails::Lerp(positionY.data() + begin, other.positionY.data() + begin, factor, count);
+    SkeletonPoseDetails::Lerp(positionZ.data() + begin, other.positionZ.data() + begin, factor, count);
+    SkeletonPoseDetails::Lerp(scale.data() + begin, other.scale.data() + begin, factor, count);
+    SkeletonPoseDetails::Slerp(orientationX.data() + begin, orientationY.data() + begin, orientationZ.data() + begin, orientationW.data() + begin,
+                               other.orientationX.data() + begin, other.orientationY.data() + begin, other.orientationZ.data() + begin, other.orientationW.data() + begin,
+                               factor, count);
+}
+
+} //ns
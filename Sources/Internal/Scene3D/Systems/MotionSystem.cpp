@@ -2,6 +2,9 @@
 
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Scene.h"
 #include "Scene3D/Components/ComponentHelpers.h"
@@ -14,6 +17,12 @@
 
 namespace DAVA
 {
+namespace MotionSystemDetails
+{
+// Minimal count of motion components processed by one worker task
+static const uint32 COMPONENTS_PER_TASK = 16;
+}
+
 MotionSystem::MotionSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -118,16 +127,47 @@ void MotionSystem::Process(float32 timeElapsed)
 
     motionSingleComponent->Clear();
 
-    for (MotionComponent* component : activeComponents)
+    // Poses of different components are independent, so with enough components they are evaluated on job workers.
+    // Motion events are collected afterwards, as single component isn't thread-safe
+    uint32 componentsCount = uint32(activeComponents.size());
+    updateResults.resize(componentsCount);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (nullptr != jobManager && componentsCount >= 2 * MotionSystemDetails::COMPONENTS_PER_TASK)
+    {
+        JobGroup group;
+        for (uint32 taskBegin = 0; taskBegin < componentsCount; taskBegin += MotionSystemDetails::COMPONENTS_PER_TASK)
+        {
+            uint32 taskEnd = std::min(taskBegin + MotionSystemDetails::COMPONENTS_PER_TASK, componentsCount);
+            jobManager->CreateWorkerTask([this, taskBegin, taskEnd, timeElapsed]() { UpdateMotionLayersRange(taskBegin, taskEnd, timeElapsed); }, &group);
+        }
+        jobManager->WaitWorkerGroup(&group);
+    }
+    else
     {
-        UpdateMotionLayers(component, timeElapsed);
+        UpdateMotionLayersRange(0, componentsCount, timeElapsed);
+    }
+
+    for (uint32 c = 0; c < componentsCount; ++c)
+    {
+        CollectMotionEvents(activeComponents[c], updateResults[c]);
     }
 }
 
-void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime)
+void MotionSystem::UpdateMotionLayersRange(uint32 begin, uint32 end, float32 dTime)
+{
+    for (uint32 c = begin; c < end; ++c)
+    {
+        updateResults[c] = UpdateMotionLayers(activeComponents[c], dTime);
+    }
+}
+
+uint8 MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime)
 {
     DVASSERT(motionComponent);
 
+    uint8 result = 0;
+
     SkeletonComponent* skeleton = GetSkeletonComponent(motionComponent->GetEntity());
     if (skeleton != nullptr && (motionComponent->GetMotionLayersCount() != 0 || (motionComponent->simpleMotion != nullptr && motionComponent->simpleMotion->IsPlaying())))
     {
@@ -141,12 +181,6 @@ void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32
 
             motionLayer->Update(dTime);
 
-            for (const auto& motionEnd : motionLayer->GetEndedMotions())
-                motionSingleComponent->animationEnd.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionEnd));
-
-            for (const auto& motionMarker : motionLayer->GetReachedMarkers())
-                motionSingleComponent->animationMarkerReached.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionMarker.first, motionMarker.second));
-
             const SkeletonPose& pose = motionLayer->GetCurrentSkeletonPose();
             MotionLayer::eMotionBlend blendMode = motionLayer->GetBlendMode();
             switch (blendMode)
@@ -171,12 +205,36 @@ void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32
         {
             simpleMotion->Update(dTime);
             if (!simpleMotion->IsPlaying())
-                motionSingleComponent->simpleMotionFinished.emplace_back(motionComponent);
+                result |= UPDATE_RESULT_SIMPLE_MOTION_FINISHED;
 
             simpleMotion->EvaluatePose(&resultPose);
         }
 
         skeleton->ApplyPose(resultPose);
+        result |= UPDATE_RESULT_UPDATED;
+    }
+
+    return result;
+}
+
+void MotionSystem::CollectMotionEvents(MotionComponent* motionComponent, uint8 updateResult)
+{
+    if ((updateResult & UPDATE_RESULT_UPDATED) == 0)
+        return;
+
+    uint32 motionLayersCount = motionComponent->GetMotionLayersCount();
+    for (uint32 l = 0; l < motionLayersCount; ++l)
+    {
+        MotionLayer* motionLayer = motionComponent->GetMotionLayer(l);
+
+        for (const auto& motionEnd : motionLayer->GetEndedMotions())
+            motionSingleComponent->animationEnd.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionEnd));
+
+        for (const auto& motionMarker : motionLayer->GetReachedMarkers())
+            motionSingleComponent->animationMarkerReached.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionMarker.first, motionMarker.second));
     }
+
+    if ((updateResult & UPDATE_RESULT_SIMPLE_MOTION_FINISHED) != 0)
+        motionSingleComponent->simpleMotionFinished.emplace_back(motionComponent);
 }
 }
\ No newline at end of file
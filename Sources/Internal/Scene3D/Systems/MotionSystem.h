@@ -30,9 +30,18 @@ protected:
     void SetScene(Scene* scene) override;
 
 private:
-    void UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime);
+    enum eUpdateResult : uint8
+    {
+        UPDATE_RESULT_UPDATED = 1 << 0,
+        UPDATE_RESULT_SIMPLE_MOTION_FINISHED = 1 << 1,
+    };
+
+    void UpdateMotionLayersRange(uint32 begin, uint32 end, float32 dTime);
+    uint8 UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime);
+    void CollectMotionEvents(MotionComponent* motionComponent, uint8 updateResult);
 
     Vector<MotionComponent*> activeComponents;
+    Vector<uint8> updateResults; //eUpdateResult flags for every active component, filled on job workers
     MotionSingleComponent* motionSingleComponent = nullptr;
 };
 
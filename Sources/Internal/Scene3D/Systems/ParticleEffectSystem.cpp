@@ -9,6 +9,8 @@
 #include "Particles/ParticlesRandom.h"
 #include "Particles/ParticleForces.h"
 #include "Particles/ParticleForce.h"
+#include "Particles/ParticleForceSimplified.h"
+#include "Particles/Private/ParticleKernels.h"
 #include "Scene3D/Systems/EventSystem.h"
 #include "Time/SystemTimer.h"
 #include "Utils/Random.h"
@@ -25,6 +27,7 @@
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
@@ -405,10 +408,9 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     float32 speedMult = 1.0f + (perfSettings->GetPsPerformanceSpeedMult() - 1.0f) * (1 - currPSValue);
     float32 shortEffectTime = timeElapsed * speedMult;
 
-    size_t componentsCount = activeComponents.size();
-    for (size_t i = 0; i < componentsCount; i++)
+    effectUpdates.clear();
+    for (ParticleEffectComponent* effect : activeComponents)
     {
-        ParticleEffectComponent* effect = activeComponents[i];
         if (effect->activeLodLevel != effect->desiredLodLevel)
             UpdateActiveLod(effect);
         if (effect->state == ParticleEffectComponent::STATE_STARTING)
@@ -418,8 +420,23 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
 
         if (effect->isPaused)
             continue;
-        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed);
 
+        EffectUpdate update;
+        update.effect = effect;
+        update.deltaTime = timeElapsed * effect->playbackSpeed;
+        update.shortEffectTime = shortEffectTime * effect->playbackSpeed;
+        BeginEffectUpdate(update);
+        effectUpdates.push_back(update);
+    }
+
+    SimulateEffects(effectUpdates);
+
+    Vector<ParticleEffectComponent*> completedEffects;
+    for (EffectUpdate& update : effectUpdates)
+    {
+        EndEffectUpdate(update);
+
+        ParticleEffectComponent* effect = update.effect;
         bool effectEnded = effect->stopWhenEmpty ? effect->effectData.groups.empty() : (effect->time > effect->effectDuration);
         if (effectEnded)
         {
@@ -441,11 +458,9 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
         {
             effect->effectData.infoSources.resize(1);
             RemoveFromActive(effect);
-            componentsCount--;
-            i--;
             effect->state = ParticleEffectComponent::STATE_STOPPED;
             if (!effect->playbackComplete.IsEmpty())
-                effect->playbackComplete(effect->GetEntity(), 0);
+                completedEffects.push_back(effect);
         }
         else
         {
@@ -454,6 +469,12 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
                 scene->GetRenderSystem()->MarkForUpdate(effect->effectRenderObject);
         }
     }
+
+    // Callbacks may start, stop or delete effects, so they are called when all updates are finished
+    for (ParticleEffectComponent* effect : completedEffects)
+    {
+        effect->playbackComplete(effect->GetEntity(), 0);
+    }
 }
 
 void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
@@ -474,36 +495,11 @@ void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
             ParticleGroup& group = *it;
             if (group.layer->degradeStrategy == ParticleLayer::DEGRADE_REMOVE)
             {
-                Particle* current = group.head;
-                while (current)
-                {
-                    Particle* next = current->next;
-                    delete current;
-                    current = next;
-                }
-                group.head = nullptr;
+                group.particles.Clear();
             }
             else if (group.layer->degradeStrategy == ParticleLayer::DEGRADE_CUT_PARTICLES)
             {
-                Particle* current = group.head;
-                Particle* prev = nullptr;
-                int32 i = 0;
-                while (current)
-                {
-                    Particle* next = current->next;
-                    if (i % 2) //cut every second particle
-                    {
-                        delete current;
-                        group.activeParticleCount--;
-                        if (prev)
-                            prev->next = next;
-                        else
-                            group.head = next;
-                    }
-                    prev = current;
-                    current = next;
-                    i++;
-                }
+                group.activeParticleCount -= static_cast<int32>(group.particles.RemoveEverySecond());
             }
         }
     }
@@ -511,164 +507,418 @@ void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
 
 void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime)
 {
-    effect->time += deltaTime;
-    const Matrix4* worldTransformPtr;
+    EffectUpdate update;
+    update.effect = effect;
+    update.deltaTime = deltaTime;
+    update.shortEffectTime = shortEffectTime;
+
+    BeginEffectUpdate(update);
+    SimulateParticles(update, simulationScratch);
+    EndEffectUpdate(update);
+}
+
+void ParticleEffectSystem::BeginEffectUpdate(EffectUpdate& update)
+{
+    ParticleEffectComponent* effect = update.effect;
+    effect->time += update.deltaTime;
     if (GetScene())
     {
         TransformComponent* tr = GetTransformComponent(effect->GetEntity());
         DVASSERT(tr);
-        worldTransformPtr = tr->GetWorldMatrixPtr();
+        update.worldTransform = tr->GetWorldMatrixPtr();
     }
     else
-        worldTransformPtr = effect->effectRenderObject->GetWorldMatrixPtr();
+        update.worldTransform = effect->effectRenderObject->GetWorldMatrixPtr();
 
-    effect->effectData.infoSources[0].position = worldTransformPtr->GetTranslationVector();
+    effect->effectData.infoSources[0].position = update.worldTransform->GetTranslationVector();
 
-    AABBox3 bbox;
-    List<ParticleGroup>::iterator it = effect->effectData.groups.begin();
-    Random* random = GetEngineContext()->random;
-    bool isInverseCalculated = false;
-    while (it != effect->effectData.groups.end())
+    for (ParticleGroup& group : effect->effectData.groups)
     {
-        ParticleGroup& group = *it;
-        group.activeParticleCount = 0;
-        float32 dt = group.emitter->shortEffect ? shortEffectTime : deltaTime;
-        group.time += dt;
-        float32 groupEndTime = group.layer->isLooped ? group.layer->loopEndTime : group.layer->endTime;
-        float32 currLoopTime = group.time - group.loopStartTime;
-        float32 currLoopTimeNormalized = currLoopTime / (group.layer->endTime - group.layer->startTime);
-        if (group.time > groupEndTime)
-            group.finishingGroup = true;
+        BeginGroupUpdate(group, update);
+        update.particlesCount += group.particles.GetCount();
+        update.groupsCount++;
+    }
+}
+
+void ParticleEffectSystem::BeginGroupUpdate(ParticleGroup& group, const EffectUpdate& update)
+{
+    group.activeParticleCount = 0;
+    float32 dt = group.emitter->shortEffect ? update.shortEffectTime : update.deltaTime;
+    group.time += dt;
+    float32 groupEndTime = group.layer->isLooped ? group.layer->loopEndTime : group.layer->endTime;
+    float32 currLoopTime = group.time - group.loopStartTime;
+    if (group.time > groupEndTime)
+        group.finishingGroup = true;
+
+    if ((!group.finishingGroup) && (group.layer->isLooped) && (currLoopTime > group.loopDuration)) //restart loop
+    {
+        Random* random = GetEngineContext()->random;
+        group.loopStartTime = group.time;
+        group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * static_cast<float32>(random->RandFloat());
+        group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * static_cast<float32>(random->RandFloat());
+    }
+
+    if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
+        group.layer->CalculateMaxStripeSizeOverLife(); // cache value before it is read by simulation on job workers
+}
 
-        if ((!group.finishingGroup) && (group.layer->isLooped) && (currLoopTime > group.loopDuration)) //restart loop
+void ParticleEffectSystem::SimulateEffects(Vector<EffectUpdate>& updates)
+{
+    uint32 particlesCount = 0;
+    for (const EffectUpdate& update : updates)
+    {
+        particlesCount += update.particlesCount;
+    }
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 workersCount = (jobManager != nullptr) ? jobManager->GetWorkersCount() : 0;
+    if (!parallelUpdateEnabled || workersCount == 0 || updates.size() < 2 || particlesCount < PARALLEL_UPDATE_MIN_PARTICLES)
+    {
+        for (EffectUpdate& update : updates)
         {
-            group.loopStartTime = group.time;
-            group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * static_cast<float32>(random->RandFloat());
-            group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * static_cast<float32>(random->RandFloat());
-            currLoopTime = 0;
+            SimulateParticles(update, simulationScratch);
         }
+        return;
+    }
 
-        //prepare forces as they will now actually change in time even for already generated particles
-        static Vector<Vector3> currSimplifiedForceValues;
-        int32 simplifiedForcesCount;
-
-        static Vector<ParticleForce*> effectAlignCurrForces;
-        static Vector<ParticleForce*> worldAlignCurrForces;
-        uint32 forcesCountWorldAlign = 0;
-        uint32 effectAlignForcesCount = 0;
+    // Effects are independent during simulation, so they are split into tasks with roughly equal amount of particles
+    uint32 tasksCount = Min(workersCount, static_cast<uint32>(updates.size()));
+    uint32 particlesPerTask = (particlesCount + tasksCount - 1) / tasksCount;
+    workerScratches.resize(tasksCount);
 
-        static Matrix4 invWorld;
-        if (group.head)
+    JobGroup group;
+    size_t taskBegin = 0;
+    for (uint32 task = 0; task < tasksCount && taskBegin < updates.size(); ++task)
+    {
+        size_t taskEnd = taskBegin;
+        uint32 taskParticles = 0;
+        while (taskEnd < updates.size() && (taskEnd == taskBegin || taskParticles < particlesPerTask))
         {
-            simplifiedForcesCount = static_cast<int32>(group.layer->GetSimplifiedParticleForces().size());
-            if (simplifiedForcesCount)
-            {
-                currSimplifiedForceValues.resize(simplifiedForcesCount);
-                for (int32 i = 0; i < simplifiedForcesCount; ++i)
-                {
-                    if (group.layer->GetSimplifiedParticleForces()[i]->force)
-                        currSimplifiedForceValues[i] = group.layer->GetSimplifiedParticleForces()[i]->force->GetValue(currLoopTime);
-                    else
-                        currSimplifiedForceValues[i] = Vector3(0, 0, 0);
-                }
-            }
+            taskParticles += updates[taskEnd].particlesCount;
+            ++taskEnd;
+        }
+        if (task == tasksCount - 1)
+            taskEnd = updates.size();
 
-            uint32 allForcesCount = static_cast<uint32>(group.layer->GetParticleForces().size());
-            if (allForcesCount > 0)
+        SimulationScratch* scratch = &workerScratches[task];
+        jobManager->CreateWorkerTask([this, &updates, taskBegin, taskEnd, scratch]() {
+            for (size_t i = taskBegin; i < taskEnd; ++i)
             {
-                effectAlignCurrForces.resize(allForcesCount);
-                worldAlignCurrForces.resize(allForcesCount);
-                for (uint32 i = 0; i < allForcesCount; ++i)
-                {
-                    DAVA::ParticleForce* currForce = group.layer->GetParticleForces()[i];
-                    if (currForce->isGlobal)
-                        continue;
-
-                    if (currForce->worldAlign)
-                    {
-                        currForce->worldPosition = currForce->position + worldTransformPtr->GetTranslationVector(); // Ignore emitter rotation.
-                        worldAlignCurrForces[forcesCountWorldAlign] = currForce;
-                        ++forcesCountWorldAlign;
-                    }
-                    else
-                    {
-                        effectAlignCurrForces[effectAlignForcesCount] = currForce;
-                        ++effectAlignForcesCount;
-                        if (!isInverseCalculated)
-                        {
-                            invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
-                            isInverseCalculated = true;
-                        }
-                    }
-                }
+                SimulateParticles(updates[i], *scratch);
             }
+        }, &group);
+        taskBegin = taskEnd;
+    }
+    jobManager->WaitWorkerGroup(&group);
+}
+
+void ParticleEffectSystem::SimulateParticles(EffectUpdate& update, SimulationScratch& scratch) const
+{
+    for (ParticleGroup& group : update.effect->effectData.groups)
+    {
+        SimulateGroup(update, group, scratch);
+    }
+}
+
+void ParticleEffectSystem::SimulateGroup(EffectUpdate& update, ParticleGroup& group, SimulationScratch& scratch) const
+{
+    ParticleStorage& particles = group.particles;
+    if (particles.IsEmpty())
+        return;
+
+    ParticleLayer* layer = group.layer;
+    ParticleEffectData& effectData = update.effect->effectData;
+    float32 dt = group.emitter->shortEffect ? update.shortEffectTime : update.deltaTime;
+    float32 currLoopTime = group.time - group.loopStartTime;
+    float32 currLoopTimeNormalized = currLoopTime / (layer->endTime - layer->startTime);
+
+    ParticleKernels::Add(particles.life.data(), dt, particles.GetCount());
+    particles.RemoveDead();
+
+    uint32 count = particles.GetCount();
+    group.activeParticleCount = static_cast<int32>(count);
+    if (count == 0)
+        return;
+
+    scratch.overLife.resize(count);
+    ParticleKernels::ComputeOverLife(particles.life.data(), particles.lifeTime.data(), scratch.overLife.data(), count);
+    const float32* overLife = scratch.overLife.data();
+
+    //prepare forces as they will now actually change in time even for already generated particles
+    const Vector<ParticleForceSimplified*>& simplifiedForces = layer->GetSimplifiedParticleForces();
+    int32 simplifiedForcesCount = static_cast<int32>(simplifiedForces.size());
+    scratch.simplifiedForceValues.resize(simplifiedForcesCount);
+    for (int32 i = 0; i < simplifiedForcesCount; ++i)
+    {
+        if (simplifiedForces[i]->force)
+            scratch.simplifiedForceValues[i] = simplifiedForces[i]->force->Evaluate(currLoopTime);
+        else
+            scratch.simplifiedForceValues[i] = Vector3(0, 0, 0);
+    }
+
+    if (layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE)
+    {
+        UpdateRegularParticles(update, group, dt, currLoopTimeNormalized, scratch);
+    }
+
+    if (layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            ParentInfo& info = effectData.infoSources[particles.positionTarget[i]];
+            info.position = particles.GetPosition(i);
+            info.size = particles.GetSize(i);
         }
+    }
 
-        Particle* current = group.head;
-        Particle* prev = nullptr;
+    if (layer->enableNoise && layer->noise.get() != nullptr)
+    {
+        scratch.values.resize(count);
+        if (layer->noiseScaleOverLife != nullptr)
+        {
+            layer->noiseScaleOverLife->Evaluate(overLife, scratch.values.data(), count);
+            ParticleKernels::Multiply(particles.baseNoiseScale.data(), scratch.values.data(), particles.currNoiseScale.data(), count);
+        }
 
-        while (current)
+        const float32* overLifeScale = nullptr;
+        if (layer->noiseUScrollSpeedOverLife != nullptr)
         {
-            current->life += dt;
-            if (current->life >= current->lifeTime)
-            {
-                Particle* next = current->next;
-                if (prev == nullptr)
-                    group.head = next;
-                else
-                    prev->next = next;
-                delete current;
-                current = next;
-                continue;
-            }
-            group.activeParticleCount++;
+            layer->noiseUScrollSpeedOverLife->Evaluate(overLife, scratch.values.data(), count);
+            overLifeScale = scratch.values.data();
+        }
+        ParticleKernels::Integrate(particles.currNoiseUOffset.data(), particles.baseNoiseUScrollSpeed.data(), overLifeScale, update.deltaTime, count);
 
-            float32 overLifeTime = current->life / current->lifeTime;
+        overLifeScale = nullptr;
+        if (layer->noiseVScrollSpeedOverLife != nullptr)
+        {
+            layer->noiseVScrollSpeedOverLife->Evaluate(overLife, scratch.values.data(), count);
+            overLifeScale = scratch.values.data();
+        }
+        ParticleKernels::Integrate(particles.currNoiseVOffset.data(), particles.baseNoiseVScrollSpeed.data(), overLifeScale, update.deltaTime, count);
+    }
 
-            if (group.layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE)
+    if (layer->enableAlphaRemap && layer->alphaRemapSprite.get() != nullptr && layer->alphaRemapOverLife != nullptr)
+    {
+        scratch.values.resize(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float32 intPart;
+            scratch.values[i] = modff(overLife[i] * layer->alphaRemapLoopCount, &intPart);
+        }
+        layer->alphaRemapOverLife->Evaluate(scratch.values.data(), particles.alphaRemap.data(), count);
+    }
+
+    if (layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
+    {
+        bool isActive = layer->IsLodActive(update.effect->activeLodLevel);
+        for (uint32 i = count; i-- > 0;)
+        {
+            UpdateStripe(particles, i, effectData, group, update.deltaTime, update.bbox, scratch.simplifiedForceValues, simplifiedForcesCount, isActive);
+        }
+    }
+}
+
+void ParticleEffectSystem::UpdateRegularParticles(EffectUpdate& update, ParticleGroup& group, float32 dt, float32 layerOverLife, SimulationScratch& scratch) const
+{
+    ParticleLayer* layer = group.layer;
+    ParticleStorage& particles = group.particles;
+    uint32 count = particles.GetCount();
+    const float32* overLife = scratch.overLife.data();
+    const Matrix4& world = *update.worldTransform;
+
+    scratch.worldAlignForces.clear();
+    scratch.worldAlignForcePositions.clear();
+    scratch.effectAlignForces.clear();
+    for (ParticleForce* force : layer->GetParticleForces())
+    {
+        if (force->isGlobal)
+            continue;
+
+        if (force->worldAlign)
+        {
+            scratch.worldAlignForces.push_back(force);
+            scratch.worldAlignForcePositions.push_back(force->position + world.GetTranslationVector()); // Ignore emitter rotation.
+        }
+        else
+        {
+            scratch.effectAlignForces.push_back(force);
+        }
+    }
+
+    if (!scratch.effectAlignForces.empty() && !update.isInverseWorldCalculated)
+    {
+        update.invWorld = GetInverseWithRemovedScale(world);
+        update.isInverseWorldCalculated = true;
+    }
+
+    bool applyForces = !scratch.worldAlignForces.empty() || !scratch.effectAlignForces.empty() || layer->applyGlobalForces;
+    if (applyForces)
+    {
+        scratch.prevPositions.resize(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            scratch.prevPositions[i] = particles.GetPosition(i);
+        }
+    }
+
+    const float32* velocityScale = nullptr;
+    if (layer->velocityOverLife)
+    {
+        scratch.velocityScale.resize(count);
+        layer->velocityOverLife->Evaluate(overLife, scratch.velocityScale.data(), count);
+        velocityScale = scratch.velocityScale.data();
+    }
+    ParticleKernels::Integrate(particles.positionX.data(), particles.speedX.data(), velocityScale, dt, count);
+    ParticleKernels::Integrate(particles.positionY.data(), particles.speedY.data(), velocityScale, dt, count);
+    ParticleKernels::Integrate(particles.positionZ.data(), particles.speedZ.data(), velocityScale, dt, count);
+
+    const float32* spinScale = nullptr;
+    if (layer->spinOverLife)
+    {
+        scratch.values.resize(count);
+        layer->spinOverLife->Evaluate(overLife, scratch.values.data(), count);
+        spinScale = scratch.values.data();
+    }
+    ParticleKernels::Integrate(particles.angle.data(), particles.spin.data(), spinScale, dt, count);
+
+    const Vector<ParticleForceSimplified*>& simplifiedForces = layer->GetSimplifiedParticleForces();
+    bool hasAcceleration = !simplifiedForces.empty();
+    if (hasAcceleration)
+    {
+        scratch.accelerationX.assign(count, 0.0f);
+        scratch.accelerationY.assign(count, 0.0f);
+        scratch.accelerationZ.assign(count, 0.0f);
+        for (size_t i = 0; i < simplifiedForces.size(); ++i)
+        {
+            const float32* forceScale = nullptr;
+            if (simplifiedForces[i]->forceOverLife)
             {
-                UpdateRegularParticleData(effect, current, group, overLifeTime, simplifiedForcesCount, currSimplifiedForceValues, dt, bbox, effectAlignCurrForces, effectAlignForcesCount, worldAlignCurrForces, forcesCountWorldAlign, *worldTransformPtr, invWorld, currLoopTimeNormalized);
+                scratch.values.resize(count);
+                simplifiedForces[i]->forceOverLife->Evaluate(overLife, scratch.values.data(), count);
+                forceScale = scratch.values.data();
             }
+            ParticleKernels::AddScaled(scratch.accelerationX.data(), scratch.accelerationY.data(), scratch.accelerationZ.data(), scratch.simplifiedForceValues[i], forceScale, count);
+        }
+    }
+
+    if (applyForces)
+    {
+        const Matrix4& invWorld = update.invWorld;
+        Matrix3 worldRotation(world);
+        Matrix3 invWorldRotation(invWorld);
+        Vector3 effectSpaceDown = -Vector3(invWorld._20, invWorld._21, invWorld._22);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 position = particles.GetPosition(i);
+            Vector3 speed = particles.GetSpeed(i);
+            const Vector3& prevPosition = scratch.prevPositions[i];
+            ParticleForces::ParticleInfo info = { particles.life[i], particles.lifeTime[i], particles.seed[i] };
+
+            for (size_t f = 0; f < scratch.worldAlignForces.size(); ++f)
+                ParticleForces::ApplyForce(scratch.worldAlignForces[f], speed, position, dt, overLife[i], layerOverLife, Vector3(0.0f, 0.0f, -1.0f), info, prevPosition, scratch.worldAlignForcePositions[f]);
 
-            if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+            if (!scratch.effectAlignForces.empty())
             {
-                effect->effectData.infoSources[current->positionTarget].position = current->position;
-                effect->effectData.infoSources[current->positionTarget].size = current->currSize;
+                Vector3 prevEffectSpacePosition;
+                Vector3 effectSpacePosition = position * invWorld;
+                Vector3 effectSpaceSpeed = speed * invWorldRotation;
+                if (layer->GetPlaneCollisiontForcesCount() > 0)
+                    prevEffectSpacePosition = prevPosition * invWorld;
+
+                for (ParticleForce* force : scratch.effectAlignForces)
+                    ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife[i], layerOverLife, effectSpaceDown, info, prevEffectSpacePosition, force->position);
+
+                speed = effectSpaceSpeed * worldRotation;
+                if (layer->GetAlterPositionForcesCount() > 0)
+                    position = effectSpacePosition * world;
             }
 
-            if (group.layer->enableNoise && group.layer->noise.get() != nullptr)
-            {
-                if (group.layer->noiseScaleOverLife != nullptr)
-                    current->currNoiseScale = current->baseNoiseScale * group.layer->noiseScaleOverLife->GetValue(overLifeTime);
+            if (layer->applyGlobalForces)
+                ApplyGlobalForces(speed, position, info, dt, overLife[i], layerOverLife, prevPosition);
 
-                DAVA::float32 overLifeScale = 1.0f;
-                if (group.layer->noiseUScrollSpeedOverLife != nullptr)
-                {
-                    overLifeScale = group.layer->noiseUScrollSpeedOverLife->GetValue(overLifeTime);
-                }
-                current->currNoiseUOffset += current->baseNoiseUScrollSpeed * overLifeScale * deltaTime;
+            particles.SetPosition(i, position);
+            particles.SetSpeed(i, speed);
+            particles.life[i] = info.life;
+        }
+    }
+
+    if (hasAcceleration)
+    {
+        ParticleKernels::Integrate(particles.speedX.data(), scratch.accelerationX.data(), nullptr, dt, count);
+        ParticleKernels::Integrate(particles.speedY.data(), scratch.accelerationY.data(), nullptr, dt, count);
+        ParticleKernels::Integrate(particles.speedZ.data(), scratch.accelerationZ.data(), nullptr, dt, count);
+    }
 
-                overLifeScale = 1.0f;
-                if (group.layer->noiseVScrollSpeedOverLife != nullptr)
+    if (layer->sizeOverLifeXY)
+    {
+        scratch.sizeScale.resize(count);
+        layer->sizeOverLifeXY->Evaluate(overLife, scratch.sizeScale.data(), count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            particles.currSizeX[i] = particles.baseSizeX[i] * scratch.sizeScale[i].x;
+            particles.currSizeY[i] = particles.baseSizeY[i] * scratch.sizeScale[i].y;
+        }
+        ParticleKernels::ComputeRadius(particles.currSizeX.data(), particles.currSizeY.data(), layer->layerPivotSizeOffsets, particles.currRadius.data(), count);
+    }
+
+    Vector3 bboxOffset;
+    if (layer->GetInheritPosition())
+        bboxOffset = update.effect->effectData.infoSources[group.positionSource].position;
+    ParticleKernels::AccumulateBBox(particles.positionX.data(), particles.positionY.data(), particles.positionZ.data(), particles.currRadius.data(), bboxOffset, update.bbox, count);
+
+    if (layer->frameOverLifeEnabled && layer->sprite)
+    {
+        const float32* animSpeedScale = nullptr;
+        if (layer->animSpeedOverLife)
+        {
+            scratch.values.resize(count);
+            layer->animSpeedOverLife->Evaluate(overLife, scratch.values.data(), count);
+            animSpeedScale = scratch.values.data();
+        }
+
+        int32 framesCount = layer->sprite->GetFrameCount();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float32 animDelta = layer->frameOverLifeFPS;
+            if (animSpeedScale != nullptr)
+                animDelta *= animSpeedScale[i];
+            particles.animTime[i] += animDelta * dt;
+
+            while (particles.animTime[i] > 1.0f)
+            {
+                particles.frame[i]++;
+                particles.animTime[i] -= 1.0f;
+                if (particles.frame[i] >= framesCount)
                 {
-                    overLifeScale = group.layer->noiseVScrollSpeedOverLife->GetValue(overLifeTime);
+                    if (layer->loopSpriteAnimation)
+                        particles.frame[i] = 0;
+                    else
+                        particles.frame[i] = framesCount - 1;
                 }
-                current->currNoiseVOffset += current->baseNoiseVScrollSpeed * overLifeScale * deltaTime;
             }
+        }
+    }
+}
 
-            if (group.layer->enableAlphaRemap && group.layer->alphaRemapSprite.get() != nullptr && group.layer->alphaRemapOverLife != nullptr)
-            {
-                float32 lookup = overLifeTime * group.layer->alphaRemapLoopCount;
-                float32 intPart;
-                current->alphaRemap = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
-            }
+void ParticleEffectSystem::EndEffectUpdate(EffectUpdate& update)
+{
+    ParticleEffectComponent* effect = update.effect;
+    const Matrix4& worldTransform = *update.worldTransform;
+    ParticleEffectData& effectData = effect->effectData;
+    Random* random = GetEngineContext()->random;
 
-            if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
-                UpdateStripe(current, effect->effectData, group, deltaTime, bbox, currSimplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
+    uint32 groupIndex = 0;
+    List<ParticleGroup>::iterator it = effectData.groups.begin();
+    while (it != effectData.groups.end())
+    {
+        ParticleGroup& group = *it;
+        if (groupIndex >= update.groupsCount) // group was started by superemitter particle generated during this update
+            BeginGroupUpdate(group, update);
+        ++groupIndex;
+
+        float32 dt = group.emitter->shortEffect ? update.shortEffectTime : update.deltaTime;
+        float32 currLoopTime = group.time - group.loopStartTime;
 
-            prev = current;
-            current = current->next;
-        }
         bool allowParticleGeneration = !group.finishingGroup;
         allowParticleGeneration &= (currLoopTime > group.loopLayerStartTime);
         allowParticleGeneration &= group.visibleLod;
@@ -676,13 +926,10 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         {
             if (group.layer->type == ParticleLayer::TYPE_SINGLE_PARTICLE || group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
             {
-                if (!group.head)
+                if (group.particles.IsEmpty())
                 {
-                    current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr);
-                    if (group.layer->GetInheritPosition())
-                        AddParticleToBBox(current->position + effect->effectData.infoSources[group.positionSource].position, current->currRadius, bbox);
-                    else
-                        AddParticleToBBox(current->position, current->currRadius, bbox);
+                    uint32 index = GenerateNewParticle(effect, group, currLoopTime, worldTransform);
+                    AddNewParticleToBBox(effectData, group, index, update.bbox);
                 }
             }
             else
@@ -699,40 +946,47 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
                 while (group.particlesToGenerate >= 1.0f)
                 {
                     group.particlesToGenerate -= 1.0f;
-                    current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr);
-                    if (group.layer->GetInheritPosition())
-                        AddParticleToBBox(current->position + effect->effectData.infoSources[group.positionSource].position, current->currRadius, bbox);
-                    else
-                        AddParticleToBBox(current->position, current->currRadius, bbox);
+                    uint32 index = GenerateNewParticle(effect, group, currLoopTime, worldTransform);
+                    AddNewParticleToBBox(effectData, group, index, update.bbox);
                 }
             }
         }
 
-        if (group.finishingGroup && (group.head == nullptr))
+        if (group.finishingGroup && group.particles.IsEmpty())
         {
             DAVA::SafeRelease(group.emitter);
             DAVA::SafeRelease(group.layer);
-            it = effect->effectData.groups.erase(it);
+            it = effectData.groups.erase(it);
         }
         else
         {
             ++it;
         }
     }
-    if (bbox.IsEmpty())
+
+    if (update.bbox.IsEmpty())
     {
-        Vector3 pos = worldTransformPtr->GetTranslationVector();
-        bbox = AABBox3(pos, pos);
+        Vector3 pos = worldTransform.GetTranslationVector();
+        update.bbox = AABBox3(pos, pos);
     }
-    effect->effectRenderObject->SetAABBox(bbox);
+    effect->effectRenderObject->SetAABBox(update.bbox);
 }
 
-void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive)
+void ParticleEffectSystem::AddNewParticleToBBox(const ParticleEffectData& effectData, const ParticleGroup& group, uint32 index, AABBox3& bbox) const
+{
+    Vector3 position = group.particles.GetPosition(index);
+    if (group.layer->GetInheritPosition())
+        position += effectData.infoSources[group.positionSource].position;
+    AddParticleToBBox(position, group.particles.currRadius[index], bbox);
+}
+
+void ParticleEffectSystem::UpdateStripe(const ParticleStorage& particles, uint32 index, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive) const
 {
     ParticleLayer* layer = group.layer;
     StripeData& data = group.stripe;
+    Vector3 particleSpeed = particles.GetSpeed(index);
     Vector3 prevBasePosition = data.baseNode.position;
-    data.baseNode.position = particle->position;
+    data.baseNode.position = particles.GetPosition(index);
     data.isActive = isActive;
 
     if (layer->GetInheritPosition())
@@ -745,7 +999,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
         data.baseNode.position = effectData.infoSources[group.positionSource].position;
     }
 
-    data.baseNode.speed = particle->speed;
+    data.baseNode.speed = particleSpeed;
 
     bool shouldInsert = data.stripeNodes.empty() || (data.baseNode.position - data.stripeNodes.front().position).SquareLength() > layer->stripeVertexSpawnStep * layer->stripeVertexSpawnStep;
 
@@ -772,7 +1026,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
 
         float32 currVelocityOverLife = 1.0f;
         if (layer->velocityOverLife)
-            currVelocityOverLife = layer->velocityOverLife->GetValue(overLife);
+            currVelocityOverLife = layer->velocityOverLife->Evaluate(overLife);
         nodeIter->position += nodeIter->speed * (currVelocityOverLife * dt);
 
         if (nodeIter == data.stripeNodes.begin())
@@ -783,7 +1037,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
             Vector3 acceleration;
             for (int32 i = 0; i < forcesCount; ++i)
             {
-                acceleration += (layer->GetSimplifiedParticleForces()[i]->forceOverLife) ? (currForceValues[i] * layer->GetSimplifiedParticleForces()[i]->forceOverLife->GetValue(overLife)) : currForceValues[i];
+                acceleration += (layer->GetSimplifiedParticleForces()[i]->forceOverLife) ? (currForceValues[i] * layer->GetSimplifiedParticleForces()[i]->forceOverLife->Evaluate(overLife)) : currForceValues[i];
             }
             nodeIter->speed += acceleration * dt;
         }
@@ -814,7 +1068,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
         else
         {
             float32 delta = (data.baseNode.position - prevBasePosition).Length();
-            if (particle->speed.DotProduct(data.baseNode.position - prevBasePosition) <= 0)
+            if (particleSpeed.DotProduct(data.baseNode.position - prevBasePosition) <= 0)
             {
                 data.uvOffset -= delta;
             }
@@ -826,105 +1080,105 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
     }
 }
 
-void ParticleEffectSystem::AddParticleToBBox(const Vector3& position, float radius, AABBox3& bbox)
+void ParticleEffectSystem::AddParticleToBBox(const Vector3& position, float radius, AABBox3& bbox) const
 {
     Vector3 sz = Vector3(radius, radius, radius);
     bbox.AddPoint(position - sz);
     bbox.AddPoint(position + sz);
 }
 
-Particle* ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform)
+uint32 ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform)
 {
-    Particle* particle = new Particle();
-    particle->life = 0.0f;
+    Particle particle;
+    particle.life = 0.0f;
 
-    particle->color = Color();
+    particle.color = Color();
     if (group.layer->colorRandom)
     {
-        particle->color = group.layer->colorRandom->GetValue(static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particle.color = group.layer->colorRandom->GetValue(static_cast<float32>(GetEngineContext()->random->RandFloat()));
     }
     if (group.emitter->colorOverLife)
     {
-        particle->color *= group.emitter->colorOverLife->GetValue(group.time);
+        particle.color *= group.emitter->colorOverLife->GetValue(group.time);
     }
 
-    particle->lifeTime = 0.0f;
+    particle.lifeTime = 0.0f;
     if (group.layer->life)
-        particle->lifeTime += group.layer->life->GetValue(currLoopTime);
+        particle.lifeTime += group.layer->life->GetValue(currLoopTime);
     if (group.layer->lifeVariation)
-        particle->lifeTime += (group.layer->lifeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particle.lifeTime += (group.layer->lifeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
 
     // Flow.
-    particle->baseFlowSpeed = 0.0f;
+    particle.baseFlowSpeed = 0.0f;
     if (group.layer->flowSpeed)
-        particle->baseFlowSpeed += group.layer->flowSpeed->GetValue(currLoopTime);
+        particle.baseFlowSpeed += group.layer->flowSpeed->GetValue(currLoopTime);
     if (group.layer->flowSpeedVariation)
-        particle->baseFlowSpeed += (group.layer->flowSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currFlowSpeed = particle->baseFlowSpeed;
+        particle.baseFlowSpeed += (group.layer->flowSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+    particle.currFlowSpeed = particle.baseFlowSpeed;
 
-    particle->baseFlowOffset = 0.0f;
+    particle.baseFlowOffset = 0.0f;
     if (group.layer->flowOffset)
-        particle->baseFlowOffset += group.layer->flowOffset->GetValue(currLoopTime);
+        particle.baseFlowOffset += group.layer->flowOffset->GetValue(currLoopTime);
     if (group.layer->flowOffsetVariation)
-        particle->baseFlowOffset += (group.layer->flowOffsetVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currFlowOffset = particle->baseFlowOffset;
+        particle.baseFlowOffset += (group.layer->flowOffsetVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+    particle.currFlowOffset = particle.baseFlowOffset;
 
     // Noise.
-    particle->baseNoiseScale = 0.0f;
+    particle.baseNoiseScale = 0.0f;
     if (group.layer->noiseScale)
-        particle->baseNoiseScale += group.layer->noiseScale->GetValue(currLoopTime);
+        particle.baseNoiseScale += group.layer->noiseScale->GetValue(currLoopTime);
     if (group.layer->noiseScaleVariation)
-        particle->baseNoiseScale += (group.layer->noiseScaleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseScale = particle->baseNoiseScale;
+        particle.baseNoiseScale += (group.layer->noiseScaleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+    particle.currNoiseScale = particle.baseNoiseScale;
 
-    particle->baseNoiseUScrollSpeed = 0.0f;
+    particle.baseNoiseUScrollSpeed = 0.0f;
     if (group.layer->noiseUScrollSpeed)
-        particle->baseNoiseUScrollSpeed += group.layer->noiseUScrollSpeed->GetValue(currLoopTime);
+        particle.baseNoiseUScrollSpeed += group.layer->noiseUScrollSpeed->GetValue(currLoopTime);
     if (group.layer->noiseUScrollSpeedVariation)
-        particle->baseNoiseUScrollSpeed += (group.layer->noiseUScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseUOffset = particle->baseNoiseUScrollSpeed;
+        particle.baseNoiseUScrollSpeed += (group.layer->noiseUScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+    particle.currNoiseUOffset = particle.baseNoiseUScrollSpeed;
 
-    particle->baseNoiseVScrollSpeed = 0.0f;
+    particle.baseNoiseVScrollSpeed = 0.0f;
     if (group.layer->noiseVScrollSpeed)
-        particle->baseNoiseVScrollSpeed += group.layer->noiseVScrollSpeed->GetValue(currLoopTime);
+        particle.baseNoiseVScrollSpeed += group.layer->noiseVScrollSpeed->GetValue(currLoopTime);
     if (group.layer->noiseVScrollSpeedVariation)
-        particle->baseNoiseVScrollSpeed += (group.layer->noiseVScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseVOffset = particle->baseNoiseVScrollSpeed;
+        particle.baseNoiseVScrollSpeed += (group.layer->noiseVScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+    particle.currNoiseVOffset = particle.baseNoiseVScrollSpeed;
 
     // size
-    particle->baseSize = Vector2(1.0f, 1.0f);
+    particle.baseSize = Vector2(1.0f, 1.0f);
     if (group.layer->size)
-        particle->baseSize = group.layer->size->GetValue(currLoopTime);
+        particle.baseSize = group.layer->size->GetValue(currLoopTime);
     if (group.layer->sizeVariation)
-        particle->baseSize += (group.layer->sizeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->baseSize *= effect->effectData.infoSources[group.positionSource].size;
+        particle.baseSize += (group.layer->sizeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+    particle.baseSize *= effect->effectData.infoSources[group.positionSource].size;
 
-    particle->currSize = particle->baseSize;
+    particle.currSize = particle.baseSize;
     if (group.layer->sizeOverLifeXY)
-        particle->currSize *= group.layer->sizeOverLifeXY->GetValue(0);
-    Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
-    particle->currRadius = pivotSize.Length();
+        particle.currSize *= group.layer->sizeOverLifeXY->GetValue(0);
+    Vector2 pivotSize = particle.currSize * group.layer->layerPivotSizeOffsets;
+    particle.currRadius = pivotSize.Length();
 
-    particle->angle = 0.0f;
-    particle->spin = 0.0f;
+    particle.angle = 0.0f;
+    particle.spin = 0.0f;
     if (group.layer->angle)
-        particle->angle = DegToRad(group.layer->angle->GetValue(currLoopTime));
+        particle.angle = DegToRad(group.layer->angle->GetValue(currLoopTime));
     if (group.layer->angleVariation)
-        particle->angle += DegToRad(group.layer->angleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particle.angle += DegToRad(group.layer->angleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
     if (group.layer->spin)
-        particle->spin = DegToRad(group.layer->spin->GetValue(currLoopTime));
+        particle.spin = DegToRad(group.layer->spin->GetValue(currLoopTime));
     if (group.layer->spinVariation)
-        particle->spin += DegToRad(group.layer->spinVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particle.spin += DegToRad(group.layer->spinVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
     if (group.layer->randomSpinDirection)
     {
         int32 dir = Rand() & 1;
-        particle->spin *= (dir)*2 - 1;
+        particle.spin *= (dir)*2 - 1;
     }
-    particle->frame = 0;
-    particle->animTime = 0;
+    particle.frame = 0;
+    particle.animTime = 0;
     if (group.layer->randomFrameOnStart && group.layer->sprite)
     {
-        particle->frame = static_cast<int32>(static_cast<float32>(GetEngineContext()->random->RandFloat()) * static_cast<float32>(group.layer->sprite->GetFrameCount()));
+        particle.frame = static_cast<int32>(static_cast<float32>(GetEngineContext()->random->RandFloat()) * static_cast<float32>(group.layer->sprite->GetFrameCount()));
     }
 
     PrepareEmitterParameters(particle, group, worldTransform);
@@ -934,113 +1188,41 @@ Particle* ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* eff
         vel += group.layer->velocity->GetValue(currLoopTime);
     if (group.layer->velocityVariation)
         vel += (group.layer->velocityVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->speed *= vel;
+    particle.speed *= vel;
 
     if (!group.layer->GetInheritPosition()) //just generate at correct position
     {
-        particle->position += effect->effectData.infoSources[group.positionSource].position;
+        particle.position += effect->effectData.infoSources[group.positionSource].position;
     }
 
-    particle->next = group.head;
-    group.head = particle;
-    group.activeParticleCount++;
-    if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+    particle.seed = GetEngineContext()->random->Rand();
+
+    bool isSuperemitterParticle = (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES);
+    if (isSuperemitterParticle)
     {
         ParentInfo info;
-        info.position = particle->position;
-        info.size = particle->currSize;
+        info.position = particle.position;
+        info.size = particle.currSize;
         effect->effectData.infoSources.push_back(info);
-        particle->positionTarget = static_cast<int32>(effect->effectData.infoSources.size() - 1);
-        ParticleEmitter* innerEmitter = group.layer->innerEmitter->GetEmitter();
-        if (innerEmitter)
-            RunEmitter(effect, innerEmitter, Vector3(0, 0, 0), particle->positionTarget);
-    }
-
-    group.particlesGenerated++;
-    return particle;
-}
-
-void ParticleEffectSystem::UpdateRegularParticleData(ParticleEffectComponent* effect, Particle* particle, const ParticleGroup& group, float32 overLife, int32 simplifiedForcesCount, Vector<Vector3>& currSimplifiedForceValues, float32 dt, AABBox3& bbox, const Vector<ParticleForce*>& effectAlignForces, uint32 effectAlignForcesCount, const Vector<ParticleForce*>& worldAlignForces, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife)
-{
-    float32 currVelocityOverLife = 1.0f;
-    if (group.layer->velocityOverLife)
-        currVelocityOverLife = group.layer->velocityOverLife->GetValue(overLife);
-    Vector3 prevParticlePosition = particle->position;
-    particle->position += particle->speed * (currVelocityOverLife * dt);
-
-    float32 currSpinOverLife = 1.0f;
-    if (group.layer->spinOverLife)
-        currSpinOverLife = group.layer->spinOverLife->GetValue(overLife);
-    particle->angle += particle->spin * currSpinOverLife * dt;
-
-    Vector3 acceleration(0.0f, 0.0f, 0.0f);
-    for (int32 i = 0; i < simplifiedForcesCount; ++i)
-    {
-        acceleration += (group.layer->GetSimplifiedParticleForces()[i]->forceOverLife) ? (currSimplifiedForceValues[i] * group.layer->GetSimplifiedParticleForces()[i]->forceOverLife->GetValue(overLife)) : currSimplifiedForceValues[i];
+        particle.positionTarget = static_cast<int32>(effect->effectData.infoSources.size() - 1);
     }
 
-    for (uint32 i = 0; i < worldAlignForcesCount; ++i)
-        ParticleForces::ApplyForce(worldAlignForces[i], particle->speed, particle->position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, worldAlignForces[i]->worldPosition);
-
-    if (effectAlignForcesCount > 0)
-    {
-        Vector3 effectSpacePosition;
-        Vector3 prevEffectSpacePosition;
-        Vector3 effectSpaceSpeed;
-        effectSpacePosition = particle->position * invWorld;
-        effectSpaceSpeed = particle->speed * Matrix3(invWorld);
-        if (group.layer->GetPlaneCollisiontForcesCount() > 0)
-            prevEffectSpacePosition = prevParticlePosition * invWorld;
-
-        for (uint32 i = 0; i < effectAlignForcesCount; ++i)
-            ParticleForces::ApplyForce(effectAlignForces[i], effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particle, prevEffectSpacePosition, effectAlignForces[i]->position);
-
-        particle->speed = effectSpaceSpeed * Matrix3(world);
-        if (group.layer->GetAlterPositionForcesCount() > 0)
-            particle->position = effectSpacePosition * world;
-    }
-
-    if (group.layer->applyGlobalForces)
-        ApplyGlobalForces(particle, dt, overLife, layerOverLife, prevParticlePosition);
-
-    particle->speed += acceleration * dt;
-
-    if (group.layer->sizeOverLifeXY)
+    uint32 index = group.particles.Add(particle);
+    group.activeParticleCount++;
+    if (isSuperemitterParticle)
     {
-        particle->currSize = particle->baseSize * group.layer->sizeOverLifeXY->GetValue(overLife);
-        Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
-        particle->currRadius = pivotSize.Length();
+        ParticleEmitter* innerEmitter = group.layer->innerEmitter->GetEmitter();
+        if (innerEmitter)
+            RunEmitter(effect, innerEmitter, Vector3(0, 0, 0), particle.positionTarget);
     }
-    if (group.layer->GetInheritPosition())
-        AddParticleToBBox(particle->position + effect->effectData.infoSources[group.positionSource].position, particle->currRadius, bbox);
-    else
-        AddParticleToBBox(particle->position, particle->currRadius, bbox);
-
-    if (group.layer->frameOverLifeEnabled && group.layer->sprite)
-    {
-        float32 animDelta = group.layer->frameOverLifeFPS;
-        if (group.layer->animSpeedOverLife)
-            animDelta *= group.layer->animSpeedOverLife->GetValue(overLife);
-        particle->animTime += animDelta * dt;
 
-        while (particle->animTime > 1.0f)
-        {
-            particle->frame++;
-            particle->animTime -= 1.0f;
-            if (particle->frame >= group.layer->sprite->GetFrameCount())
-            {
-                if (group.layer->loopSpriteAnimation)
-                    particle->frame = 0;
-                else
-                    particle->frame = group.layer->sprite->GetFrameCount() - 1;
-            }
-        }
-    }
+    group.particlesGenerated++;
+    return index;
 }
 
-void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition)
+void ParticleEffectSystem::ApplyGlobalForces(Vector3& speed, Vector3& position, ParticleForces::ParticleInfo& particle, float32 dt, float32 overLife, float32 layerOverLife, const Vector3& prevParticlePosition) const
 {
-    for (auto& forcePair : globalForces)
+    for (const auto& forcePair : globalForces)
     {
         ParticleEffectComponent* effect = forcePair.first;
         TransformComponent* tr = GetTransformComponent(effect->GetEntity());
@@ -1049,8 +1231,8 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
         for (ParticleForce* force : forcePair.second.worldAlignForces)
         {
             Vector3 forceWorldPosition = worldTransformPtr->GetTranslationVector() + force->position;
-            if (force->isInfinityRange || (forceWorldPosition - particle->position).SquareLength() < force->GetSquaredRadius())
-                ParticleForces::ApplyForce(force, particle->speed, particle->position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, forceWorldPosition);
+            if (force->isInfinityRange || (forceWorldPosition - position).SquareLength() < force->GetSquaredRadius())
+                ParticleForces::ApplyForce(force, speed, position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, forceWorldPosition);
         }
 
         if (!forcePair.second.effectAlignForces.empty())
@@ -1064,7 +1246,7 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
                     break;
                 }
                 Vector3 forceWorldPosition = worldTransformPtr->GetTranslationVector() + force->position; // Do not rotate global forces if force position is not zero.
-                float32 sqrDist = (forceWorldPosition - particle->position).SquareLength();
+                float32 sqrDist = (forceWorldPosition - position).SquareLength();
                 if (sqrDist < force->GetSquaredRadius())
                 {
                     inForceBoundingSphere = true;
@@ -1076,9 +1258,9 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
 
             Matrix4 invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
 
-            Vector3 effectSpacePosition = particle->position * invWorld;
+            Vector3 effectSpacePosition = position * invWorld;
             Vector3 prevEffectSpacePosition = prevParticlePosition * invWorld;
-            Vector3 effectSpaceSpeed = particle->speed * Matrix3(invWorld);
+            Vector3 effectSpaceSpeed = speed * Matrix3(invWorld);
             bool transformPosition = false;
             for (ParticleForce* force : forcePair.second.effectAlignForces)
             {
@@ -1086,14 +1268,14 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
                     transformPosition = true;
                 ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particle, prevEffectSpacePosition, force->position);
             }
-            particle->speed = effectSpaceSpeed * Matrix3(*worldTransformPtr);
+            speed = effectSpaceSpeed * Matrix3(*worldTransformPtr);
             if (transformPosition)
-                particle->position = effectSpacePosition * (*worldTransformPtr);
+                position = effectSpacePosition * (*worldTransformPtr);
         }
     }
 }
 
-void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, ParticleGroup& group, const Matrix4& worldTransform)
+void ParticleEffectSystem::PrepareEmitterParameters(Particle& particle, ParticleGroup& group, const Matrix4& worldTransform)
 {
     //calculate position new particle position in emitter space (for point leave it V3(0,0,0))
     uintptr_t uptr = reinterpret_cast<uintptr_t>(&group);
@@ -1106,7 +1288,7 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         if (group.emitter->size)
         {
             Vector3 currSize = group.emitter->size->GetValue(group.time);
-            particle->position = Vector3(currSize.x * (ParticlesRandom::VanDerCorputRnd(ind, 3) - 0.5f), currSize.y * (ParticlesRandom::VanDerCorputRnd(ind, 2) - 0.5f), currSize.z * (ParticlesRandom::VanDerCorputRnd(ind, 5) - 0.5f));
+            particle.position = Vector3(currSize.x * (ParticlesRandom::VanDerCorputRnd(ind, 3) - 0.5f), currSize.y * (ParticlesRandom::VanDerCorputRnd(ind, 2) - 0.5f), currSize.z * (ParticlesRandom::VanDerCorputRnd(ind, 5) - 0.5f));
         }
     }
     else if ((group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_VOLUME) || (group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_EDGES) || (group.emitter->emitterType == ParticleEmitter::EMITTER_SHOCKWAVE))
@@ -1138,7 +1320,7 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         float32 sinAngle = 0.0f;
         float32 cosAngle = 0.0f;
         SinCosFast(curAngle, sinAngle, cosAngle);
-        particle->position = Vector3(curRadius * cosAngle, curRadius * sinAngle, 0.0f);
+        particle.position = Vector3(curRadius * cosAngle, curRadius * sinAngle, 0.0f);
     }
 
     //current emission vector and it's length
@@ -1158,11 +1340,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
     //calculate speed in emitter space not transformed by emission vector yet
     if (group.emitter->emitterType == ParticleEmitter::EMITTER_SHOCKWAVE)
     {
-        particle->speed = particle->position;
-        float32 spl = particle->speed.SquareLength();
+        particle.speed = particle.position;
+        float32 spl = particle.speed.SquareLength();
         if (spl > EPSILON)
         {
-            particle->speed *= currVelPower / std::sqrt(spl);
+            particle.speed *= currVelPower / std::sqrt(spl);
         }
     }
     else
@@ -1171,11 +1353,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         {
             float32 theta = ParticlesRandom::VanDerCorputRnd(ind, 3) * DegToRad(group.emitter->emissionRange->GetValue(group.time)) * 0.5f;
             float32 phi = ParticlesRandom::VanDerCorputRnd(ind, 4) * PI_2;
-            particle->speed = Vector3(currVelPower * cos(phi) * sin(theta), currVelPower * sin(phi) * sin(theta), currVelPower * cos(theta));
+            particle.speed = Vector3(currVelPower * cos(phi) * sin(theta), currVelPower * sin(phi) * sin(theta), currVelPower * cos(theta));
         }
         else
         {
-            particle->speed = Vector3(0, 0, currVelPower);
+            particle.speed = Vector3(0, 0, currVelPower);
         }
     }
 
@@ -1187,19 +1369,19 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
     {
         if (currEmissionVector.z < 0)
         {
-            particle->position = particle->position * PIRotationAroundX;
+            particle.position = particle.position * PIRotationAroundX;
 
             if (!hasCustomEmissionVector)
-                particle->speed = particle->speed * PIRotationAroundX;
+                particle.speed = particle.speed * PIRotationAroundX;
         }
     }
     else
     {
         Matrix3 rotation = ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currEmissionVector, currEmissionPower);
-        particle->position = particle->position * rotation;
+        particle.position = particle.position * rotation;
 
         if (!hasCustomEmissionVector)
-            particle->speed = particle->speed * rotation;
+            particle.speed = particle.speed * rotation;
     }
 
     if (hasCustomEmissionVector)
@@ -1207,16 +1389,16 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         if ((std::abs(currVelVector.x) < EPSILON) && (std::abs(currVelVector.y) < EPSILON))
         {
             if (currVelVector.z < 0)
-                particle->speed = particle->speed * PIRotationAroundX;
+                particle.speed = particle.speed * PIRotationAroundX;
         }
         else
         {
-            particle->speed = particle->speed * ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currVelVector, currVelPower);
+            particle.speed = particle.speed * ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currVelVector, currVelPower);
         }
     }
-    particle->position += group.spawnPosition;
-    TransformPerserveLength(particle->speed, newTransform);
-    TransformPerserveLength(particle->position, newTransform); //note - from now emitter position is not effected by scale anymore (artist request)
+    particle.position += group.spawnPosition;
+    TransformPerserveLength(particle.speed, newTransform);
+    TransformPerserveLength(particle.position, newTransform); //note - from now emitter position is not effected by scale anymore (artist request)
 }
 
 void ParticleEffectSystem::SetGlobalExtertnalValue(const String& name, float32 value)
@@ -3,6 +3,7 @@
 #include "Base/BaseTypes.h"
 #include "Entity/SceneSystem.h"
 #include "Scene3D/Components/ParticleEffectComponent.h"
+#include "Particles/ParticleForces.h"
 
 namespace DAVA
 {
@@ -79,6 +80,13 @@ public:
     inline void SetAllowLodDegrade(bool allowDegrade);
     inline bool GetAllowLodDegrade() const;
 
+    /**
+        Enable simulation of particles of different effects on job workers.
+        Particles generation and effects lifetime handling are always done on the calling thread. Enabled by default.
+    */
+    inline void SetParallelUpdateEnabled(bool enabled);
+    inline bool IsParallelUpdateEnabled() const;
+
     inline const Vector<std::pair<MaterialData, NMaterial*>>& GetMaterialInstances() const;
 
     void PrebuildMaterials(ParticleEffectComponent* component);
@@ -90,17 +98,60 @@ protected:
 
     void UpdateActiveLod(ParticleEffectComponent* effect);
     void UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime);
-    Particle* GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform);
-    void UpdateRegularParticleData(ParticleEffectComponent* effect, Particle* particle, const ParticleGroup& group, float32 overLife, int32 simplifiedForcesCount, Vector<Vector3>& currSimplifiedForceValues, float32 dt, AABBox3& bbox, const Vector<ParticleForce*>& effectAlignForces, uint32 effectAlignForcesCount, const Vector<ParticleForce*>& worldAlignForces, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife);
+    uint32 GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform);
 
-    void PrepareEmitterParameters(Particle* particle, ParticleGroup& group, const Matrix4& worldTransform);
-    void AddParticleToBBox(const Vector3& position, float radius, AABBox3& bbox);
+    void PrepareEmitterParameters(Particle& particle, ParticleGroup& group, const Matrix4& worldTransform);
+    void AddParticleToBBox(const Vector3& position, float radius, AABBox3& bbox) const;
 
     void RunEmitter(ParticleEffectComponent* effect, ParticleEmitter* emitter, const Vector3& spawnPosition, int32 positionSource = 0);
 
 private:
-    void ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition);
-    void UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive);
+    /** Per thread buffers for simulation of one group, reused between groups and frames. */
+    struct SimulationScratch
+    {
+        Vector<float32> overLife;
+        Vector<float32> values;
+        Vector<float32> velocityScale;
+        Vector<float32> accelerationX;
+        Vector<float32> accelerationY;
+        Vector<float32> accelerationZ;
+        Vector<Vector2> sizeScale;
+        Vector<Vector3> prevPositions;
+        Vector<Vector3> simplifiedForceValues;
+        Vector<ParticleForce*> worldAlignForces;
+        Vector<Vector3> worldAlignForcePositions;
+        Vector<ParticleForce*> effectAlignForces;
+    };
+
+    /**
+        State of one effect update. Update is split into three stages:
+        `BeginEffectUpdate` and `EndEffectUpdate` advance groups time, generate particles and start new groups and use shared state (random, materials),
+        `SimulateParticles` moves existing particles of the effect only and can run on job worker in parallel with other effects.
+    */
+    struct EffectUpdate
+    {
+        ParticleEffectComponent* effect = nullptr;
+        float32 deltaTime = 0.0f;
+        float32 shortEffectTime = 0.0f;
+        const Matrix4* worldTransform = nullptr;
+        Matrix4 invWorld;
+        bool isInverseWorldCalculated = false;
+        AABBox3 bbox;
+        uint32 groupsCount = 0;
+        uint32 particlesCount = 0;
+    };
+
+    void BeginEffectUpdate(EffectUpdate& update);
+    void BeginGroupUpdate(ParticleGroup& group, const EffectUpdate& update);
+    void SimulateEffects(Vector<EffectUpdate>& updates);
+    void SimulateParticles(EffectUpdate& update, SimulationScratch& scratch) const;
+    void SimulateGroup(EffectUpdate& update, ParticleGroup& group, SimulationScratch& scratch) const;
+    void UpdateRegularParticles(EffectUpdate& update, ParticleGroup& group, float32 dt, float32 layerOverLife, SimulationScratch& scratch) const;
+    void EndEffectUpdate(EffectUpdate& update);
+    void AddNewParticleToBBox(const ParticleEffectData& effectData, const ParticleGroup& group, uint32 index, AABBox3& bbox) const;
+
+    void ApplyGlobalForces(Vector3& speed, Vector3& position, ParticleForces::ParticleInfo& particle, float32 dt, float32 overLife, float32 layerOverLife, const Vector3& prevParticlePosition) const;
+    void UpdateStripe(const ParticleStorage& particles, uint32 index, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive) const;
     void SimulateEffect(ParticleEffectComponent* effect);
 
     Map<String, float32> globalExternalValues;
@@ -122,6 +173,12 @@ private: //materials stuff
 
     bool allowLodDegrade;
     bool is2DMode;
+
+    static const uint32 PARALLEL_UPDATE_MIN_PARTICLES = 1024;
+    bool parallelUpdateEnabled = true;
+    Vector<EffectUpdate> effectUpdates;
+    SimulationScratch simulationScratch;
+    Vector<SimulationScratch> workerScratches;
 };
 
 inline const Vector<std::pair<ParticleEffectSystem::MaterialData, NMaterial*>>& ParticleEffectSystem::GetMaterialInstances() const
@@ -138,4 +195,14 @@ inline bool ParticleEffectSystem::GetAllowLodDegrade() const
 {
     return allowLodDegrade;
 }
+
+inline void ParticleEffectSystem::SetParallelUpdateEnabled(bool enabled)
+{
+    parallelUpdateEnabled = enabled;
+}
+
+inline bool ParticleEffectSystem::IsParallelUpdateEnabled() const
+{
+    return parallelUpdateEnabled;
+}
 };
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "Animation/AnimationTrack.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/ComponentHelpers.h"
@@ -16,6 +19,12 @@
 
 namespace DAVA
 {
+namespace SkeletonSystemDetails
+{
+// Minimal count of skeletons processed by one worker task
+static const uint32 SKELETONS_PER_TASK = 8;
+}
+
 SkeletonSystem::SkeletonSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -72,6 +81,7 @@ void SkeletonSystem::Process(float32 timeElapsed)
     UpdateTestSkeletons();
 #endif
 
+    updatedSkeletons.clear();
     for (int32 i = 0, sz = static_cast<int32>(entities.size()); i < sz; ++i)
     {
         SkeletonComponent* component = GetSkeletonComponent(entities[i]);
@@ -85,16 +95,45 @@ void SkeletonSystem::Process(float32 timeElapsed)
 
             if (component->startJoint != SkeletonComponent::INVALID_JOINT_INDEX)
             {
-                UpdateJointTransforms(component);
+                SkinnedMesh* skinnedMesh = nullptr;
                 RenderObject* ro = GetRenderObject(entities[i]);
                 if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
                 {
-                    UpdateSkinnedMesh(component, static_cast<SkinnedMesh*>(ro));
+                    skinnedMesh = static_cast<SkinnedMesh*>(ro);
                 }
+                updatedSkeletons.push_back({ component, skinnedMesh });
             }
         }
     }
 
+    // Skeletons are independent, so with enough of them joints are updated on job workers.
+    // Render system isn't thread-safe, skinned meshes are marked for update afterwards
+    uint32 updatedCount = static_cast<uint32>(updatedSkeletons.size());
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (nullptr != jobManager && updatedCount >= 2 * SkeletonSystemDetails::SKELETONS_PER_TASK)
+    {
+        JobGroup group;
+        for (uint32 taskBegin = 0; taskBegin < updatedCount; taskBegin += SkeletonSystemDetails::SKELETONS_PER_TASK)
+        {
+            uint32 taskEnd = std::min(taskBegin + SkeletonSystemDetails::SKELETONS_PER_TASK, updatedCount);
+            jobManager->CreateWorkerTask([this, taskBegin, taskEnd]() { UpdateSkeletonsRange(taskBegin, taskEnd); }, &group);
+        }
+        jobManager->WaitWorkerGroup(&group);
+    }
+    else
+    {
+        UpdateSkeletonsRange(0, updatedCount);
+    }
+
+    RenderSystem* renderSystem = GetScene()->GetRenderSystem();
+    for (const SkeletonUpdate& update : updatedSkeletons)
+    {
+        if (update.skinnedMesh != nullptr)
+        {
+            renderSystem->MarkForUpdate(update.skinnedMesh);
+        }
+    }
+
     DrawSkeletons(GetScene()->renderSystem->GetDebugDrawer());
 }
 
@@ -137,6 +176,19 @@ void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
     }
 }
 
+void SkeletonSystem::UpdateSkeletonsRange(uint32 begin, uint32 end)
+{
+    for (uint32 i = begin; i < end; ++i)
+    {
+        const SkeletonUpdate& update = updatedSkeletons[i];
+        UpdateJointTransforms(update.skeleton);
+        if (update.skinnedMesh != nullptr)
+        {
+            UpdateSkinnedMeshData(update.skeleton, update.skinnedMesh);
+        }
+    }
+}
+
 void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 {
     DVASSERT(!skeleton->configUpdated);
@@ -183,6 +235,12 @@ void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 }
 
 void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
+{
+    UpdateSkinnedMeshData(skeleton, skinnedMeshObject);
+    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
+}
+
+void SkeletonSystem::UpdateSkinnedMeshData(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
 {
     DVASSERT(!skeleton->configUpdated);
 
@@ -199,8 +257,6 @@ void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh*
 
     skinnedMeshObject->UpdateJointTransforms(skeleton->finalTransforms);
     skinnedMeshObject->SetBoundingBox(resBox); //TODO: *Skinning* decide on bbox calculation
-
-    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
 }
 
 void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
@@ -28,13 +28,22 @@ public:
     void DrawSkeletons(RenderHelper* drawer);
 
 private:
+    struct SkeletonUpdate
+    {
+        SkeletonComponent* skeleton;
+        SkinnedMesh* skinnedMesh;
+    };
+
+    void UpdateSkeletonsRange(uint32 begin, uint32 end);
     void UpdateJointTransforms(SkeletonComponent* skeleton);
+    void UpdateSkinnedMeshData(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject);
 
     void RebuildSkeleton(SkeletonComponent* skeleton);
 
     void UpdateTestSkeletons(float32 timeElapsed);
 
     Vector<Entity*> entities;
+    Vector<SkeletonUpdate> updatedSkeletons; //skeletons with changed joints in the current frame
 };
 
 } //ns
@@ -0,0 +1,103 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/RefPtr.h"
+#include "Math/Transform.h"
+#include "Scene3D/Scene.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
+#include "Scene3D/Systems/TransformSystem.h"
+
+namespace TransformSystemTestDetails
+{
+using namespace DAVA;
+
+const uint32 ROOTS_COUNT = 8;
+const uint32 CHILDREN_COUNT = 6;
+const uint32 DEPTH = 4;
+
+Transform MakeTransform(uint32 index)
+{
+    float32 f = static_cast<float32>(index);
+    return Transform(Vector3(f * 0.37f, -f * 1.13f, f * 0.01f), Vector3(1.0f + 0.001f * f, 1.0f, 0.999f), Quaternion::MakeRotation(Vector3(0.3f, 1.0f, 0.2f), 0.017f * f));
+}
+
+void CreateHierarchy(Entity* parent, uint32 depth, Vector<Entity*>& entities)
+{
+    if (depth == DEPTH)
+    {
+        return;
+    }
+
+    for (uint32 i = 0; i < CHILDREN_COUNT; ++i)
+    {
+        RefPtr<Entity> child;
+        child.ConstructInplace();
+        child->GetComponent<TransformComponent>()->SetLocalTransform(MakeTransform(static_cast<uint32>(entities.size())));
+        parent->AddNode(child.Get());
+        entities.push_back(child.Get());
+
+        CreateHierarchy(child.Get(), depth + 1, entities);
+    }
+}
+
+void CreateScene(Scene* scene, Vector<Entity*>& entities)
+{
+    for (uint32 i = 0; i < ROOTS_COUNT; ++i)
+    {
+        RefPtr<Entity> root;
+        root.ConstructInplace();
+        root->GetComponent<TransformComponent>()->SetLocalTransform(MakeTransform(i));
+        scene->AddNode(root.Get());
+        entities.push_back(root.Get());
+
+        CreateHierarchy(root.Get(), 1, entities);
+    }
+}
+}
+
+DAVA_TESTCLASS (TransformSystemTest)
+{
+    DAVA_TEST (BatchedUpdateIsBitIdenticalTest)
+    {
+        using namespace DAVA;
+        using namespace TransformSystemTestDetails;
+
+        RefPtr<Scene> defaultScene;
+        defaultScene.ConstructInplace();
+        Vector<Entity*> defaultEntities;
+        CreateScene(defaultScene.Get(), defaultEntities);
+
+        RefPtr<Scene> batchedScene;
+        batchedScene.ConstructInplace();
+        batchedScene->transformSystem->SetBatchedUpdateEnabled(true);
+        Vector<Entity*> batchedEntities;
+        CreateScene(batchedScene.Get(), batchedEntities);
+
+        TEST_VERIFY(defaultEntities.size() == batchedEntities.size());
+
+        for (uint32 frame = 0; frame < 3; ++frame)
+        {
+            defaultScene->transformSystem->Process(0.0f);
+            batchedScene->transformSystem->Process(0.0f);
+            defaultScene->transformSingleComponent->Clear();
+            batchedScene->transformSingleComponent->Clear();
+
+            for (size_t i = 0; i < defaultEntities.size(); ++i)
+            {
+                TransformComponent* defaultTransform = defaultEntities[i]->GetComponent<TransformComponent>();
+                TransformComponent* batchedTransform = batchedEntities[i]->GetComponent<TransformComponent>();
+
+                TEST_VERIFY(defaultTransform->GetWorldTransform() == batchedTransform->GetWorldTransform());
+            }
+
+            // move every third entity to make next frame update only a part of the hierarchy
+            for (size_t i = 0; i < defaultEntities.size(); i += 3)
+            {
+                Transform transform = MakeTransform(static_cast<uint32>(i + frame * 7));
+                defaultEntities[i]->GetComponent<TransformComponent>()->SetLocalTransform(transform);
+                batchedEntities[i]->GetComponent<TransformComponent>()->SetLocalTransform(transform);
+            }
+        }
+    }
+};
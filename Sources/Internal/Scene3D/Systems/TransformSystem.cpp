@@ -1,6 +1,9 @@
 #include "Debug/DVAssert.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Scene3D/Components/AnimationComponent.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Math/Transform.h"
@@ -12,6 +15,12 @@
 
 namespace DAVA
 {
+namespace TransformSystemDetails
+{
+// Minimal count of nodes processed by one worker task in batched mode
+static const uint32 NODES_PER_TASK = 512;
+}
+
 TransformSystem::TransformSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -47,6 +56,16 @@ void TransformSystem::Process(float32 timeElapsed)
         FindNodeThatRequireUpdate(updatableEntities[i]);
     }
     updatableEntities.clear();
+
+    if (batchedUpdateEnabled)
+    {
+        ProcessBatch();
+    }
+}
+
+void TransformSystem::SetBatchedUpdateEnabled(bool enabled)
+{
+    batchedUpdateEnabled = enabled;
 }
 
 void TransformSystem::FindNodeThatRequireUpdate(Entity* entity)
@@ -62,7 +81,14 @@ void TransformSystem::FindNodeThatRequireUpdate(Entity* entity)
 
         if (entity->GetFlags() & Entity::TRANSFORM_NEED_UPDATE)
         {
-            TransformAllChildEntities(entity);
+            if (batchedUpdateEnabled)
+            {
+                GatherAllChildEntities(entity);
+            }
+            else
+            {
+                TransformAllChildEntities(entity);
+            }
         }
         else
         {
@@ -128,6 +154,147 @@ void TransformSystem::TransformAllChildEntities(Entity* entity)
     multipliedNodes += localMultiplied;
 }
 
+void TransformSystem::GatherAllChildEntities(Entity* entity)
+{
+    static const uint32 STACK_SIZE = 5000;
+    uint32 stackPosition = 0;
+    Entity* stack[STACK_SIZE];
+    uint32 levelStack[STACK_SIZE];
+    stack[stackPosition] = entity;
+    levelStack[stackPosition++] = 0;
+
+    while (stackPosition > 0)
+    {
+        --stackPosition;
+        Entity* entity = stack[stackPosition];
+        uint32 level = levelStack[stackPosition];
+
+        // Subtrees gathered from different roots don't intersect,
+        // so depth relative to the subtree root is enough to order parents before children
+        batch.gatheredEntities.push_back(entity);
+        batch.gatheredLevels.push_back(level);
+
+        entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE | Entity::TRANSFORM_DIRTY);
+
+        uint32 size = entity->GetChildrenCount();
+        for (uint32 i = 0; i < size; ++i)
+        {
+            DVASSERT(stackPosition < STACK_SIZE - 1);
+            stack[stackPosition] = entity->GetChild(i);
+            levelStack[stackPosition++] = level + 1;
+        }
+    }
+    DVASSERT(stackPosition == 0);
+}
+
+void TransformSystem::ProcessBatch()
+{
+    uint32 gatheredCount = static_cast<uint32>(batch.gatheredEntities.size());
+    if (gatheredCount == 0)
+    {
+        return;
+    }
+
+    // Counting sort of gathered nodes by level
+    batch.levelOffsets.clear();
+    for (uint32 level : batch.gatheredLevels)
+    {
+        if (level + 2 > batch.levelOffsets.size())
+        {
+            batch.levelOffsets.resize(level + 2, 0);
+        }
+        batch.levelOffsets[level + 1]++;
+    }
+
+    uint32 levelsCount = static_cast<uint32>(batch.levelOffsets.size()) - 1;
+    for (uint32 level = 0; level < levelsCount; ++level)
+    {
+        batch.levelOffsets[level + 1] += batch.levelOffsets[level];
+    }
+
+    batch.components.assign(gatheredCount, nullptr);
+    batch.localTransforms.resize(gatheredCount);
+    batch.parentTransforms.assign(gatheredCount, nullptr);
+
+    Vector<uint32> insertPositions(batch.levelOffsets.begin(), batch.levelOffsets.end() - 1);
+    for (uint32 i = 0; i < gatheredCount; ++i)
+    {
+        Entity* entity = batch.gatheredEntities[i];
+        uint32 index = insertPositions[batch.gatheredLevels[i]]++;
+
+        TransformComponent* transform = entity->GetComponent<TransformComponent>();
+        batch.components[index] = transform;
+        batch.parentTransforms[index] = transform->parentTransform;
+
+        if (transform->parentTransform)
+        {
+            AnimationComponent* animComp = GetAnimationComponent(entity);
+            if (animComp)
+            {
+                batch.localTransforms[index] = Transform(animComp->animationTransform) * transform->localTransform;
+            }
+            else
+            {
+                batch.localTransforms[index] = transform->localTransform;
+            }
+        }
+    }
+
+    batch.gatheredEntities.clear();
+    batch.gatheredLevels.clear();
+
+    // Levels are processed one after another, as each level reads world transforms of the previous one
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    for (uint32 level = 0; level < levelsCount; ++level)
+    {
+        uint32 begin = batch.levelOffsets[level];
+        uint32 end = batch.levelOffsets[level + 1];
+
+        if (nullptr != jobManager && end - begin >= 2 * TransformSystemDetails::NODES_PER_TASK)
+        {
+            JobGroup group;
+            for (uint32 taskBegin = begin; taskBegin < end; taskBegin += TransformSystemDetails::NODES_PER_TASK)
+            {
+                uint32 taskEnd = std::min(taskBegin + TransformSystemDetails::NODES_PER_TASK, end);
+                jobManager->CreateWorkerTask([this, taskBegin, taskEnd]() { TransformBatchRange(taskBegin, taskEnd); }, &group);
+            }
+            jobManager->WaitWorkerGroup(&group);
+        }
+        else
+        {
+            TransformBatchRange(begin, end);
+        }
+    }
+
+    // Notification about changed transforms isn't thread-safe, so do it here
+    TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
+    for (TransformComponent* transform : batch.components)
+    {
+        if (transform->parentTransform)
+        {
+            tsc->worldTransformChanged.Push(transform->GetEntity());
+            multipliedNodes++;
+        }
+    }
+}
+
+void TransformSystem::TransformBatchRange(uint32 begin, uint32 end)
+{
+    TransformComponent* const* components = batch.components.data();
+    const Transform* localTransforms = batch.localTransforms.data();
+    const Transform* const* parentTransforms = batch.parentTransforms.data();
+
+    for (uint32 i = begin; i < end; ++i)
+    {
+        if (nullptr != parentTransforms[i])
+        {
+            TransformComponent* transform = components[i];
+            transform->worldTransform = localTransforms[i] * *(parentTransforms[i]);
+            transform->worldMatrix = TransformUtils::ToMatrix(transform->worldTransform);
+        }
+    }
+}
+
 void TransformSystem::EntityNeedUpdate(Entity* entity)
 {
     entity->AddFlag(Entity::TRANSFORM_NEED_UPDATE);
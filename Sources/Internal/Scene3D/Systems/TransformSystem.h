@@ -3,6 +3,7 @@
 #include "Base/BaseTypes.h"
 #include "Math/MathConstants.h"
 #include "Math/Matrix4.h"
+#include "Math/Transform.h"
 #include "Base/Singleton.h"
 #include "Entity/SceneSystem.h"
 
@@ -24,15 +25,46 @@ public:
     void PrepareForRemove() override;
     void Process(float32 timeElapsed) override;
 
+    /**
+        Enable or disable batched update mode.
+        In batched mode dirty nodes are gathered into flat arrays sorted by hierarchy depth,
+        and each hierarchy level is updated as one batch split across worker threads.
+        Results are bit-identical to the default mode.
+    */
+    void SetBatchedUpdateEnabled(bool enabled);
+    bool IsBatchedUpdateEnabled() const;
+
 private:
+    struct UpdateBatch
+    {
+        Vector<TransformComponent*> components;
+        Vector<Transform> localTransforms; // local transforms with applied animation
+        Vector<const Transform*> parentTransforms;
+        Vector<uint32> levelOffsets; // nodes of level `i` are in range [levelOffsets[i], levelOffsets[i + 1])
+
+        Vector<Entity*> gatheredEntities;
+        Vector<uint32> gatheredLevels;
+    };
+
     Vector<Entity*> updatableEntities;
+    UpdateBatch batch;
+    bool batchedUpdateEnabled = false;
 
     void EntityNeedUpdate(Entity* entity);
     void HierarchicAddToUpdate(Entity* entity);
     void FindNodeThatRequireUpdate(Entity* entity);
     void TransformAllChildEntities(Entity* entity);
 
+    void GatherAllChildEntities(Entity* entity);
+    void ProcessBatch();
+    void TransformBatchRange(uint32 begin, uint32 end);
+
     int32 passedNodes;
     int32 multipliedNodes;
 };
+
+inline bool TransformSystem::IsBatchedUpdateEnabled() const
+{
+    return batchedUpdateEnabled;
+}
 };
@@ -21,7 +21,9 @@ public:
         FLAG_STICK_THIS = 1 << 4,
         FLAG_STICK_HARD = 1 << 5,
         FLAG_LTR = 1 << 6,
-        FLAG_RTL = 1 << 7
+        FLAG_RTL = 1 << 7,
+        FLAG_SIZE_MEASURED = 1 << 8, // size is final before measure phase, measuring is skipped
+        FLAG_CHILDREN_SKIPPED = 1 << 9 // subtree is clean, children keep results of previous layout
     };
 
 public:
@@ -14,8 +14,25 @@
 namespace DAVA
 {
 void Layouter::ApplyLayout(UIControl* control)
+{
+    ApplyLayoutToSubtree(control, false);
+
+    // skipped subtrees which roots got new size
+    while (!resizedControls.empty())
+    {
+        RefPtr<UIControl> resizedControl = resizedControls.back();
+        resizedControls.pop_back();
+        ApplyLayoutToSubtree(resizedControl.Get(), true);
+    }
+}
+
+void Layouter::ApplyLayoutToSubtree(UIControl* control, bool keepRootSize)
 {
     CollectControls(control, true);
+    if (keepRootSize)
+    {
+        layoutData[0].SetFlag(ControlLayoutData::FLAG_SIZE_MEASURED);
+    }
 
     ProcessAxis(Vector2::AXIS_X, true);
     ProcessAxis(Vector2::AXIS_Y, true);
@@ -70,13 +87,33 @@ void Layouter::CollectControlChildren(UIControl* control, int32 parentIndex, int
         {
             if (child->GetComponentCount<UILayoutIsolationComponent>() == 0)
             {
-                CollectControlChildren(child.Get(), index, childIndex, recursive);
+                if (CanSkipChildren(child.Get()))
+                {
+                    layoutData[childIndex].SetParentIndex(index);
+                    layoutData[childIndex].SetFlag(ControlLayoutData::FLAG_CHILDREN_SKIPPED);
+                }
+                else
+                {
+                    CollectControlChildren(child.Get(), index, childIndex, recursive);
+                }
                 childIndex++;
             }
         }
     }
 }
 
+bool Layouter::CanSkipChildren(const UIControl* control) const
+{
+    if (!isIncremental || control->IsLayoutSubtreeDirty() || control->GetChildren().empty())
+    {
+        return false;
+    }
+
+    // measuring of such control needs its children
+    UISizePolicyComponent* sizePolicy = control->GetComponent<UISizePolicyComponent>();
+    return sizePolicy == nullptr || !(sizePolicy->IsDependsOnChildren(Vector2::AXIS_X) || sizePolicy->IsDependsOnChildren(Vector2::AXIS_Y));
+}
+
 void Layouter::ProcessAxis(Vector2::eAxis axis, bool processSizes)
 {
     if (processSizes)
@@ -91,6 +128,11 @@ void Layouter::DoMeasurePhase(Vector2::eAxis axis)
     int32 lastIndex = static_cast<int32>(layoutData.size() - 1);
     for (int32 index = lastIndex; index >= 0; index--)
     {
+        if (layoutData[index].HasFlag(ControlLayoutData::FLAG_SIZE_MEASURED))
+        {
+            continue;
+        }
+
         UISizePolicyComponent* sizePolicy = layoutData[index].GetControl()->GetComponent<UISizePolicyComponent>();
         if (sizePolicy != nullptr)
         {
@@ -169,7 +211,19 @@ void Layouter::ApplySizesAndPositions()
 {
     for (ControlLayoutData& data : layoutData)
     {
-        data.ApplyLayoutToControl();
+        if (data.HasFlag(ControlLayoutData::FLAG_CHILDREN_SKIPPED))
+        {
+            Vector2 prevSize = data.GetControl()->GetSize();
+            data.ApplyLayoutToControl();
+            if (prevSize != data.GetControl()->GetSize())
+            {
+                resizedControls.push_back(RefPtr<UIControl>::ConstructWithRetain(data.GetControl()));
+            }
+        }
+        else
+        {
+            data.ApplyLayoutToControl();
+        }
     }
 }
 
@@ -186,6 +240,11 @@ void Layouter::SetRtl(bool rtl)
     isRtl = rtl;
 }
 
+void Layouter::SetIncremental(bool incremental)
+{
+    isIncremental = incremental;
+}
+
 bool Layouter::IsLeftNotch() const
 {
     return isLeftNotch;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Base/RefPtr.h"
 #include "Functional/Function.h"
 #include "Math/Vector.h"
 #include "Math/Rect.h"
@@ -29,6 +30,14 @@ public:
     void SetRtl(bool rtl);
     bool IsRtl() const;
 
+    /**
+     In incremental mode children with clean layout subtree (see `UIControl::IsLayoutSubtreeDirty`)
+     are collected without their descendants, current control size is used as their measurement.
+     Descendants are laid out only if size of such control is changed.
+     */
+    void SetIncremental(bool incremental);
+    bool IsIncremental() const;
+
     bool IsLeftNotch() const;
     bool IsRightNotch() const;
     const LayoutMargins& GetSafeAreaInsets() const;
@@ -45,8 +54,13 @@ public:
     Function<void(UIControl*, Vector2::eAxis, const LayoutFormula*)> onFormulaProcessed;
 
 private:
+    void ApplyLayoutToSubtree(UIControl* control, bool keepRootSize);
+    bool CanSkipChildren(const UIControl* control) const;
+
     Vector<ControlLayoutData> layoutData;
+    Vector<RefPtr<UIControl>> resizedControls;
     bool isRtl = false;
+    bool isIncremental = false;
     Rect visibilityRect;
     LayoutMargins safeAreaInsets;
     bool isLeftNotch = false;
@@ -68,6 +82,11 @@ inline bool Layouter::IsRtl() const
     return isRtl;
 }
 
+inline bool Layouter::IsIncremental() const
+{
+    return isIncremental;
+}
+
 inline const Rect& Layouter::GetVisibilityRect() const
 {
     return visibilityRect;
@@ -92,13 +92,15 @@ void UILayoutSystem::Process(float32 elapsedTime)
 
     if (currentScreen.Valid())
     {
-        ProcessControlHierarhy(currentScreen.Get());
+        ProcessHierarhy(currentScreen.Get());
     }
 
     if (popupContainer.Valid())
     {
-        ProcessControlHierarhy(popupContainer.Get());
+        ProcessHierarhy(popupContainer.Get());
     }
+
+    fullLayoutRequired = false;
 }
 
 void UILayoutSystem::UnregisterControl(UIControl* control)
@@ -141,7 +143,7 @@ void UILayoutSystem::ForceProcessControl(float32 elapsedTime, UIControl* control
     if (!needUpdate && !dirty)
         return;
 
-    ProcessControlHierarhy(control);
+    ProcessHierarhy(control);
 }
 
 void UILayoutSystem::SetCurrentScreen(const RefPtr<UIScreen>& screen)
@@ -162,6 +164,16 @@ bool UILayoutSystem::IsRtl() const
 void UILayoutSystem::SetRtl(bool rtl)
 {
     sharedLayouter->SetRtl(rtl);
+    fullLayoutRequired = true;
+
+    if (currentScreen.Valid())
+    {
+        currentScreen->SetLayoutDirty();
+    }
+    if (popupContainer.Valid())
+    {
+        popupContainer->SetLayoutDirty();
+    }
 }
 
 void UILayoutSystem::SetPhysicalSafeAreaInsets(float32 left, float32 top, float32 right, float32 bottom, bool isLeftNotch_, bool isRightNotch_)
@@ -180,6 +192,7 @@ void UILayoutSystem::SetPhysicalSafeAreaInsets(float32 left, float32 top, float3
                                       vcs->ConvertPhysicalToVirtualY(bottom),
                                       isLeftNotch,
                                       isRightNotch);
+    fullLayoutRequired = true;
 
     if (currentScreen.Valid())
     {
@@ -329,8 +342,21 @@ bool UILayoutSystem::HaveToLayoutAfterReposition(const UIControl* control) const
     return false;
 }
 
+void UILayoutSystem::ProcessHierarhy(UIControl* control)
+{
+    sharedLayouter->SetIncremental(!fullLayoutRequired);
+    ProcessControlHierarhy(control);
+    sharedLayouter->SetIncremental(false);
+}
+
 void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
 {
+    // nothing to layout in this subtree
+    if (!control->IsLayoutSubtreeDirty())
+    {
+        return;
+    }
+
     ProcessControl(control);
 
     // TODO: For now game has many places where changes in layouts can
@@ -350,11 +376,24 @@ void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
         }
         ++it;
     }
+
+    // flag is kept if something was marked dirty during layout of the subtree
+    bool subtreeDirty = control->IsLayoutDirty() || control->IsLayoutPositionDirty() || control->IsLayoutOrderDirty();
+    for (auto childIt = children.begin(); childIt != children.end() && !subtreeDirty; ++childIt)
+    {
+        subtreeDirty = (*childIt)->IsLayoutSubtreeDirty();
+    }
+
+    if (!subtreeDirty)
+    {
+        control->ResetLayoutSubtreeDirty();
+    }
 }
 
 void UILayoutSystem::UpdateVisibilityRect(const Rect& visibilityRect)
 {
     sharedLayouter->SetVisibilityRect(visibilityRect);
+    fullLayoutRequired = true;
     if (currentScreen.Valid())
     {
         currentScreen->SetLayoutDirty();
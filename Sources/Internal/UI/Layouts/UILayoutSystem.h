@@ -66,6 +66,7 @@ private:
     bool HaveToLayoutAfterReposition(const UIControl* control) const;
 
     void CollectControls(UIControl* control, bool recursive);
+    void ProcessHierarhy(UIControl* control);
     void ProcessControlHierarhy(UIControl* control);
     void ProcessControl(UIControl* control);
 
@@ -74,6 +75,7 @@ private:
     bool autoupdatesEnabled = true;
     bool dirty = false;
     bool needUpdate = false;
+    bool fullLayoutRequired = true; // parameters which affect whole hierarchy are changed
     std::unique_ptr<class Layouter> sharedLayouter;
     RefPtr<UIScreen> currentScreen;
     RefPtr<UIControl> popupContainer;
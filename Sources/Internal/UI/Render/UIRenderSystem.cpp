@@ -6,12 +6,14 @@
 #include "Render/2D/TextBlock.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/Renderer.h"
+#include "Render/Texture.h"
 #include "UI/Render/UIClipContentComponent.h"
 #include "UI/Render/UIDebugRenderComponent.h"
 #include "UI/Scene3D/UISceneComponent.h"
 #include "UI/Text/Private/UITextSystemLink.h"
 #include "UI/Text/UITextComponent.h"
 #include "UI/UIControl.h"
+#include "UI/UIControlBackground.h"
 #include "UI/UIControlSystem.h"
 #include "UI/UIScreen.h"
 #include "UI/UIScreenTransition.h"
@@ -58,6 +60,12 @@ void UIRenderSystem::OnControlInvisible(UIControl* control)
     {
         ui3DViews.erase(control);
     }
+
+    UIControlBackground* bg = control->GetComponent<UIControlBackground>();
+    if (bg != nullptr)
+    {
+        retainedBackgrounds.erase(bg);
+    }
 }
 
 void UIRenderSystem::RegisterComponent(UIControl* control, UIComponent* component)
@@ -74,6 +82,10 @@ void UIRenderSystem::UnregisterComponent(UIControl* control, UIComponent* compon
     {
         ui3DViews.erase(control);
     }
+    else if (component->GetType() == Type::Instance<UIControlBackground>())
+    {
+        retainedBackgrounds.erase(static_cast<UIControlBackground*>(component));
+    }
 }
 
 void UIRenderSystem::Process(float32 elapsedTime)
@@ -149,6 +161,121 @@ void UIRenderSystem::SetPopupContainer(const RefPtr<UIControl>& _popupContainer)
     popupContainer = _popupContainer;
 }
 
+void UIRenderSystem::SetRetainedBatchesEnabled(bool enabled)
+{
+    retainedBatchesEnabled = enabled;
+    if (!retainedBatchesEnabled)
+    {
+        retainedBackgrounds.clear();
+    }
+}
+
+bool UIRenderSystem::IsRetainedBatchesEnabled() const
+{
+    return retainedBatchesEnabled;
+}
+
+void UIRenderSystem::DrawBackground(const UIControl* control, UIControlBackground* background, const UIGeometricData& geometricData)
+{
+    UIControlBackground::eDrawType drawType = background->GetDrawType();
+    // Custom batches are set for one draw only, multilayer tiles use several texture streams
+    // and per pixel accuracy depends on position of previous draw
+    bool retain = retainedBatchesEnabled && control->IsVisible() &&
+    drawType != UIControlBackground::DRAW_BATCH &&
+    drawType != UIControlBackground::DRAW_TILED_MULTILAYER &&
+    background->GetPerPixelAccuracyType() != UIControlBackground::PER_PIXEL_ACCURACY_ENABLED;
+
+    if (!retain)
+    {
+        background->Draw(geometricData);
+        return;
+    }
+
+    RetainedBackgroundState state;
+    state.Build(background, geometricData);
+
+    RetainedBackground& retained = retainedBackgrounds[background];
+    if (retained.state == state && renderSystem2D->PushRetainedBatches(retained.batches))
+    {
+        return;
+    }
+
+    retained.state = state;
+    renderSystem2D->BeginRetainedBatches(&retained.batches);
+    background->Draw(geometricData);
+    renderSystem2D->EndRetainedBatches();
+}
+
+void UIRenderSystem::RetainedBackgroundState::Build(const UIControlBackground* background, const UIGeometricData& geometricData)
+{
+    position = geometricData.position;
+    size = geometricData.size;
+    pivotPoint = geometricData.pivotPoint;
+    scale = geometricData.scale;
+    angle = geometricData.angle;
+    unrotatedRect = geometricData.GetUnrotatedRect();
+    drawColor = background->GetDrawColor();
+    drawType = background->GetDrawType();
+    align = background->GetAlign();
+    modification = background->GetModification();
+    perPixelAccuracyType = background->GetPerPixelAccuracyType();
+    stretchCap = Vector2(background->GetLeftRightStretchCap(), background->GetTopBottomStretchCap());
+    material = background->GetMaterial();
+
+    // Sprite can be reloaded or repacked in place, so its frame data is compared too
+    sprite = background->GetSprite();
+    if (sprite != nullptr)
+    {
+        frame = Clamp(background->GetFrame(), 0, sprite->GetFrameCount() - 1);
+        spriteSize = sprite->GetSize();
+        spritePivotPoint = sprite->GetDefaultPivotPoint();
+        Memcpy(frameVertices.data(), sprite->GetFrameVerticesForFrame(frame), sizeof(frameVertices));
+        Memcpy(textureCoords.data(), sprite->GetTextureCoordsForFrame(frame), sizeof(textureCoords));
+        for (uint32 i = 0; i < rectsAndOffsets.size(); ++i)
+        {
+            rectsAndOffsets[i] = sprite->GetRectOffsetValueForFrame(frame, static_cast<Sprite::eRectsAndOffsets>(i));
+        }
+
+        texture = sprite->GetTexture(frame);
+        if (texture != nullptr)
+        {
+            textureSetHandle = texture->singleTextureSet;
+            samplerStateHandle = texture->samplerStateHandle;
+            textureWidth = texture->width;
+            textureHeight = texture->height;
+        }
+    }
+}
+
+bool UIRenderSystem::RetainedBackgroundState::operator==(const RetainedBackgroundState& other) const
+{
+    return position == other.position &&
+    size == other.size &&
+    pivotPoint == other.pivotPoint &&
+    scale == other.scale &&
+    angle == other.angle &&
+    unrotatedRect == other.unrotatedRect &&
+    drawColor == other.drawColor &&
+    drawType == other.drawType &&
+    align == other.align &&
+    modification == other.modification &&
+    perPixelAccuracyType == other.perPixelAccuracyType &&
+    stretchCap == other.stretchCap &&
+    material == other.material &&
+    sprite == other.sprite &&
+    frame == other.frame &&
+    spriteSize == other.spriteSize &&
+    spritePivotPoint == other.spritePivotPoint &&
+    frameVertices == other.frameVertices &&
+    textureCoords == other.textureCoords &&
+    rectsAndOffsets == other.rectsAndOffsets &&
+    texture == other.texture &&
+    textureSetHandle == other.textureSetHandle &&
+    samplerStateHandle == other.samplerStateHandle &&
+    textureWidth == other.textureWidth &&
+    textureHeight == other.textureHeight;
+}
+
 void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground)
 {
     if (!control->GetVisibilityFlag() || control->IsHiddenForDebug())
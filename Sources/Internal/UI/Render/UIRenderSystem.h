@@ -2,9 +2,12 @@
 
 #include "Base/BaseTypes.h"
 #include "Base/RefPtr.h"
+#include "Render/2D/Systems/BatchDescriptor2D.h"
 #include "UI/UISystem.h"
 #include "UI/UIGeometricData.h"
 
+struct UIRenderSystemTest;
+
 namespace DAVA
 {
 class Color;
@@ -15,11 +18,15 @@ class UITextComponent;
 class UIScreen;
 class UIScreenTransition;
 class UIScreenshoter;
+class NMaterial;
+class Sprite;
+class Texture;
 
 class UIRenderSystem final
 : public UISystem
 {
     friend class UIControlSystem;
+    friend UIRenderSystemTest;
 
 public:
     UIRenderSystem(RenderSystem2D* renderSystem2D);
@@ -36,6 +43,17 @@ public:
     void SetCurrentScreen(const RefPtr<UIScreen>& screen);
     void SetPopupContainer(const RefPtr<UIControl>& popupContainer);
 
+    /**
+        Enable or disable retained batches of control backgrounds (enabled by default).
+        Batches of each visible background are kept between frames and pushed again as is
+        until geometry, transform, color or sprite of the background changes.
+    */
+    void SetRetainedBatchesEnabled(bool enabled);
+    bool IsRetainedBatchesEnabled() const;
+
+    /** Draw `background` of `control`, reusing batches built on previous frames if nothing has changed. */
+    void DrawBackground(const UIControl* control, UIControlBackground* background, const UIGeometricData& geometricData);
+
 protected:
     void OnControlVisible(UIControl* control) override;
     void OnControlInvisible(UIControl* control) override;
@@ -47,6 +65,46 @@ protected:
     void Render();
 
 private:
+    /** Everything background geometry depends on. */
+    struct RetainedBackgroundState
+    {
+        Vector2 position;
+        Vector2 size;
+        Vector2 pivotPoint;
+        Vector2 scale;
+        float32 angle = 0.0f;
+        Rect unrotatedRect;
+        Color drawColor;
+        int32 drawType = 0;
+        int32 align = 0;
+        int32 modification = 0;
+        int32 perPixelAccuracyType = 0;
+        Vector2 stretchCap;
+        NMaterial* material = nullptr;
+
+        Sprite* sprite = nullptr;
+        int32 frame = 0;
+        Vector2 spriteSize;
+        Vector2 spritePivotPoint;
+        Array<float32, 8> frameVertices = {};
+        Array<float32, 8> textureCoords = {};
+        Array<float32, 6> rectsAndOffsets = {};
+        Texture* texture = nullptr;
+        rhi::HTextureSet textureSetHandle;
+        rhi::HSamplerState samplerStateHandle;
+        uint32 textureWidth = 0;
+        uint32 textureHeight = 0;
+
+        void Build(const UIControlBackground* background, const UIGeometricData& geometricData);
+        bool operator==(const RetainedBackgroundState& other) const;
+    };
+
+    struct RetainedBackground
+    {
+        RetainedBackgroundState state;
+        RetainedBatches2D batches;
+    };
+
     void ForceRenderControl(UIControl* control);
 
     void RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground);
@@ -67,5 +125,8 @@ private:
 
     Set<UIControl*> ui3DViews;
     bool needClearMainPass = true;
+
+    UnorderedMap<const UIControlBackground*, RetainedBackground> retainedBackgrounds;
+    bool retainedBatchesEnabled = true;
 };
 }
@@ -0,0 +1,101 @@
+#include "UI/Styles/UIStyleSheetIndex.h"
+#include "UI/Styles/UIStyleSheet.h"
+#include "UI/UIControl.h"
+
+namespace DAVA
+{
+void UIStyleSheetIndex::Build(const Vector<UIPriorityStyleSheet>& sortedStyleSheets)
+{
+    Clear();
+
+    for (uint32 index = 0; index < static_cast<uint32>(sortedStyleSheets.size()); ++index)
+    {
+        const UIStyleSheetSelectorChain& chain = sortedStyleSheets[index].GetStyleSheet()->GetSelectorChain();
+        for (const UIStyleSheetSelector& selector : chain)
+        {
+            usedClasses.insert(selector.classes.begin(), selector.classes.end());
+        }
+
+        if (chain.GetSize() == 0)
+        {
+            unkeyedStyleSheets.push_back(index);
+            continue;
+        }
+
+        // name is the most selective key, class name is the least one
+        const UIStyleSheetSelector& selector = *chain.rbegin();
+        if (selector.name.IsValid())
+        {
+            nameBuckets[selector.name].push_back(index);
+        }
+        else if (!selector.classes.empty())
+        {
+            classBuckets[selector.classes.front()].push_back(index);
+        }
+        else if (!selector.className.empty())
+        {
+            classNameBuckets[selector.className].push_back(index);
+        }
+        else
+        {
+            unkeyedStyleSheets.push_back(index);
+        }
+    }
+}
+
+void UIStyleSheetIndex::Clear()
+{
+    nameBuckets.clear();
+    classBuckets.clear();
+    classNameBuckets.clear();
+    unkeyedStyleSheets.clear();
+    usedClasses.clear();
+}
+
+void UIStyleSheetIndex::CollectCandidates(const UIControl* control, const UIStyleSheetClassSet& globalClasses, Vector<uint32>& candidates) const
+{
+    candidates.clear();
+    candidates.insert(candidates.end(), unkeyedStyleSheets.begin(), unkeyedStyleSheets.end());
+
+    if (control->GetName().IsValid() && !nameBuckets.empty())
+    {
+        auto it = nameBuckets.find(control->GetName());
+        AppendBucket(it != nameBuckets.end() ? &it->second : nullptr, candidates);
+    }
+
+    if (!classNameBuckets.empty())
+    {
+        auto it = classNameBuckets.find(control->GetClassName());
+        AppendBucket(it != classNameBuckets.end() ? &it->second : nullptr, candidates);
+    }
+
+    if (!classBuckets.empty())
+    {
+        for (const UIStyleSheetClassSet* classSet : { &control->GetClassSet(), &globalClasses })
+        {
+            for (const UIStyleSheetClass& clazz : classSet->GetClasses())
+            {
+                auto it = classBuckets.find(clazz.clazz);
+                AppendBucket(it != classBuckets.end() ? &it->second : nullptr, candidates);
+            }
+        }
+    }
+
+    // keep order of cascade, class may be both in control and global classes
+    std::sort(candidates.begin(), candidates.end(), std::greater<uint32>());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+bool UIStyleSheetIndex::IsClassUsed(const FastName& clazz) const
+{
+    return usedClasses.find(clazz) != usedClasses.end();
+}
+
+void UIStyleSheetIndex::AppendBucket(const Vector<uint32>* bucket, Vector<uint32>& candidates)
+{
+    if (bucket != nullptr)
+    {
+        candidates.insert(candidates.end(), bucket->begin(), bucket->end());
+    }
+}
+};
@@ -0,0 +1,41 @@
+#ifndef __DAVAENGINE_UI_STYLESHEET_INDEX_H__
+#define __DAVAENGINE_UI_STYLESHEET_INDEX_H__
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "UI/Styles/UIPriorityStyleSheet.h"
+
+namespace DAVA
+{
+class UIControl;
+class UIStyleSheetClassSet;
+
+/**
+ Index of style sheets by the rightmost selector of their chains.
+ Every style sheet is put into one bucket: by control name, by one of required classes, by control class name
+ or into list of selectors without keys. Only style sheets from buckets of the control keys can match it.
+ */
+class UIStyleSheetIndex
+{
+public:
+    void Build(const Vector<UIPriorityStyleSheet>& sortedStyleSheets);
+    void Clear();
+
+    /** Fills indices of style sheets (in sorted list) which may match `control`, in decreasing order. */
+    void CollectCandidates(const UIControl* control, const UIStyleSheetClassSet& globalClasses, Vector<uint32>& candidates) const;
+
+    /** Whether some selector of indexed style sheets requires `clazz`. */
+    bool IsClassUsed(const FastName& clazz) const;
+
+private:
+    static void AppendBucket(const Vector<uint32>* bucket, Vector<uint32>& candidates);
+
+    UnorderedMap<FastName, Vector<uint32>> nameBuckets;
+    UnorderedMap<FastName, Vector<uint32>> classBuckets;
+    UnorderedMap<String, Vector<uint32>> classNameBuckets;
+    Vector<uint32> unkeyedStyleSheets;
+    UnorderedSet<FastName> usedClasses;
+};
+};
+
+#endif
@@ -33,6 +33,11 @@ bool UIStyleSheetClassSet::RemoveClass(const FastName& clazz)
     return false;
 }
 
+const Vector<UIStyleSheetClass>& UIStyleSheetClassSet::GetClasses() const
+{
+    return classes;
+}
+
 bool UIStyleSheetClassSet::HasClass(const FastName& clazz) const
 {
     auto it = std::find_if(classes.begin(), classes.end(), [&clazz](const UIStyleSheetClass& cl) {
@@ -113,6 +113,9 @@ void UIStyleSheetSystem::Process(float32 elapsedTime)
     if (!needUpdate)
         return;
 
+    // only controls which style sheets use changed global classes are processed for global changes
+    filterGlobalClassChanges = true;
+
     if (currentScreen.Valid())
     {
         ProcessControlHierarhy(currentScreen.Get());
@@ -123,7 +126,9 @@ void UIStyleSheetSystem::Process(float32 elapsedTime)
         ProcessControlHierarhy(popupContainer.Get());
     }
 
+    filterGlobalClassChanges = false;
     globalStyleSheetDirty = false;
+    changedGlobalClasses.clear();
 }
 
 void UIStyleSheetSystem::ForceProcessControl(float32 elapsedTime, UIControl* control)
@@ -172,7 +177,7 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
     }
 
     if (packageContext
-        && (styleSheetListChanged || distanceFromDirty < packageContext->GetMaxStyleSheetHierarchyDepth()))
+        && ((styleSheetListChanged && IsAffectedByGlobalClasses(packageContext.Get())) || distanceFromDirty < packageContext->GetMaxStyleSheetHierarchyDepth()))
     {
 #if STYLESHEET_STATS
         ++statsProcessedControls;
@@ -181,16 +186,19 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
         UIStyleSheetPropertySet cascadeProperties;
         const UIStyleSheetPropertySet localControlProperties = control->GetLocalPropertySet();
         const Vector<UIPriorityStyleSheet>& styleSheets = packageContext->GetSortedStyleSheets();
-        
+        packageContext->GetStyleSheetIndex().CollectCandidates(control, globalClasses, candidateStyleSheets);
+
 #if STYLESHEET_STATS
-        statsStyleSheetCount += styleSheets.size();
+        statsStyleSheetCount += candidateStyleSheets.size();
 #endif
 
         Array<const UIStyleSheetProperty*, UIStyleSheetPropertyDataBase::STYLE_SHEET_PROPERTY_COUNT> propertySources = {};
 
-        for (auto styleSheetIter = styleSheets.rbegin(); styleSheetIter != styleSheets.rend(); ++styleSheetIter)
+        // candidates are in decreasing order, as style sheets were iterated from the end of sorted list
+        for (uint32 styleSheetIndex : candidateStyleSheets)
         {
-            const UIStyleSheet* styleSheet = styleSheetIter->GetStyleSheet();
+            const UIPriorityStyleSheet& priorityStyleSheet = styleSheets[styleSheetIndex];
+            const UIStyleSheet* styleSheet = priorityStyleSheet.GetStyleSheet();
 
             if (StyleSheetMatchesControl(styleSheet, control))
             {
@@ -209,7 +217,7 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
 
                 if (debugData != nullptr)
                 {
-                    debugData->styleSheets.push_back(*styleSheetIter);
+                    debugData->styleSheets.push_back(priorityStyleSheet);
                 }
             }
         }
@@ -279,7 +287,7 @@ void UIStyleSheetSystem::AddGlobalClass(const FastName& clazz)
 {
     if (globalClasses.AddClass(clazz))
     {
-        SetGlobalStyleSheetDirty();
+        SetGlobalStyleSheetDirty(clazz);
     }
 }
 
@@ -287,7 +295,7 @@ void UIStyleSheetSystem::RemoveGlobalClass(const FastName& clazz)
 {
     if (globalClasses.RemoveClass(clazz))
     {
-        SetGlobalStyleSheetDirty();
+        SetGlobalStyleSheetDirty(clazz);
     }
 }
 
@@ -298,7 +306,12 @@ bool UIStyleSheetSystem::HasGlobalClass(const FastName& clazz) const
 
 void UIStyleSheetSystem::SetGlobalTaggedClass(const FastName& tag, const FastName& clazz)
 {
-    globalClasses.SetTaggedClass(tag, clazz);
+    FastName prevClass = globalClasses.GetTaggedClass(tag);
+    if (globalClasses.SetTaggedClass(tag, clazz))
+    {
+        SetGlobalStyleSheetDirty(prevClass);
+        SetGlobalStyleSheetDirty(clazz);
+    }
 }
 
 FastName UIStyleSheetSystem::GetGlobalTaggedClass(const FastName& tag) const
@@ -308,7 +321,11 @@ FastName UIStyleSheetSystem::GetGlobalTaggedClass(const FastName& tag) const
 
 void UIStyleSheetSystem::ResetGlobalTaggedClass(const FastName& tag)
 {
-    globalClasses.ResetTaggedClass(tag);
+    FastName prevClass = globalClasses.GetTaggedClass(tag);
+    if (globalClasses.ResetTaggedClass(tag))
+    {
+        SetGlobalStyleSheetDirty(prevClass);
+    }
 }
 
 void UIStyleSheetSystem::ClearGlobalClasses()
@@ -425,8 +442,26 @@ void UIStyleSheetSystem::DoForAllPropertyInstances(UIControl* control, uint32 pr
     }
 }
 
-void UIStyleSheetSystem::SetGlobalStyleSheetDirty()
+bool UIStyleSheetSystem::IsAffectedByGlobalClasses(UIControlPackageContext* packageContext) const
 {
+    if (!filterGlobalClassChanges)
+    {
+        return true;
+    }
+
+    const UIStyleSheetIndex& index = packageContext->GetStyleSheetIndex();
+    return std::any_of(changedGlobalClasses.begin(), changedGlobalClasses.end(), [&index](const FastName& clazz) {
+        return index.IsClassUsed(clazz);
+    });
+}
+
+void UIStyleSheetSystem::SetGlobalStyleSheetDirty(const FastName& changedClass)
+{
+    if (changedClass.IsValid())
+    {
+        changedGlobalClasses.push_back(changedClass);
+    }
+
     globalStyleSheetDirty = true;
     if (currentScreen.Valid())
     {
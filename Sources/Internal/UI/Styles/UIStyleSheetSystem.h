@@ -13,6 +13,7 @@
 namespace DAVA
 {
 class UIControl;
+class UIControlPackageContext;
 class UIScreen;
 class UIScreenTransition;
 class UIStyleSheet;
@@ -73,9 +74,12 @@ private:
     template <typename CallbackType>
     void DoForAllPropertyInstances(UIControl* control, uint32 propertyIndex, const CallbackType& action);
     /** Sets 'globalStyleSheetDirty' flag for next 'Process()' call. Flag will reset automatically. */
-    void SetGlobalStyleSheetDirty();
+    void SetGlobalStyleSheetDirty(const FastName& changedClass);
+    bool IsAffectedByGlobalClasses(UIControlPackageContext* packageContext) const;
 
     UIStyleSheetClassSet globalClasses;
+    Vector<FastName> changedGlobalClasses;
+    Vector<uint32> candidateStyleSheets;
 
     uint64 statsTime = 0;
     int32 statsProcessedControls = 0;
@@ -84,6 +88,7 @@ private:
     bool dirty = false;
     bool needUpdate = false;
     bool globalStyleSheetDirty = false;
+    bool filterGlobalClassChanges = false;
     RefPtr<UIScreen> currentScreen;
     RefPtr<UIControl> popupContainer;
 };
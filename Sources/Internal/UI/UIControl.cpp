@@ -90,6 +90,7 @@ UIControl::UIControl(const Rect& rect)
     , layoutDirty(true)
     , layoutPositionDirty(true)
     , layoutOrderDirty(true)
+    , layoutSubtreeDirty(true)
     , inputEnabled(true)
 {
     StartControlTracking(this);
@@ -890,6 +891,7 @@ void UIControl::CopyDataFrom(UIControl* srcControl)
     layoutDirty = srcControl->layoutDirty;
     layoutPositionDirty = srcControl->layoutPositionDirty;
     layoutOrderDirty = srcControl->layoutOrderDirty;
+    SetLayoutSubtreeDirty();
     packageContext = srcControl->packageContext;
 
     eventDispatcher = nullptr;
@@ -1346,7 +1348,8 @@ void UIControl::Draw(const UIGeometricData& geometricData)
     UIControlBackground* bg = GetComponent<UIControlBackground>();
     if (bg)
     {
-        bg->Draw(geometricData);
+        UIControlSystem* controlSystem = scene ? scene : GetEngineContext()->uiControlSystem;
+        controlSystem->GetRenderSystem()->DrawBackground(this, bg, geometricData);
     }
 }
 
@@ -2248,6 +2251,11 @@ String UIControl::GetClassesAsString() const
     return classes.GetClassesAsString();
 }
 
+const UIStyleSheetClassSet& UIControl::GetClassSet() const
+{
+    return classes;
+}
+
 void UIControl::SetClassesFromString(const String& classesStr)
 {
     classes.SetClassesFromString(classesStr);
@@ -2316,6 +2324,7 @@ void UIControl::ResetStyleSheetDirty()
 void UIControl::SetLayoutDirty()
 {
     layoutDirty = true;
+    SetLayoutSubtreeDirty();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2336,6 +2345,7 @@ void UIControl::ResetLayoutDirty()
 void UIControl::SetLayoutPositionDirty()
 {
     layoutPositionDirty = true;
+    SetLayoutSubtreeDirty();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2354,6 +2364,7 @@ void UIControl::ResetLayoutPositionDirty()
 void UIControl::SetLayoutOrderDirty()
 {
     layoutOrderDirty = true;
+    SetLayoutSubtreeDirty();
 }
 
 void UIControl::ResetLayoutOrderDirty()
@@ -2361,6 +2372,22 @@ void UIControl::ResetLayoutOrderDirty()
     layoutOrderDirty = false;
 }
 
+void UIControl::SetLayoutSubtreeDirty()
+{
+    // ancestors of dirty control are already marked
+    UIControl* control = this;
+    while (control != nullptr && !control->layoutSubtreeDirty)
+    {
+        control->layoutSubtreeDirty = true;
+        control = control->parent;
+    }
+}
+
+void UIControl::ResetLayoutSubtreeDirty()
+{
+    layoutSubtreeDirty = false;
+}
+
 void UIControl::SetPackageContext(const RefPtr<UIControlPackageContext>& newPackageContext)
 {
     if (packageContext != newPackageContext)
@@ -906,6 +906,7 @@ protected:
     bool layoutDirty : 1;
     bool layoutPositionDirty : 1;
     bool layoutOrderDirty : 1;
+    bool layoutSubtreeDirty : 1;
 
     int32 inputProcessorsCount = 1;
 
@@ -1054,6 +1055,7 @@ public:
     void ResetTaggedClass(const FastName& tag);
 
     String GetClassesAsString() const;
+    const UIStyleSheetClassSet& GetClassSet() const;
     void SetClassesFromString(const String& classes);
 
     const UIStyleSheetPropertySet& GetLocalPropertySet() const;
@@ -1082,12 +1084,18 @@ public:
     void SetLayoutOrderDirty();
     void ResetLayoutOrderDirty();
 
+    /** Control or some of its descendants have dirty layout flags. Set on whole path to root, so layout skips clean subtrees. */
+    bool IsLayoutSubtreeDirty() const;
+    void ResetLayoutSubtreeDirty();
+
     RefPtr<UIControlPackageContext> GetPackageContext() const;
     const RefPtr<UIControlPackageContext>& GetLocalPackageContext() const;
     void SetPackageContext(const RefPtr<UIControlPackageContext>& packageContext);
     UIControl* GetParentWithContext() const;
 
 private:
+    void SetLayoutSubtreeDirty();
+
     UIStyleSheetClassSet classes;
     UIStyleSheetPropertySet localProperties;
     UIStyleSheetPropertySet styledProperties;
@@ -1238,4 +1246,9 @@ inline bool UIControl::IsLayoutOrderDirty() const
 {
     return layoutOrderDirty;
 }
+
+inline bool UIControl::IsLayoutSubtreeDirty() const
+{
+    return layoutSubtreeDirty;
+}
 };
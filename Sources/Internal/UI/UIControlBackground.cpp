@@ -581,7 +581,7 @@ void UIControlBackground::SetMaterial(NMaterial* _material)
     material = _material;
 }
 
-inline NMaterial* UIControlBackground::GetMaterial() const
+NMaterial* UIControlBackground::GetMaterial() const
 {
     return material.Get();
 }
@@ -31,6 +31,7 @@ void UIControlPackageContext::AddStyleSheet(const UIPriorityStyleSheet& styleShe
 void UIControlPackageContext::RemoveAllStyleSheets()
 {
     styleSheets.clear();
+    styleSheetIndex.Clear();
     maxStyleSheetHierarchyDepth = 0;
 }
 
@@ -39,12 +40,19 @@ const Vector<UIPriorityStyleSheet>& UIControlPackageContext::GetSortedStyleSheet
     if (!styleSheetsSorted)
     {
         std::sort(styleSheets.begin(), styleSheets.end());
+        styleSheetIndex.Build(styleSheets);
         styleSheetsSorted = true;
     }
 
     return styleSheets;
 }
 
+const UIStyleSheetIndex& UIControlPackageContext::GetStyleSheetIndex()
+{
+    GetSortedStyleSheets();
+    return styleSheetIndex;
+}
+
 int32 UIControlPackageContext::GetMaxStyleSheetHierarchyDepth() const
 {
     return maxStyleSheetHierarchyDepth;
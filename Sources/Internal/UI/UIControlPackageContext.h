@@ -4,6 +4,7 @@
 #include "Base/BaseObject.h"
 #include "Base/BaseTypes.h"
 #include "UI/Styles/UIPriorityStyleSheet.h"
+#include "UI/Styles/UIStyleSheetIndex.h"
 
 namespace DAVA
 {
@@ -20,11 +21,14 @@ public:
     void RemoveAllStyleSheets();
 
     const Vector<UIPriorityStyleSheet>& GetSortedStyleSheets();
+    /** Index of sorted style sheets, see `GetSortedStyleSheets`. */
+    const UIStyleSheetIndex& GetStyleSheetIndex();
 
     int32 GetMaxStyleSheetHierarchyDepth() const;
 
 private:
     Vector<UIPriorityStyleSheet> styleSheets;
+    UIStyleSheetIndex styleSheetIndex;
     bool styleSheetsSorted = false;
     int32 maxStyleSheetHierarchyDepth = 0;
 };